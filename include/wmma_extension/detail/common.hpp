@@ -109,6 +109,10 @@ __device__ inline void fill_fragment(__frag_base<float, 4>& f, const T v) {
 template <class Use, int m, int n, int k, class T, class Layout = void>
 class fragment;
 
+// Fragment uses for `mma.sp` (see sparse_24.hpp)
+struct sparse_matrix_a;
+struct metadata;
+
 template <class Use, int M, int N, int K, class Layout>
 __device__ inline void fill_zero(mtk::wmma::mma::fragment<Use, M, N, K, float, Layout>& frag) {
 	constexpr unsigned size = 4 * mtk::wmma::mma::fragment<Use, M, N, K, float, Layout>::num_elements;
@@ -164,16 +168,26 @@ template <class Use, int M, int N, int K> struct get_M;
 template <int M, int N, int K> struct get_M<nvcuda::wmma::matrix_a   , M, N, K>{static const int value = M;};
 template <int M, int N, int K> struct get_M<nvcuda::wmma::matrix_b   , M, N, K>{static const int value = K;};
 template <int M, int N, int K> struct get_M<nvcuda::wmma::accumulator, M, N, K>{static const int value = M;};
+template <int M, int N, int K> struct get_M<mtk::wmma::mma::sparse_matrix_a, M, N, K>{static const int value = M;};
 
 template <class Use, int M, int N, int K> struct get_N;
 template <int M, int N, int K> struct get_N<nvcuda::wmma::matrix_a   , M, N, K>{static const int value = K;};
 template <int M, int N, int K> struct get_N<nvcuda::wmma::matrix_b   , M, N, K>{static const int value = N;};
 template <int M, int N, int K> struct get_N<nvcuda::wmma::accumulator, M, N, K>{static const int value = N;};
+template <int M, int N, int K> struct get_N<mtk::wmma::mma::sparse_matrix_a, M, N, K>{static const int value = K / 2;};
 
 template <class Layout, int col_value, int row_value> struct layout_switch;
 template <int col_value, int row_value> struct layout_switch<nvcuda::wmma::col_major, col_value, row_value> {static const int value = col_value;};
 template <int col_value, int row_value> struct layout_switch<nvcuda::wmma::row_major, col_value, row_value> {static const int value = row_value;};
 
+// memory offset of the matrix position (i, j)
+template <class Layout> __device__ inline unsigned get_mem_offset(const unsigned i, const unsigned j, const unsigned ldm);
+template <> __device__ inline unsigned get_mem_offset<nvcuda::wmma::col_major>(const unsigned i, const unsigned j, const unsigned ldm) {return i + j * ldm;}
+template <> __device__ inline unsigned get_mem_offset<nvcuda::wmma::row_major>(const unsigned i, const unsigned j, const unsigned ldm) {return i * ldm + j;}
+__device__ inline unsigned get_mem_offset(const unsigned i, const unsigned j, const unsigned ldm, const nvcuda::wmma::layout_t layout) {
+	return (layout == nvcuda::wmma::mem_col_major) ? get_mem_offset<nvcuda::wmma::col_major>(i, j, ldm) : get_mem_offset<nvcuda::wmma::row_major>(i, j, ldm);
+}
+
 } // namespace common
 } // namespace detail
 template <class Use, int M, int N, int K, class Layout>
@@ -0,0 +1,233 @@
+#ifndef __WMMAE_DETAIL_CP_ASYNC_HPP__
+#define __WMMAE_DETAIL_CP_ASYNC_HPP__
+#include <cstdint>
+#include "host_device.hpp"
+
+// The pre-sm_80 path (synchronous copy) is also used when this header is compiled by a host compiler,
+// so that the code using these functions can be unit tested without GPUs.
+namespace mtk {
+namespace wmma {
+namespace utils {
+namespace detail {
+#ifdef __CUDACC__
+__device__ inline uint32_t get_smem_ptr_uint(const void* const ptr) {
+  uint32_t smem_ptr;
+  asm volatile("{.reg .u64 smem_ptr; cvta.to.shared.u64 smem_ptr, %1; cvt.u32.u64 %0, smem_ptr; }\n": "=r"(smem_ptr) : "l"(ptr));
+  return smem_ptr;
+}
+#endif
+} // namespace detail
+
+// async copy
+namespace cp_async {
+// Cache operators
+struct cache_all;    // cp.async.ca : cache in L1 and L2
+struct cache_global; // cp.async.cg : cache in L2 only (Size has to be 16)
+
+// L2 eviction priorities for `create_l2_policy`
+struct evict_normal;
+struct evict_first;
+struct evict_last;
+} // namespace cp_async
+
+namespace detail {
+// Used before sm_80 and on the host
+template <unsigned Size>
+WMMAE_HOST_DEVICE inline void cp_async_fallback(void* const smem, const void* const gmem, const unsigned src_size) {
+	if (src_size >= Size) {
+		for (unsigned i = 0; i < Size / 4; i++) {
+			*(reinterpret_cast<uint32_t*>(smem) + i) = *(reinterpret_cast<const uint32_t*>(gmem) + i);
+		}
+	} else {
+		// `gmem` is not read beyond `src_size` bytes
+		for (unsigned i = 0; i < Size; i++) {
+			*(reinterpret_cast<uint8_t*>(smem) + i) = (i < src_size) ? *(reinterpret_cast<const uint8_t*>(gmem) + i) : 0;
+		}
+	}
+}
+
+template <class CacheOp, unsigned Size>
+struct cp_async_core;
+
+template <unsigned Size>
+struct cp_async_core<mtk::wmma::utils::cp_async::cache_all, Size> {
+	static_assert(Size == 4 || Size == 8 || Size == 16, "Size must be one of 4, 8 and 16");
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.ca.shared.global [%0], [%1], %2;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size));
+#else
+		cp_async_fallback<Size>(smem, gmem, Size);
+#endif
+	}
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem, const unsigned src_size) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.ca.shared.global [%0], [%1], %2, %3;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size), "r"(src_size));
+#else
+		cp_async_fallback<Size>(smem, gmem, src_size);
+#endif
+	}
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem, const unsigned src_size, const uint64_t l2_policy) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.ca.shared.global.L2::cache_hint [%0], [%1], %2, %3, %4;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size), "r"(src_size), "l"(l2_policy));
+#else
+		(void)l2_policy;
+		cp_async_fallback<Size>(smem, gmem, src_size);
+#endif
+	}
+};
+
+template <unsigned Size>
+struct cp_async_core<mtk::wmma::utils::cp_async::cache_global, Size> {
+	static_assert(Size == 16, "cp.async.cg supports only 16 bytes");
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.cg.shared.global [%0], [%1], %2;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size));
+#else
+		cp_async_fallback<Size>(smem, gmem, Size);
+#endif
+	}
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem, const unsigned src_size) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.cg.shared.global [%0], [%1], %2, %3;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size), "r"(src_size));
+#else
+		cp_async_fallback<Size>(smem, gmem, src_size);
+#endif
+	}
+	WMMAE_HOST_DEVICE void operator()(void* const smem, const void* const gmem, const unsigned src_size, const uint64_t l2_policy) const {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+		const unsigned smem_int_ptr = get_smem_ptr_uint(smem);
+		asm volatile("{cp.async.cg.shared.global.L2::cache_hint [%0], [%1], %2, %3, %4;}" :: "r"(smem_int_ptr), "l"(gmem), "n"(Size), "r"(src_size), "l"(l2_policy));
+#else
+		(void)l2_policy;
+		cp_async_fallback<Size>(smem, gmem, src_size);
+#endif
+	}
+};
+
+template <class EvictionPriority>
+struct create_l2_policy_core;
+
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+#define WMMAE_CREATE_L2_POLICY_CORE(priority) \
+	asm volatile("{createpolicy.fractional.L2::" priority ".b64 %0, %1;}" : "=l"(policy) : "f"(fraction));
+#else
+#define WMMAE_CREATE_L2_POLICY_CORE(priority) \
+	(void)fraction;
+#endif
+
+template <>
+struct create_l2_policy_core<mtk::wmma::utils::cp_async::evict_normal> {
+	WMMAE_HOST_DEVICE uint64_t operator()(const float fraction) const {
+		uint64_t policy = 0;
+		WMMAE_CREATE_L2_POLICY_CORE("evict_normal");
+		return policy;
+	}
+};
+template <>
+struct create_l2_policy_core<mtk::wmma::utils::cp_async::evict_first> {
+	WMMAE_HOST_DEVICE uint64_t operator()(const float fraction) const {
+		uint64_t policy = 0;
+		WMMAE_CREATE_L2_POLICY_CORE("evict_first");
+		return policy;
+	}
+};
+template <>
+struct create_l2_policy_core<mtk::wmma::utils::cp_async::evict_last> {
+	WMMAE_HOST_DEVICE uint64_t operator()(const float fraction) const {
+		uint64_t policy = 0;
+		WMMAE_CREATE_L2_POLICY_CORE("evict_last");
+		return policy;
+	}
+};
+#undef WMMAE_CREATE_L2_POLICY_CORE
+} // namespace detail
+
+namespace cp_async {
+template <unsigned Size, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+WMMAE_HOST_DEVICE inline void cp_async(void* const smem, const void* const gmem) {
+	mtk::wmma::utils::detail::cp_async_core<CacheOp, Size>{}(smem, gmem);
+}
+
+// Copy the first `src_size` (<= Size) bytes and fill the rest with zeros.
+// `gmem` is not read when `src_size` is 0, so this also works as a predicated copy:
+//   cp_async_zfill<16>(smem, gmem, in_bounds ? 16 : 0);
+template <unsigned Size, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+WMMAE_HOST_DEVICE inline void cp_async_zfill(void* const smem, const void* const gmem, const unsigned src_size) {
+	mtk::wmma::utils::detail::cp_async_core<CacheOp, Size>{}(smem, gmem, src_size);
+}
+
+// `l2_policy` is created by `create_l2_policy` (ignored before sm_80)
+template <unsigned Size, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+WMMAE_HOST_DEVICE inline void cp_async_zfill(void* const smem, const void* const gmem, const unsigned src_size, const uint64_t l2_policy) {
+	mtk::wmma::utils::detail::cp_async_core<CacheOp, Size>{}(smem, gmem, src_size, l2_policy);
+}
+
+template <unsigned Size, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+WMMAE_HOST_DEVICE inline void cp_async(void* const smem, const void* const gmem, const uint64_t l2_policy) {
+	mtk::wmma::utils::detail::cp_async_core<CacheOp, Size>{}(smem, gmem, Size, l2_policy);
+}
+
+// L2 cache policy in which `fraction` of the accessed lines have `EvictionPriority`
+// e.g. evict_first for streamed operands, evict_last for reused ones
+template <class EvictionPriority>
+WMMAE_HOST_DEVICE inline uint64_t create_l2_policy(const float fraction = 1.f) {
+	return mtk::wmma::utils::detail::create_l2_policy_core<EvictionPriority>{}(fraction);
+}
+
+WMMAE_HOST_DEVICE inline void commit() {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+	asm volatile("{cp.async.commit_group;}\n");
+#endif
+}
+
+WMMAE_HOST_DEVICE inline void wait_all() {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+	asm volatile("{cp.async.wait_all;}");
+#endif
+}
+
+template <int N>
+WMMAE_HOST_DEVICE inline void wait_group() {
+#if defined(__CUDA_ARCH__) && __CUDA_ARCH__ >= 800
+	asm volatile("{cp.async.wait_group %0;}":: "n"(N));
+#endif
+}
+} // namespace cp_async
+
+namespace detail {
+template <int N>
+struct wait_group_dynamic {
+	WMMAE_HOST_DEVICE void operator()(const int n) const {
+		if (n >= N) {
+			mtk::wmma::utils::cp_async::wait_group<N>();
+		} else {
+			wait_group_dynamic<N - 1>{}(n);
+		}
+	}
+};
+template <>
+struct wait_group_dynamic<0> {
+	WMMAE_HOST_DEVICE void operator()(const int) const {
+		mtk::wmma::utils::cp_async::wait_group<0>();
+	}
+};
+} // namespace detail
+
+namespace cp_async {
+// Wait until at most `n` groups are pending, where `n` is not a compile time constant.
+// `n` larger than `MaxN` is treated as `MaxN`.
+template <int MaxN>
+WMMAE_HOST_DEVICE inline void wait_group(const int n) {
+	mtk::wmma::utils::detail::wait_group_dynamic<MaxN>{}(n);
+}
+} // namespace cp_async
+} // namespace utils
+} // namespace wmma
+} // namespace mtk
+
+#endif
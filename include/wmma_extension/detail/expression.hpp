@@ -0,0 +1,199 @@
+#ifndef __WMMAE_DETAIL_EXPRESSION__
+#define __WMMAE_DETAIL_EXPRESSION__
+#include <type_traits>
+#include <cuda_fp16.h>
+
+namespace mtk {
+namespace wmma {
+namespace expr {
+namespace detail {
+// Element-wise arithmetic on the value types of expressions.
+// An expression is evaluated element by element with `V = value_t` or by two elements with `V = half2` for `half`.
+template <class V>
+struct value_ops;
+
+template <>
+struct value_ops<float> {
+	using scalar_t = float;
+	__device__ static float from_scalar(const scalar_t s) {return s;}
+	__device__ static float add(const float a, const float b) {return a + b;}
+	__device__ static float sub(const float a, const float b) {return a - b;}
+	__device__ static float mul(const float a, const float b) {return a * b;}
+	__device__ static float div(const float a, const float b) {return a / b;}
+	__device__ static float neg(const float a) {return -a;}
+	__device__ static float fma(const float a, const float b, const float c) {return __fmaf_rn(a, b, c);}
+};
+
+template <>
+struct value_ops<half> {
+	using scalar_t = half;
+	__device__ static half from_scalar(const scalar_t s) {return s;}
+	__device__ static half add(const half a, const half b) {return __hadd(a, b);}
+	__device__ static half sub(const half a, const half b) {return __hsub(a, b);}
+	__device__ static half mul(const half a, const half b) {return __hmul(a, b);}
+	__device__ static half div(const half a, const half b) {return __hdiv(a, b);}
+	__device__ static half neg(const half a) {return __hneg(a);}
+	__device__ static half fma(const half a, const half b, const half c) {return __hfma(a, b, c);}
+};
+
+template <>
+struct value_ops<half2> {
+	using scalar_t = half;
+	__device__ static half2 from_scalar(const scalar_t s) {return __half2half2(s);}
+	__device__ static half2 add(const half2 a, const half2 b) {return __hadd2(a, b);}
+	__device__ static half2 sub(const half2 a, const half2 b) {return __hsub2(a, b);}
+	__device__ static half2 mul(const half2 a, const half2 b) {return __hmul2(a, b);}
+	__device__ static half2 div(const half2 a, const half2 b) {return __h2div(a, b);}
+	__device__ static half2 neg(const half2 a) {return __hneg2(a);}
+	__device__ static half2 fma(const half2 a, const half2 b, const half2 c) {return __hfma2(a, b, c);}
+};
+
+// Load / store of the register arrays of `nvcuda::wmma::fragment` and `mtk::wmma::mma::fragment`
+template <class V, class T>
+struct array_access {
+	__device__ static V load(const T* const ptr, const unsigned i) {return ptr[i];}
+	__device__ static void store(T* const ptr, const unsigned i, const V v) {ptr[i] = v;}
+};
+
+template <>
+struct array_access<half2, half> {
+	__device__ static half2 load(const half* const ptr, const unsigned i) {return reinterpret_cast<const half2*>(ptr)[i];}
+	__device__ static void store(half* const ptr, const unsigned i, const half2 v) {reinterpret_cast<half2*>(ptr)[i] = v;}
+};
+
+template <class T>
+struct array_destination {
+	template <class V>
+	__device__ static void store(T* const ptr, const unsigned i, const V v) {array_access<V, T>::store(ptr, i, v);}
+};
+
+// Evaluation loop.
+// `Access::store<V>` writes the i-th element (`V = value_t`) or the i-th pair of elements (`V = half2`) to the destination.
+template <class value_t, unsigned N>
+struct evaluator {
+	template <class Access, class Dst, class E>
+	__device__ static void run(Dst& dst, const E& e) {
+		for (unsigned i = 0; i < N; i++) {
+			Access::template store<value_t>(dst, i, e.template get<value_t>(i));
+		}
+	}
+};
+
+template <unsigned N>
+struct evaluator<half, N> {
+	template <class Access, class Dst, class E>
+	__device__ static void run(Dst& dst, const E& e) {
+		for (unsigned i = 0; i < N / 2; i++) {
+			Access::template store<half2>(dst, i, e.template get<half2>(i));
+		}
+		if (N % 2) {
+			Access::template store<half>(dst, N - 1, e.template get<half>(N - 1));
+		}
+	}
+};
+
+struct op_add {template <class V> __device__ static V apply(const V a, const V b) {return value_ops<V>::add(a, b);}};
+struct op_sub {template <class V> __device__ static V apply(const V a, const V b) {return value_ops<V>::sub(a, b);}};
+struct op_mul {template <class V> __device__ static V apply(const V a, const V b) {return value_ops<V>::mul(a, b);}};
+struct op_div {template <class V> __device__ static V apply(const V a, const V b) {return value_ops<V>::div(a, b);}};
+} // namespace detail
+
+// ------------------------------
+// Expression nodes
+// ------------------------------
+// Every node has
+//   - value_t      : the type in which the expression is computed
+//   - num_elements : the number of elements per thread
+//   - get<V>(i)    : the i-th element (V = value_t) or the i-th pair of elements (V = half2)
+// The nodes hold their operands by value and the terminals hold pointers to the fragments,
+// so an expression must be evaluated while the fragments are alive.
+struct expression_base {};
+
+template <class E>
+struct is_expression : std::is_base_of<expression_base, E> {};
+
+template <class T, unsigned N>
+struct array_terminal : expression_base {
+	using value_t = T;
+	using scalar_t = typename detail::value_ops<value_t>::scalar_t;
+	static const unsigned num_elements = N;
+
+	const T* const ptr;
+
+	__device__ array_terminal(const T* const ptr) : ptr(ptr) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return detail::array_access<V, T>::load(ptr, i);}
+};
+
+template <class Op, class L, class R>
+struct binary_expression : expression_base {
+	static_assert(std::is_same<typename L::value_t, typename R::value_t>::value, "The value types of the operands have to be the same");
+	static_assert(L::num_elements == R::num_elements, "The number of elements of the operands have to be the same");
+	using value_t = typename L::value_t;
+	using scalar_t = typename L::scalar_t;
+	static const unsigned num_elements = L::num_elements;
+
+	const L l;
+	const R r;
+
+	__device__ binary_expression(const L& l, const R& r) : l(l), r(r) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return Op::template apply<V>(l.template get<V>(i), r.template get<V>(i));}
+};
+
+template <class Op, class E>
+struct scalar_expression : expression_base {
+	using value_t = typename E::value_t;
+	using scalar_t = typename E::scalar_t;
+	static const unsigned num_elements = E::num_elements;
+
+	const E e;
+	const scalar_t s;
+
+	__device__ scalar_expression(const E& e, const scalar_t s) : e(e), s(s) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return Op::template apply<V>(e.template get<V>(i), detail::value_ops<V>::from_scalar(s));}
+};
+
+// l * s + r (contracted)
+template <class L, class R>
+struct fma_expression : expression_base {
+	static_assert(std::is_same<typename L::value_t, typename R::value_t>::value, "The value types of the operands have to be the same");
+	static_assert(L::num_elements == R::num_elements, "The number of elements of the operands have to be the same");
+	using value_t = typename L::value_t;
+	using scalar_t = typename L::scalar_t;
+	static const unsigned num_elements = L::num_elements;
+
+	const L l;
+	const scalar_t s;
+	const R r;
+
+	__device__ fma_expression(const L& l, const scalar_t s, const R& r) : l(l), s(s), r(r) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return detail::value_ops<V>::fma(l.template get<V>(i), detail::value_ops<V>::from_scalar(s), r.template get<V>(i));}
+};
+
+template <class E>
+struct negate_expression : expression_base {
+	using value_t = typename E::value_t;
+	using scalar_t = typename E::scalar_t;
+	static const unsigned num_elements = E::num_elements;
+
+	const E e;
+
+	__device__ negate_expression(const E& e) : e(e) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return detail::value_ops<V>::neg(e.template get<V>(i));}
+};
+
+template <class E>
+using scaled_expression = scalar_expression<detail::op_mul, E>;
+} // namespace expr
+} // namespace wmma
+} // namespace mtk
+#endif
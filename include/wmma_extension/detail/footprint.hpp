@@ -0,0 +1,94 @@
+#ifndef __WMMAE_DETAIL_FOOTPRINT_HPP__
+#define __WMMAE_DETAIL_FOOTPRINT_HPP__
+#include <mma.h>
+#include "common.hpp"
+#include "occupancy.hpp"
+
+// Compile time register / shared memory footprint of fragments
+//
+// e.g.
+//   using fp = mtk::wmma::utils::footprint<decltype(frag_a)>;
+//   static_assert(mtk::wmma::utils::total_registers<frag_a_t, frag_b_t, frag_c_t>() + 32
+//       <= mtk::wmma::utils::get_register_budget(mtk::wmma::utils::get_sm_resource(80), 256, 2), "register spill");
+//   __shared__ half smem[fp::smem_bytes() / sizeof(half)];
+namespace mtk {
+namespace wmma {
+namespace utils {
+namespace detail {
+namespace footprint {
+// Shape of the matrix held by a fragment
+template <class Use, int M, int N, int K>
+struct shape {
+	static const unsigned rows = mtk::wmma::detail::common::get_M<Use, M, N, K>::value;
+	static const unsigned cols = mtk::wmma::detail::common::get_N<Use, M, N, K>::value;
+};
+// The metadata of `mma.sp` is an M x K/16 matrix of uint16_t
+template <int M, int N, int K>
+struct shape<mtk::wmma::mma::metadata, M, N, K> {
+	static const unsigned rows = M;
+	static const unsigned cols = K / 16;
+};
+
+template <class Layout>
+struct is_col_major {static const bool value = false;};
+template <>
+struct is_col_major<nvcuda::wmma::col_major> {static const bool value = true;};
+// The memory layout of accumulators is given at run time. Col major is assumed by default.
+template <>
+struct is_col_major<void> {static const bool value = true;};
+
+// Bytes of a rows x cols matrix in the memory with the leading dimension ldm (0 : packed)
+constexpr unsigned get_matrix_bytes(const unsigned rows, const unsigned cols, const unsigned ldm, const bool col_major, const unsigned element_size) {
+	return (ldm > (col_major ? rows : cols) ? ldm : (col_major ? rows : cols)) * (col_major ? cols : rows) * element_size;
+}
+} // namespace footprint
+} // namespace detail
+
+// Number of 32-bit registers per lane of a register-resident object
+template <class Frag>
+struct footprint {
+	static const unsigned registers = (sizeof(Frag) + 3) / 4;
+};
+
+template <class Use, int M, int N, int K, class T, class Layout>
+struct footprint<nvcuda::wmma::fragment<Use, M, N, K, T, Layout>> {
+	using fragment_t = nvcuda::wmma::fragment<Use, M, N, K, T, Layout>;
+	static const unsigned rows = mtk::wmma::utils::detail::footprint::shape<Use, M, N, K>::rows;
+	static const unsigned cols = mtk::wmma::utils::detail::footprint::shape<Use, M, N, K>::cols;
+	static const unsigned num_elements = fragment_t::num_elements;
+	static const unsigned registers = (sizeof(fragment_t) + 3) / 4;
+
+	// Shared memory to stage the matrix of the fragment in MemT
+	template <class MemT = typename mtk::wmma::detail::common::storage_t<T>::type, class MemLayout = Layout>
+	static constexpr unsigned smem_bytes(const unsigned ldm = 0) {
+		return mtk::wmma::utils::detail::footprint::get_matrix_bytes(rows, cols, ldm, mtk::wmma::utils::detail::footprint::is_col_major<MemLayout>::value, sizeof(MemT));
+	}
+};
+
+template <class Use, int M, int N, int K, class T, class Layout>
+struct footprint<mtk::wmma::mma::fragment<Use, M, N, K, T, Layout>> {
+	using fragment_t = mtk::wmma::mma::fragment<Use, M, N, K, T, Layout>;
+	static const unsigned rows = mtk::wmma::utils::detail::footprint::shape<Use, M, N, K>::rows;
+	static const unsigned cols = mtk::wmma::utils::detail::footprint::shape<Use, M, N, K>::cols;
+	static const unsigned num_elements = fragment_t::num_elements;
+	static const unsigned registers = (sizeof(fragment_t) + 3) / 4;
+
+	template <class MemT = typename mtk::wmma::detail::common::storage_t<T>::type, class MemLayout = Layout>
+	static constexpr unsigned smem_bytes(const unsigned ldm = 0) {
+		return mtk::wmma::utils::detail::footprint::get_matrix_bytes(rows, cols, ldm, mtk::wmma::utils::detail::footprint::is_col_major<MemLayout>::value, sizeof(MemT));
+	}
+};
+
+// Sum of the registers of the fragments
+template <class Frag>
+constexpr unsigned total_registers() {
+	return mtk::wmma::utils::footprint<Frag>::registers;
+}
+template <class Frag0, class Frag1, class... Frags>
+constexpr unsigned total_registers() {
+	return mtk::wmma::utils::footprint<Frag0>::registers + total_registers<Frag1, Frags...>();
+}
+} // namespace utils
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,12 @@
+#ifndef __WMMAE_DETAIL_HOST_DEVICE_HPP__
+#define __WMMAE_DETAIL_HOST_DEVICE_HPP__
+
+// Headers which are also compiled by a host compiler (e.g. for unit tests without a GPU)
+// use this macro instead of `__host__ __device__`.
+#ifdef __CUDACC__
+#define WMMAE_HOST_DEVICE __host__ __device__
+#else
+#define WMMAE_HOST_DEVICE
+#endif
+
+#endif
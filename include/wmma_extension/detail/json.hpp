@@ -0,0 +1,263 @@
+#ifndef __WMMAE_DETAIL_JSON_HPP__
+#define __WMMAE_DETAIL_JSON_HPP__
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal JSON reader / writer for the host side tools (tuning cache etc.)
+// This header does not depend on CUDA.
+namespace mtk {
+namespace wmma {
+namespace detail {
+namespace json {
+
+struct value {
+	enum type_t {
+		null_t,
+		bool_t,
+		number_t,
+		string_t,
+		array_t,
+		object_t,
+	};
+
+	type_t type = null_t;
+	bool boolean = false;
+	double number = 0.;
+	std::string string;
+	std::vector<value> array;
+	// The order of the members is kept
+	std::vector<std::pair<std::string, value>> object;
+
+	// Returns nullptr if this is not an object or the member does not exist
+	const value* find(const std::string& key) const {
+		if (type != object_t) {
+			return nullptr;
+		}
+		for (const auto& m : object) {
+			if (m.first == key) {
+				return &m.second;
+			}
+		}
+		return nullptr;
+	}
+
+	// Throws std::runtime_error if the member does not exist or its type is different
+	const value& at(const std::string& key, const type_t t) const {
+		const auto v = find(key);
+		if (v == nullptr) {
+			throw std::runtime_error("json : no member \"" + key + "\"");
+		}
+		if (v->type != t) {
+			throw std::runtime_error("json : unexpected type of member \"" + key + "\"");
+		}
+		return *v;
+	}
+};
+
+namespace detail {
+class parser {
+	const std::string& str;
+	std::size_t pos;
+
+	[[noreturn]] void error(const std::string& message) const {
+		throw std::runtime_error("json : " + message + " at " + std::to_string(pos));
+	}
+
+	void skip_spaces() {
+		while (pos < str.size() && (str[pos] == ' ' || str[pos] == '\t' || str[pos] == '\n' || str[pos] == '\r')) {
+			pos++;
+		}
+	}
+
+	void expect(const char c) {
+		skip_spaces();
+		if (pos >= str.size() || str[pos] != c) {
+			error(std::string("'") + c + "' is expected");
+		}
+		pos++;
+	}
+
+	bool consume(const std::string& word) {
+		if (str.compare(pos, word.size(), word) == 0) {
+			pos += word.size();
+			return true;
+		}
+		return false;
+	}
+
+	std::string parse_string() {
+		expect('"');
+		std::string res;
+		while (true) {
+			if (pos >= str.size()) {
+				error("unterminated string");
+			}
+			const auto c = str[pos++];
+			if (c == '"') {
+				break;
+			}
+			if (c != '\\') {
+				res.push_back(c);
+				continue;
+			}
+			if (pos >= str.size()) {
+				error("unterminated string");
+			}
+			const auto e = str[pos++];
+			switch (e) {
+			case '"' : res.push_back('"' ); break;
+			case '\\': res.push_back('\\'); break;
+			case '/' : res.push_back('/' ); break;
+			case 'b' : res.push_back('\b'); break;
+			case 'f' : res.push_back('\f'); break;
+			case 'n' : res.push_back('\n'); break;
+			case 'r' : res.push_back('\r'); break;
+			case 't' : res.push_back('\t'); break;
+			case 'u' : {
+				if (pos + 4 > str.size()) {
+					error("invalid \\u escape");
+				}
+				const auto code = std::strtoul(str.substr(pos, 4).c_str(), nullptr, 16);
+				pos += 4;
+				// Only the ASCII range is supported
+				res.push_back(code < 0x80 ? static_cast<char>(code) : '?');
+				break;
+			}
+			default:
+				error("invalid escape");
+			}
+		}
+		return res;
+	}
+
+	value parse_value() {
+		skip_spaces();
+		if (pos >= str.size()) {
+			error("unexpected end");
+		}
+		value v;
+		const auto c = str[pos];
+		if (c == '{') {
+			pos++;
+			v.type = value::object_t;
+			skip_spaces();
+			if (pos < str.size() && str[pos] == '}') {
+				pos++;
+				return v;
+			}
+			while (true) {
+				auto key = parse_string();
+				expect(':');
+				auto member = parse_value();
+				v.object.emplace_back(std::move(key), std::move(member));
+				skip_spaces();
+				if (pos < str.size() && str[pos] == ',') {
+					pos++;
+					continue;
+				}
+				expect('}');
+				break;
+			}
+		} else if (c == '[') {
+			pos++;
+			v.type = value::array_t;
+			skip_spaces();
+			if (pos < str.size() && str[pos] == ']') {
+				pos++;
+				return v;
+			}
+			while (true) {
+				v.array.push_back(parse_value());
+				skip_spaces();
+				if (pos < str.size() && str[pos] == ',') {
+					pos++;
+					continue;
+				}
+				expect(']');
+				break;
+			}
+		} else if (c == '"') {
+			v.type = value::string_t;
+			v.string = parse_string();
+		} else if (consume("true")) {
+			v.type = value::bool_t;
+			v.boolean = true;
+		} else if (consume("false")) {
+			v.type = value::bool_t;
+			v.boolean = false;
+		} else if (consume("null")) {
+			v.type = value::null_t;
+		} else {
+			const char* const begin = str.c_str() + pos;
+			char* end;
+			v.type = value::number_t;
+			v.number = std::strtod(begin, &end);
+			if (end == begin) {
+				error("invalid value");
+			}
+			pos += end - begin;
+		}
+		return v;
+	}
+
+public:
+	parser(const std::string& str) : str(str), pos(0) {}
+
+	value parse() {
+		auto v = parse_value();
+		skip_spaces();
+		if (pos != str.size()) {
+			error("unexpected trailing characters");
+		}
+		return v;
+	}
+};
+} // namespace detail
+
+inline value parse(const std::string& str) {
+	return detail::parser(str).parse();
+}
+
+inline std::string escape(const std::string& str) {
+	std::string res = "\"";
+	for (const auto c : str) {
+		switch (c) {
+		case '"' : res += "\\\""; break;
+		case '\\': res += "\\\\"; break;
+		case '\n': res += "\\n" ; break;
+		case '\r': res += "\\r" ; break;
+		case '\t': res += "\\t" ; break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20) {
+				char buf[8];
+				std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+				res += buf;
+			} else {
+				res.push_back(c);
+			}
+		}
+	}
+	return res + "\"";
+}
+
+// Shortest representation which is read back to the same double
+inline std::string to_string(const double v) {
+	char buf[32];
+	for (int precision = 1; precision <= 17; precision++) {
+		std::snprintf(buf, sizeof(buf), "%.*g", precision, v);
+		if (std::strtod(buf, nullptr) == v) {
+			break;
+		}
+	}
+	return buf;
+}
+
+} // namespace json
+} // namespace detail
+} // namespace wmma
+} // namespace mtk
+#endif
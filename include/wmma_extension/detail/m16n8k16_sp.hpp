@@ -0,0 +1,66 @@
+#ifndef __WMMAE_M16N8K16_SP_HPP__
+#define __WMMAE_M16N8K16_SP_HPP__
+#include <mma.h>
+#include "common.hpp"
+#include "sparse_24.hpp"
+#include "m16n8k16.hpp"
+
+// 2:4 sparse m16n8k16 (the B and accumulator fragments are the same as the dense m16n8k16)
+namespace mtk {
+namespace wmma {
+namespace mma {
+template <> class fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 16, half, nvcuda::wmma::row_major> : public __frag_base<half, 4>{};
+template <> class fragment<mtk::wmma::mma::metadata       , 16, 8, 16, half> : public __frag_base<std::uint32_t, 1>{};
+
+// foreach
+template <class Func>
+__device__ inline void foreach(mtk::wmma::mma::fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 16, half, nvcuda::wmma::row_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<16>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::a_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::a_row(lane_id, x) * 8 + layout::a_col(lane_id, x));
+	}
+}
+
+// foreach_ij
+template <class Func>
+__device__ inline void foreach_ij(mtk::wmma::mma::fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 16, half, nvcuda::wmma::row_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<16>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::a_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::a_row(lane_id, x), layout::a_col(lane_id, x));
+	}
+}
+
+// Mma
+__device__ inline void mma_sync(
+		fragment<nvcuda::wmma::accumulator, 16, 8, 16, float>& d,
+		const fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 16, half, nvcuda::wmma::row_major>& a,
+		const fragment<nvcuda::wmma::matrix_b, 16, 8, 16, half, nvcuda::wmma::col_major>& b,
+		const fragment<nvcuda::wmma::accumulator, 16, 8, 16, float>& c,
+		const fragment<mtk::wmma::mma::metadata, 16, 8, 16, half>& e) {
+	asm(R"({
+    mma.sp.sync.aligned.m16n8k16.row.col.f32.f16.f16.f32
+      {%0, %1, %2, %3},
+      {%4, %5},
+      {%6, %7},
+      {%8, %9, %10, %11},
+      %12, 0x0;
+})"
+			: "=f"(d.x[0]), "=f"(d.x[1]), "=f"(d.x[2]), "=f"(d.x[3])
+			: "r"(*reinterpret_cast<const unsigned*>(a.x)),
+			"r"(*reinterpret_cast<const unsigned*>(a.x + 2)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x + 2)),
+			"f"(c.x[0]), "f"(c.x[1]), "f"(c.x[2]), "f"(c.x[3]),
+			"r"(e.x[0]));
+}
+} // namespace mma
+} // namespace wmma
+} // namespace mtk
+
+#endif /* end of include guard */
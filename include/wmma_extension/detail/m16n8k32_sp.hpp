@@ -0,0 +1,121 @@
+#ifndef __WMMAE_M16N8K32_SP_HPP__
+#define __WMMAE_M16N8K32_SP_HPP__
+#include <mma.h>
+#include "common.hpp"
+#include "sparse_24.hpp"
+
+// 2:4 sparse m16n8k32 (there is no dense f16 m16n8k32 mma, so the B and accumulator fragments are only used by `mma.sp`)
+namespace mtk {
+namespace wmma {
+namespace mma {
+template <> class fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 32, half, nvcuda::wmma::row_major> : public __frag_base<half, 8>{};
+template <> class fragment<mtk::wmma::mma::metadata       , 16, 8, 32, half> : public __frag_base<std::uint32_t, 1>{};
+template <> class fragment<nvcuda::wmma::matrix_b         , 16, 8, 32, half, nvcuda::wmma::col_major> : public __frag_base<half, 8>{};
+template <> class fragment<nvcuda::wmma::accumulator      , 16, 8, 32, float> : public __frag_base<float, 4>{};
+
+// foreach
+template <class Func>
+__device__ inline void foreach(mtk::wmma::mma::fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 32, half, nvcuda::wmma::row_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::a_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::a_row(lane_id, x) * 16 + layout::a_col(lane_id, x));
+	}
+}
+
+template <class Func>
+__device__ inline void foreach(mtk::wmma::mma::fragment<nvcuda::wmma::matrix_b, 16, 8, 32, half, nvcuda::wmma::col_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::b_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::b_row(lane_id, x) + layout::b_col(lane_id, x) * 32);
+	}
+}
+
+template <class Func>
+__device__ inline void foreach(mtk::wmma::mma::fragment<nvcuda::wmma::accumulator, 16, 8, 32, float>& frag, const nvcuda::wmma::layout_t layout, Func func) {
+	using sp_layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < sp_layout::c_size; x++) {
+		const auto row = sp_layout::c_row(lane_id, x);
+		const auto col = sp_layout::c_col(lane_id, x);
+		const unsigned frag_index_list[1] = {x};
+		if (layout == nvcuda::wmma::mem_col_major) {
+			func(frag_index_list, 1, row + col * 16);
+		} else {
+			func(frag_index_list, 1, row * 8 + col);
+		}
+	}
+}
+
+// foreach_ij
+template <class Func>
+__device__ inline void foreach_ij(mtk::wmma::mma::fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 32, half, nvcuda::wmma::row_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::a_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::a_row(lane_id, x), layout::a_col(lane_id, x));
+	}
+}
+
+template <class Func>
+__device__ inline void foreach_ij(mtk::wmma::mma::fragment<nvcuda::wmma::matrix_b, 16, 8, 32, half, nvcuda::wmma::col_major>& frag, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::b_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::b_row(lane_id, x), layout::b_col(lane_id, x));
+	}
+}
+
+template <class Func>
+__device__ inline void foreach_ij(mtk::wmma::mma::fragment<nvcuda::wmma::accumulator, 16, 8, 32, float>& frag, const nvcuda::wmma::layout_t, Func func) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<32>;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+
+	for (unsigned x = 0; x < layout::c_size; x++) {
+		const unsigned frag_index_list[1] = {x};
+		func(frag_index_list, 1, layout::c_row(lane_id, x), layout::c_col(lane_id, x));
+	}
+}
+
+// Mma
+__device__ inline void mma_sync(
+		fragment<nvcuda::wmma::accumulator, 16, 8, 32, float>& d,
+		const fragment<mtk::wmma::mma::sparse_matrix_a, 16, 8, 32, half, nvcuda::wmma::row_major>& a,
+		const fragment<nvcuda::wmma::matrix_b, 16, 8, 32, half, nvcuda::wmma::col_major>& b,
+		const fragment<nvcuda::wmma::accumulator, 16, 8, 32, float>& c,
+		const fragment<mtk::wmma::mma::metadata, 16, 8, 32, half>& e) {
+	asm(R"({
+    mma.sp.sync.aligned.m16n8k32.row.col.f32.f16.f16.f32
+      {%0, %1, %2, %3},
+      {%4, %5, %6, %7},
+      {%8, %9, %10, %11},
+      {%12, %13, %14, %15},
+      %16, 0x0;
+})"
+			: "=f"(d.x[0]), "=f"(d.x[1]), "=f"(d.x[2]), "=f"(d.x[3])
+			: "r"(*reinterpret_cast<const unsigned*>(a.x)),
+			"r"(*reinterpret_cast<const unsigned*>(a.x + 2)),
+			"r"(*reinterpret_cast<const unsigned*>(a.x + 4)),
+			"r"(*reinterpret_cast<const unsigned*>(a.x + 6)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x + 2)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x + 4)),
+			"r"(*reinterpret_cast<const unsigned*>(b.x + 6)),
+			"f"(c.x[0]), "f"(c.x[1]), "f"(c.x[2]), "f"(c.x[3]),
+			"r"(e.x[0]));
+}
+} // namespace mma
+} // namespace wmma
+} // namespace mtk
+
+#endif /* end of include guard */
@@ -0,0 +1,122 @@
+#ifndef __WMMAE_DETAIL_OCCUPANCY_HPP__
+#define __WMMAE_DETAIL_OCCUPANCY_HPP__
+
+// Occupancy calculator which is usable on the host and at compile time (C++14 constexpr).
+// This header does not depend on CUDA.
+namespace mtk {
+namespace wmma {
+namespace utils {
+
+// Resources of an SM (CUDA Occupancy Calculator / CUDA C Programming Guide, "Technical Specifications per Compute Capability")
+struct sm_resource {
+	unsigned arch;                     // e.g. 80 for sm_80, 0 if unknown
+	unsigned max_warps_per_sm;
+	unsigned max_blocks_per_sm;
+	unsigned registers_per_sm;         // 32-bit registers
+	unsigned max_registers_per_thread;
+	unsigned register_allocation_unit; // registers per warp
+	unsigned smem_per_sm;              // the maximum carveout [B]
+	unsigned max_smem_per_block;       // including the dynamic shared memory (opt-in) [B]
+	unsigned smem_allocation_unit;     // [B]
+	unsigned reserved_smem_per_block;  // used by the CUDA runtime [B]
+};
+
+constexpr sm_resource get_sm_resource(const unsigned arch) {
+	return
+		arch == 70 ? sm_resource{70, 64, 32, 65536, 255, 256, 98304 , 98304 , 256, 0   } :
+		arch == 75 ? sm_resource{75, 32, 16, 65536, 255, 256, 65536 , 65536 , 256, 0   } :
+		arch == 80 ? sm_resource{80, 64, 32, 65536, 255, 256, 167936, 166912, 128, 1024} :
+		arch == 86 ? sm_resource{86, 48, 16, 65536, 255, 256, 102400, 101376, 128, 1024} :
+		arch == 89 ? sm_resource{89, 48, 24, 65536, 255, 256, 102400, 101376, 128, 1024} :
+		arch == 90 ? sm_resource{90, 64, 32, 65536, 255, 256, 233472, 232448, 128, 1024} :
+		sm_resource{0, 0, 0, 0, 0, 1, 0, 0, 1, 0};
+}
+
+enum class occupancy_limiter {
+	warps,         // the maximum number of warps per SM
+	blocks,        // the maximum number of blocks per SM
+	registers,
+	shared_memory,
+	invalid,       // the block can not be launched (too many threads / registers / shared memory or unknown arch)
+};
+
+struct occupancy {
+	unsigned blocks_per_sm;
+	unsigned active_warps_per_sm;
+	unsigned max_warps_per_sm;
+	occupancy_limiter limiter;
+
+	constexpr double ratio() const {
+		return max_warps_per_sm ? static_cast<double>(active_warps_per_sm) / max_warps_per_sm : 0.;
+	}
+};
+
+namespace detail {
+namespace occupancy {
+constexpr unsigned round_up(const unsigned v, const unsigned unit) {return (v + unit - 1) / unit * unit;}
+constexpr unsigned unlimited = ~0u;
+} // namespace occupancy
+} // namespace detail
+
+// Number of resident blocks per SM of a kernel
+// registers_per_thread : `registers` of `--ptxas-options=-v` (or a footprint estimation)
+// smem_per_block       : static + dynamic shared memory [B]
+constexpr occupancy compute_occupancy(
+		const sm_resource& res,
+		const unsigned threads_per_block,
+		const unsigned registers_per_thread,
+		const unsigned smem_per_block
+		) {
+	using mtk::wmma::utils::detail::occupancy::round_up;
+	using mtk::wmma::utils::detail::occupancy::unlimited;
+	if (res.arch == 0 || threads_per_block == 0 || threads_per_block > 1024 ||
+			registers_per_thread > res.max_registers_per_thread || smem_per_block > res.max_smem_per_block) {
+		return occupancy{0, 0, res.max_warps_per_sm, occupancy_limiter::invalid};
+	}
+	const unsigned warps_per_block = (threads_per_block + 31) / 32;
+
+	const unsigned limit_warps = res.max_warps_per_sm / warps_per_block;
+	const unsigned limit_blocks = res.max_blocks_per_sm;
+	// Registers are allocated per warp
+	const unsigned registers_per_warp = round_up(registers_per_thread * 32, res.register_allocation_unit);
+	const unsigned limit_registers = registers_per_warp ? (res.registers_per_sm / registers_per_warp) / warps_per_block : unlimited;
+	const unsigned smem = round_up(smem_per_block + res.reserved_smem_per_block, res.smem_allocation_unit);
+	const unsigned limit_smem = smem ? res.smem_per_sm / smem : unlimited;
+
+	unsigned blocks = limit_warps;
+	occupancy_limiter limiter = occupancy_limiter::warps;
+	if (limit_blocks < blocks) {
+		blocks = limit_blocks;
+		limiter = occupancy_limiter::blocks;
+	}
+	if (limit_registers < blocks) {
+		blocks = limit_registers;
+		limiter = occupancy_limiter::registers;
+	}
+	if (limit_smem < blocks) {
+		blocks = limit_smem;
+		limiter = occupancy_limiter::shared_memory;
+	}
+	return occupancy{blocks, blocks * warps_per_block, res.max_warps_per_sm, limiter};
+}
+
+// The maximum number of registers per thread (a multiple of 8) with which `min_blocks_per_sm` blocks are resident.
+// This is the budget of `__launch_bounds__(threads_per_block, min_blocks_per_sm)`.
+// Returns 0 if it is impossible.
+constexpr unsigned get_register_budget(
+		const sm_resource& res,
+		const unsigned threads_per_block,
+		const unsigned min_blocks_per_sm = 1,
+		const unsigned smem_per_block = 0
+		) {
+	for (unsigned r = res.max_registers_per_thread / 8 * 8; r > 0; r -= 8) {
+		if (compute_occupancy(res, threads_per_block, r, smem_per_block).blocks_per_sm >= min_blocks_per_sm) {
+			return r;
+		}
+	}
+	return 0;
+}
+} // namespace utils
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -1,10 +1,57 @@
 #ifndef __WMMAE_DETAIL_OPERATORS__
 #define __WMMAE_DETAIL_OPERATORS__
 #include <mma.h>
+#include <cuda_fp16.h>
 
 namespace mtk {
 namespace wmma {
 namespace ops {
+namespace detail {
+// Element-wise operations on the register arrays of fragments.
+// `half` arrays are computed by `half2` instructions (the arrays have to be 4-byte aligned).
+template <class T, unsigned N>
+struct array_ops {
+	__device__ static void add(T* const res, const T* const a, const T* const b) {
+		for (unsigned i = 0; i < N; i++) res[i] = a[i] + b[i];
+	}
+	__device__ static void sub(T* const res, const T* const a, const T* const b) {
+		for (unsigned i = 0; i < N; i++) res[i] = a[i] - b[i];
+	}
+	__device__ static void mul(T* const res, const T* const a, const T b) {
+		for (unsigned i = 0; i < N; i++) res[i] = a[i] * b;
+	}
+	__device__ static void div(T* const res, const T* const a, const T b) {
+		for (unsigned i = 0; i < N; i++) res[i] = a[i] / b;
+	}
+	__device__ static void fma(T* const res, const T alpha, const T* const a, const T* const b) {
+		for (unsigned i = 0; i < N; i++) res[i] = __fmaf_rn(alpha, a[i], b[i]);
+	}
+};
+
+template <unsigned N>
+struct array_ops<half, N> {
+	__device__ static void add(half* const res, const half* const a, const half* const b) {
+		for (unsigned i = 0; i < N / 2; i++) reinterpret_cast<half2*>(res)[i] = __hadd2(reinterpret_cast<const half2*>(a)[i], reinterpret_cast<const half2*>(b)[i]);
+		if (N % 2) res[N - 1] = __hadd(a[N - 1], b[N - 1]);
+	}
+	__device__ static void sub(half* const res, const half* const a, const half* const b) {
+		for (unsigned i = 0; i < N / 2; i++) reinterpret_cast<half2*>(res)[i] = __hsub2(reinterpret_cast<const half2*>(a)[i], reinterpret_cast<const half2*>(b)[i]);
+		if (N % 2) res[N - 1] = __hsub(a[N - 1], b[N - 1]);
+	}
+	__device__ static void mul(half* const res, const half* const a, const half b) {
+		for (unsigned i = 0; i < N / 2; i++) reinterpret_cast<half2*>(res)[i] = __hmul2(reinterpret_cast<const half2*>(a)[i], __half2half2(b));
+		if (N % 2) res[N - 1] = __hmul(a[N - 1], b);
+	}
+	__device__ static void div(half* const res, const half* const a, const half b) {
+		for (unsigned i = 0; i < N / 2; i++) reinterpret_cast<half2*>(res)[i] = __h2div(reinterpret_cast<const half2*>(a)[i], __half2half2(b));
+		if (N % 2) res[N - 1] = __hdiv(a[N - 1], b);
+	}
+	__device__ static void fma(half* const res, const half alpha, const half* const a, const half* const b) {
+		for (unsigned i = 0; i < N / 2; i++) reinterpret_cast<half2*>(res)[i] = __hfma2(__half2half2(alpha), reinterpret_cast<const half2*>(a)[i], reinterpret_cast<const half2*>(b)[i]);
+		if (N % 2) res[N - 1] = __hfma(alpha, a[N - 1], b[N - 1]);
+	}
+};
+} // namespace detail
 
 // Add
 template <class Use, int M, int N, int K, class Type, class Layout>
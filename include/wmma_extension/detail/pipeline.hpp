@@ -0,0 +1,96 @@
+#ifndef __WMMAE_DETAIL_PIPELINE_HPP__
+#define __WMMAE_DETAIL_PIPELINE_HPP__
+#include <cstdint>
+#include "host_device.hpp"
+#include "cp_async.hpp"
+
+namespace mtk {
+namespace wmma {
+namespace utils {
+// Multi-stage pipeline of asynchronous copies from global memory to a ring buffer in shared memory.
+// `smem` has to be `smem_bytes` bytes and 16-byte aligned.
+//
+// e.g.
+//   for (; pipe.num_in_flight() < Stages - 1 && t < num_tiles; t++) {copy tile t; pipe.producer_commit();}
+//   for (unsigned i = 0; i < num_tiles; i++) {
+//     if (t < num_tiles) {copy tile t; pipe.producer_commit(); t++;}
+//     const auto tile = pipe.consumer_wait(); __syncthreads();
+//     compute(tile);                          __syncthreads();
+//     pipe.consumer_release();
+//   }
+//
+// The pipeline does not synchronize threads: call __syncthreads() (or __syncwarp()) after `consumer_wait`
+// when a stage is copied by other threads, and before the released stage is acquired again.
+template <unsigned Stages, unsigned TileBytes>
+class pipeline {
+	static_assert(Stages >= 1, "Stages must be larger than 0");
+	static_assert(TileBytes % 16 == 0, "TileBytes must be a multiple of 16");
+public:
+	static const unsigned num_stages = Stages;
+	static const unsigned tile_bytes = TileBytes;
+	static const unsigned smem_bytes = Stages * TileBytes;
+
+private:
+	std::uint8_t* const smem;
+	// The number of committed stages
+	unsigned head;
+	// The number of released stages
+	unsigned tail;
+
+public:
+	WMMAE_HOST_DEVICE pipeline(void* const smem_ptr) : smem(reinterpret_cast<std::uint8_t*>(smem_ptr)), head(0), tail(0) {}
+
+	WMMAE_HOST_DEVICE unsigned stage_index(const unsigned i) const {return i % Stages;}
+	WMMAE_HOST_DEVICE void* stage_ptr(const unsigned i) const {return smem + stage_index(i) * TileBytes;}
+	WMMAE_HOST_DEVICE unsigned num_in_flight() const {return head - tail;}
+	WMMAE_HOST_DEVICE bool can_acquire() const {return num_in_flight() < Stages;}
+
+	// ---------------------------
+	// Producer
+	// ---------------------------
+	WMMAE_HOST_DEVICE void* producer_acquire() const {return stage_ptr(head);}
+
+	// Copy `Size` bytes to `offset` bytes from the head of the acquired stage.
+	// The destination is filled with zeros instead when `pred` is false.
+	template <unsigned Size, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+	WMMAE_HOST_DEVICE void producer_copy(const unsigned offset, const void* const gmem, const bool pred = true) const {
+		mtk::wmma::utils::cp_async::cp_async_zfill<Size, CacheOp>(smem + stage_index(head) * TileBytes + offset, gmem, pred ? Size : 0);
+	}
+
+	// Copy [gmem, gmem + valid_bytes) to the acquired stage and fill the rest of the stage with zeros.
+	// The copy is shared by `num_threads` threads and this thread issues the `thread_id`-th chunks.
+	// `gmem` has to be `Size`-byte aligned.
+	template <unsigned Size = 16, class CacheOp = mtk::wmma::utils::cp_async::cache_all>
+	WMMAE_HOST_DEVICE void producer_copy_tile(const void* const gmem, const unsigned valid_bytes, const unsigned thread_id, const unsigned num_threads) const {
+		static_assert(TileBytes % Size == 0, "TileBytes must be a multiple of Size");
+		const auto src = reinterpret_cast<const std::uint8_t*>(gmem);
+		for (unsigned offset = thread_id * Size; offset < TileBytes; offset += num_threads * Size) {
+			const auto src_size = (offset >= valid_bytes) ? 0u : ((valid_bytes - offset < Size) ? valid_bytes - offset : Size);
+			mtk::wmma::utils::cp_async::cp_async_zfill<Size, CacheOp>(smem + stage_index(head) * TileBytes + offset, src + offset, src_size);
+		}
+	}
+
+	WMMAE_HOST_DEVICE void producer_commit() {
+		mtk::wmma::utils::cp_async::commit();
+		head++;
+	}
+
+	// ---------------------------
+	// Consumer
+	// ---------------------------
+	// Wait for the copies of this thread to the oldest committed stage
+	WMMAE_HOST_DEVICE void* consumer_wait() const {
+		mtk::wmma::utils::cp_async::wait_group<static_cast<int>(Stages) - 1>(static_cast<int>(num_in_flight()) - 1);
+		return stage_ptr(tail);
+	}
+
+	WMMAE_HOST_DEVICE void consumer_release() {
+		tail++;
+	}
+};
+
+} // namespace utils
+} // namespace wmma
+} // namespace mtk
+
+#endif
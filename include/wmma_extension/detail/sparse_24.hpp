@@ -0,0 +1,204 @@
+#ifndef __WMMAE_DETAIL_SPARSE_24_HPP__
+#define __WMMAE_DETAIL_SPARSE_24_HPP__
+#include <cstdint>
+#include "host_device.hpp"
+
+// 2:4 structured sparsity for `mma.sp` (f16 inputs, m16n8k16 and m16n8k32).
+// This header does not depend on CUDA so that the compressor and the emulator can be tested without GPUs.
+//
+// Memory format
+//  - dense A      : M x K row major. At most 2 of every 4 consecutive elements in a row are non-zero.
+//  - compressed A : M x (K/2) row major. The kept 2 elements of each group of 4.
+//  - metadata     : M x (K/16) row major `uint16_t`. Each 4 bits hold the two 2-bit indices (ascending) of a group of 4.
+//                   The first index is stored in the lower 2 bits, and the group `q` of a word is stored at bits [4q, 4q+4).
+namespace mtk {
+namespace wmma {
+namespace mma {
+// Fragment uses for `mma.sp`
+struct sparse_matrix_a; // compressed matrix A
+struct metadata;        // indices of the non-zero elements in matrix A
+
+namespace sparse {
+namespace detail {
+// Thread mapping of the f16 `mma.sp` fragments (lane = %laneid, index = element index in the fragment)
+template <int K>
+struct layout {
+	static_assert(K == 16 || K == 32, "K must be 16 or 32");
+	static const unsigned m = 16;
+	static const unsigned n = 8;
+	static const unsigned k = K;
+	// Number of elements per thread
+	static const unsigned a_size = K / 4;
+	static const unsigned b_size = K / 4;
+	static const unsigned c_size = 4;
+
+	// Compressed A (m x k/2)
+	static WMMAE_HOST_DEVICE unsigned a_row(const unsigned lane, const unsigned index) {return lane / 4 + ((index >> 1) & 0x1) * 8;}
+	static WMMAE_HOST_DEVICE unsigned a_col(const unsigned lane, const unsigned index) {return (lane % 4) * 2 + (index & 0x1) + (index >> 2) * 8;}
+	// B (k x n)
+	static WMMAE_HOST_DEVICE unsigned b_row(const unsigned lane, const unsigned index) {return (lane % 4) * 2 + (index & 0x1) + (index >> 1) * 8;}
+	static WMMAE_HOST_DEVICE unsigned b_col(const unsigned lane, const unsigned) {return lane / 4;}
+	// C, D (m x n)
+	static WMMAE_HOST_DEVICE unsigned c_row(const unsigned lane, const unsigned index) {return lane / 4 + (index >> 1) * 8;}
+	static WMMAE_HOST_DEVICE unsigned c_col(const unsigned lane, const unsigned index) {return (lane % 4) * 2 + (index & 0x1);}
+	// Metadata : a thread pair {2s, 2s+1} of each quad provides the metadata of the rows {lane/4, lane/4+8}
+	// where s is the sparsity selector.
+	static WMMAE_HOST_DEVICE unsigned meta_row(const unsigned lane) {return lane / 4 + (lane & 0x1) * 8;}
+};
+
+// Metadata register of a thread (K/16 words of the row)
+template <int K>
+WMMAE_HOST_DEVICE inline std::uint32_t get_metadata(const std::uint16_t* const ptr, const unsigned ldm, const unsigned lane) {
+	const auto row_ptr = ptr + layout<K>::meta_row(lane) * ldm;
+	std::uint32_t e = row_ptr[0];
+	if (K == 32) {
+		e |= static_cast<std::uint32_t>(row_ptr[1]) << 16;
+	}
+	return e;
+}
+
+// The `s`-th (0 or 1) index of the group `q` in a metadata row
+WMMAE_HOST_DEVICE inline unsigned get_index(const std::uint32_t e, const unsigned q, const unsigned s) {
+	return (e >> (q * 4 + s * 2)) & 0x3;
+}
+} // namespace detail
+
+// ------------------------------
+// Host functions
+// ------------------------------
+template <class T>
+inline bool is_2_4_sparse(const unsigned m, const unsigned k, const T* const dense, const unsigned ldd) {
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned q = 0; q < k / 4; q++) {
+			unsigned num_nonzeros = 0;
+			for (unsigned l = 0; l < 4; l++) {
+				if (static_cast<float>(dense[i * ldd + q * 4 + l]) != 0.f) {
+					num_nonzeros++;
+				}
+			}
+			if (num_nonzeros > 2) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Prune `dense` to 2:4 sparsity by keeping the two largest magnitudes of every group of 4 elements,
+// and encode it to the compressed matrix and the metadata. `k` must be a multiple of 16.
+// When `dense` is already 2:4 sparse, no non-zero element is dropped.
+template <class T>
+inline void compress(
+		const unsigned m, const unsigned k,
+		const T* const dense, const unsigned ldd,
+		T* const compressed, const unsigned ldc,
+		std::uint16_t* const metadata, const unsigned ldm
+		) {
+	const auto magnitude = [](const T v) {const auto f = static_cast<float>(v); return f < 0.f ? -f : f;};
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned w = 0; w < k / 16; w++) {
+			std::uint16_t e = 0;
+			for (unsigned g = 0; g < 4; g++) {
+				const unsigned q = w * 4 + g;
+				const auto group = dense + i * ldd + q * 4;
+				// Select the two largest magnitudes (the lower index wins a tie)
+				unsigned idx0 = 0, idx1 = 1;
+				if (magnitude(group[1]) > magnitude(group[0])) {
+					idx0 = 1;
+					idx1 = 0;
+				}
+				for (unsigned l = 2; l < 4; l++) {
+					const auto v = magnitude(group[l]);
+					if (v > magnitude(group[idx0])) {
+						idx1 = idx0;
+						idx0 = l;
+					} else if (v > magnitude(group[idx1])) {
+						idx1 = l;
+					}
+				}
+				if (idx0 > idx1) {
+					const auto t = idx0;
+					idx0 = idx1;
+					idx1 = t;
+				}
+				compressed[i * ldc + q * 2 + 0] = group[idx0];
+				compressed[i * ldc + q * 2 + 1] = group[idx1];
+				e |= static_cast<std::uint16_t>((idx0 | (idx1 << 2)) << (g * 4));
+			}
+			metadata[i * ldm + w] = e;
+		}
+	}
+}
+
+// Decode the compressed matrix to the M x K dense matrix
+template <class T>
+inline void decompress(
+		const unsigned m, const unsigned k,
+		T* const dense, const unsigned ldd,
+		const T* const compressed, const unsigned ldc,
+		const std::uint16_t* const metadata, const unsigned ldm
+		) {
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned l = 0; l < k; l++) {
+			dense[i * ldd + l] = static_cast<T>(0.f);
+		}
+		for (unsigned q = 0; q < k / 4; q++) {
+			const std::uint32_t e = metadata[i * ldm + q / 4];
+			for (unsigned s = 0; s < 2; s++) {
+				dense[i * ldd + q * 4 + detail::get_index(e, q % 4, s)] = compressed[i * ldc + q * 2 + s];
+			}
+		}
+	}
+}
+
+// Emulation of `mma.sp.sync.aligned.m16n8k{K}.row.col.f32.f16.f16.f32` on the register level.
+// a, b, c, d and e are the fragment elements and the metadata register of each lane.
+template <int K, class T>
+inline void emulate_mma_sync(
+		T (*const d)[4],
+		const T (*const a)[K / 4],
+		const T (*const b)[K / 4],
+		const T (*const c)[4],
+		const std::uint32_t* const e,
+		const unsigned selector = 0
+		) {
+	using layout = detail::layout<K>;
+	float mat_a[layout::m][K / 2];
+	float mat_b[K][layout::n];
+	float mat_c[layout::m][layout::n];
+	std::uint32_t meta[layout::m];
+	for (unsigned lane = 0; lane < 32; lane++) {
+		for (unsigned x = 0; x < layout::a_size; x++) {
+			mat_a[layout::a_row(lane, x)][layout::a_col(lane, x)] = static_cast<float>(a[lane][x]);
+		}
+		for (unsigned x = 0; x < layout::b_size; x++) {
+			mat_b[layout::b_row(lane, x)][layout::b_col(lane, x)] = static_cast<float>(b[lane][x]);
+		}
+		for (unsigned x = 0; x < layout::c_size; x++) {
+			mat_c[layout::c_row(lane, x)][layout::c_col(lane, x)] = static_cast<float>(c[lane][x]);
+		}
+		// Only the threads chosen by the selector provide the metadata
+		if ((lane % 4) / 2 == selector) {
+			meta[layout::meta_row(lane)] = e[lane];
+		}
+	}
+
+	for (unsigned lane = 0; lane < 32; lane++) {
+		for (unsigned x = 0; x < layout::c_size; x++) {
+			const auto i = layout::c_row(lane, x);
+			const auto j = layout::c_col(lane, x);
+			float sum = mat_c[i][j];
+			for (unsigned q = 0; q < K / 4; q++) {
+				for (unsigned s = 0; s < 2; s++) {
+					sum += mat_a[i][q * 2 + s] * mat_b[q * 4 + detail::get_index(meta[i], q, s)][j];
+				}
+			}
+			d[lane][x] = static_cast<T>(sum);
+		}
+	}
+}
+} // namespace sparse
+} // namespace mma
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,125 @@
+#ifndef __WMMAE_EXPRESSION__
+#define __WMMAE_EXPRESSION__
+#include <type_traits>
+#include <utility>
+#include "detail/expression.hpp"
+
+namespace mtk {
+namespace wmma {
+namespace expr {
+// ------------------------------
+// Terminal / evaluation
+// ------------------------------
+// `lazy` wraps a fragment (`nvcuda::wmma::fragment` or `mtk::wmma::mma::fragment`) as a terminal of an expression.
+// `eval` computes the whole expression in a single loop over the elements of the destination fragment.
+// The destination may be one of the operands since every element is read before it is written.
+//
+// mtk::wmma::expr::eval(frag_d, mtk::wmma::expr::lazy(frag_a) + mtk::wmma::expr::lazy(frag_b) * s - mtk::wmma::expr::lazy(frag_c));
+template <class Frag>
+__device__ array_terminal<typename std::remove_const<typename std::remove_reference<decltype(std::declval<const Frag&>().x[0])>::type>::type, Frag::num_elements>
+lazy(const Frag& frag) {
+	return {frag.x};
+}
+
+template <class Frag, class E>
+__device__ typename std::enable_if<is_expression<E>::value>::type
+eval(Frag& frag, const E& e) {
+	using storage_t = typename std::remove_reference<decltype(frag.x[0])>::type;
+	static_assert(std::is_same<storage_t, typename E::value_t>::value, "The value type of the expression has to be the storage type of the fragment");
+	static_assert(Frag::num_elements == E::num_elements, "The number of elements of the expression has to be the same as the fragment");
+	detail::evaluator<typename E::value_t, E::num_elements>::template run<detail::array_destination<storage_t>>(frag.x, e);
+}
+
+// ------------------------------
+// Operators
+// ------------------------------
+// `a * s + b`, `b + a * s`, `a * s - b` and `b - a * s` are contracted to a single fma.
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value && is_expression<R>::value, binary_expression<detail::op_add, L, R>>::type
+operator+(const L& l, const R& r) {
+	return {l, r};
+}
+
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value && is_expression<R>::value, binary_expression<detail::op_sub, L, R>>::type
+operator-(const L& l, const R& r) {
+	return {l, r};
+}
+
+template <class E>
+__device__ typename std::enable_if<is_expression<E>::value, negate_expression<E>>::type
+operator-(const E& e) {
+	return {e};
+}
+
+template <class E>
+__device__ typename std::enable_if<is_expression<E>::value, scaled_expression<E>>::type
+operator*(const E& e, const typename E::scalar_t s) {
+	return {e, s};
+}
+
+template <class E>
+__device__ typename std::enable_if<is_expression<E>::value, scaled_expression<E>>::type
+operator*(const typename E::scalar_t s, const E& e) {
+	return {e, s};
+}
+
+template <class E>
+__device__ typename std::enable_if<is_expression<E>::value, scalar_expression<detail::op_div, E>>::type
+operator/(const E& e, const typename E::scalar_t s) {
+	return {e, s};
+}
+
+// FMA contraction
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<R>::value, fma_expression<L, R>>::type
+operator+(const scaled_expression<L>& l, const R& r) {
+	return {l.e, l.s, r};
+}
+
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value, fma_expression<R, L>>::type
+operator+(const L& l, const scaled_expression<R>& r) {
+	return {r.e, r.s, l};
+}
+
+template <class L, class R>
+__device__ fma_expression<L, scaled_expression<R>>
+operator+(const scaled_expression<L>& l, const scaled_expression<R>& r) {
+	return {l.e, l.s, r};
+}
+
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<R>::value, fma_expression<L, negate_expression<R>>>::type
+operator-(const scaled_expression<L>& l, const R& r) {
+	return {l.e, l.s, negate_expression<R>{r}};
+}
+
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value, fma_expression<R, L>>::type
+operator-(const L& l, const scaled_expression<R>& r) {
+	return {r.e, detail::value_ops<typename R::scalar_t>::neg(r.s), l};
+}
+
+template <class L, class R>
+__device__ fma_expression<L, scaled_expression<R>>
+operator-(const scaled_expression<L>& l, const scaled_expression<R>& r) {
+	return {l.e, l.s, scaled_expression<R>{r.e, detail::value_ops<typename R::scalar_t>::neg(r.s)}};
+}
+
+// alpha * a + b
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value && is_expression<R>::value, fma_expression<L, R>>::type
+fma(const typename L::scalar_t alpha, const L& a, const R& b) {
+	return {a, alpha, b};
+}
+
+template <class L, class R>
+__device__ typename std::enable_if<is_expression<L>::value && is_expression<R>::value, fma_expression<L, R>>::type
+fma(const L& a, const typename L::scalar_t alpha, const R& b) {
+	return {a, alpha, b};
+}
+} // namespace expr
+} // namespace wmma
+} // namespace mtk
+#endif
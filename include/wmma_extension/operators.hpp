@@ -48,6 +48,76 @@ __device__ nvcuda::wmma::fragment<Use, M, N, K, Type, Layout> fma(
 		const nvcuda::wmma::fragment<Use, M, N, K, Type, Layout>& b) {
 	return mtk::wmma::ops::fma<Use, M, N, K, Type, Layout>{}(alpha, a, b);
 }
+
+// ------------------------------
+// Operators for mtk::wmma::mma::fragment
+// ------------------------------
+namespace mma {
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> operator+(
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& b) {
+	using frag_t = mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>;
+	using storage_t = typename mtk::wmma::detail::common::storage_t<Type>::type;
+	frag_t res;
+	mtk::wmma::ops::detail::array_ops<storage_t, frag_t::num_elements>::add(res.x, a.x, b.x);
+	return res;
+}
+
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> operator-(
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& b) {
+	using frag_t = mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>;
+	using storage_t = typename mtk::wmma::detail::common::storage_t<Type>::type;
+	frag_t res;
+	mtk::wmma::ops::detail::array_ops<storage_t, frag_t::num_elements>::sub(res.x, a.x, b.x);
+	return res;
+}
+
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> operator*(
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const typename mtk::wmma::detail::common::storage_t<Type>::type b) {
+	using frag_t = mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>;
+	using storage_t = typename mtk::wmma::detail::common::storage_t<Type>::type;
+	frag_t res;
+	mtk::wmma::ops::detail::array_ops<storage_t, frag_t::num_elements>::mul(res.x, a.x, b);
+	return res;
+}
+
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> operator/(
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const typename mtk::wmma::detail::common::storage_t<Type>::type b) {
+	using frag_t = mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>;
+	using storage_t = typename mtk::wmma::detail::common::storage_t<Type>::type;
+	frag_t res;
+	mtk::wmma::ops::detail::array_ops<storage_t, frag_t::num_elements>::div(res.x, a.x, b);
+	return res;
+}
+
+// alpha * a + b
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> fma(
+		const typename mtk::wmma::detail::common::storage_t<Type>::type alpha,
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& b) {
+	using frag_t = mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>;
+	using storage_t = typename mtk::wmma::detail::common::storage_t<Type>::type;
+	frag_t res;
+	mtk::wmma::ops::detail::array_ops<storage_t, frag_t::num_elements>::fma(res.x, alpha, a.x, b.x);
+	return res;
+}
+
+template <class Use, int M, int N, int K, class Type, class Layout>
+__device__ mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout> fma(
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& a,
+		const typename mtk::wmma::detail::common::storage_t<Type>::type alpha,
+		const mtk::wmma::mma::fragment<Use, M, N, K, Type, Layout>& b) {
+	return mtk::wmma::mma::fma(alpha, a, b);
+}
+} // namespace mma
 } // namespace wmma
 } // namespace mtk
 #endif
@@ -0,0 +1,232 @@
+#ifndef __WMMAE_TCEC_BSR_HPP__
+#define __WMMAE_TCEC_BSR_HPP__
+#include "tcec.hpp"
+#include "bsr_host.hpp"
+
+// Block sparse (BSR) matrix multiplications
+// Only the non-zero blocks are loaded by `load_matrix_sync` and multiplied by `mma_sync`,
+// so the computation is proportional to the number of the non-zero blocks.
+//   SpMM  : C = alpha * A * B + beta * C              (A : BSR, B / C : dense)
+//   SDDMM : C = alpha * (A * B) o spy(C) + beta * C   (A / B : dense, C : BSR)
+// See bsr_host.hpp for the format (`mtk::wmma::tcec::bsr::matrix`), the builder and the host references.
+// The kernels are written over tcec::fragment only. The no-correction path on mtk::wmma::mma::fragment is
+// Policy<op_mma, without_ec, ...>, whose sub fragments are mma::fragment, so no separate mma::fragment kernel is provided.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace bsr {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+} // namespace detail
+
+// C[block_row * BLOCK_M:(block_row + 1) * BLOCK_M, tile_n:tile_n+WARP_N] = alpha * A * B + beta * C
+// A : BSR of (BLOCK_M x BLOCK_K) blocks, B : col major, C : col major
+template <unsigned BLOCK_M, unsigned BLOCK_K, unsigned WARP_N, class T, class Policy>
+__device__ inline void spmm_tile(
+		const unsigned block_row, const unsigned tile_n,
+		const float alpha,
+		const unsigned* const row_ptr,
+		const unsigned* const col_idx,
+		const float* const values,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , BLOCK_M, WARP_N, BLOCK_K, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , BLOCK_M, WARP_N, BLOCK_K, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, BLOCK_M, WARP_N, BLOCK_K, T, void                   , Policy> frag_c;
+
+	float* const c_tile_ptr = c_ptr + block_row * BLOCK_M + tile_n * static_cast<std::size_t>(ldc);
+	if (beta == 0.f) {
+		mtk::wmma::tcec::fill_zero(frag_c);
+	} else {
+		mtk::wmma::tcec::load_matrix_sync(frag_c, c_tile_ptr, ldc, nvcuda::wmma::mem_col_major, false);
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= beta;
+		}
+	}
+
+	const auto block_end = row_ptr[block_row + 1];
+	for (auto p = row_ptr[block_row]; p < block_end; p++) {
+		mtk::wmma::tcec::load_matrix_sync_with_mul<nvcuda::wmma::col_major>(frag_a, values + p * static_cast<std::size_t>(BLOCK_M * BLOCK_K), BLOCK_M, alpha, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, b_ptr + col_idx[p] * BLOCK_K + tile_n * static_cast<std::size_t>(ldb), ldb, false);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	mtk::wmma::tcec::store_matrix_sync(c_tile_ptr, frag_c, ldc, nvcuda::wmma::mem_col_major, false);
+}
+
+// m and n must be multiples of BLOCK_M and WARP_N respectively.
+// A warp computes a (BLOCK_M x WARP_N) tile of C.
+template <unsigned BLOCK_M, unsigned BLOCK_K, unsigned WARP_N, class T, class Policy>
+__global__ void spmm_kernel(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const unsigned* const row_ptr,
+		const unsigned* const col_idx,
+		const float* const values,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	const unsigned num_block_rows = m / BLOCK_M;
+	const unsigned long num_tiles = static_cast<unsigned long>(num_block_rows) * (n / WARP_N);
+	for (unsigned long tile_id = threadIdx.x / 32 + static_cast<unsigned long>(blockIdx.x) * (blockDim.x / 32); tile_id < num_tiles; tile_id += static_cast<unsigned long>(gridDim.x) * (blockDim.x / 32)) {
+		// The warps of a block share the same columns of B
+		const unsigned block_row = tile_id % num_block_rows;
+		const unsigned tile_n = (tile_id / num_block_rows) * WARP_N;
+		spmm_tile<BLOCK_M, BLOCK_K, WARP_N, T, Policy>(block_row, tile_n, alpha, row_ptr, col_idx, values, b_ptr, ldb, beta, c_ptr, ldc);
+	}
+}
+
+// The block row of the p-th block (the same value in all threads of the warp)
+__device__ inline unsigned find_block_row(const unsigned* const row_ptr, const unsigned num_block_rows, const unsigned p) {
+	// The last block row r such that row_ptr[r] <= p
+	unsigned lo = 0, hi = num_block_rows;
+	while (hi - lo > 1) {
+		const auto mid = (lo + hi) / 2;
+		if (row_ptr[mid] <= p) {
+			lo = mid;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// The p-th block of C = alpha * A * B + beta * C
+// A : row major, B : col major, C : BSR of (BLOCK_M x BLOCK_N) blocks
+template <unsigned BLOCK_M, unsigned BLOCK_N, unsigned WARP_K, class T, class Policy>
+__device__ inline void sddmm_block(
+		const unsigned p,
+		const unsigned block_row,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		const unsigned* const col_idx,
+		float* const values
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , BLOCK_M, BLOCK_N, WARP_K, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , BLOCK_M, BLOCK_N, WARP_K, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, BLOCK_M, BLOCK_N, WARP_K, T, void                   , Policy> frag_c;
+
+	float* const c_block_ptr = values + p * static_cast<std::size_t>(BLOCK_M * BLOCK_N);
+	if (beta == 0.f) {
+		mtk::wmma::tcec::fill_zero(frag_c);
+	} else {
+		mtk::wmma::tcec::load_matrix_sync(frag_c, c_block_ptr, BLOCK_M, nvcuda::wmma::mem_col_major, false);
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= beta;
+		}
+	}
+
+	const float* const a_block_ptr = a_ptr + block_row * BLOCK_M * static_cast<std::size_t>(lda);
+	const float* const b_block_ptr = b_ptr + col_idx[p] * BLOCK_N * static_cast<std::size_t>(ldb);
+	for (unsigned bk = 0; bk < k; bk += WARP_K) {
+		mtk::wmma::tcec::load_matrix_sync_with_mul(frag_a, a_block_ptr + bk, lda, alpha, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, b_block_ptr + bk, ldb, false);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	mtk::wmma::tcec::store_matrix_sync(c_block_ptr, frag_c, BLOCK_M, nvcuda::wmma::mem_col_major, false);
+}
+
+// k must be a multiple of WARP_K.
+// A warp computes a non-zero block of C.
+template <unsigned BLOCK_M, unsigned BLOCK_N, unsigned WARP_K, class T, class Policy>
+__global__ void sddmm_kernel(
+		const unsigned m,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		const unsigned* const row_ptr,
+		const unsigned* const col_idx,
+		float* const values
+		) {
+	const unsigned num_block_rows = m / BLOCK_M;
+	const unsigned num_blocks = row_ptr[num_block_rows];
+	for (unsigned p = threadIdx.x / 32 + blockIdx.x * (blockDim.x / 32); p < num_blocks; p += gridDim.x * (blockDim.x / 32)) {
+		const auto block_row = find_block_row(row_ptr, num_block_rows, p);
+		sddmm_block<BLOCK_M, BLOCK_N, WARP_K, T, Policy>(p, block_row, k, alpha, a_ptr, lda, b_ptr, ldb, beta, col_idx, values);
+	}
+}
+
+// Launch spmm_kernel
+// row_ptr / col_idx / values : the device copies of `mtk::wmma::tcec::bsr::matrix` (block_m = BLOCK_M, block_n = BLOCK_K)
+// num_blocks == 0 : one tile per warp
+template <unsigned BLOCK_M, unsigned BLOCK_K, unsigned WARP_N, class T, class Policy>
+inline void launch_spmm(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const unsigned* const row_ptr,
+		const unsigned* const col_idx,
+		const float* const values,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	const unsigned long num_tiles = static_cast<unsigned long>(m / BLOCK_M) * (n / WARP_N);
+	if (num_tiles == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (num_tiles + detail::num_warps - 1) / detail::num_warps;
+	}
+	spmm_kernel<BLOCK_M, BLOCK_K, WARP_N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			m, n,
+			alpha,
+			row_ptr, col_idx, values,
+			b_ptr, ldb,
+			beta,
+			c_ptr, ldc
+			);
+}
+
+// Launch sddmm_kernel
+// nnz_blocks : the number of the non-zero blocks of C (`mtk::wmma::tcec::bsr::matrix::num_blocks()`) to determine the grid size
+// num_blocks == 0 : one non-zero block per warp
+template <unsigned BLOCK_M, unsigned BLOCK_N, unsigned WARP_K, class T, class Policy>
+inline void launch_sddmm(
+		const unsigned m,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		const unsigned* const row_ptr,
+		const unsigned* const col_idx,
+		float* const values,
+		const unsigned nnz_blocks,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (nnz_blocks == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (nnz_blocks + detail::num_warps - 1) / detail::num_warps;
+	}
+	sddmm_kernel<BLOCK_M, BLOCK_N, WARP_K, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			m, k,
+			alpha,
+			a_ptr, lda,
+			b_ptr, ldb,
+			beta,
+			row_ptr, col_idx, values
+			);
+}
+} // namespace bsr
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,164 @@
+#ifndef __WMMAE_TCEC_BSR_HOST_HPP__
+#define __WMMAE_TCEC_BSR_HOST_HPP__
+#include <cstddef>
+#include <vector>
+
+// Block sparse row (BSR) matrices for mtk::wmma::tcec::bsr (see bsr.hpp)
+// This header does not depend on CUDA.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace bsr {
+
+// An m x n matrix of (block_m x block_n) blocks
+//   row_ptr : num_block_rows + 1 offsets of the blocks of each block row
+//   col_idx : the block column index of each block (ascending in each block row)
+//   values  : block_m * block_n elements of each block (col major, ld = block_m)
+struct matrix {
+	unsigned m = 0;
+	unsigned n = 0;
+	unsigned block_m = 0;
+	unsigned block_n = 0;
+	std::vector<unsigned> row_ptr;
+	std::vector<unsigned> col_idx;
+	std::vector<float> values;
+
+	unsigned num_block_rows() const {return block_m ? m / block_m : 0;}
+	unsigned num_block_cols() const {return block_n ? n / block_n : 0;}
+	unsigned num_blocks() const {return static_cast<unsigned>(col_idx.size());}
+	std::size_t block_size() const {return static_cast<std::size_t>(block_m) * block_n;}
+	// The ratio of the non-zero blocks
+	double density() const {
+		const auto total = static_cast<double>(num_block_rows()) * num_block_cols();
+		return total > 0. ? num_blocks() / total : 0.;
+	}
+};
+
+namespace host {
+// Make a BSR matrix from a dense m x n matrix (col major, ld).
+// The blocks whose elements are all zero are dropped.
+// m and n must be multiples of block_m and block_n respectively.
+inline mtk::wmma::tcec::bsr::matrix build(
+		const float* const dense_ptr, const unsigned ld,
+		const unsigned m, const unsigned n,
+		const unsigned block_m, const unsigned block_n
+		) {
+	mtk::wmma::tcec::bsr::matrix mat;
+	mat.m = m;
+	mat.n = n;
+	mat.block_m = block_m;
+	mat.block_n = block_n;
+	mat.row_ptr.push_back(0);
+	for (unsigned bi = 0; bi < m / block_m; bi++) {
+		for (unsigned bj = 0; bj < n / block_n; bj++) {
+			const auto block_ptr = dense_ptr + bi * block_m + bj * block_n * static_cast<std::size_t>(ld);
+			bool zero = true;
+			for (unsigned j = 0; j < block_n && zero; j++) {
+				for (unsigned i = 0; i < block_m; i++) {
+					if (block_ptr[i + j * static_cast<std::size_t>(ld)] != 0.f) {
+						zero = false;
+						break;
+					}
+				}
+			}
+			if (zero) {
+				continue;
+			}
+			mat.col_idx.push_back(bj);
+			for (unsigned j = 0; j < block_n; j++) {
+				for (unsigned i = 0; i < block_m; i++) {
+					mat.values.push_back(block_ptr[i + j * static_cast<std::size_t>(ld)]);
+				}
+			}
+		}
+		mat.row_ptr.push_back(static_cast<unsigned>(mat.col_idx.size()));
+	}
+	return mat;
+}
+
+// Expand a BSR matrix to a dense matrix (col major, ld). The zero blocks are filled with zero.
+inline void to_dense(float* const dense_ptr, const unsigned ld, const mtk::wmma::tcec::bsr::matrix& mat) {
+	for (unsigned j = 0; j < mat.n; j++) {
+		for (unsigned i = 0; i < mat.m; i++) {
+			dense_ptr[i + j * static_cast<std::size_t>(ld)] = 0.f;
+		}
+	}
+	for (unsigned bi = 0; bi < mat.num_block_rows(); bi++) {
+		for (unsigned p = mat.row_ptr[bi]; p < mat.row_ptr[bi + 1]; p++) {
+			const auto block_ptr = dense_ptr + bi * mat.block_m + mat.col_idx[p] * mat.block_n * static_cast<std::size_t>(ld);
+			for (unsigned j = 0; j < mat.block_n; j++) {
+				for (unsigned i = 0; i < mat.block_m; i++) {
+					block_ptr[i + j * static_cast<std::size_t>(ld)] = mat.values[p * mat.block_size() + i + j * mat.block_m];
+				}
+			}
+		}
+	}
+}
+
+// Reference of mtk::wmma::tcec::bsr::launch_spmm in double
+// C = alpha * A * B + beta * C
+// A : BSR (m x k), B : k x n (col major), C : m x n (col major)
+inline void spmm(
+		const unsigned n,
+		const float alpha,
+		const mtk::wmma::tcec::bsr::matrix& a,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	std::vector<double> acc(a.m);
+	for (unsigned j = 0; j < n; j++) {
+		for (auto& v : acc) {
+			v = 0.;
+		}
+		for (unsigned bi = 0; bi < a.num_block_rows(); bi++) {
+			for (unsigned p = a.row_ptr[bi]; p < a.row_ptr[bi + 1]; p++) {
+				const auto b_col_ptr = b_ptr + a.col_idx[p] * a.block_n + j * static_cast<std::size_t>(ldb);
+				for (unsigned l = 0; l < a.block_n; l++) {
+					for (unsigned i = 0; i < a.block_m; i++) {
+						acc[bi * a.block_m + i] += static_cast<double>(a.values[p * a.block_size() + i + l * a.block_m]) * b_col_ptr[l];
+					}
+				}
+			}
+		}
+		for (unsigned i = 0; i < a.m; i++) {
+			auto& c = c_ptr[i + j * static_cast<std::size_t>(ldc)];
+			c = static_cast<float>(alpha * acc[i] + (beta == 0.f ? 0. : static_cast<double>(beta) * c));
+		}
+	}
+}
+
+// Reference of mtk::wmma::tcec::bsr::launch_sddmm in double
+// C = alpha * (A * B) o spy(C) + beta * C
+// A : m x k (row major), B : k x n (col major), C : BSR (m x n) whose values are updated
+inline void sddmm(
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		mtk::wmma::tcec::bsr::matrix& c
+		) {
+	for (unsigned bi = 0; bi < c.num_block_rows(); bi++) {
+		for (unsigned p = c.row_ptr[bi]; p < c.row_ptr[bi + 1]; p++) {
+			for (unsigned j = 0; j < c.block_n; j++) {
+				for (unsigned i = 0; i < c.block_m; i++) {
+					const auto a_row_ptr = a_ptr + (bi * c.block_m + i) * static_cast<std::size_t>(lda);
+					const auto b_col_ptr = b_ptr + (c.col_idx[p] * c.block_n + j) * static_cast<std::size_t>(ldb);
+					double acc = 0.;
+					for (unsigned l = 0; l < k; l++) {
+						acc += static_cast<double>(a_row_ptr[l]) * b_col_ptr[l];
+					}
+					auto& v = c.values[p * c.block_size() + i + j * c.block_m];
+					v = static_cast<float>(alpha * acc + (beta == 0.f ? 0. : static_cast<double>(beta) * v));
+				}
+			}
+		}
+	}
+}
+} // namespace host
+} // namespace bsr
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
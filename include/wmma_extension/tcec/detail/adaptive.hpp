@@ -0,0 +1,192 @@
+#ifndef __WMMAE_TCEC_DETAIL_ADAPTIVE_HPP__
+#define __WMMAE_TCEC_DETAIL_ADAPTIVE_HPP__
+
+#include <type_traits>
+
+#include "common.hpp"
+#include "policy.hpp"
+#include "functions.hpp"
+#include "scale.hpp"
+#include "skip.hpp"
+
+// Error correction selected at runtime from the magnitudes of the sub fragments (with_ec_adaptive)
+//   - matrix_a / matrix_b : the same as with_ec
+//   - accumulator         : with_ec + the counters of the skipped mma (detail::skip::mma_counters, the same as with_ec_skip)
+// mma_sync(frag_d, frag_a, frag_b, frag_c, tolerance) skips the correction mma of A.dx * B.x (A.x * B.dx) of a pair of the sub fragments when
+//     correction_scale_1(max|A.dx| * max|B.x|) <= tolerance / 2 * (S_A * S_B)
+// where max is taken over the sub fragment and S_A (S_B) is max|A.x| (max|B.x|) over the whole fragment.
+// Each skipped mma changes an element of D by at most fk * correction_scale_1(max|A.dx| * max|B.x|), so
+//     max|D - D_with_ec| <= tolerance * k * S_A * S_B
+// up to the rounding of the accumulation (normwise relative to the magnitude of the product).
+// The correction is paid only for the sub fragments whose residuals are not negligible to the largest elements of the fragment.
+// with_ec_adaptive_zero_tile (with_ec_adaptive_t<true>) also skips all mma with an all-zero operand sub fragment
+// when the other operand sub fragment is finite (see skip.hpp).
+// The host reference of this selection is `mtk::wmma::tcec::host::adaptive_correction` in tcec/host.hpp.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+struct fragment <Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>
+	: public fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>> {
+	static_assert(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value, "with_ec_adaptive supports op_mma and op_wmma only");
+	using base_t = fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>;
+
+	fragment() = default;
+	__device__ fragment(const base_t& frag) : base_t(frag) {}
+};
+
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+struct fragment <nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>
+	: public fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>,
+	  public mtk::wmma::tcec::detail::skip::mma_counters {
+	static_assert(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value, "with_ec_adaptive supports op_mma and op_wmma only");
+	using base_t = fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>;
+
+	fragment() = default;
+	__device__ fragment(const base_t& frag) : base_t(frag) {}
+};
+
+namespace detail {
+namespace adaptive {
+// max(a, b) which propagates nan (fmaxf discards it)
+__device__ inline float max_nan(const float a, const float b) {
+	return (isnan(b) || b > a) ? b : a;
+}
+
+// max|x| of a sub fragment in the warp (the same value in all threads)
+// It is nan if the sub fragment has nan, so that the sub fragment is neither regarded as zero nor its correction skipped.
+template <class Frag>
+__device__ inline float max_abs(const Frag& sub_frag) {
+	float v = 0.f;
+	for (unsigned i = 0; i < sub_frag.num_elements; i++) {
+		v = max_nan(v, fabsf(mtk::wmma::detail::common::cast<float>(sub_frag.x[i])));
+	}
+	for (unsigned mask = 16; mask > 0; mask >>= 1) {
+		v = max_nan(v, __shfl_xor_sync(0xffffffff, v, mask));
+	}
+	return v;
+}
+
+// Correction selector of with_ec_adaptive (see the top of this file)
+template <class T, bool zero_tile, class Frag_A, class Frag_B>
+struct tolerance_selector {
+	static constexpr unsigned num_a_sub_frags = Frag_A::num_sub_frag_m * Frag_A::num_sub_frag_n;
+	static constexpr unsigned num_b_sub_frags = Frag_B::num_sub_frag_m * Frag_B::num_sub_frag_n;
+	float a_hi[num_a_sub_frags];
+	float a_lo[num_a_sub_frags];
+	float b_hi[num_b_sub_frags];
+	float b_lo[num_b_sub_frags];
+	float threshold;
+
+	__device__ tolerance_selector(const Frag_A& frag_a, const Frag_B& frag_b, const float tolerance) {
+		float scale_a = 0.f;
+		for (unsigned i = 0; i < num_a_sub_frags; i++) {
+			a_hi[i] = max_abs(frag_a.sub_frag  [i]);
+			a_lo[i] = max_abs(frag_a.sub_d_frag[i]);
+			scale_a = max_nan(scale_a, a_hi[i]);
+		}
+		float scale_b = 0.f;
+		for (unsigned i = 0; i < num_b_sub_frags; i++) {
+			b_hi[i] = max_abs(frag_b.sub_frag  [i]);
+			b_lo[i] = max_abs(frag_b.sub_d_frag[i]);
+			scale_b = max_nan(scale_b, b_hi[i]);
+		}
+		// The same expression as host::adaptive_threshold
+		// A nan threshold skips no correction mma.
+		threshold = __fmul_rn(tolerance / 2, __fmul_rn(scale_a, scale_b));
+	}
+
+	// All mma
+	__device__ bool skip_tile(const unsigned a_index, const unsigned b_index) const {
+		const auto a_zero = a_hi[a_index] == 0.f && a_lo[a_index] == 0.f;
+		const auto b_zero = b_hi[b_index] == 0.f && b_lo[b_index] == 0.f;
+		const auto a_finite = isfinite(a_hi[a_index]) && isfinite(a_lo[a_index]);
+		const auto b_finite = isfinite(b_hi[b_index]) && isfinite(b_lo[b_index]);
+		return zero_tile && ((a_zero && b_finite) || (b_zero && a_finite));
+	}
+	// A.dx * B.x
+	__device__ bool skip_a(const unsigned a_index, const unsigned b_index) const {
+		return mtk::wmma::tcec::detail::correction_scale_1<T>(__fmul_rn(a_lo[a_index], b_hi[b_index])) <= threshold;
+	}
+	// A.x * B.dx
+	__device__ bool skip_b(const unsigned a_index, const unsigned b_index) const {
+		return mtk::wmma::tcec::detail::correction_scale_1<T>(__fmul_rn(a_hi[a_index], b_lo[b_index])) <= threshold;
+	}
+};
+
+template <bool rz, class T, class A_Layout, class B_Layout, class Frag_D, class Frag_A, class Frag_B, class Frag_C>
+__device__ void mma(Frag_D& frag_d, const Frag_A& frag_a, const Frag_B& frag_b, const Frag_C& frag_c, const float tolerance) {
+	constexpr bool zero_tile = mtk::wmma::tcec::detail::skip::skip_zero_tile<typename Frag_D::Policy::error_correction>::value;
+	mtk::wmma::tcec::detail::skip::mma<rz, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c, tolerance_selector<T, zero_tile, Frag_A, Frag_B>(frag_a, frag_b, tolerance));
+}
+} // namespace adaptive
+} // namespace detail
+
+// The correction mma is selected with `tolerance` (0 : skipped only when the products of it are zero)
+// rn
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_c,
+		const float tolerance = 0.f) {
+	mtk::wmma::tcec::detail::adaptive::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c, tolerance);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const float tolerance = 0.f) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::adaptive::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d, tolerance);
+}
+
+// rz
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_c,
+		const float tolerance = 0.f) {
+	mtk::wmma::tcec::detail::adaptive::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c, tolerance);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const float tolerance = 0.f) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::adaptive::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d, tolerance);
+}
+
+// mma
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_c,
+		const float tolerance = 0.f) {
+	mma_rn_sync(frag_d, frag_a, frag_b, frag_c, tolerance);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const float tolerance = 0.f) {
+	mma_rn_sync(frag_d, frag_a, frag_b, tolerance);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
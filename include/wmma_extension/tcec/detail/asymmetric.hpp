@@ -0,0 +1,159 @@
+#ifndef __WMMAE_TCEC_DETAIL_ASYMMETRIC_HPP__
+#define __WMMAE_TCEC_DETAIL_ASYMMETRIC_HPP__
+
+#include <type_traits>
+
+#include "common.hpp"
+#include "policy.hpp"
+#include "functions.hpp"
+
+// Asymmetric error correction
+// When one operand is exactly representable in T (e.g. one-hot, quantized or integer-valued matrices),
+// its residual is zero and the correction product with it can be skipped.
+// The exact operand is given as a without_ec fragment and the other one as a with_ec fragment:
+//   D = A.x * B.x + (A.dx * B.x + A.x * B.dx)   (with_ec x with_ec       : 3 mma)
+//   D = A.x * B.x + (A.dx * B.x)                (with_ec x without_ec    : 2 mma)
+//   D = A.x * B.x + (A.x * B.dx)                (without_ec x with_ec    : 2 mma)
+// The accumulators are with_ec. Only the combinations above are overloaded, so the other ones do not compile.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace detail {
+namespace asymmetric {
+template <class Op, class A_EC, class B_EC>
+struct is_supported : public std::integral_constant<bool,
+	(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value) &&
+	((std::is_same<A_EC, mtk::wmma::tcec::with_ec>::value && std::is_same<B_EC, mtk::wmma::tcec::without_ec>::value) ||
+	 (std::is_same<A_EC, mtk::wmma::tcec::without_ec>::value && std::is_same<B_EC, mtk::wmma::tcec::with_ec>::value))
+	> {};
+
+// The correction product of the operand which has the residual
+template <class MMA_Op, class Frag_D, class Frag_A, class Frag_B, class Op, int fm, int fn, int fk>
+__device__ void mma_correction(
+		MMA_Op& mma_op,
+		Frag_D& d_d_frag,
+		const Frag_A& frag_a, const unsigned a_index, const mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec   , fm, fn, fk>,
+		const Frag_B& frag_b, const unsigned b_index, const mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>
+		) {
+	mma_op(d_d_frag, frag_a.sub_d_frag[a_index], frag_b.sub_frag[b_index], d_d_frag);
+}
+
+template <class MMA_Op, class Frag_D, class Frag_A, class Frag_B, class Op, int fm, int fn, int fk>
+__device__ void mma_correction(
+		MMA_Op& mma_op,
+		Frag_D& d_d_frag,
+		const Frag_A& frag_a, const unsigned a_index, const mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>,
+		const Frag_B& frag_b, const unsigned b_index, const mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec   , fm, fn, fk>
+		) {
+	mma_op(d_d_frag, frag_a.sub_frag[a_index], frag_b.sub_d_frag[b_index], d_d_frag);
+}
+
+// RN : The products of A.x * B.x are computed from zero and added to D in FP32 (see mma_rn_sync of with_ec)
+// RZ : The products of A.x * B.x are accumulated by the Tensor Cores
+template <bool rz, class T, class A_Layout, class B_Layout, class Frag_D, class Frag_A, class Frag_B, class Frag_C>
+__device__ void mma(Frag_D& frag_d, const Frag_A& frag_a, const Frag_B& frag_b, const Frag_C& frag_c) {
+	using Policy = typename Frag_D::Policy;
+	constexpr unsigned num_m_block = Frag_D::num_sub_frag_m;
+	constexpr unsigned num_n_block = Frag_D::num_sub_frag_n;
+	constexpr unsigned num_k_block = Frag_A::num_sub_frag_n;
+
+	mtk::wmma::tcec::detail::mma_sync_wrapper<T, A_Layout, B_Layout, float, Policy> mma_op;
+	mtk::wmma::tcec::detail::fill_zero_wrapper<nvcuda::wmma::accumulator, float, void, Policy> zero_op;
+
+	for (unsigned bm = 0; bm < num_m_block; bm++) {
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			auto& d_frag   = frag_d.sub_frag  [bm + bn * num_m_block];
+			auto& d_d_frag = frag_d.sub_d_frag[bm + bn * num_m_block];
+			for (unsigned i = 0; i < d_frag.num_elements; i++) {
+				d_frag  .x[i] = frag_c.sub_frag  [bm + bn * num_m_block].x[i];
+				d_d_frag.x[i] = frag_c.sub_d_frag[bm + bn * num_m_block].x[i];
+			}
+			for (unsigned bk = 0; bk < num_k_block; bk++) {
+				if (rz) {
+					mma_op(d_frag, frag_a.sub_frag[bm + bk * num_m_block], frag_b.sub_frag[bk + bn * num_k_block], d_frag);
+				} else {
+					typename Frag_D::sub_frag_t tmp;
+					zero_op(tmp);
+					mma_op(tmp, frag_a.sub_frag[bm + bk * num_m_block], frag_b.sub_frag[bk + bn * num_k_block], tmp);
+					for (unsigned i = 0; i < tmp.num_elements; i++) {
+						d_frag.x[i] += tmp.x[i];
+					}
+				}
+				mma_correction(
+						mma_op,
+						d_d_frag,
+						frag_a, bm + bk * num_m_block, typename Frag_A::Policy{},
+						frag_b, bk + bn * num_k_block, typename Frag_B::Policy{}
+						);
+			}
+		}
+	}
+}
+} // namespace asymmetric
+} // namespace detail
+
+// rn
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_c) {
+	mtk::wmma::tcec::detail::asymmetric::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::asymmetric::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d);
+}
+
+// rz
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_c) {
+	mtk::wmma::tcec::detail::asymmetric::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::asymmetric::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d);
+}
+
+// mma
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_c) {
+	mma_rn_sync(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, class A_EC, class B_EC,
+				 typename std::enable_if<mtk::wmma::tcec::detail::asymmetric::is_supported<Op, A_EC, B_EC>::value, bool>::type = false>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, A_EC, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, B_EC, fm, fn, fk>>& frag_b) {
+	mma_rn_sync(frag_d, frag_a, frag_b);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,169 @@
+#ifndef __WMMAE_TCEC_DETAIL_EXPRESSION_HPP__
+#define __WMMAE_TCEC_DETAIL_EXPRESSION_HPP__
+#include "../../expression.hpp"
+#include "common.hpp"
+#include "scale.hpp"
+
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace detail {
+// The value type of the accumulator fragments with error correction in expressions.
+// `dx` is not scaled by `correction_scale_0`.
+struct compensated_float {
+	float x;
+	float dx;
+};
+} // namespace detail
+} // namespace tcec
+
+namespace expr {
+namespace detail {
+// The rounding errors of the operations on x are accumulated to dx (TwoSum / TwoProd)
+template <>
+struct value_ops<mtk::wmma::tcec::detail::compensated_float> {
+	using value_t = mtk::wmma::tcec::detail::compensated_float;
+	using scalar_t = float;
+	__device__ static float two_sum_error(const float a, const float b, const float s) {
+		const auto bb = s - a;
+		return (a - (s - bb)) + (b - bb);
+	}
+	__device__ static value_t from_scalar(const scalar_t s) {return {s, 0.f};}
+	__device__ static value_t add(const value_t a, const value_t b) {
+		const auto s = a.x + b.x;
+		return {s, a.dx + b.dx + two_sum_error(a.x, b.x, s)};
+	}
+	__device__ static value_t sub(const value_t a, const value_t b) {
+		return add(a, neg(b));
+	}
+	__device__ static value_t mul(const value_t a, const value_t b) {
+		const auto p = a.x * b.x;
+		return {p, __fmaf_rn(a.dx, b.x, a.x * b.dx) + __fmaf_rn(a.x, b.x, -p)};
+	}
+	__device__ static value_t div(const value_t a, const value_t b) {
+		const auto q = a.x / b.x;
+		// The remainder of the division is exact
+		return {q, (__fmaf_rn(-q, b.x, a.x) + __fmaf_rn(-q, b.dx, a.dx)) / b.x};
+	}
+	__device__ static value_t neg(const value_t a) {return {-a.x, -a.dx};}
+	__device__ static value_t fma(const value_t a, const value_t b, const value_t c) {
+		const auto p = a.x * b.x;
+		const auto p_error = __fmaf_rn(a.x, b.x, -p);
+		const auto s = p + c.x;
+		return {s, __fmaf_rn(a.dx, b.x, __fmaf_rn(a.x, b.dx, c.dx)) + p_error + two_sum_error(p, c.x, s)};
+	}
+};
+} // namespace detail
+} // namespace expr
+
+namespace tcec {
+namespace detail {
+// Element access of tcec fragments in expressions
+template <class Use, class T, class ErrorCorrection>
+struct expression_access;
+
+// Without error correction : the elements are computed in the storage type (by `half2` for `half`)
+template <class Use, class T>
+struct expression_access<Use, T, mtk::wmma::tcec::without_ec> {
+	using value_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+
+	template <class V, class DUMMY = void>
+	struct access {
+		template <class Frag_T>
+		__device__ static V load(const Frag_T& frag, const unsigned i) {return frag.x(i);}
+		template <class Frag_T>
+		__device__ static void store(Frag_T& frag, const unsigned i, const V v) {frag.x(i) = v;}
+	};
+	template <class DUMMY>
+	struct access<half2, DUMMY> {
+		template <class Frag_T>
+		__device__ static half2 load(const Frag_T& frag, const unsigned i) {return __halves2half2(frag.x(2 * i), frag.x(2 * i + 1));}
+		template <class Frag_T>
+		__device__ static void store(Frag_T& frag, const unsigned i, const half2 v) {
+			frag.x(2 * i) = __low2half(v);
+			frag.x(2 * i + 1) = __high2half(v);
+		}
+	};
+
+	template <class V, class Frag_T>
+	__device__ static V load(const Frag_T& frag, const unsigned i) {return access<V>::load(frag, i);}
+	template <class V, class Frag_T>
+	__device__ static void store(Frag_T& frag, const unsigned i, const V v) {access<V>::store(frag, i, v);}
+};
+
+// With error correction (matrix_a / matrix_b) :
+// The elements are computed in FP32 from (x + dx) and split into x and dx again as the load functions do.
+template <class Use, class T>
+struct expression_access<Use, T, mtk::wmma::tcec::with_ec> {
+	using value_t = float;
+
+	template <class V, class Frag_T>
+	__device__ static V load(const Frag_T& frag, const unsigned i) {
+		return mtk::wmma::detail::common::cast<float>(frag.x(i)) + correction_scale_1<T>(mtk::wmma::detail::common::cast<float>(frag.dx(i)));
+	}
+	template <class V, class Frag_T>
+	__device__ static void store(Frag_T& frag, const unsigned i, const V v) {
+		const auto hv = mtk::wmma::detail::common::cast<T>(v);
+		const auto dhv = mtk::wmma::detail::common::cast<T>(correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(hv)));
+		frag.x(i) = hv;
+		frag.dx(i) = dhv;
+	}
+};
+
+// With error correction (accumulator) :
+// The elements are computed as `compensated_float`.
+template <class T>
+struct expression_access<nvcuda::wmma::accumulator, T, mtk::wmma::tcec::with_ec> {
+	using value_t = compensated_float;
+
+	template <class V, class Frag_T>
+	__device__ static V load(const Frag_T& frag, const unsigned i) {
+		return {frag.x(i), correction_scale_1<T>(frag.dx(i))};
+	}
+	template <class V, class Frag_T>
+	__device__ static void store(Frag_T& frag, const unsigned i, const V v) {
+		frag.x(i) = v.x;
+		frag.dx(i) = correction_scale_0<T>(v.dx);
+	}
+};
+
+template <class Frag_T, class Access>
+struct fragment_terminal : mtk::wmma::expr::expression_base {
+	using value_t = typename Access::value_t;
+	using scalar_t = typename mtk::wmma::expr::detail::value_ops<value_t>::scalar_t;
+	static const unsigned num_elements = Frag_T::num_elements;
+
+	const Frag_T* const frag;
+
+	__device__ fragment_terminal(const Frag_T* const frag) : frag(frag) {}
+
+	template <class V>
+	__device__ V get(const unsigned i) const {return Access::template load<V>(*frag, i);}
+};
+} // namespace detail
+
+// ------------------------------
+// Terminal / evaluation
+// ------------------------------
+// The operators of `mtk::wmma::expr` are available for the terminals.
+//
+// mtk::wmma::tcec::eval(frag_d, mtk::wmma::tcec::lazy(frag_a) + mtk::wmma::tcec::lazy(frag_b) * alpha);
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ detail::fragment_terminal<fragment<Use, m, n, k, T, Layout, Policy>, detail::expression_access<Use, T, typename Policy::error_correction>>
+lazy(const fragment<Use, m, n, k, T, Layout, Policy>& frag) {
+	return {&frag};
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy, class E>
+__device__ typename std::enable_if<mtk::wmma::expr::is_expression<E>::value>::type
+eval(fragment<Use, m, n, k, T, Layout, Policy>& frag, const E& e) {
+	using frag_t = fragment<Use, m, n, k, T, Layout, Policy>;
+	using access_t = detail::expression_access<Use, T, typename Policy::error_correction>;
+	static_assert(std::is_same<typename access_t::value_t, typename E::value_t>::value, "The value type of the expression has to be the one of the fragment");
+	static_assert(frag_t::num_elements == E::num_elements, "The number of elements of the expression has to be the same as the fragment");
+	mtk::wmma::expr::detail::evaluator<typename E::value_t, E::num_elements>::template run<access_t>(frag, e);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
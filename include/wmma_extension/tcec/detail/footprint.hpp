@@ -0,0 +1,34 @@
+#ifndef __WMMAE_TCEC_DETAIL_FOOTPRINT_HPP__
+#define __WMMAE_TCEC_DETAIL_FOOTPRINT_HPP__
+#include <type_traits>
+#include "../../detail/footprint.hpp"
+
+namespace mtk {
+namespace wmma {
+namespace utils {
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+struct footprint<mtk::wmma::tcec::fragment<Use, m, n, k, T, Layout, Policy>> {
+	using fragment_t = mtk::wmma::tcec::fragment<Use, m, n, k, T, Layout, Policy>;
+	static const bool error_correction = !std::is_same<typename Policy::error_correction, mtk::wmma::tcec::without_ec>::value;
+	static const unsigned rows = mtk::wmma::tcec::detail::select_value<Use, m, k, m>::value;
+	static const unsigned cols = mtk::wmma::tcec::detail::select_value<Use, k, n, n>::value;
+	static const unsigned num_elements = fragment_t::num_elements;
+	static const unsigned num_sub_frags = fragment_t::num_sub_frag_m * fragment_t::num_sub_frag_n;
+	static const unsigned sub_frag_registers = mtk::wmma::utils::footprint<typename fragment_t::sub_frag_t>::registers;
+	// with_ec            : sub_frag and sub_d_frag (x2 registers)
+	// without_ec         : sub_frag only (sub_d_frag is a zero-length array)
+	// with_ec_recompute  : the FP32 source in matrix_a / matrix_b (tf32 only) and sub_frag and sub_d_frag in accumulators
+	// with_ec_skip       : with_ec + the mma counters in accumulators
+	// with_ec_adaptive   : with_ec + the mma counters in accumulators
+	static const unsigned registers = (sizeof(fragment_t) + 3) / 4;
+
+	// Shared memory to stage the FP32 matrix of the fragment
+	template <class MemT = float, class MemLayout = Layout>
+	static constexpr unsigned smem_bytes(const unsigned ldm = 0) {
+		return mtk::wmma::utils::detail::footprint::get_matrix_bytes(rows, cols, ldm, mtk::wmma::utils::detail::footprint::is_col_major<MemLayout>::value, sizeof(MemT));
+	}
+};
+} // namespace utils
+} // namespace wmma
+} // namespace mtk
+#endif
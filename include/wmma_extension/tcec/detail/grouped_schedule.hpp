@@ -0,0 +1,173 @@
+#ifndef __WMMAE_TCEC_DETAIL_GROUPED_SCHEDULE_HPP__
+#define __WMMAE_TCEC_DETAIL_GROUPED_SCHEDULE_HPP__
+#include <vector>
+#include "../../detail/host_device.hpp"
+
+// Problem descriptors and the tile scheduler of the grouped GEMM.
+// This header does not depend on CUDA so that the schedule can be simulated on the host.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace grouped {
+
+// A GEMM of the group
+//   C = alpha * A * B + beta * C
+//   A : m x k (row major), B : k x n (col major), C : m x n (col major)
+// The sizes are arbitrary (the tiles on the edges are partial) and each problem has its own pointers and leading dimensions.
+struct problem {
+	unsigned m;
+	unsigned n;
+	unsigned k;
+	float alpha;
+	float beta;
+	const float* a_ptr;
+	unsigned lda;
+	const float* b_ptr;
+	unsigned ldb;
+	float* c_ptr;
+	unsigned ldc;
+};
+
+template <unsigned WARP_M>
+WMMAE_HOST_DEVICE inline unsigned num_tiles_m(const mtk::wmma::tcec::grouped::problem& p) {
+	return (p.m + WARP_M - 1) / WARP_M;
+}
+
+template <unsigned WARP_M, unsigned WARP_N>
+WMMAE_HOST_DEVICE inline unsigned long num_tiles(const mtk::wmma::tcec::grouped::problem& p) {
+	return static_cast<unsigned long>(num_tiles_m<WARP_M>(p)) * ((p.n + WARP_N - 1) / WARP_N);
+}
+
+// The number of the tiles of all problems
+template <unsigned WARP_M, unsigned WARP_N>
+WMMAE_HOST_DEVICE inline unsigned long num_tiles(const mtk::wmma::tcec::grouped::problem* const problems, const unsigned num_problems) {
+	unsigned long count = 0;
+	for (unsigned i = 0; i < num_problems; i++) {
+		count += num_tiles<WARP_M, WARP_N>(problems[i]);
+	}
+	return count;
+}
+
+// C[tile_m:tile_m+WARP_M, tile_n:tile_n+WARP_N] of the problem `problem_id`
+struct tile {
+	unsigned problem_id;
+	unsigned tile_m;
+	unsigned tile_n;
+};
+
+// The tiles of all problems are numbered consecutively (the tiles of problem 0 first, and along m first in each problem).
+// The warp `warp_id` of the block `block_id` computes the tiles
+//   block_id * num_warps + warp_id + i * (num_blocks * num_warps), i = 0, 1, ...
+// so that the warps of a block share the columns of B.
+// The tile ids of a warp are increasing, so the scheduler only walks the problem list forward
+// and no prefix sum of the tile counts has to be prepared on the host.
+template <unsigned WARP_M, unsigned WARP_N>
+struct tile_scheduler {
+	unsigned long tile_id;
+	unsigned long stride;
+	// The current problem and the id of its first tile
+	unsigned problem_id;
+	unsigned long problem_tile_offset;
+
+	WMMAE_HOST_DEVICE tile_scheduler(const unsigned block_id, const unsigned num_blocks, const unsigned warp_id, const unsigned num_warps)
+		: tile_id(static_cast<unsigned long>(block_id) * num_warps + warp_id),
+		  stride(static_cast<unsigned long>(num_blocks) * num_warps),
+		  problem_id(0), problem_tile_offset(0) {}
+
+	// Sets the next tile of the warp to `t`. Returns false if no tile is left.
+	WMMAE_HOST_DEVICE bool next(const mtk::wmma::tcec::grouped::problem* const problems, const unsigned num_problems, mtk::wmma::tcec::grouped::tile& t) {
+		for (; problem_id < num_problems; problem_id++) {
+			const auto problem_num_tiles = num_tiles<WARP_M, WARP_N>(problems[problem_id]);
+			if (tile_id < problem_tile_offset + problem_num_tiles) {
+				break;
+			}
+			problem_tile_offset += problem_num_tiles;
+		}
+		if (problem_id >= num_problems) {
+			return false;
+		}
+		const auto local_tile_id = tile_id - problem_tile_offset;
+		const auto problem_num_tiles_m = num_tiles_m<WARP_M>(problems[problem_id]);
+		t.problem_id = problem_id;
+		t.tile_m = static_cast<unsigned>(local_tile_id % problem_num_tiles_m) * WARP_M;
+		t.tile_n = static_cast<unsigned>(local_tile_id / problem_num_tiles_m) * WARP_N;
+		tile_id += stride;
+		return true;
+	}
+};
+
+// Host simulator of the tile assignment
+struct tile_assignment_report {
+	// The number of the tiles of each problem
+	std::vector<unsigned long> num_tiles;
+	unsigned long num_missing_tiles;
+	unsigned long num_duplicated_tiles;
+	// Tiles which are not in the C of their problem
+	unsigned long num_invalid_tiles;
+	// The largest / smallest number of the tiles computed by a warp
+	unsigned long max_tiles_per_warp;
+	unsigned long min_tiles_per_warp;
+};
+
+template <unsigned WARP_M, unsigned WARP_N>
+inline tile_assignment_report simulate_tile_assignment(
+		const mtk::wmma::tcec::grouped::problem* const problems,
+		const unsigned num_problems,
+		const unsigned num_blocks,
+		const unsigned num_warps
+		) {
+	tile_assignment_report report;
+	report.num_missing_tiles = 0;
+	report.num_duplicated_tiles = 0;
+	report.num_invalid_tiles = 0;
+	report.max_tiles_per_warp = 0;
+	report.min_tiles_per_warp = ~0lu;
+
+	// The tiles are identified by (problem_id, tile_m, tile_n), not by the tile id used in the scheduler
+	std::vector<unsigned long> offsets(num_problems + 1, 0);
+	for (unsigned i = 0; i < num_problems; i++) {
+		report.num_tiles.push_back(num_tiles<WARP_M, WARP_N>(problems[i]));
+		offsets[i + 1] = offsets[i] + report.num_tiles[i];
+	}
+	std::vector<unsigned> count(offsets[num_problems], 0);
+
+	for (unsigned block_id = 0; block_id < num_blocks; block_id++) {
+		for (unsigned warp_id = 0; warp_id < num_warps; warp_id++) {
+			tile_scheduler<WARP_M, WARP_N> scheduler(block_id, num_blocks, warp_id, num_warps);
+			mtk::wmma::tcec::grouped::tile t;
+			unsigned long num_warp_tiles = 0;
+			while (scheduler.next(problems, num_problems, t)) {
+				num_warp_tiles++;
+				if (t.problem_id >= num_problems || t.tile_m >= problems[t.problem_id].m || t.tile_n >= problems[t.problem_id].n || t.tile_m % WARP_M != 0 || t.tile_n % WARP_N != 0) {
+					report.num_invalid_tiles++;
+					continue;
+				}
+				const auto& p = problems[t.problem_id];
+				auto& c = count[offsets[t.problem_id] + t.tile_m / WARP_M + static_cast<unsigned long>(t.tile_n / WARP_N) * num_tiles_m<WARP_M>(p)];
+				if (c != 0) {
+					report.num_duplicated_tiles++;
+				}
+				c++;
+			}
+			report.max_tiles_per_warp = num_warp_tiles > report.max_tiles_per_warp ? num_warp_tiles : report.max_tiles_per_warp;
+			report.min_tiles_per_warp = num_warp_tiles < report.min_tiles_per_warp ? num_warp_tiles : report.min_tiles_per_warp;
+		}
+	}
+
+	for (const auto c : count) {
+		if (c == 0) {
+			report.num_missing_tiles++;
+		}
+	}
+	if (num_blocks * num_warps == 0) {
+		report.min_tiles_per_warp = 0;
+	}
+
+	return report;
+}
+
+} // namespace grouped
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
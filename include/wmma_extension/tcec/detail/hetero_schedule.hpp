@@ -0,0 +1,162 @@
+#ifndef __WMMAE_TCEC_DETAIL_HETERO_SCHEDULE_HPP__
+#define __WMMAE_TCEC_DETAIL_HETERO_SCHEDULE_HPP__
+#include <vector>
+#include "../../detail/host_device.hpp"
+
+// Static tile schedule of the heterogeneous (Tensor Core + SIMT) GEMM.
+// This header does not depend on CUDA so that the schedule can be simulated on the host.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+
+// Same declarations as detail/policy.hpp
+struct sm_70;
+struct sm_75;
+struct sm_80;
+struct sm_86;
+struct sm_not_specified;
+
+namespace hetero {
+
+// Work ratio
+// In each round, a TC warp computes `TC_TILES` tiles while a SIMT warp computes `SIMT_TILES` tiles.
+template <unsigned TC_TILES, unsigned SIMT_TILES>
+struct ratio {
+	static const unsigned tc   = TC_TILES;
+	static const unsigned simt = SIMT_TILES;
+};
+
+// Default ratio per architecture
+// These values assume the same number of TC and SIMT warps in a block
+// and the FP16 TCEC (three mma per product) on the TC warps.
+// They are not measured. Each one is the ratio of the peak throughputs per SM from the whitepapers, rounded to a small integer:
+//     (FP16 Tensor Core FMA/clk with FP32 accumulation / 3) : (FP32 FMA/clk)
+//   sm_70 (V100)           :  512 / 3 :  64 = 2.7 -> 3 : 1
+//   sm_75 (T4 / GeForce)   :  512 / 3 :  64 = 2.7 (256 / 3 : 64 = 1.3 with the half rate FP32 accumulation of GeForce) -> 2 : 1
+//   sm_80 (A100)           : 1024 / 3 :  64 = 5.3 -> 5 : 1
+//   sm_86 (A6000 / GeForce):  512 / 3 : 128 = 1.3 ( 256 / 3 : 128 = 0.7 on GeForce) -> 1 : 1
+//   others                 : 2 : 1
+// The memory traffic, the split of the operands and the occupancy are ignored, so the ratio of a kernel
+// should be tuned on the device (e.g. with the makespan of simulate_tile_split and measured tile times).
+template <class Sm>
+struct default_ratio {using type = mtk::wmma::tcec::hetero::ratio<2, 1>;};
+template <>
+struct default_ratio<mtk::wmma::tcec::sm_70> {using type = mtk::wmma::tcec::hetero::ratio<3, 1>;};
+template <>
+struct default_ratio<mtk::wmma::tcec::sm_75> {using type = mtk::wmma::tcec::hetero::ratio<2, 1>;};
+template <>
+struct default_ratio<mtk::wmma::tcec::sm_80> {using type = mtk::wmma::tcec::hetero::ratio<5, 1>;};
+template <>
+struct default_ratio<mtk::wmma::tcec::sm_86> {using type = mtk::wmma::tcec::hetero::ratio<1, 1>;};
+
+// Warps [0, NUM_TC_WARPS) of a block are TC warps and the rest are SIMT warps.
+// The tiles are processed in rounds of `tiles_per_round` consecutive tiles.
+// The round `r` is assigned to the block `r % num_blocks`, and in a round
+//   TC warp   `w` computes the tiles [w * Ratio::tc, (w + 1) * Ratio::tc)
+//   SIMT warp `w` computes the tiles [NUM_TC_WARPS * Ratio::tc + (w - NUM_TC_WARPS) * Ratio::simt, ...)
+template <unsigned NUM_TC_WARPS, unsigned NUM_SIMT_WARPS, class Ratio = typename mtk::wmma::tcec::hetero::default_ratio<mtk::wmma::tcec::sm_not_specified>::type>
+struct schedule {
+	static const unsigned num_tc_warps   = NUM_TC_WARPS;
+	static const unsigned num_simt_warps = NUM_SIMT_WARPS;
+	static const unsigned num_warps      = NUM_TC_WARPS + NUM_SIMT_WARPS;
+	static const unsigned tiles_per_round = NUM_TC_WARPS * Ratio::tc + NUM_SIMT_WARPS * Ratio::simt;
+	static_assert(tiles_per_round > 0, "No tile is assigned to any warp");
+
+	WMMAE_HOST_DEVICE static bool is_tc_warp(const unsigned warp_id) {
+		return warp_id < NUM_TC_WARPS;
+	}
+
+	WMMAE_HOST_DEVICE static unsigned num_tiles_per_round(const unsigned warp_id) {
+		return is_tc_warp(warp_id) ? Ratio::tc : Ratio::simt;
+	}
+
+	WMMAE_HOST_DEVICE static unsigned offset_in_round(const unsigned warp_id) {
+		return is_tc_warp(warp_id) ? warp_id * Ratio::tc : NUM_TC_WARPS * Ratio::tc + (warp_id - NUM_TC_WARPS) * Ratio::simt;
+	}
+
+	// The `i`-th tile computed by the warp `warp_id` of the block `block_id`.
+	// The sequence is increasing in `i`, so a warp can stop at the first tile id >= num_tiles.
+	WMMAE_HOST_DEVICE static unsigned long tile_id(const unsigned block_id, const unsigned num_blocks, const unsigned warp_id, const unsigned i) {
+		const auto n = num_tiles_per_round(warp_id);
+		if (n == 0) {
+			return ~0lu;
+		}
+		const auto round = static_cast<unsigned long>(block_id) + static_cast<unsigned long>(i / n) * num_blocks;
+		return round * tiles_per_round + offset_in_round(warp_id) + i % n;
+	}
+
+	// The number of blocks for which every block has at least one round
+	WMMAE_HOST_DEVICE static unsigned num_blocks(const unsigned long num_tiles) {
+		return static_cast<unsigned>((num_tiles + tiles_per_round - 1) / tiles_per_round);
+	}
+};
+
+// Host simulator of the tile split
+struct tile_split_report {
+	// Owner of each tile (-1 if no warp computes the tile)
+	std::vector<int> owner_block;
+	std::vector<int> owner_warp;
+	unsigned num_tc_tiles;
+	unsigned num_simt_tiles;
+	unsigned num_missing_tiles;
+	unsigned num_duplicated_tiles;
+	// Estimated execution time (max over all warps of the sum of the tile costs)
+	double makespan;
+};
+
+// tc_tile_time / simt_tile_time : time for a TC / SIMT warp to compute a tile
+template <class Schedule>
+inline tile_split_report simulate_tile_split(
+		const unsigned num_tiles,
+		const unsigned num_blocks,
+		const double tc_tile_time = 1.,
+		const double simt_tile_time = 1.
+		) {
+	tile_split_report report;
+	report.owner_block = std::vector<int>(num_tiles, -1);
+	report.owner_warp  = std::vector<int>(num_tiles, -1);
+	report.num_tc_tiles = 0;
+	report.num_simt_tiles = 0;
+	report.num_duplicated_tiles = 0;
+	report.makespan = 0.;
+
+	for (unsigned block_id = 0; block_id < num_blocks; block_id++) {
+		for (unsigned warp_id = 0; warp_id < Schedule::num_warps; warp_id++) {
+			const auto tile_time = Schedule::is_tc_warp(warp_id) ? tc_tile_time : simt_tile_time;
+			double warp_time = 0.;
+			for (unsigned i = 0; ; i++) {
+				const auto tile_id = Schedule::tile_id(block_id, num_blocks, warp_id, i);
+				if (tile_id >= num_tiles) {
+					break;
+				}
+				if (report.owner_warp[tile_id] != -1) {
+					report.num_duplicated_tiles++;
+				}
+				report.owner_block[tile_id] = block_id;
+				report.owner_warp[tile_id] = warp_id;
+				if (Schedule::is_tc_warp(warp_id)) {
+					report.num_tc_tiles++;
+				} else {
+					report.num_simt_tiles++;
+				}
+				warp_time += tile_time;
+			}
+			report.makespan = warp_time > report.makespan ? warp_time : report.makespan;
+		}
+	}
+
+	report.num_missing_tiles = 0;
+	for (unsigned i = 0; i < num_tiles; i++) {
+		if (report.owner_warp[i] == -1) {
+			report.num_missing_tiles++;
+		}
+	}
+
+	return report;
+}
+
+} // namespace hetero
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
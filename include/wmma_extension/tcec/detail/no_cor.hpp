@@ -177,8 +177,8 @@ __device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk:
 
 template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
 				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
-__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const MEM_T mul, const bool sync = true) {
-	load_matrix_sync<Layout>(frag, ptr, ldm, mul, sync);
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const MEM_T mul, const bool sync = true) {
+	load_matrix_sync_with_mul<Layout>(frag, ptr, ldm, mul, sync);
 }
 
 // Store matrix
@@ -242,9 +242,174 @@ __device__ void store_matrix_sync_with_mul(MEM_T* const ptr,
 		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>> frag,
 		const unsigned ldm, const MEM_T mul, const nvcuda::wmma::layout_t layout, const bool sync = true) {
 	if (layout == nvcuda::wmma::mem_col_major) {
-		store_matrix_sync<nvcuda::wmma::col_major>(ptr, frag, ldm, mul, sync);
+		store_matrix_sync_with_mul<nvcuda::wmma::col_major>(ptr, frag, ldm, mul, sync);
 	} else {                                                
-		store_matrix_sync<nvcuda::wmma::row_major>(ptr, frag, ldm, mul, sync);
+		store_matrix_sync_with_mul<nvcuda::wmma::row_major>(ptr, frag, ldm, mul, sync);
+	}
+}
+
+// Bounds-checked load/store
+// Only the elements in [0, rows) x [0, cols) of the fragment matrix are accessed.
+// The other elements are filled with zero on load and are not written on store.
+template <class MatrixLayout, int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync(fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<nvcuda::wmma::accumulator, float, void, Policy>{}(std::is_same<MatrixLayout, nvcuda::wmma::col_major>::value ? nvcuda::wmma::mem_col_major : nvcuda::wmma::mem_row_major,
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto v = (i + bm * frag_m < rows && j + bn * frag_n < cols) ? mtk::wmma::detail::common::cast<float>(ptr[mem_offset]) : 0.f;
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[f]] = v;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync(fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		load_matrix_sync<nvcuda::wmma::col_major>(frag, ptr, ldm, rows, cols, sync);
+	} else {
+		load_matrix_sync<nvcuda::wmma::row_major>(frag, ptr, ldm, rows, cols, sync);
+	}
+}
+
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto v = (i + bm * frag_m < rows && j + bn * frag_n < cols) ? mtk::wmma::detail::common::cast<float>(ptr[mem_offset]) : 0.f;
+						const auto hv = mtk::wmma::detail::common::cast<T>(v);
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[f]] = hv;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	load_matrix_sync<Layout>(frag, ptr, ldm, rows, cols, sync);
+}
+
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto v = (i + bm * frag_m < rows && j + bn * frag_n < cols) ? mtk::wmma::detail::common::cast<float>(ptr[mem_offset] * mul) : 0.f;
+						const auto hv = mtk::wmma::detail::common::cast<T>(v);
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[f]] = hv;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const bool sync = true) {
+	load_matrix_sync_with_mul<Layout>(frag, ptr, ldm, rows, cols, mul, sync);
+}
+
+template <class MatrixLayout, int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void store_matrix_sync(MEM_T* const ptr, fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>> frag, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<nvcuda::wmma::accumulator, float, void, Policy>{}(std::is_same<MatrixLayout, nvcuda::wmma::col_major>::value ? nvcuda::wmma::mem_col_major : nvcuda::wmma::mem_row_major,
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						if (i + bm * frag_m < rows && j + bn * frag_n < cols) {
+							const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+							ptr[mem_offset] = frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[0]];
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void store_matrix_sync(MEM_T* const ptr, fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>> frag, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		store_matrix_sync<nvcuda::wmma::col_major>(ptr, frag, ldm, rows, cols, sync);
+	} else {
+		store_matrix_sync<nvcuda::wmma::row_major>(ptr, frag, ldm, rows, cols, sync);
+	}
+}
+
+template <class MatrixLayout, int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void store_matrix_sync_with_mul(MEM_T* const ptr, fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>> frag, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<nvcuda::wmma::accumulator, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<nvcuda::wmma::accumulator, float, void, Policy>{}(std::is_same<MatrixLayout, nvcuda::wmma::col_major>::value ? nvcuda::wmma::mem_col_major : nvcuda::wmma::mem_row_major,
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						if (i + bm * frag_m < rows && j + bn * frag_n < cols) {
+							const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+							ptr[mem_offset] = frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[0]] * mul;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void store_matrix_sync_with_mul(MEM_T* const ptr, fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>> frag, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		store_matrix_sync_with_mul<nvcuda::wmma::col_major>(ptr, frag, ldm, rows, cols, mul, sync);
+	} else {
+		store_matrix_sync_with_mul<nvcuda::wmma::row_major>(ptr, frag, ldm, rows, cols, mul, sync);
 	}
 }
 
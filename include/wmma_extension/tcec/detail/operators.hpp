@@ -0,0 +1,217 @@
+#ifndef __WMMAE_TCEC_DETAIL_OPERATORS_HPP__
+#define __WMMAE_TCEC_DETAIL_OPERATORS_HPP__
+#include "../../operators.hpp"
+#include "common.hpp"
+#include "scale.hpp"
+
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace detail {
+template <class Use, class T, class ErrorCorrection>
+struct fragment_ops;
+
+// Without error correction : the sub fragments are computed by the packed operations
+template <class Use, class T>
+struct fragment_ops<Use, T, mtk::wmma::tcec::without_ec> {
+	template <class Frag_T>
+	__device__ static void add(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		using storage_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+		for (unsigned f = 0; f < Frag_T::num_sub_frag_m * Frag_T::num_sub_frag_n; f++) {
+			mtk::wmma::ops::detail::array_ops<storage_t, Frag_T::sub_frag_t::num_elements>::add(res.sub_frag[f].x, a.sub_frag[f].x, b.sub_frag[f].x);
+		}
+	}
+	template <class Frag_T>
+	__device__ static void sub(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		using storage_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+		for (unsigned f = 0; f < Frag_T::num_sub_frag_m * Frag_T::num_sub_frag_n; f++) {
+			mtk::wmma::ops::detail::array_ops<storage_t, Frag_T::sub_frag_t::num_elements>::sub(res.sub_frag[f].x, a.sub_frag[f].x, b.sub_frag[f].x);
+		}
+	}
+	template <class Frag_T>
+	__device__ static void mul(Frag_T& res, const Frag_T& a, const float alpha) {
+		using storage_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+		const auto s = mtk::wmma::detail::common::cast<storage_t>(alpha);
+		for (unsigned f = 0; f < Frag_T::num_sub_frag_m * Frag_T::num_sub_frag_n; f++) {
+			mtk::wmma::ops::detail::array_ops<storage_t, Frag_T::sub_frag_t::num_elements>::mul(res.sub_frag[f].x, a.sub_frag[f].x, s);
+		}
+	}
+	template <class Frag_T>
+	__device__ static void div(Frag_T& res, const Frag_T& a, const float alpha) {
+		using storage_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+		const auto s = mtk::wmma::detail::common::cast<storage_t>(alpha);
+		for (unsigned f = 0; f < Frag_T::num_sub_frag_m * Frag_T::num_sub_frag_n; f++) {
+			mtk::wmma::ops::detail::array_ops<storage_t, Frag_T::sub_frag_t::num_elements>::div(res.sub_frag[f].x, a.sub_frag[f].x, s);
+		}
+	}
+	template <class Frag_T>
+	__device__ static void fma(Frag_T& res, const float alpha, const Frag_T& a, const Frag_T& b) {
+		using storage_t = typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type;
+		const auto s = mtk::wmma::detail::common::cast<storage_t>(alpha);
+		for (unsigned f = 0; f < Frag_T::num_sub_frag_m * Frag_T::num_sub_frag_n; f++) {
+			mtk::wmma::ops::detail::array_ops<storage_t, Frag_T::sub_frag_t::num_elements>::fma(res.sub_frag[f].x, s, a.sub_frag[f].x, b.sub_frag[f].x);
+		}
+	}
+};
+
+// With error correction (matrix_a / matrix_b) :
+// The results are computed in FP32 from (x + dx) and split into x and dx again as the load functions do.
+template <class Use, class T>
+struct fragment_ops<Use, T, mtk::wmma::tcec::with_ec> {
+	template <class Frag_T>
+	__device__ static float get(const Frag_T& frag, const unsigned i) {
+		return mtk::wmma::detail::common::cast<float>(frag.x(i)) + correction_scale_1<T>(mtk::wmma::detail::common::cast<float>(frag.dx(i)));
+	}
+	template <class Frag_T>
+	__device__ static void set(Frag_T& frag, const unsigned i, const float v) {
+		const auto hv = mtk::wmma::detail::common::cast<T>(v);
+		const auto dhv = mtk::wmma::detail::common::cast<T>(correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(hv)));
+		frag.x(i) = hv;
+		frag.dx(i) = dhv;
+	}
+	template <class Frag_T>
+	__device__ static void add(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) set(res, i, get(a, i) + get(b, i));
+	}
+	template <class Frag_T>
+	__device__ static void sub(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) set(res, i, get(a, i) - get(b, i));
+	}
+	template <class Frag_T>
+	__device__ static void mul(Frag_T& res, const Frag_T& a, const float alpha) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) set(res, i, get(a, i) * alpha);
+	}
+	template <class Frag_T>
+	__device__ static void div(Frag_T& res, const Frag_T& a, const float alpha) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) set(res, i, get(a, i) / alpha);
+	}
+	template <class Frag_T>
+	__device__ static void fma(Frag_T& res, const float alpha, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) set(res, i, __fmaf_rn(alpha, get(a, i), get(b, i)));
+	}
+};
+
+// With error correction (accumulator) :
+// The rounding errors of the FP32 operations on x are accumulated to dx (TwoSum / TwoProd).
+template <class T>
+struct fragment_ops<nvcuda::wmma::accumulator, T, mtk::wmma::tcec::with_ec> {
+	__device__ static float two_sum_error(const float a, const float b, const float s) {
+		const auto bb = s - a;
+		return (a - (s - bb)) + (b - bb);
+	}
+	template <class Frag_T>
+	__device__ static void add(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) {
+			const auto s = a.x(i) + b.x(i);
+			res.dx(i) = a.dx(i) + b.dx(i) + correction_scale_0<T>(two_sum_error(a.x(i), b.x(i), s));
+			res.x(i) = s;
+		}
+	}
+	template <class Frag_T>
+	__device__ static void sub(Frag_T& res, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) {
+			const auto s = a.x(i) - b.x(i);
+			res.dx(i) = a.dx(i) - b.dx(i) + correction_scale_0<T>(two_sum_error(a.x(i), -b.x(i), s));
+			res.x(i) = s;
+		}
+	}
+	template <class Frag_T>
+	__device__ static void mul(Frag_T& res, const Frag_T& a, const float alpha) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) {
+			const auto p = a.x(i) * alpha;
+			res.dx(i) = a.dx(i) * alpha + correction_scale_0<T>(__fmaf_rn(a.x(i), alpha, -p));
+			res.x(i) = p;
+		}
+	}
+	template <class Frag_T>
+	__device__ static void div(Frag_T& res, const Frag_T& a, const float alpha) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) {
+			const auto q = a.x(i) / alpha;
+			// The remainder of the division is exact
+			res.dx(i) = (a.dx(i) + correction_scale_0<T>(__fmaf_rn(-q, alpha, a.x(i)))) / alpha;
+			res.x(i) = q;
+		}
+	}
+	template <class Frag_T>
+	__device__ static void fma(Frag_T& res, const float alpha, const Frag_T& a, const Frag_T& b) {
+		for (unsigned i = 0; i < Frag_T::num_elements; i++) {
+			const auto p = a.x(i) * alpha;
+			const auto p_error = __fmaf_rn(a.x(i), alpha, -p);
+			const auto s = p + b.x(i);
+			res.dx(i) = __fmaf_rn(a.dx(i), alpha, b.dx(i)) + correction_scale_0<T>(p_error + two_sum_error(p, b.x(i), s));
+			res.x(i) = s;
+		}
+	}
+};
+
+// with_ec_skip : the same as with_ec
+template <class Use, class T, bool skip_zero_tile>
+struct fragment_ops<Use, T, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>> : public fragment_ops<Use, T, mtk::wmma::tcec::with_ec> {};
+
+// with_ec_adaptive : the same as with_ec
+template <class Use, class T, bool skip_zero_tile>
+struct fragment_ops<Use, T, mtk::wmma::tcec::with_ec_adaptive_t<skip_zero_tile>> : public fragment_ops<Use, T, mtk::wmma::tcec::with_ec> {};
+} // namespace detail
+
+// ------------------------------
+// Operators
+// ------------------------------
+// The correction terms (dx) of the fragments with error correction are kept compensated.
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> operator+(
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const fragment<Use, m, n, k, T, Layout, Policy>& b) {
+	fragment<Use, m, n, k, T, Layout, Policy> res;
+	detail::fragment_ops<Use, T, typename Policy::error_correction>::add(res, a, b);
+	return res;
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> operator-(
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const fragment<Use, m, n, k, T, Layout, Policy>& b) {
+	fragment<Use, m, n, k, T, Layout, Policy> res;
+	detail::fragment_ops<Use, T, typename Policy::error_correction>::sub(res, a, b);
+	return res;
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> operator*(
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const float alpha) {
+	fragment<Use, m, n, k, T, Layout, Policy> res;
+	detail::fragment_ops<Use, T, typename Policy::error_correction>::mul(res, a, alpha);
+	return res;
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> operator/(
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const float alpha) {
+	fragment<Use, m, n, k, T, Layout, Policy> res;
+	detail::fragment_ops<Use, T, typename Policy::error_correction>::div(res, a, alpha);
+	return res;
+}
+
+// alpha * a + b
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> fma(
+		const float alpha,
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const fragment<Use, m, n, k, T, Layout, Policy>& b) {
+	fragment<Use, m, n, k, T, Layout, Policy> res;
+	detail::fragment_ops<Use, T, typename Policy::error_correction>::fma(res, alpha, a, b);
+	return res;
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ fragment<Use, m, n, k, T, Layout, Policy> fma(
+		const fragment<Use, m, n, k, T, Layout, Policy>& a,
+		const float alpha,
+		const fragment<Use, m, n, k, T, Layout, Policy>& b) {
+	return mtk::wmma::tcec::fma(alpha, a, b);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
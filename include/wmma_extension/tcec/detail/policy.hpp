@@ -15,6 +15,19 @@ struct op_wmma;
 // Error correction policy
 struct with_ec;
 struct without_ec;
+// with_ec which holds only the FP32 source in matrix_a / matrix_b fragments and computes the residual in mma_sync
+struct with_ec_recompute;
+// with_ec which skips the correction mma of the sub fragments whose residuals are all zero at runtime
+// skip_zero_tile : also skips all mma of the operand sub fragments which are all zero (see detail/skip.hpp)
+template <bool skip_zero_tile>
+struct with_ec_skip_t;
+using with_ec_skip = with_ec_skip_t<false>;
+using with_ec_skip_zero_tile = with_ec_skip_t<true>;
+// with_ec which skips the correction mma whose contribution is below a given tolerance at runtime
+template <bool skip_zero_tile>
+struct with_ec_adaptive_t;
+using with_ec_adaptive = with_ec_adaptive_t<false>;
+using with_ec_adaptive_zero_tile = with_ec_adaptive_t<true>;
 // Alias for compatibility
 using op_with_error_correction = with_ec;
 using op_without_error_correction = without_ec;
@@ -0,0 +1,354 @@
+#ifndef __WMMAE_TCEC_DETAIL_RECOMPUTE_HPP__
+#define __WMMAE_TCEC_DETAIL_RECOMPUTE_HPP__
+
+#include <type_traits>
+
+#include "common.hpp"
+#include "policy.hpp"
+#include "functions.hpp"
+#include "scale.hpp"
+
+// Register-light error correction (with_ec_recompute)
+//   - matrix_a / matrix_b : only the FP32 source is held and the hi / residual fragments are computed just before each mma
+//   - accumulator         : the same as with_ec
+// Only TF32 is supported: the FP32 source is half of a TF32 hi / residual pair,
+// while it is as large as an FP16 pair, so FP16 operands would save no register.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk>
+struct fragment <Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>> {
+	static_assert(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value, "with_ec_recompute supports op_mma and op_wmma only");
+	static_assert(std::is_same<T, nvcuda::wmma::precision::tf32>::value, "with_ec_recompute supports tf32 only");
+	using element_type = float;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+	static const int sub_frag_m = Policy::m;
+	static const int sub_frag_n = Policy::n;
+	static const int sub_frag_k = Policy::k;
+
+	// The type of the hi / residual fragments given to the mma instruction
+	using sub_frag_t = typename mtk::wmma::tcec::detail::default_fragment<Use, typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type, Layout, Policy>::type;
+	static constexpr int num_sub_frag_m = mtk::wmma::tcec::detail::select_value<Use, m, k, m>::value / mtk::wmma::tcec::detail::select_value<Use, sub_frag_m, sub_frag_k, sub_frag_m>::value;
+	static constexpr int num_sub_frag_n = mtk::wmma::tcec::detail::select_value<Use, k, n, n>::value / mtk::wmma::tcec::detail::select_value<Use, sub_frag_k, sub_frag_n, sub_frag_n>::value;
+
+	// FP32 source in the element order of sub_frag_t
+	float sub_src[num_sub_frag_m * num_sub_frag_n][sub_frag_t::num_elements];
+
+	static const unsigned num_elements = num_sub_frag_m * num_sub_frag_n * sub_frag_t::num_elements;
+	__device__ float& x(const unsigned index) {
+		const auto frag_index = index % sub_frag_t::num_elements;
+		const auto sub_frag_id = index / sub_frag_t::num_elements;
+		return sub_src[sub_frag_id][frag_index];
+	}
+	// const version
+	__device__ float x(const unsigned index) const {
+		const auto frag_index = index % sub_frag_t::num_elements;
+		const auto sub_frag_id = index / sub_frag_t::num_elements;
+		return sub_src[sub_frag_id][frag_index];
+	}
+	// The scaled residual is computed from the source
+	__device__ typename mtk::wmma::detail::common::storage_t<typename mtk::wmma::tcec::detail::sub_frag_t<Use, T>::type>::type dx(const unsigned index) const {
+		const auto v = x(index);
+		return mtk::wmma::detail::common::cast<T>(mtk::wmma::tcec::detail::correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(mtk::wmma::detail::common::cast<T>(v))));
+	}
+
+	// integrate
+	__device__ void integrate() {}
+};
+
+// The accumulator keeps the correction term in sub_d_frag, so it is the with_ec accumulator.
+// All functions for the with_ec accumulator are available through the base class.
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk>
+struct fragment <nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>
+	: public fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>> {
+	static_assert(std::is_same<T, nvcuda::wmma::precision::tf32>::value, "with_ec_recompute supports tf32 only");
+	using base_t = fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+
+	fragment() = default;
+	__device__ fragment(const base_t& frag) : base_t(frag) {}
+};
+
+namespace detail {
+namespace recompute {
+// Convert the FP32 source of a sub fragment to the hi fragment
+template <class T, class Frag>
+__device__ inline void make_hi(Frag& hi, const float* const src) {
+	for (unsigned i = 0; i < hi.num_elements; i++) {
+		hi.x[i] = mtk::wmma::detail::common::cast<T>(src[i]);
+	}
+}
+
+// Convert the FP32 source of a sub fragment to the scaled residual fragment
+template <class T, class Frag>
+__device__ inline void make_residual(Frag& dhi, const float* const src) {
+	for (unsigned i = 0; i < dhi.num_elements; i++) {
+		const auto v = src[i];
+		dhi.x[i] = mtk::wmma::detail::common::cast<T>(mtk::wmma::tcec::detail::correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(mtk::wmma::detail::common::cast<T>(v))));
+	}
+}
+
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T>
+__device__ inline void load_matrix(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto v = (i + bm * frag_m < rows && j + bn * frag_n < cols) ? mtk::wmma::detail::common::cast<float>(ptr[mem_offset] * mul) : 0.f;
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							frag.sub_src[bm + frag.num_sub_frag_m * bn][frag_index_list[f]] = v;
+						}
+					}
+				}
+			});
+}
+} // namespace recompute
+} // namespace detail
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>> neg(
+		const fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag
+		) {
+	fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>> res;
+	for (unsigned i = 0; i < res.num_elements; i++) {
+		res.x(i) = -frag.x(i);
+	}
+	return res;
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void fill_fragment(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const float v) {
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		frag.x(i) = v;
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void fill_zero(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag) {
+	fill_fragment(frag, 0.f);
+}
+
+// Load matrix
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const bool sync = true) {
+	mtk::wmma::tcec::detail::recompute::load_matrix<MatrixLayout>(frag, ptr, ldm, ~0u, ~0u, static_cast<MEM_T>(1));
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const bool sync = true) {
+	load_matrix_sync<Layout>(frag, ptr, ldm, sync);
+}
+
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const MEM_T mul, const bool sync = true) {
+	mtk::wmma::tcec::detail::recompute::load_matrix<MatrixLayout>(frag, ptr, ldm, ~0u, ~0u, mul);
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const MEM_T mul, const bool sync = true) {
+	load_matrix_sync_with_mul<Layout>(frag, ptr, ldm, mul, sync);
+}
+
+// Bounds-checked load
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	mtk::wmma::tcec::detail::recompute::load_matrix<MatrixLayout>(frag, ptr, ldm, rows, cols, static_cast<MEM_T>(1));
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	load_matrix_sync<Layout>(frag, ptr, ldm, rows, cols, sync);
+}
+
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const bool sync = true) {
+	mtk::wmma::tcec::detail::recompute::load_matrix<MatrixLayout>(frag, ptr, ldm, rows, cols, mul);
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_matrix_sync_with_mul(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const MEM_T mul, const bool sync = true) {
+	load_matrix_sync_with_mul<Layout>(frag, ptr, ldm, rows, cols, mul, sync);
+}
+
+// Load vector
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_vector(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr, const MEM_T mul) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	constexpr auto num_load_blocks = mtk::wmma::tcec::detail::layout_switch<Layout, frag.num_sub_frag_m, frag.num_sub_frag_n>::value;
+	constexpr auto block_ld        = mtk::wmma::tcec::detail::layout_switch<Layout, 1, frag.num_sub_frag_m>::value;
+	constexpr auto vec_per_block   = mtk::wmma::tcec::detail::layout_switch<Layout, frag_m, frag_n>::value;
+
+	mtk::wmma::tcec::detail::foreach_v_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned mem_index) {
+				for (unsigned bn = 0; bn < num_load_blocks; bn++) {
+					const auto v = mtk::wmma::detail::common::cast<float>(ptr[mem_index + bn * vec_per_block] * mul);
+					for (unsigned i = 0; i < frag_index_count; i++) {
+						frag.sub_src[bn * block_ld][frag_index_list[i]] = v;
+					}
+				}
+			});
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, class MEM_T,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_vector(fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag, const MEM_T* const ptr) {
+	load_vector(frag, ptr, static_cast<MEM_T>(1));
+}
+
+// rn
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_c) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+	constexpr unsigned num_m_block = frag_d.num_sub_frag_m;
+	constexpr unsigned num_n_block = frag_d.num_sub_frag_n;
+	constexpr unsigned num_k_block = frag_a.num_sub_frag_n;
+
+	mtk::wmma::tcec::detail::mma_sync_wrapper<T, A_Layout, B_Layout, float, Policy> mma_op;
+	mtk::wmma::tcec::detail::fill_zero_wrapper<nvcuda::wmma::accumulator, float, void, Policy> zero_op;
+
+	for (unsigned bm = 0; bm < num_m_block; bm++) {
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			auto& d_frag   = frag_d.sub_frag  [bm + bn * num_m_block];
+			auto& d_d_frag = frag_d.sub_d_frag[bm + bn * num_m_block];
+			for (unsigned i = 0; i < d_frag.num_elements; i++) {
+				d_frag  .x[i] = frag_c.sub_frag  [bm + bn * num_m_block].x[i];
+				d_d_frag.x[i] = frag_c.sub_d_frag[bm + bn * num_m_block].x[i];
+			}
+			for (unsigned bk = 0; bk < num_k_block; bk++) {
+				const auto a_src = frag_a.sub_src[bm + bk * num_m_block];
+				const auto b_src = frag_b.sub_src[bk + bn * num_k_block];
+				typename std::remove_reference<decltype(frag_a)>::type::sub_frag_t a_frag, da_frag;
+				typename std::remove_reference<decltype(frag_b)>::type::sub_frag_t b_frag, db_frag;
+				typename std::remove_reference<decltype(frag_d)>::type::sub_frag_t tmp;
+
+				mtk::wmma::tcec::detail::recompute::make_hi<T>(a_frag, a_src);
+				mtk::wmma::tcec::detail::recompute::make_hi<T>(b_frag, b_src);
+				zero_op(tmp);
+				mma_op(tmp, a_frag, b_frag, tmp);
+				for (unsigned i = 0; i < tmp.num_elements; i++) {
+					d_frag.x[i] += tmp.x[i];
+				}
+				mtk::wmma::tcec::detail::recompute::make_residual<T>(da_frag, a_src);
+				mma_op(d_d_frag, da_frag, b_frag, d_d_frag);
+				mtk::wmma::tcec::detail::recompute::make_residual<T>(db_frag, b_src);
+				mma_op(d_d_frag, a_frag, db_frag, d_d_frag);
+			}
+		}
+	}
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mma_rn_sync(frag_d, frag_a, frag_b, frag_d);
+}
+
+// rz
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_c) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>;
+	constexpr unsigned num_m_block = frag_d.num_sub_frag_m;
+	constexpr unsigned num_n_block = frag_d.num_sub_frag_n;
+	constexpr unsigned num_k_block = frag_a.num_sub_frag_n;
+
+	mtk::wmma::tcec::detail::mma_sync_wrapper<T, A_Layout, B_Layout, float, Policy> mma_op;
+
+	for (unsigned bm = 0; bm < num_m_block; bm++) {
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			auto& d_frag   = frag_d.sub_frag  [bm + bn * num_m_block];
+			auto& d_d_frag = frag_d.sub_d_frag[bm + bn * num_m_block];
+			for (unsigned i = 0; i < d_frag.num_elements; i++) {
+				d_frag  .x[i] = frag_c.sub_frag  [bm + bn * num_m_block].x[i];
+				d_d_frag.x[i] = frag_c.sub_d_frag[bm + bn * num_m_block].x[i];
+			}
+			for (unsigned bk = 0; bk < num_k_block; bk++) {
+				const auto a_src = frag_a.sub_src[bm + bk * num_m_block];
+				const auto b_src = frag_b.sub_src[bk + bn * num_k_block];
+				typename std::remove_reference<decltype(frag_a)>::type::sub_frag_t a_frag, da_frag;
+				typename std::remove_reference<decltype(frag_b)>::type::sub_frag_t b_frag, db_frag;
+
+				mtk::wmma::tcec::detail::recompute::make_hi<T>(a_frag, a_src);
+				mtk::wmma::tcec::detail::recompute::make_hi<T>(b_frag, b_src);
+				mma_op(d_frag, a_frag, b_frag, d_frag);
+				mtk::wmma::tcec::detail::recompute::make_residual<T>(da_frag, a_src);
+				mma_op(d_d_frag, da_frag, b_frag, d_d_frag);
+				mtk::wmma::tcec::detail::recompute::make_residual<T>(db_frag, b_src);
+				mma_op(d_d_frag, a_frag, db_frag, d_d_frag);
+			}
+		}
+	}
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mma_rz_sync(frag_d, frag_a, frag_b, frag_d);
+}
+
+// mma
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_c) {
+	mma_rn_sync(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_recompute, fm, fn, fk>>& frag_b) {
+	mma_rn_sync(frag_d, frag_a, frag_b);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
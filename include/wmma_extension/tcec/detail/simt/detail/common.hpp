@@ -47,6 +47,14 @@ template <class Layout, int col_value, int row_value> struct layout_switch;
 template <int col_value, int row_value> struct layout_switch<nvcuda::wmma::col_major, col_value, row_value> {static const int value = col_value;};
 template <int col_value, int row_value> struct layout_switch<nvcuda::wmma::row_major, col_value, row_value> {static const int value = row_value;};
 
+// memory offset of the matrix position (i, j)
+template <class Layout> __device__ inline unsigned get_mem_offset(const unsigned i, const unsigned j, const unsigned ldm);
+template <> __device__ inline unsigned get_mem_offset<nvcuda::wmma::col_major>(const unsigned i, const unsigned j, const unsigned ldm) {return i + j * ldm;}
+template <> __device__ inline unsigned get_mem_offset<nvcuda::wmma::row_major>(const unsigned i, const unsigned j, const unsigned ldm) {return i * ldm + j;}
+__device__ inline unsigned get_mem_offset(const unsigned i, const unsigned j, const unsigned ldm, const nvcuda::wmma::layout_t layout) {
+	return (layout == nvcuda::wmma::mem_col_major) ? get_mem_offset<nvcuda::wmma::col_major>(i, j, ldm) : get_mem_offset<nvcuda::wmma::row_major>(i, j, ldm);
+}
+
 template <class T>
 struct storage_t {using type = T;};
 template <class DST, class SRC> inline __device__ __host__ typename storage_t<DST>::type cast(const SRC v) {return static_cast<DST>(v);}
@@ -0,0 +1,221 @@
+#ifndef __WMMAE_SIMT_DETAIL_M16N8K8__
+#define __WMMAE_SIMT_DETAIL_M16N8K8__
+#include <mma.h>
+#include "common.hpp"
+#include "fma.hpp"
+#include "../../../../detail/common.hpp"
+
+// The element layouts of these fragments are the same as mtk::wmma::mma::fragment<*, 16, 8, 8, T, *>.
+// float fragments follow the tf32 layout and the others follow the half layout.
+// https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#warp-level-matrix-fragment-mma-1688
+namespace mtk {
+namespace wmma {
+namespace mma_simt {
+template <class T>
+class fragment<nvcuda::wmma::matrix_a   , 16, 8, 8, T, nvcuda::wmma::row_major> : public mtk::wmma::mma_simt::detail::__frag_base<T, 4>{};
+template <class T>
+class fragment<nvcuda::wmma::matrix_b   , 16, 8, 8, T, nvcuda::wmma::col_major> : public mtk::wmma::mma_simt::detail::__frag_base<T, 2>{};
+template <class T>
+class fragment<nvcuda::wmma::accumulator, 16, 8, 8, T> : public mtk::wmma::mma_simt::detail::__frag_base<T, 4>{};
+
+namespace detail {
+template <class T>
+struct m16n8k8_tf32_layout {static const bool value = false;};
+template <>
+struct m16n8k8_tf32_layout<float> {static const bool value = true;};
+} // namespace detail
+
+// foreach
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_a, 16, 8, 8, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned row_block_id = mtk::wmma::detail::common::get_lane_id() / 4;
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		const unsigned col = mtk::wmma::detail::common::get_lane_id() % 4;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (row_block_id + 0) * 8 + (col + 0));}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (row_block_id + 8) * 8 + (col + 0));}
+		{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, (row_block_id + 0) * 8 + (col + 4));}
+		{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, (row_block_id + 8) * 8 + (col + 4));}
+	} else {
+		const unsigned col = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+		for (unsigned i = 0; i < 2; i++) {
+			const auto row = row_block_id + i * 8;
+			{const unsigned frag_index_list[1] = {(i * 2 + 0)};func(frag_index_list, 1, row * 8 + (col + 0));}
+			{const unsigned frag_index_list[1] = {(i * 2 + 1)};func(frag_index_list, 1, row * 8 + (col + 1));}
+		}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_b, 16, 8, 8, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	const unsigned col = mtk::wmma::detail::common::get_lane_id() / 4;
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		const unsigned row_start = mtk::wmma::detail::common::get_lane_id() % 4;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (row_start + 0) + col * 8);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (row_start + 4) + col * 8);}
+	} else {
+		const unsigned row = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (row + 0) + col * 8);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (row + 1) + col * 8);}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::accumulator, 16, 8, 8, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+	const unsigned col = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+	const unsigned row_block_id = mtk::wmma::detail::common::get_lane_id() / 4;
+
+	for (unsigned i = 0; i < 2; i++) {
+		const auto row = row_block_id + i * 8;
+		if (layout == nvcuda::wmma::mem_col_major) {
+			{const unsigned frag_index_list[1] = {(i * 2 + 0)};func(frag_index_list, 1, row + (col + 0) * 16);}
+			{const unsigned frag_index_list[1] = {(i * 2 + 1)};func(frag_index_list, 1, row + (col + 1) * 16);}
+		} else {
+			{const unsigned frag_index_list[1] = {(i * 2 + 0)};func(frag_index_list, 1, row * 8 + (col + 0));}
+			{const unsigned frag_index_list[1] = {(i * 2 + 1)};func(frag_index_list, 1, row * 8 + (col + 1));}
+		}
+	}
+}
+
+// foreach_ij
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_a, 16, 8, 8, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned row_block_id = mtk::wmma::detail::common::get_lane_id() / 4;
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		const unsigned col = mtk::wmma::detail::common::get_lane_id() % 4;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (row_block_id + 0), (col + 0));}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (row_block_id + 8), (col + 0));}
+		{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, (row_block_id + 0), (col + 4));}
+		{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, (row_block_id + 8), (col + 4));}
+	} else {
+		const unsigned col = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+		for (unsigned i = 0; i < 2; i++) {
+			const auto row = row_block_id + i * 8;
+			{const unsigned frag_index_list[1] = {(i * 2 + 0)};func(frag_index_list, 1, row, col + 0);}
+			{const unsigned frag_index_list[1] = {(i * 2 + 1)};func(frag_index_list, 1, row, col + 1);}
+		}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_b, 16, 8, 8, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	const unsigned col = mtk::wmma::detail::common::get_lane_id() / 4;
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		const unsigned row_start = mtk::wmma::detail::common::get_lane_id() % 4;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (row_start + 0), col);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (row_start + 4), col);}
+	} else {
+		const unsigned row = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, row + 0, col);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, row + 1, col);}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::accumulator, 16, 8, 8, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+	const unsigned col = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+	const unsigned row_block_id = mtk::wmma::detail::common::get_lane_id() / 4;
+
+	for (unsigned i = 0; i < 2; i++) {
+		const auto row = row_block_id + i * 8;
+		{const unsigned frag_index_list[1] = {(i * 2 + 0)};func(frag_index_list, 1, row, col + 0);}
+		{const unsigned frag_index_list[1] = {(i * 2 + 1)};func(frag_index_list, 1, row, col + 1);}
+	}
+}
+
+// foreach_v
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_a, 16, 8, 8, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	if (mtk::wmma::detail::common::get_lane_id() >= 4)
+		return;
+
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() + 0);}
+		{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() + 4);}
+	} else {
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 0);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 1);}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_b, 16, 8, 8, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	if (mtk::wmma::detail::common::get_lane_id() >= 4)
+		return;
+
+	if (detail::m16n8k8_tf32_layout<T>::value) {
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() + 0);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() + 4);}
+	} else {
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 0);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 1);}
+	}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::accumulator, 16, 8, 8, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		if (mtk::wmma::detail::common::get_lane_id() & 0b11)
+			return;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() / 4 + 0);}
+		{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() / 4 + 8);}
+	} else {
+		if (mtk::wmma::detail::common::get_lane_id() >= 4)
+			return;
+		{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 0);}
+		{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mtk::wmma::detail::common::get_lane_id() * 2 + 1);}
+	}
+}
+
+// mma
+// Each thread computes its own accumulator elements (rows `row_block_id + {0, 8}`, cols `col + {0, 1}`).
+// The elements of A and B are fetched from the owner threads by warp shuffles.
+template <class AB_T, class C_T, class D_T>
+__device__ inline void mma_sync(
+		fragment<nvcuda::wmma::accumulator, 16, 8, 8, D_T , void>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a   , 16, 8, 8, AB_T, nvcuda::wmma::row_major>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b   , 16, 8, 8, AB_T, nvcuda::wmma::col_major>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, 16, 8, 8, C_T , void>& frag_c,
+		const mtk::wmma::mma_simt::detail::fma<AB_T, AB_T, C_T>& mfma = mtk::wmma::mma_simt::detail::fma<AB_T, AB_T, C_T>()
+		) {
+	const unsigned row_block_id = mtk::wmma::detail::common::get_lane_id() / 4;
+	const unsigned col = (mtk::wmma::detail::common::get_lane_id() % 4) * 2;
+	constexpr bool tf32_layout = detail::m16n8k8_tf32_layout<AB_T>::value;
+
+	C_T array_acc[frag_c.num_elements];
+	for (unsigned i = 0; i < frag_c.num_elements; i++) {
+		array_acc[i] = detail::cast<C_T>(0);
+	}
+
+	for (unsigned k = 0; k < 8; k++) {
+		// tf32 layout
+		//   A(row, k) : lane = (row % 8) * 4 + k % 4, index = (row / 8) + (k / 4) * 2
+		//   B(k, col) : lane = col * 4 + k % 4      , index = k / 4
+		// half layout
+		//   A(row, k) : lane = (row % 8) * 4 + k / 2, index = (row / 8) * 2 + k % 2
+		//   B(k, col) : lane = col * 4 + k / 2      , index = k % 2
+		const unsigned k_lane = tf32_layout ? (k % 4) : (k / 2);
+		AB_T a[2], b[2];
+		for (unsigned i = 0; i < 2; i++) {
+			const unsigned a_index = tf32_layout ? (i + (k / 4) * 2) : (i * 2 + k % 2);
+			a[i] = __shfl_sync(0xffffffff, frag_a.x[a_index], row_block_id * 4 + k_lane);
+		}
+		const unsigned b_index = tf32_layout ? (k / 4) : (k % 2);
+		for (unsigned j = 0; j < 2; j++) {
+			b[j] = __shfl_sync(0xffffffff, frag_b.x[b_index], (col + j) * 4 + k_lane);
+		}
+		for (unsigned i = 0; i < 2; i++) {
+			for (unsigned j = 0; j < 2; j++) {
+				array_acc[i * 2 + j] = mfma(a[i], b[j], array_acc[i * 2 + j]);
+			}
+		}
+	}
+
+	for (unsigned i = 0; i < frag_d.num_elements; i++) {
+		frag_d.x[i] = detail::cast<D_T>(array_acc[i] + frag_c.x[i]);
+	}
+}
+
+} // namespace mma_simt
+} // namespace wmma
+} // namespace mtk
+#endif
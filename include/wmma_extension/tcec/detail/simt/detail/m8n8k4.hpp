@@ -0,0 +1,319 @@
+#ifndef __WMMAE_SIMT_DETAIL_M8N8K4__
+#define __WMMAE_SIMT_DETAIL_M8N8K4__
+#include <mma.h>
+#include "common.hpp"
+#include "fma.hpp"
+#include "../../../../detail/common.hpp"
+
+// The element layouts of these fragments are the same as mtk::wmma::mma::fragment<*, 8, 8, 4, half, *>.
+// half accumulators follow the f16 accumulator layout and the others follow the f32 one.
+// As with the tensor core version, the four quad pairs hold the same matrices.
+// https://docs.nvidia.com/cuda/parallel-thread-execution/index.html#warp-level-matrix-fragment-mma-884-f16
+namespace mtk {
+namespace wmma {
+namespace mma_simt {
+template <class T, class Layout>
+class fragment<nvcuda::wmma::matrix_a   , 8, 8, 4, T, Layout> : public mtk::wmma::mma_simt::detail::__frag_base<T, 4>{};
+template <class T, class Layout>
+class fragment<nvcuda::wmma::matrix_b   , 8, 8, 4, T, Layout> : public mtk::wmma::mma_simt::detail::__frag_base<T, 4>{};
+template <class T>
+class fragment<nvcuda::wmma::accumulator, 8, 8, 4, T> : public mtk::wmma::mma_simt::detail::__frag_base<T, 8>{};
+
+namespace detail {
+template <class T>
+struct m8n8k4_half_acc_layout {static const bool value = false;};
+template <>
+struct m8n8k4_half_acc_layout<half> {static const bool value = true;};
+
+// (row, col) of the i-th accumulator element
+template <class T>
+__device__ inline void m8n8k4_acc_ij(const unsigned i, unsigned& row, unsigned& col) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (m8n8k4_half_acc_layout<T>::value) {
+		row = (lane_id & 0x3) + ((lane_id & 0x10) >> 2);
+		col = i;
+	} else {
+		row = (lane_id & 0x1) + ((lane_id & 0x10) >> 2) + (i & 0x2);
+		col = (lane_id & 0x2) + ((i & 0x1) + (i & 0x4));
+	}
+}
+
+// Fetch `frag.x[index]` of `src_lane` when `index` is not uniform in the warp
+template <class T, int size>
+__device__ inline T shfl_frag_element(const __frag_base<T, size>& frag, const unsigned index, const unsigned src_lane) {
+	T v = frag.x[0];
+	for (unsigned i = 0; i < size; i++) {
+		const T t = __shfl_sync(0xffffffff, frag.x[i], src_lane);
+		if (i == index) {
+			v = t;
+		}
+	}
+	return v;
+}
+
+// A(row, k) / B(k, col) fetched from the owner thread in the same quad pair
+template <class T>
+__device__ inline T m8n8k4_load_a(const fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const unsigned row, const unsigned k) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	return __shfl_sync(0xffffffff, frag.x[k], (row & 0x3) + ((row >> 2) << 4) + (lane_id & 0xc));
+}
+
+template <class T>
+__device__ inline T m8n8k4_load_a(const fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const unsigned row, const unsigned k) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	return shfl_frag_element(frag, row & 0x3, k + ((row >> 2) << 4) + (lane_id & 0xc));
+}
+
+template <class T>
+__device__ inline T m8n8k4_load_b(const fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const unsigned k, const unsigned col) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	return __shfl_sync(0xffffffff, frag.x[k], (col & 0x3) + ((col >> 2) << 4) + (lane_id & 0xc));
+}
+
+template <class T>
+__device__ inline T m8n8k4_load_b(const fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const unsigned k, const unsigned col) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	return shfl_frag_element(frag, col & 0x3, k + ((col >> 2) << 4) + (lane_id & 0xc));
+}
+} // namespace detail
+
+// foreach
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	constexpr unsigned ldm = 8;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned col = lane_id & 0x3;
+	const unsigned row_offset = ((lane_id >> 4) << 2);
+	const unsigned mem_offset = col * ldm + row_offset;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	constexpr unsigned ldm = 4;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned row = (lane_id & 0x3) + ((lane_id >> 4) << 2);
+	const unsigned mem_offset = row * ldm;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	constexpr unsigned ldm = 4;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned col = (lane_id & 0x3) + ((lane_id >> 4) << 2);
+	const unsigned mem_offset = col * ldm;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	constexpr unsigned ldm = 8;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned row = lane_id & 0x3;
+	const unsigned col_offset = ((lane_id >> 4) << 2);
+	const unsigned mem_offset = row * ldm + col_offset;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach(fragment<nvcuda::wmma::accumulator, 8, 8, 4, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+	constexpr unsigned ldm = 8;
+#pragma unroll
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		unsigned row, col;
+		detail::m8n8k4_acc_ij<T>(i, row, col);
+		if (layout == nvcuda::wmma::mem_col_major) {
+			{const unsigned frag_index_list[1] = {i};func(frag_index_list, 1, row + col * ldm);}
+		} else {
+			{const unsigned frag_index_list[1] = {i};func(frag_index_list, 1, row * ldm + col);}
+		}
+	}
+}
+
+// foreach_ij
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned col = lane_id & 0x3;
+	const unsigned row_offset = ((lane_id >> 4) << 2);
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, row_offset + 0, col);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, row_offset + 1, col);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, row_offset + 2, col);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, row_offset + 3, col);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned row = (lane_id & 0x3) + ((lane_id >> 4) << 2);
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, row, 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, row, 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, row, 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, row, 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned col = (lane_id & 0x3) + ((lane_id >> 4) << 2);
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, 0, col);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, 1, col);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, 2, col);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, 3, col);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	const unsigned row = lane_id & 0x3;
+	const unsigned col_offset = ((lane_id >> 4) << 2);
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, row, col_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, row, col_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, row, col_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, row, col_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_ij(fragment<nvcuda::wmma::accumulator, 8, 8, 4, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+#pragma unroll
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		unsigned row, col;
+		detail::m8n8k4_acc_ij<T>(i, row, col);
+		{const unsigned frag_index_list[1] = {i};func(frag_index_list, 1, row, col);}
+	}
+}
+
+// foreach_v
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	constexpr unsigned ldm = 16;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (lane_id % 4) return;
+	const unsigned col = lane_id & 0x3;
+	const unsigned row_offset = ((lane_id >> 4) << 2);
+	const unsigned mem_offset = col * ldm + row_offset;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_a, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (lane_id & 0b10010) return;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, ((lane_id & 0x1) << 2) + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, ((lane_id & 0x1) << 2) + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, ((lane_id & 0x1) << 2) + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, ((lane_id & 0x1) << 2) + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::col_major>& frag, const Func func) {
+	constexpr unsigned ldm = 16;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (lane_id & 0b10011) return;
+	const unsigned col = (lane_id & 0x3) + ((lane_id >> 4) << 2);
+	const unsigned mem_offset = col * ldm;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, mem_offset + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, mem_offset + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, mem_offset + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, mem_offset + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::matrix_b, 8, 8, 4, T, nvcuda::wmma::row_major>& frag, const Func func) {
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (lane_id & 0b11) return;
+
+	{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, ((lane_id >> 4) << 2) + 0);}
+	{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, ((lane_id >> 4) << 2) + 1);}
+	{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, ((lane_id >> 4) << 2) + 2);}
+	{const unsigned frag_index_list[1] = {3};func(frag_index_list, 1, ((lane_id >> 4) << 2) + 3);}
+}
+
+template <class Func, class T>
+__device__ inline void foreach_v(fragment<nvcuda::wmma::accumulator, 8, 8, 4, T>& frag, const nvcuda::wmma::layout_t layout, const Func func) {
+	constexpr unsigned ldm = 8;
+	const unsigned lane_id = mtk::wmma::detail::common::get_lane_id();
+	if (detail::m8n8k4_half_acc_layout<T>::value) {
+		const unsigned row = (lane_id & 0x3) + ((lane_id & 0x10) >> 2);
+		if (layout == nvcuda::wmma::mem_col_major) {
+			{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, row);}
+		} else {
+			if (lane_id & 0b10011) return;
+			const unsigned index_offset = row * ldm;
+#pragma unroll
+			for (unsigned i = 0; i < 8; i++)
+				{const unsigned frag_index_list[1] = {i};func(frag_index_list, 1, index_offset + i);}
+		}
+	} else {
+		if (layout == nvcuda::wmma::mem_col_major) {
+			if (lane_id & 0b10) return;
+			{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, ((lane_id >> 4) << 2) + (lane_id & 0x1) + 0);}
+			{const unsigned frag_index_list[1] = {2};func(frag_index_list, 1, ((lane_id >> 4) << 2) + (lane_id & 0x1) + 2);}
+		} else {
+			if (lane_id & 0b10001) return;
+			{const unsigned frag_index_list[1] = {0};func(frag_index_list, 1, (lane_id & 0x2) + 0);}
+			{const unsigned frag_index_list[1] = {1};func(frag_index_list, 1, (lane_id & 0x2) + 1);}
+			{const unsigned frag_index_list[1] = {4};func(frag_index_list, 1, (lane_id & 0x2) + 4);}
+			{const unsigned frag_index_list[1] = {5};func(frag_index_list, 1, (lane_id & 0x2) + 5);}
+		}
+	}
+}
+
+// mma
+// Each thread computes its own accumulator elements.
+// The elements of A and B are fetched from the owner threads in the same quad pair by warp shuffles.
+template <class AB_T, class A_Layout, class B_Layout, class C_T, class D_T>
+__device__ inline void mma_sync(
+		fragment<nvcuda::wmma::accumulator, 8, 8, 4, D_T , void>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a   , 8, 8, 4, AB_T, A_Layout>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b   , 8, 8, 4, AB_T, B_Layout>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, 8, 8, 4, C_T , void>& frag_c,
+		const mtk::wmma::mma_simt::detail::fma<AB_T, AB_T, C_T>& mfma = mtk::wmma::mma_simt::detail::fma<AB_T, AB_T, C_T>()
+		) {
+	static_assert(detail::m8n8k4_half_acc_layout<C_T>::value == detail::m8n8k4_half_acc_layout<D_T>::value, "The accumulator layouts of C and D must be the same");
+
+	for (unsigned i = 0; i < frag_d.num_elements; i++) {
+		unsigned row, col;
+		detail::m8n8k4_acc_ij<D_T>(i, row, col);
+
+		C_T acc = detail::cast<C_T>(0);
+		for (unsigned k = 0; k < 4; k++) {
+			const AB_T a = detail::m8n8k4_load_a(frag_a, row, k);
+			const AB_T b = detail::m8n8k4_load_b(frag_b, k, col);
+			acc = mfma(a, b, acc);
+		}
+		frag_d.x[i] = detail::cast<D_T>(acc + frag_c.x[i]);
+	}
+}
+
+} // namespace mma_simt
+} // namespace wmma
+} // namespace mtk
+#endif
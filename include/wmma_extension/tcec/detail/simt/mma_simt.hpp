@@ -2,6 +2,9 @@
 #define __WMMAE_MMA_SIMT__
 #include <type_traits>
 #include "detail/m16n16k16.hpp"
+#include "detail/m16n8k16.hpp"
+#include "detail/m16n8k8.hpp"
+#include "detail/m8n8k4.hpp"
 
 namespace mtk {
 namespace wmma {
@@ -99,6 +102,51 @@ __device__ inline void store_matrix_sync(T* const ptr, const mtk::wmma::mma_simt
 		__syncwarp();
 }
 
+// ------------------------------
+// Bounds-checked LD/ST functions for mma fragments
+// ------------------------------
+// Only the elements in [0, rows) x [0, cols) of the fragment matrix are accessed.
+// The other elements are filled with zero on load and are not written on store.
+template <class Use, int M, int N, int K, class FT, class Layout, class T>
+__device__ inline void load_matrix_sync(mtk::wmma::mma_simt::fragment<Use, M, N, K, FT, Layout>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	mtk::wmma::mma_simt::foreach_ij<decltype(frag)>(
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::mma_simt::detail::cast<typename mtk::wmma::mma_simt::detail::storage_t<FT>::type>(ptr[mtk::wmma::mma_simt::detail::get_mem_offset<Layout>(i, j, ldm)])
+				: mtk::wmma::mma_simt::detail::cast<typename mtk::wmma::mma_simt::detail::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++) {
+				frag.x[frag_index_list[f]] = v;
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void load_matrix_sync(mtk::wmma::mma_simt::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	mtk::wmma::mma_simt::foreach_ij<decltype(frag)>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::mma_simt::detail::cast<typename mtk::wmma::mma_simt::detail::storage_t<FT>::type>(ptr[mtk::wmma::mma_simt::detail::get_mem_offset(i, j, ldm, layout)])
+				: mtk::wmma::mma_simt::detail::cast<typename mtk::wmma::mma_simt::detail::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++) {
+				frag.x[frag_index_list[f]] = v;
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void store_matrix_sync(T* const ptr, const mtk::wmma::mma_simt::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	mtk::wmma::mma_simt::foreach_ij<decltype(frag)>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			if (i < rows && j < cols) {
+				ptr[mtk::wmma::mma_simt::detail::get_mem_offset(i, j, ldm, layout)] = mtk::wmma::mma_simt::detail::cast<typename mtk::wmma::mma_simt::detail::storage_t<T>::type>(frag.x[frag_index_list[0]]);
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
 // ------------------------------
 // LD/ST vector functions for mma fragments
 // ------------------------------
@@ -0,0 +1,254 @@
+#ifndef __WMMAE_TCEC_DETAIL_SKIP_HPP__
+#define __WMMAE_TCEC_DETAIL_SKIP_HPP__
+
+#include <type_traits>
+
+#include "common.hpp"
+#include "policy.hpp"
+#include "functions.hpp"
+
+// Error correction with the runtime skip of the mma (with_ec_skip)
+//   - matrix_a / matrix_b : the same as with_ec
+//   - accumulator         : with_ec + the counters of the skipped mma (detail::skip::mma_counters)
+// mma_sync checks whether the residual (sub_d_frag) of each operand sub fragment is all zero by a warp vote,
+// and skips the correction mma with it (e.g. small integers, sparse or quantized matrices).
+// The correction mma is not skipped when the other operand sub fragment has inf or nan, since the product of zero and them is nan in with_ec.
+// with_ec_skip_zero_tile (with_ec_skip_t<true>) also skips all mma with an operand sub fragment which is all zero
+// (sub_frag and sub_d_frag, e.g. activations after ReLU) when the other operand sub fragment is finite.
+// It costs another warp vote per operand sub fragment, so it is opt-in. with_ec_adaptive_zero_tile is the counterpart of with_ec_adaptive.
+// The check is done on the registers in mma_sync, so any function which modifies the fragments can be used before it.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace detail {
+namespace skip {
+// The counters of the accumulators of with_ec_skip and with_ec_adaptive
+// They are accumulated by every mma function which writes to the fragment (frag_d = frag_c + ...)
+struct mma_counters {
+	// The number of the correction mma (issued + skipped) and the skipped ones. These are warp-uniform.
+	unsigned num_correction_mma = 0;
+	unsigned num_skipped_mma = 0;
+	// The number of the products of the sub fragments (issued + skipped) and the ones skipped since an operand sub fragment is all zero
+	// (always 0 unless skip_zero_tile).
+	unsigned num_tile_mma = 0;
+	unsigned num_skipped_tile_mma = 0;
+};
+} // namespace skip
+} // namespace detail
+
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+struct fragment <Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>
+	: public fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>> {
+	static_assert(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value, "with_ec_skip supports op_mma and op_wmma only");
+	using base_t = fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>;
+
+	fragment() = default;
+	__device__ fragment(const base_t& frag) : base_t(frag) {}
+};
+
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+struct fragment <nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>
+	: public fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>,
+	  public mtk::wmma::tcec::detail::skip::mma_counters {
+	static_assert(std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value, "with_ec_skip supports op_mma and op_wmma only");
+	using base_t = fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>;
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>;
+
+	fragment() = default;
+	__device__ fragment(const base_t& frag) : base_t(frag) {}
+};
+
+namespace detail {
+namespace skip {
+// Returns true if all elements of the sub fragment are zero in the warp
+template <class Frag>
+__device__ inline bool is_zero(const Frag& sub_frag) {
+	bool zero = true;
+	for (unsigned i = 0; i < sub_frag.num_elements; i++) {
+		zero = zero && (mtk::wmma::detail::common::cast<float>(sub_frag.x[i]) == 0.f);
+	}
+	return __all_sync(0xffffffff, zero);
+}
+
+// Returns true if all elements of the sub fragment and its residual are finite in the warp
+template <class Frag, class D_Frag>
+__device__ inline bool is_finite(const Frag& sub_frag, const D_Frag& sub_d_frag) {
+	bool finite = true;
+	for (unsigned i = 0; i < sub_frag.num_elements; i++) {
+		finite = finite && isfinite(mtk::wmma::detail::common::cast<float>(sub_frag.x[i])) && isfinite(mtk::wmma::detail::common::cast<float>(sub_d_frag.x[i]));
+	}
+	return __all_sync(0xffffffff, finite);
+}
+
+// Whether all mma of the all-zero operand sub fragments are skipped
+template <class ErrorCorrection>
+struct skip_zero_tile {static const bool value = false;};
+template <bool zero_tile>
+struct skip_zero_tile<mtk::wmma::tcec::with_ec_skip_t<zero_tile>> {static const bool value = zero_tile;};
+template <bool zero_tile>
+struct skip_zero_tile<mtk::wmma::tcec::with_ec_adaptive_t<zero_tile>> {static const bool value = zero_tile;};
+
+// Correction selector of with_ec_skip : skips the correction mma with the sub fragments whose residuals are all zero
+// when the other operand sub fragment is finite
+// zero_tile : also skips all mma with the all-zero sub fragments in the same way
+template <bool zero_tile, class Frag_A, class Frag_B>
+struct zero_residual_selector {
+	bool a_zero[Frag_A::num_sub_frag_m * Frag_A::num_sub_frag_n];
+	bool b_zero[Frag_B::num_sub_frag_m * Frag_B::num_sub_frag_n];
+	bool a_finite[Frag_A::num_sub_frag_m * Frag_A::num_sub_frag_n];
+	bool b_finite[Frag_B::num_sub_frag_m * Frag_B::num_sub_frag_n];
+	bool a_zero_tile[Frag_A::num_sub_frag_m * Frag_A::num_sub_frag_n];
+	bool b_zero_tile[Frag_B::num_sub_frag_m * Frag_B::num_sub_frag_n];
+
+	__device__ zero_residual_selector(const Frag_A& frag_a, const Frag_B& frag_b) {
+		for (unsigned i = 0; i < Frag_A::num_sub_frag_m * Frag_A::num_sub_frag_n; i++) {
+			a_zero[i] = is_zero(frag_a.sub_d_frag[i]);
+			a_finite[i] = is_finite(frag_a.sub_frag[i], frag_a.sub_d_frag[i]);
+			a_zero_tile[i] = zero_tile && a_zero[i] && is_zero(frag_a.sub_frag[i]);
+		}
+		for (unsigned i = 0; i < Frag_B::num_sub_frag_m * Frag_B::num_sub_frag_n; i++) {
+			b_zero[i] = is_zero(frag_b.sub_d_frag[i]);
+			b_finite[i] = is_finite(frag_b.sub_frag[i], frag_b.sub_d_frag[i]);
+			b_zero_tile[i] = zero_tile && b_zero[i] && is_zero(frag_b.sub_frag[i]);
+		}
+	}
+
+	// All mma
+	__device__ bool skip_tile(const unsigned a_index, const unsigned b_index) const {
+		return zero_tile && ((a_zero_tile[a_index] && b_finite[b_index]) || (b_zero_tile[b_index] && a_finite[a_index]));
+	}
+	// A.dx * B.x
+	__device__ bool skip_a(const unsigned a_index, const unsigned b_index) const {return a_zero[a_index] && b_finite[b_index];}
+	// A.x * B.dx
+	__device__ bool skip_b(const unsigned a_index, const unsigned b_index) const {return b_zero[b_index] && a_finite[a_index];}
+};
+
+// RN : The products of A.x * B.x are computed from zero and added to D in FP32 (see mma_rn_sync of with_ec)
+// RZ : The products of A.x * B.x are accumulated by the Tensor Cores
+// The selector decides (warp-uniformly) whether all mma (skip_tile) or each correction mma (skip_a, skip_b) of the pairs of the sub fragments are skipped.
+// The selectors skip the products with a zero sub fragment only when the other one is finite, so D is the same as with_ec.
+template <bool rz, class T, class A_Layout, class B_Layout, class Frag_D, class Frag_A, class Frag_B, class Frag_C, class Selector>
+__device__ void mma(Frag_D& frag_d, const Frag_A& frag_a, const Frag_B& frag_b, const Frag_C& frag_c, const Selector& selector) {
+	using Policy = typename Frag_D::Policy;
+	constexpr unsigned num_m_block = Frag_D::num_sub_frag_m;
+	constexpr unsigned num_n_block = Frag_D::num_sub_frag_n;
+	constexpr unsigned num_k_block = Frag_A::num_sub_frag_n;
+
+	mtk::wmma::tcec::detail::mma_sync_wrapper<T, A_Layout, B_Layout, float, Policy> mma_op;
+	mtk::wmma::tcec::detail::fill_zero_wrapper<nvcuda::wmma::accumulator, float, void, Policy> zero_op;
+
+	unsigned num_skipped_mma = 0;
+	unsigned num_skipped_tile_mma = 0;
+	for (unsigned bm = 0; bm < num_m_block; bm++) {
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			auto& d_frag   = frag_d.sub_frag  [bm + bn * num_m_block];
+			auto& d_d_frag = frag_d.sub_d_frag[bm + bn * num_m_block];
+			for (unsigned i = 0; i < d_frag.num_elements; i++) {
+				d_frag  .x[i] = frag_c.sub_frag  [bm + bn * num_m_block].x[i];
+				d_d_frag.x[i] = frag_c.sub_d_frag[bm + bn * num_m_block].x[i];
+			}
+			for (unsigned bk = 0; bk < num_k_block; bk++) {
+				const auto a_index = bm + bk * num_m_block;
+				const auto b_index = bk + bn * num_k_block;
+				if (selector.skip_tile(a_index, b_index)) {
+					num_skipped_tile_mma++;
+					num_skipped_mma += 2;
+					continue;
+				}
+				if (rz) {
+					mma_op(d_frag, frag_a.sub_frag[a_index], frag_b.sub_frag[b_index], d_frag);
+				} else {
+					typename Frag_D::sub_frag_t tmp;
+					zero_op(tmp);
+					mma_op(tmp, frag_a.sub_frag[a_index], frag_b.sub_frag[b_index], tmp);
+					for (unsigned i = 0; i < tmp.num_elements; i++) {
+						d_frag.x[i] += tmp.x[i];
+					}
+				}
+				if (!selector.skip_a(a_index, b_index)) {
+					mma_op(d_d_frag, frag_a.sub_d_frag[a_index], frag_b.sub_frag[b_index], d_d_frag);
+				} else {
+					num_skipped_mma++;
+				}
+				if (!selector.skip_b(a_index, b_index)) {
+					mma_op(d_d_frag, frag_a.sub_frag[a_index], frag_b.sub_d_frag[b_index], d_d_frag);
+				} else {
+					num_skipped_mma++;
+				}
+			}
+		}
+	}
+	frag_d.num_correction_mma = frag_c.num_correction_mma + 2 * num_m_block * num_n_block * num_k_block;
+	frag_d.num_skipped_mma = frag_c.num_skipped_mma + num_skipped_mma;
+	frag_d.num_tile_mma = frag_c.num_tile_mma + num_m_block * num_n_block * num_k_block;
+	frag_d.num_skipped_tile_mma = frag_c.num_skipped_tile_mma + num_skipped_tile_mma;
+}
+
+template <bool rz, class T, class A_Layout, class B_Layout, class Frag_D, class Frag_A, class Frag_B, class Frag_C>
+__device__ void mma(Frag_D& frag_d, const Frag_A& frag_a, const Frag_B& frag_b, const Frag_C& frag_c) {
+	constexpr bool zero_tile = skip_zero_tile<typename Frag_D::Policy::error_correction>::value;
+	mma<rz, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c, zero_residual_selector<zero_tile, Frag_A, Frag_B>(frag_a, frag_b));
+}
+} // namespace skip
+} // namespace detail
+
+// rn
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_c) {
+	mtk::wmma::tcec::detail::skip::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rn_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::skip::mma<false, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d);
+}
+
+// rz
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_c) {
+	mtk::wmma::tcec::detail::skip::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_rz_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b) {
+	mtk::wmma::tcec::fill_zero(frag_d);
+	mtk::wmma::tcec::detail::skip::mma<true, T, A_Layout, B_Layout>(frag_d, frag_a, frag_b, frag_d);
+}
+
+// mma
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b,
+		const fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_c) {
+	mma_rn_sync(frag_d, frag_a, frag_b, frag_c);
+}
+
+template <int m, int n, int k, class A_Layout, class B_Layout, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void mma_sync(
+		fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_d,
+		const fragment<nvcuda::wmma::matrix_a, m, n, k, T, A_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_a,
+		const fragment<nvcuda::wmma::matrix_b, m, n, k, T, B_Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag_b) {
+	mma_rn_sync(frag_d, frag_a, frag_b);
+}
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,528 @@
+#ifndef __WMMAE_TCEC_FACTORIZATION_HPP__
+#define __WMMAE_TCEC_FACTORIZATION_HPP__
+#include "tcec.hpp"
+#include "factorization_host.hpp"
+
+// Batched LU (with partial pivoting) and Cholesky factorizations and solvers of small (N x N, N = 16 or 32) matrices
+//   LU       : P * A = L * U   and B = inv(A) * B
+//   Cholesky : A = L * L^T     and B = inv(A) * B (A : symmetric positive definite)
+// A warp factorizes a matrix in its shared memory. The panels of 16 columns are factorized in FP32 (the lane `i` owns the row `i`,
+// so that the pivot search is a warp shuffle reduction), and the trailing matrix is updated by mma_sync.
+// The triangular solves are blocked in the same way: the diagonal blocks are solved in FP32 and the off diagonal blocks are mma_sync.
+// All matrices are col major. See factorization_host.hpp for the storage format and the host references.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace factorization {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+
+// The size of the blocks
+constexpr unsigned panel = 16;
+
+// C (panel x panel) -= op(A) * op(B), op(X) = X^T if TRANS_X, X otherwise
+template <bool TRANS_A, bool TRANS_B, class T, class Policy>
+__device__ inline void gemm_update(
+		float* const c_ptr, const unsigned ldc,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb
+		) {
+	using a_layout = typename std::conditional<TRANS_A, nvcuda::wmma::row_major, nvcuda::wmma::col_major>::type;
+	using b_layout = typename std::conditional<TRANS_B, nvcuda::wmma::row_major, nvcuda::wmma::col_major>::type;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , panel, panel, panel, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , panel, panel, panel, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, panel, panel, panel, T, void                   , Policy> frag_c;
+	mtk::wmma::tcec::load_matrix_sync_with_mul<a_layout>(frag_a, a_ptr, lda, -1.f, false);
+	mtk::wmma::tcec::load_matrix_sync<b_layout>(frag_b, b_ptr, ldb, false);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, ldc, nvcuda::wmma::mem_col_major);
+	mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	mtk::wmma::tcec::store_matrix_sync(c_ptr, frag_c, ldc, nvcuda::wmma::mem_col_major);
+}
+
+// B (panel x ncols) = inv(op(T)) * B for the (panel x panel) triangular block T, op(T) = T^T if TRANSPOSE, T otherwise
+// UPPER : op(T) is upper triangular, UNIT : the diagonal of T is one and not referenced
+// The lane `j` solves the column `j` in FP32.
+template <bool UPPER, bool UNIT, bool TRANSPOSE>
+__device__ inline void solve_block(
+		const float* const t_ptr, const unsigned ldt,
+		float* const b_ptr, const unsigned ldb,
+		const unsigned ncols
+		) {
+	const auto op_t = [&](const unsigned i, const unsigned l) {
+		return TRANSPOSE ? t_ptr[l + i * static_cast<std::size_t>(ldt)] : t_ptr[i + l * static_cast<std::size_t>(ldt)];
+	};
+	for (unsigned j = threadIdx.x % 32; j < ncols; j += 32) {
+		float* const x = b_ptr + j * static_cast<std::size_t>(ldb);
+		for (unsigned n = 0; n < panel; n++) {
+			const auto i = UPPER ? panel - 1 - n : n;
+			float s = x[i];
+			for (unsigned l = (UPPER ? i + 1 : 0); l < (UPPER ? panel : i); l++) {
+				s -= op_t(i, l) * x[l];
+			}
+			x[i] = UNIT ? s : s / op_t(i, i);
+		}
+	}
+	__syncwarp();
+}
+
+// Factorize the columns p:p+panel of A (rows p:N) by the right looking LU with partial pivoting (LAPACK getf2)
+// The rows are swapped in all N columns.
+template <unsigned N>
+__device__ inline int lu_panel(
+		const unsigned p,
+		float* const a_ptr, const unsigned lda,
+		unsigned* const ipiv_ptr
+		) {
+	const unsigned lane_id = threadIdx.x % 32;
+	int info = 0;
+	for (unsigned k = p; k < p + panel; k++) {
+		float* const a_k_ptr = a_ptr + k * static_cast<std::size_t>(lda);
+		// Pivot search : the first maximum of |A[k:N, k]|
+		float max_v = (lane_id >= k && lane_id < N) ? fabsf(a_k_ptr[lane_id]) : -1.f;
+		unsigned max_i = lane_id;
+		for (unsigned offset = 16; offset > 0; offset >>= 1) {
+			const auto v = __shfl_xor_sync(0xffffffff, max_v, offset);
+			const auto i = __shfl_xor_sync(0xffffffff, max_i, offset);
+			if (v > max_v || (v == max_v && i < max_i)) {
+				max_v = v;
+				max_i = i;
+			}
+		}
+		if (lane_id == 0) {
+			ipiv_ptr[k] = max_i;
+		}
+		if (max_i != k) {
+			for (unsigned j = lane_id; j < N; j += 32) {
+				const auto tmp = a_ptr[k + j * static_cast<std::size_t>(lda)];
+				a_ptr[k + j * static_cast<std::size_t>(lda)] = a_ptr[max_i + j * static_cast<std::size_t>(lda)];
+				a_ptr[max_i + j * static_cast<std::size_t>(lda)] = tmp;
+			}
+		}
+		__syncwarp();
+
+		const auto pivot = a_k_ptr[k];
+		if (pivot == 0.f) {
+			if (info == 0) {
+				info = static_cast<int>(k) + 1;
+			}
+			continue;
+		}
+		if (lane_id > k && lane_id < N) {
+			const auto l = a_k_ptr[lane_id] / pivot;
+			a_k_ptr[lane_id] = l;
+			for (unsigned j = k + 1; j < p + panel; j++) {
+				a_ptr[lane_id + j * static_cast<std::size_t>(lda)] -= l * a_ptr[k + j * static_cast<std::size_t>(lda)];
+			}
+		}
+		__syncwarp();
+	}
+	return info;
+}
+
+// Factorize the columns p:p+panel of A (rows p:N) by the right looking Cholesky (LAPACK potf2, lower)
+template <unsigned N>
+__device__ inline int cholesky_panel(
+		const unsigned p,
+		float* const a_ptr, const unsigned lda
+		) {
+	const unsigned lane_id = threadIdx.x % 32;
+	for (unsigned k = p; k < p + panel; k++) {
+		float* const a_k_ptr = a_ptr + k * static_cast<std::size_t>(lda);
+		const auto d = a_k_ptr[k];
+		if (!(d > 0.f)) {
+			return static_cast<int>(k) + 1;
+		}
+		const auto s = sqrtf(d);
+		__syncwarp();
+		if (lane_id >= k && lane_id < N) {
+			a_k_ptr[lane_id] = lane_id == k ? s : a_k_ptr[lane_id] / s;
+		}
+		__syncwarp();
+		if (lane_id > k && lane_id < N) {
+			const auto l = a_k_ptr[lane_id];
+			for (unsigned j = k + 1; j < p + panel && j <= lane_id; j++) {
+				a_ptr[lane_id + j * static_cast<std::size_t>(lda)] -= l * a_k_ptr[j];
+			}
+		}
+		__syncwarp();
+	}
+	return 0;
+}
+} // namespace detail
+
+// P * A (N x N) = L * U (LAPACK getrf except that ipiv is 0-based)
+// a_ptr : e.g. shared memory, ipiv_ptr : N unsigned integers
+// Returns 0 or k + 1 if U[k, k] is the first exactly zero pivot
+template <unsigned N, class T, class Policy>
+__device__ inline int lu(
+		float* const a_ptr, const unsigned lda,
+		unsigned* const ipiv_ptr
+		) {
+	static_assert(N == 16 || N == 32, "N must be 16 or 32");
+	int info = 0;
+	for (unsigned p = 0; p < N; p += detail::panel) {
+		const auto panel_info = detail::lu_panel<N>(p, a_ptr, lda, ipiv_ptr);
+		if (info == 0 && panel_info != 0) {
+			info = panel_info;
+		}
+		if (p + detail::panel == N) {
+			break;
+		}
+		// U12 = inv(L11) * A12
+		float* const a_12_ptr = a_ptr + p + (p + detail::panel) * static_cast<std::size_t>(lda);
+		detail::solve_block<false, true, false>(a_ptr + p * (static_cast<std::size_t>(lda) + 1), lda, a_12_ptr, lda, N - p - detail::panel);
+		// A22 -= L21 * U12
+		for (unsigned j = p + detail::panel; j < N; j += detail::panel) {
+			for (unsigned i = p + detail::panel; i < N; i += detail::panel) {
+				detail::gemm_update<false, false, T, Policy>(
+						a_ptr + i + j * static_cast<std::size_t>(lda), lda,
+						a_ptr + i + p * static_cast<std::size_t>(lda), lda,
+						a_ptr + p + j * static_cast<std::size_t>(lda), lda
+						);
+			}
+		}
+	}
+	return info;
+}
+
+// B (N x NRHS) = inv(A) * B (LAPACK getrs)
+// lu_ptr / ipiv_ptr : the output of lu, b_ptr : e.g. shared memory
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__device__ inline void lu_solve(
+		const float* const lu_ptr, const unsigned ldlu,
+		const unsigned* const ipiv_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	static_assert(NRHS % detail::panel == 0, "NRHS must be a multiple of 16");
+	for (unsigned j = threadIdx.x % 32; j < NRHS; j += 32) {
+		float* const x = b_ptr + j * static_cast<std::size_t>(ldb);
+		for (unsigned k = 0; k < N; k++) {
+			const auto tmp = x[k];
+			x[k] = x[ipiv_ptr[k]];
+			x[ipiv_ptr[k]] = tmp;
+		}
+	}
+	__syncwarp();
+	// L * Y = P * B
+	for (unsigned i = 0; i < N; i += detail::panel) {
+		for (unsigned k = 0; k < i; k += detail::panel) {
+			for (unsigned j = 0; j < NRHS; j += detail::panel) {
+				detail::gemm_update<false, false, T, Policy>(
+						b_ptr + i + j * static_cast<std::size_t>(ldb), ldb,
+						lu_ptr + i + k * static_cast<std::size_t>(ldlu), ldlu,
+						b_ptr + k + j * static_cast<std::size_t>(ldb), ldb
+						);
+			}
+		}
+		detail::solve_block<false, true, false>(lu_ptr + i * (static_cast<std::size_t>(ldlu) + 1), ldlu, b_ptr + i, ldb, NRHS);
+	}
+	// U * X = Y
+	for (unsigned i = N; i > 0;) {
+		i -= detail::panel;
+		for (unsigned k = i + detail::panel; k < N; k += detail::panel) {
+			for (unsigned j = 0; j < NRHS; j += detail::panel) {
+				detail::gemm_update<false, false, T, Policy>(
+						b_ptr + i + j * static_cast<std::size_t>(ldb), ldb,
+						lu_ptr + i + k * static_cast<std::size_t>(ldlu), ldlu,
+						b_ptr + k + j * static_cast<std::size_t>(ldb), ldb
+						);
+			}
+		}
+		detail::solve_block<true, false, false>(lu_ptr + i * (static_cast<std::size_t>(ldlu) + 1), ldlu, b_ptr + i, ldb, NRHS);
+	}
+}
+
+// A (N x N) = L * L^T (LAPACK potrf, lower)
+// Only the lower triangle of A is referenced. The upper triangle of the diagonal blocks is overwritten.
+// a_ptr : e.g. shared memory
+// Returns 0 or k + 1 if the leading minor of order k + 1 is not positive definite (the factorization stops there)
+template <unsigned N, class T, class Policy>
+__device__ inline int cholesky(
+		float* const a_ptr, const unsigned lda
+		) {
+	static_assert(N == 16 || N == 32, "N must be 16 or 32");
+	for (unsigned p = 0; p < N; p += detail::panel) {
+		const auto info = detail::cholesky_panel<N>(p, a_ptr, lda);
+		if (info != 0) {
+			return info;
+		}
+		// A22 -= L21 * L21^T (the lower tiles)
+		for (unsigned j = p + detail::panel; j < N; j += detail::panel) {
+			for (unsigned i = j; i < N; i += detail::panel) {
+				detail::gemm_update<false, true, T, Policy>(
+						a_ptr + i + j * static_cast<std::size_t>(lda), lda,
+						a_ptr + i + p * static_cast<std::size_t>(lda), lda,
+						a_ptr + j + p * static_cast<std::size_t>(lda), lda
+						);
+			}
+		}
+	}
+	return 0;
+}
+
+// B (N x NRHS) = inv(L * L^T) * B (LAPACK potrs, lower)
+// l_ptr : the output of cholesky, b_ptr : e.g. shared memory
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__device__ inline void cholesky_solve(
+		const float* const l_ptr, const unsigned ldl,
+		float* const b_ptr, const unsigned ldb
+		) {
+	static_assert(NRHS % detail::panel == 0, "NRHS must be a multiple of 16");
+	// L * Y = B
+	for (unsigned i = 0; i < N; i += detail::panel) {
+		for (unsigned k = 0; k < i; k += detail::panel) {
+			for (unsigned j = 0; j < NRHS; j += detail::panel) {
+				detail::gemm_update<false, false, T, Policy>(
+						b_ptr + i + j * static_cast<std::size_t>(ldb), ldb,
+						l_ptr + i + k * static_cast<std::size_t>(ldl), ldl,
+						b_ptr + k + j * static_cast<std::size_t>(ldb), ldb
+						);
+			}
+		}
+		detail::solve_block<false, false, false>(l_ptr + i * (static_cast<std::size_t>(ldl) + 1), ldl, b_ptr + i, ldb, NRHS);
+	}
+	// L^T * X = Y
+	for (unsigned i = N; i > 0;) {
+		i -= detail::panel;
+		for (unsigned k = i + detail::panel; k < N; k += detail::panel) {
+			for (unsigned j = 0; j < NRHS; j += detail::panel) {
+				detail::gemm_update<true, false, T, Policy>(
+						b_ptr + i + j * static_cast<std::size_t>(ldb), ldb,
+						l_ptr + k + i * static_cast<std::size_t>(ldl), ldl,
+						b_ptr + k + j * static_cast<std::size_t>(ldb), ldb
+						);
+			}
+		}
+		detail::solve_block<true, false, true>(l_ptr + i * (static_cast<std::size_t>(ldl) + 1), ldl, b_ptr + i, ldb, NRHS);
+	}
+}
+
+// The matrices of a batch are stored contiguously (A : N x N, ld = N, ipiv : N).
+// info_ptr : the info of each matrix (optional, nullptr)
+template <unsigned N, class T, class Policy>
+__global__ void lu_kernel(
+		const unsigned batch_size,
+		float* const a_ptr,
+		unsigned* const ipiv_ptr,
+		int* const info_ptr
+		) {
+	__shared__ float smem[detail::num_warps][N * N];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const a_smem = smem[warp_id];
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		float* const a_batch_ptr = a_ptr + static_cast<std::size_t>(batch_id) * N * N;
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			a_smem[i] = a_batch_ptr[i];
+		}
+		__syncwarp();
+		const auto info = lu<N, T, Policy>(a_smem, N, ipiv_ptr + static_cast<std::size_t>(batch_id) * N);
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			a_batch_ptr[i] = a_smem[i];
+		}
+		if (info_ptr != nullptr && lane_id == 0) {
+			info_ptr[batch_id] = info;
+		}
+		__syncwarp();
+	}
+}
+
+// The matrices of a batch are stored contiguously (LU : N x N, ld = N, ipiv : N, B : N x NRHS, ld = N).
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__global__ void lu_solve_kernel(
+		const unsigned batch_size,
+		const float* const lu_ptr,
+		const unsigned* const ipiv_ptr,
+		float* const b_ptr
+		) {
+	__shared__ float smem[detail::num_warps][N * N + N * NRHS];
+	__shared__ unsigned ipiv_smem[detail::num_warps][N];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const lu_smem = smem[warp_id];
+	float* const b_smem = lu_smem + N * N;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		const float* const lu_batch_ptr = lu_ptr + static_cast<std::size_t>(batch_id) * N * N;
+		float* const b_batch_ptr = b_ptr + static_cast<std::size_t>(batch_id) * N * NRHS;
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			lu_smem[i] = lu_batch_ptr[i];
+		}
+		for (unsigned i = lane_id; i < N * NRHS; i += 32) {
+			b_smem[i] = b_batch_ptr[i];
+		}
+		for (unsigned i = lane_id; i < N; i += 32) {
+			ipiv_smem[warp_id][i] = ipiv_ptr[static_cast<std::size_t>(batch_id) * N + i];
+		}
+		__syncwarp();
+		lu_solve<N, NRHS, T, Policy>(lu_smem, N, ipiv_smem[warp_id], b_smem, N);
+		for (unsigned i = lane_id; i < N * NRHS; i += 32) {
+			b_batch_ptr[i] = b_smem[i];
+		}
+		__syncwarp();
+	}
+}
+
+// The matrices of a batch are stored contiguously (A : N x N, ld = N).
+// Only the lower triangle of A is read and written.
+// info_ptr : the info of each matrix (optional, nullptr)
+template <unsigned N, class T, class Policy>
+__global__ void cholesky_kernel(
+		const unsigned batch_size,
+		float* const a_ptr,
+		int* const info_ptr
+		) {
+	__shared__ float smem[detail::num_warps][N * N];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const a_smem = smem[warp_id];
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		float* const a_batch_ptr = a_ptr + static_cast<std::size_t>(batch_id) * N * N;
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			a_smem[i] = (i % N >= i / N) ? a_batch_ptr[i] : 0.f;
+		}
+		__syncwarp();
+		const auto info = cholesky<N, T, Policy>(a_smem, N);
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			if (i % N >= i / N) {
+				a_batch_ptr[i] = a_smem[i];
+			}
+		}
+		if (info_ptr != nullptr && lane_id == 0) {
+			info_ptr[batch_id] = info;
+		}
+		__syncwarp();
+	}
+}
+
+// The matrices of a batch are stored contiguously (L : N x N, ld = N, B : N x NRHS, ld = N).
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__global__ void cholesky_solve_kernel(
+		const unsigned batch_size,
+		const float* const l_ptr,
+		float* const b_ptr
+		) {
+	__shared__ float smem[detail::num_warps][N * N + N * NRHS];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const l_smem = smem[warp_id];
+	float* const b_smem = l_smem + N * N;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		const float* const l_batch_ptr = l_ptr + static_cast<std::size_t>(batch_id) * N * N;
+		float* const b_batch_ptr = b_ptr + static_cast<std::size_t>(batch_id) * N * NRHS;
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			l_smem[i] = (i % N >= i / N) ? l_batch_ptr[i] : 0.f;
+		}
+		for (unsigned i = lane_id; i < N * NRHS; i += 32) {
+			b_smem[i] = b_batch_ptr[i];
+		}
+		__syncwarp();
+		cholesky_solve<N, NRHS, T, Policy>(l_smem, N, b_smem, N);
+		for (unsigned i = lane_id; i < N * NRHS; i += 32) {
+			b_batch_ptr[i] = b_smem[i];
+		}
+		__syncwarp();
+	}
+}
+
+// Launch lu_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, class T, class Policy>
+inline void launch_lu(
+		const unsigned batch_size,
+		float* const a_ptr,
+		unsigned* const ipiv_ptr,
+		int* const info_ptr = nullptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	lu_kernel<N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			a_ptr,
+			ipiv_ptr,
+			info_ptr
+			);
+}
+
+// Launch lu_solve_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, unsigned NRHS, class T, class Policy>
+inline void launch_lu_solve(
+		const unsigned batch_size,
+		const float* const lu_ptr,
+		const unsigned* const ipiv_ptr,
+		float* const b_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	lu_solve_kernel<N, NRHS, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			lu_ptr,
+			ipiv_ptr,
+			b_ptr
+			);
+}
+
+// Launch cholesky_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, class T, class Policy>
+inline void launch_cholesky(
+		const unsigned batch_size,
+		float* const a_ptr,
+		int* const info_ptr = nullptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	cholesky_kernel<N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			a_ptr,
+			info_ptr
+			);
+}
+
+// Launch cholesky_solve_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, unsigned NRHS, class T, class Policy>
+inline void launch_cholesky_solve(
+		const unsigned batch_size,
+		const float* const l_ptr,
+		float* const b_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	cholesky_solve_kernel<N, NRHS, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			l_ptr,
+			b_ptr
+			);
+}
+} // namespace factorization
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,170 @@
+#ifndef __WMMAE_TCEC_FACTORIZATION_HOST_HPP__
+#define __WMMAE_TCEC_FACTORIZATION_HOST_HPP__
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// The host references of mtk::wmma::tcec::factorization (see factorization.hpp)
+// This header does not depend on CUDA.
+// All matrices are col major.
+// The results are stored in the LAPACK format except that the pivot indices are 0-based:
+//   LU       : P * A = L * U, L (unit lower) and U are stored in A, ipiv[k] is the row swapped with the row k (getrf)
+//   Cholesky : A = L * L^T, L is stored in the lower triangle of A and the upper triangle is not referenced (potrf)
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace factorization {
+namespace host {
+namespace detail {
+inline std::vector<double> load(const unsigned n, const unsigned m, const float* const ptr, const unsigned ld) {
+	std::vector<double> a(static_cast<std::size_t>(n) * m);
+	for (unsigned j = 0; j < m; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			a[i + j * static_cast<std::size_t>(n)] = ptr[i + j * static_cast<std::size_t>(ld)];
+		}
+	}
+	return a;
+}
+} // namespace detail
+
+// Reference of mtk::wmma::tcec::factorization::launch_lu in double (LAPACK getf2)
+// Returns 0 or k + 1 if U[k, k] is the first exactly zero pivot
+inline int lu(
+		const unsigned n,
+		float* const a_ptr, const unsigned lda,
+		unsigned* const ipiv_ptr
+		) {
+	auto a = detail::load(n, n, a_ptr, lda);
+	int info = 0;
+	for (unsigned k = 0; k < n; k++) {
+		// The first maximum as isamax
+		unsigned piv = k;
+		for (unsigned i = k + 1; i < n; i++) {
+			if (std::abs(a[i + k * static_cast<std::size_t>(n)]) > std::abs(a[piv + k * static_cast<std::size_t>(n)])) {
+				piv = i;
+			}
+		}
+		ipiv_ptr[k] = piv;
+		if (piv != k) {
+			for (unsigned j = 0; j < n; j++) {
+				std::swap(a[k + j * static_cast<std::size_t>(n)], a[piv + j * static_cast<std::size_t>(n)]);
+			}
+		}
+		const auto pivot = a[k + k * static_cast<std::size_t>(n)];
+		if (pivot == 0.) {
+			if (info == 0) {
+				info = static_cast<int>(k) + 1;
+			}
+			continue;
+		}
+		for (unsigned i = k + 1; i < n; i++) {
+			a[i + k * static_cast<std::size_t>(n)] /= pivot;
+		}
+		for (unsigned j = k + 1; j < n; j++) {
+			for (unsigned i = k + 1; i < n; i++) {
+				a[i + j * static_cast<std::size_t>(n)] -= a[i + k * static_cast<std::size_t>(n)] * a[k + j * static_cast<std::size_t>(n)];
+			}
+		}
+	}
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			a_ptr[i + j * static_cast<std::size_t>(lda)] = static_cast<float>(a[i + j * static_cast<std::size_t>(n)]);
+		}
+	}
+	return info;
+}
+
+// Reference of mtk::wmma::tcec::factorization::launch_lu_solve in double (LAPACK getrs)
+// B (n x nrhs) = inv(A) * B, lu_ptr / ipiv_ptr : the output of lu
+inline void lu_solve(
+		const unsigned n, const unsigned nrhs,
+		const float* const lu_ptr, const unsigned ldlu,
+		const unsigned* const ipiv_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	auto b = detail::load(n, nrhs, b_ptr, ldb);
+	const auto lu = [&](const unsigned i, const unsigned j) {return static_cast<double>(lu_ptr[i + j * static_cast<std::size_t>(ldlu)]);};
+	for (unsigned j = 0; j < nrhs; j++) {
+		double* const x = b.data() + j * static_cast<std::size_t>(n);
+		for (unsigned k = 0; k < n; k++) {
+			std::swap(x[k], x[ipiv_ptr[k]]);
+		}
+		for (unsigned i = 0; i < n; i++) {
+			for (unsigned l = 0; l < i; l++) {
+				x[i] -= lu(i, l) * x[l];
+			}
+		}
+		for (unsigned i = n; i-- > 0;) {
+			for (unsigned l = i + 1; l < n; l++) {
+				x[i] -= lu(i, l) * x[l];
+			}
+			x[i] /= lu(i, i);
+		}
+		for (unsigned i = 0; i < n; i++) {
+			b_ptr[i + j * static_cast<std::size_t>(ldb)] = static_cast<float>(x[i]);
+		}
+	}
+}
+
+// Reference of mtk::wmma::tcec::factorization::launch_cholesky in double (LAPACK potf2, lower)
+// Returns 0 or k + 1 if the leading minor of order k + 1 is not positive definite (the factorization stops there)
+inline int cholesky(
+		const unsigned n,
+		float* const a_ptr, const unsigned lda
+		) {
+	auto a = detail::load(n, n, a_ptr, lda);
+	for (unsigned k = 0; k < n; k++) {
+		const auto d = a[k + k * static_cast<std::size_t>(n)];
+		if (!(d > 0.)) {
+			return static_cast<int>(k) + 1;
+		}
+		const auto s = std::sqrt(d);
+		a_ptr[k + k * static_cast<std::size_t>(lda)] = static_cast<float>(s);
+		for (unsigned i = k + 1; i < n; i++) {
+			a[i + k * static_cast<std::size_t>(n)] /= s;
+			a_ptr[i + k * static_cast<std::size_t>(lda)] = static_cast<float>(a[i + k * static_cast<std::size_t>(n)]);
+		}
+		for (unsigned j = k + 1; j < n; j++) {
+			for (unsigned i = j; i < n; i++) {
+				a[i + j * static_cast<std::size_t>(n)] -= a[i + k * static_cast<std::size_t>(n)] * a[j + k * static_cast<std::size_t>(n)];
+			}
+		}
+	}
+	return 0;
+}
+
+// Reference of mtk::wmma::tcec::factorization::launch_cholesky_solve in double (LAPACK potrs, lower)
+// B (n x nrhs) = inv(L * L^T) * B, l_ptr : the output of cholesky
+inline void cholesky_solve(
+		const unsigned n, const unsigned nrhs,
+		const float* const l_ptr, const unsigned ldl,
+		float* const b_ptr, const unsigned ldb
+		) {
+	auto b = detail::load(n, nrhs, b_ptr, ldb);
+	const auto l = [&](const unsigned i, const unsigned j) {return static_cast<double>(l_ptr[i + j * static_cast<std::size_t>(ldl)]);};
+	for (unsigned j = 0; j < nrhs; j++) {
+		double* const x = b.data() + j * static_cast<std::size_t>(n);
+		for (unsigned i = 0; i < n; i++) {
+			for (unsigned k = 0; k < i; k++) {
+				x[i] -= l(i, k) * x[k];
+			}
+			x[i] /= l(i, i);
+		}
+		for (unsigned i = n; i-- > 0;) {
+			for (unsigned k = i + 1; k < n; k++) {
+				x[i] -= l(k, i) * x[k];
+			}
+			x[i] /= l(i, i);
+		}
+		for (unsigned i = 0; i < n; i++) {
+			b_ptr[i + j * static_cast<std::size_t>(ldb)] = static_cast<float>(x[i]);
+		}
+	}
+}
+} // namespace host
+} // namespace factorization
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,112 @@
+#ifndef __WMMAE_TCEC_GROUPED_HPP__
+#define __WMMAE_TCEC_GROUPED_HPP__
+#include "tcec.hpp"
+#include "detail/grouped_schedule.hpp"
+
+// Grouped GEMM
+// A single kernel computes a group of GEMMs of different sizes, pointers and leading dimensions.
+// The tiles of all problems are assigned to the warps by the device-side scheduler (see detail/grouped_schedule.hpp),
+// so the host only passes the array of the problem descriptors (`mtk::wmma::tcec::grouped::problem`).
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace grouped {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+} // namespace detail
+
+// The tile (tile_m, tile_n) of C = alpha * A * B + beta * C of the problem `p`
+// The tiles on the edges of C and the last k block are loaded and stored with the bounds checks.
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class T, class Policy>
+__device__ inline void gemm_tile(
+		const mtk::wmma::tcec::grouped::problem& p,
+		const unsigned tile_m, const unsigned tile_n
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , WARP_M, WARP_N, WARP_K, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , WARP_M, WARP_N, WARP_K, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, WARP_M, WARP_N, WARP_K, T, void                   , Policy> frag_c;
+
+	// The branches are uniform within each warp
+	const auto rows = p.m - tile_m < WARP_M ? p.m - tile_m : WARP_M;
+	const auto cols = p.n - tile_n < WARP_N ? p.n - tile_n : WARP_N;
+	const bool full_tile = rows == WARP_M && cols == WARP_N;
+
+	float* const c_tile_ptr = p.c_ptr + tile_m + tile_n * static_cast<std::size_t>(p.ldc);
+	if (p.beta == 0.f) {
+		mtk::wmma::tcec::fill_zero(frag_c);
+	} else {
+		if (full_tile) {
+			mtk::wmma::tcec::load_matrix_sync(frag_c, c_tile_ptr, p.ldc, nvcuda::wmma::mem_col_major, false);
+		} else {
+			mtk::wmma::tcec::load_matrix_sync(frag_c, c_tile_ptr, p.ldc, rows, cols, nvcuda::wmma::mem_col_major, false);
+		}
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= p.beta;
+		}
+	}
+
+	const float* const a_tile_ptr = p.a_ptr + tile_m * static_cast<std::size_t>(p.lda);
+	const float* const b_tile_ptr = p.b_ptr + tile_n * static_cast<std::size_t>(p.ldb);
+	for (unsigned bk = 0; bk < p.k; bk += WARP_K) {
+		const auto depth = p.k - bk < WARP_K ? p.k - bk : WARP_K;
+		if (full_tile && depth == WARP_K) {
+			mtk::wmma::tcec::load_matrix_sync_with_mul(frag_a, a_tile_ptr + bk, p.lda, p.alpha, false);
+			mtk::wmma::tcec::load_matrix_sync(frag_b, b_tile_ptr + bk, p.ldb, false);
+		} else {
+			mtk::wmma::tcec::load_matrix_sync_with_mul(frag_a, a_tile_ptr + bk, p.lda, rows, depth, p.alpha, false);
+			mtk::wmma::tcec::load_matrix_sync(frag_b, b_tile_ptr + bk, p.ldb, depth, cols, false);
+		}
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	if (full_tile) {
+		mtk::wmma::tcec::store_matrix_sync(c_tile_ptr, frag_c, p.ldc, nvcuda::wmma::mem_col_major, false);
+	} else {
+		mtk::wmma::tcec::store_matrix_sync(c_tile_ptr, frag_c, p.ldc, rows, cols, nvcuda::wmma::mem_col_major, false);
+	}
+}
+
+// problems : device array of the problem descriptors
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class T, class Policy>
+__global__ void gemm_kernel(
+		const mtk::wmma::tcec::grouped::problem* const problems,
+		const unsigned num_problems
+		) {
+	mtk::wmma::tcec::grouped::tile_scheduler<WARP_M, WARP_N> scheduler(blockIdx.x, gridDim.x, threadIdx.x / 32, blockDim.x / 32);
+	mtk::wmma::tcec::grouped::tile t;
+	while (scheduler.next(problems, num_problems, t)) {
+		gemm_tile<WARP_M, WARP_N, WARP_K, T, Policy>(problems[t.problem_id], t.tile_m, t.tile_n);
+	}
+}
+
+// Launch gemm_kernel
+// problems  : device array of the problem descriptors (the pointers in them are device pointers)
+// num_tiles : the number of the tiles of all problems (`mtk::wmma::tcec::grouped::num_tiles<WARP_M, WARP_N>` of the host copy of the descriptors)
+// num_blocks == 0 : one tile per warp. Pass a multiple of the number of SMs for a persistent kernel.
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class T, class Policy>
+inline void launch_gemm(
+		const mtk::wmma::tcec::grouped::problem* const problems,
+		const unsigned num_problems,
+		const unsigned long num_tiles,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (num_tiles == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = static_cast<unsigned>((num_tiles + detail::num_warps - 1) / detail::num_warps);
+	}
+	gemm_kernel<WARP_M, WARP_N, WARP_K, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			problems,
+			num_problems
+			);
+}
+
+} // namespace grouped
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
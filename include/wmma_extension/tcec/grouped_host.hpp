@@ -0,0 +1,46 @@
+#ifndef __WMMAE_TCEC_GROUPED_HOST_HPP__
+#define __WMMAE_TCEC_GROUPED_HOST_HPP__
+#include "host.hpp"
+#include "detail/grouped_schedule.hpp"
+
+// Host emulation of mtk::wmma::tcec::grouped::gemm_kernel (see grouped.hpp)
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace grouped {
+namespace host {
+
+// T : mtk::wmma::tcec::host::{fp16, tf32, fp32}
+// FK : Policy::k
+// The tiles are computed in the order of the scheduler of each warp.
+template <unsigned WARP_M, unsigned WARP_N, class T, class ErrorCorrection, unsigned FK>
+inline void gemm(
+		const mtk::wmma::tcec::grouped::problem* const problems,
+		const unsigned num_problems,
+		const unsigned num_blocks,
+		const unsigned num_warps
+		) {
+	for (unsigned block_id = 0; block_id < num_blocks; block_id++) {
+		for (unsigned warp_id = 0; warp_id < num_warps; warp_id++) {
+			mtk::wmma::tcec::grouped::tile_scheduler<WARP_M, WARP_N> scheduler(block_id, num_blocks, warp_id, num_warps);
+			mtk::wmma::tcec::grouped::tile t;
+			while (scheduler.next(problems, num_problems, t)) {
+				const auto& p = problems[t.problem_id];
+				mtk::wmma::tcec::host::gemm_tile<T, ErrorCorrection>(
+						t.tile_m, t.tile_n,
+						p.m - t.tile_m < WARP_M ? p.m - t.tile_m : WARP_M,
+						p.n - t.tile_n < WARP_N ? p.n - t.tile_n : WARP_N,
+						p.k, FK,
+						p.alpha, p.a_ptr, p.lda, p.b_ptr, p.ldb, p.beta, p.c_ptr, p.ldc
+						);
+			}
+		}
+	}
+}
+
+} // namespace host
+} // namespace grouped
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
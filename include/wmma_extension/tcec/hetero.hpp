@@ -0,0 +1,127 @@
+#ifndef __WMMAE_TCEC_HETERO_HPP__
+#define __WMMAE_TCEC_HETERO_HPP__
+#include "tcec.hpp"
+#include "detail/hetero_schedule.hpp"
+
+// Heterogeneous GEMM
+// TC warps compute tiles with a Tensor Core policy with error correction (e.g. op_mma + with_ec),
+// while SIMT warps compute the other tiles with op_simt on the FP32 units.
+// The work ratio is static and given by the Schedule (see detail/hetero_schedule.hpp).
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace hetero {
+
+// C[tile_m:tile_m+WARP_M, tile_n:tile_n+WARP_N] = alpha * A * B + beta * C
+// A : row major, B : col major, C : col major
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class T, class Policy>
+__device__ inline void gemm_tile(
+		const unsigned tile_m, const unsigned tile_n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , WARP_M, WARP_N, WARP_K, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , WARP_M, WARP_N, WARP_K, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, WARP_M, WARP_N, WARP_K, T, void                   , Policy> frag_c;
+
+	float* const c_tile_ptr = c_ptr + tile_m + tile_n * static_cast<std::size_t>(ldc);
+	if (beta == 0.f) {
+		mtk::wmma::tcec::fill_zero(frag_c);
+	} else {
+		mtk::wmma::tcec::load_matrix_sync(frag_c, c_tile_ptr, ldc, nvcuda::wmma::mem_col_major, false);
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= beta;
+		}
+	}
+
+	const float* const a_tile_ptr = a_ptr + tile_m * static_cast<std::size_t>(lda);
+	const float* const b_tile_ptr = b_ptr + tile_n * static_cast<std::size_t>(ldb);
+	for (unsigned bk = 0; bk < k; bk += WARP_K) {
+		mtk::wmma::tcec::load_matrix_sync_with_mul(frag_a, a_tile_ptr + bk, lda, alpha, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, b_tile_ptr + bk, ldb, false);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	mtk::wmma::tcec::store_matrix_sync(c_tile_ptr, frag_c, ldc, nvcuda::wmma::mem_col_major, false);
+}
+
+// m, n, k must be multiples of WARP_M, WARP_N, WARP_K respectively.
+// blockDim.x must be Schedule::num_warps * 32.
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class TC_T, class TC_Policy, class SIMT_Policy, class Schedule>
+__global__ void gemm_kernel(
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned num_tiles_m = m / WARP_M;
+	const unsigned long num_tiles = static_cast<unsigned long>(num_tiles_m) * (n / WARP_N);
+
+	// The branch is uniform within each warp
+	const bool is_tc_warp = Schedule::is_tc_warp(warp_id);
+	for (unsigned i = 0; ; i++) {
+		const auto tile_id = Schedule::tile_id(blockIdx.x, gridDim.x, warp_id, i);
+		if (tile_id >= num_tiles) {
+			break;
+		}
+		const unsigned tile_m = (tile_id % num_tiles_m) * WARP_M;
+		const unsigned tile_n = (tile_id / num_tiles_m) * WARP_N;
+		if (is_tc_warp) {
+			gemm_tile<WARP_M, WARP_N, WARP_K, TC_T , TC_Policy  >(tile_m, tile_n, k, alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc);
+		} else {
+			gemm_tile<WARP_M, WARP_N, WARP_K, float, SIMT_Policy>(tile_m, tile_n, k, alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc);
+		}
+	}
+}
+
+// Default policies of both paths
+template <class TC_T = half, class Sm = mtk::wmma::tcec::sm_not_specified>
+struct default_policy {
+	using tc_policy   = typename mtk::wmma::tcec::detail::default_policy<TC_T, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, Sm>::type;
+	using simt_policy = mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, tc_policy::m, tc_policy::n, tc_policy::k>;
+};
+
+// num_blocks == 0 : one round per block
+template <unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class TC_T, class TC_Policy, class SIMT_Policy, class Schedule>
+inline void launch_gemm(
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (num_blocks == 0) {
+		num_blocks = Schedule::num_blocks(static_cast<unsigned long>(m / WARP_M) * (n / WARP_N));
+	}
+	if (num_blocks == 0) {
+		return;
+	}
+	gemm_kernel<WARP_M, WARP_N, WARP_K, TC_T, TC_Policy, SIMT_Policy, Schedule><<<num_blocks, Schedule::num_warps * 32, 0, cuda_stream>>>(
+			m, n, k,
+			alpha,
+			a_ptr, lda,
+			b_ptr, ldb,
+			beta,
+			c_ptr, ldc
+			);
+}
+
+} // namespace hetero
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,61 @@
+#ifndef __WMMAE_TCEC_HETERO_HOST_HPP__
+#define __WMMAE_TCEC_HETERO_HOST_HPP__
+#include "host.hpp"
+#include "detail/hetero_schedule.hpp"
+
+// Host emulation of mtk::wmma::tcec::hetero::gemm_kernel (see hetero.hpp)
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace hetero {
+namespace host {
+
+// TC_T : mtk::wmma::tcec::host::{fp16, tf32}
+// TC_K / SIMT_K : Policy::k of the TC / SIMT policy
+// A : row major, B : col major, C : col major
+template <unsigned WARP_M, unsigned WARP_N, class TC_T, unsigned TC_K, unsigned SIMT_K, class Schedule>
+inline void gemm(
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		const unsigned num_blocks
+		) {
+	const unsigned num_tiles_m = m / WARP_M;
+	const unsigned long num_tiles = static_cast<unsigned long>(num_tiles_m) * (n / WARP_N);
+
+	for (unsigned block_id = 0; block_id < num_blocks; block_id++) {
+		for (unsigned warp_id = 0; warp_id < Schedule::num_warps; warp_id++) {
+			for (unsigned i = 0; ; i++) {
+				const auto tile_id = Schedule::tile_id(block_id, num_blocks, warp_id, i);
+				if (tile_id >= num_tiles) {
+					break;
+				}
+				const unsigned tile_m = (tile_id % num_tiles_m) * WARP_M;
+				const unsigned tile_n = (tile_id / num_tiles_m) * WARP_N;
+				if (Schedule::is_tc_warp(warp_id)) {
+					mtk::wmma::tcec::host::gemm_tile<TC_T, mtk::wmma::tcec::with_ec>(
+							tile_m, tile_n, WARP_M, WARP_N, k, TC_K,
+							alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc
+							);
+				} else {
+					mtk::wmma::tcec::host::gemm_tile<mtk::wmma::tcec::host::fp32, mtk::wmma::tcec::without_ec>(
+							tile_m, tile_n, WARP_M, WARP_N, k, SIMT_K,
+							alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc
+							);
+				}
+			}
+		}
+	}
+}
+
+} // namespace host
+} // namespace hetero
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
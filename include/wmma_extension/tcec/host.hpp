@@ -0,0 +1,353 @@
+#ifndef __WMMAE_TCEC_HOST_HPP__
+#define __WMMAE_TCEC_HOST_HPP__
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+// Host emulation of the TCEC arithmetic.
+// This header does not depend on CUDA so that it can be used in unit tests on machines without GPUs.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+
+// Error correction policy (same declarations as detail/policy.hpp)
+struct with_ec;
+struct without_ec;
+
+namespace host {
+// Input types of the emulated computing units
+struct fp16; // half                          (op_mma / op_wmma)
+struct tf32; // nvcuda::wmma::precision::tf32 (op_mma / op_wmma)
+struct fp32; // float                         (op_simt)
+
+namespace detail {
+inline std::uint32_t to_bits(const float v) {
+	std::uint32_t u;
+	std::memcpy(&u, &v, sizeof(u));
+	return u;
+}
+inline float from_bits(const std::uint32_t u) {
+	float v;
+	std::memcpy(&v, &u, sizeof(v));
+	return v;
+}
+} // namespace detail
+
+// Round to the nearest binary16 value (ties to even) as `__float2half` does
+inline float round_to_fp16(const float v) {
+	const auto u = detail::to_bits(v);
+	const auto sign = u & 0x80000000u;
+	const auto abs_u = u & 0x7fffffffu;
+	if (abs_u >= 0x7f800000u) {
+		// inf / nan
+		return v;
+	}
+	if (abs_u >= 0x477ff000u) {
+		// overflow
+		return detail::from_bits(sign | 0x7f800000u);
+	}
+	if (abs_u < 0x38800000u) {
+		// subnormal in binary16 : round to a multiple of 2^-24
+		const auto r = std::nearbyint(std::ldexp(detail::from_bits(abs_u), 24));
+		return detail::from_bits(sign | detail::to_bits(std::ldexp(r, -24)));
+	}
+	auto r = abs_u >> 13;
+	const auto rem = abs_u & 0x1fffu;
+	if (rem > 0x1000u || (rem == 0x1000u && (r & 0x1u))) {
+		r++;
+	}
+	return detail::from_bits(sign | (r << 13));
+}
+
+// Round to tf32 (ties away from zero) as `cvt.rna.tf32.f32` does
+inline float round_to_tf32(const float v) {
+	const auto u = detail::to_bits(v);
+	if ((u & 0x7f800000u) == 0x7f800000u) {
+		// inf / nan
+		return v;
+	}
+	return detail::from_bits((u + 0x1000u) & 0xffffe000u);
+}
+
+template <class T>
+inline float cast(const float v);
+template <> inline float cast<fp16>(const float v) {return round_to_fp16(v);}
+template <> inline float cast<tf32>(const float v) {return round_to_tf32(v);}
+template <> inline float cast<fp32>(const float v) {return v;}
+
+// Same as tcec/detail/scale.hpp
+template <class T>
+inline float correction_scale_0(const float v) {return v;}
+template <>
+inline float correction_scale_0<fp16>(const float v) {return v * 2048;}
+
+template <class T>
+inline float correction_scale_1(const float v) {return v;}
+template <>
+inline float correction_scale_1<fp16>(const float v) {return v / 2048;}
+
+// Split `v` into the pair (hv, dhv) that `tcec::load_matrix_sync` stores into `x` and `dx`
+template <class T>
+inline void split(const float v, float& hv, float& dhv) {
+	hv  = cast<T>(v);
+	dhv = cast<T>(correction_scale_0<T>(v - hv));
+}
+
+// Bits of a binary16 value `v` (e.g. a result of `round_to_fp16`)
+inline std::uint16_t to_fp16_bits(const float v) {
+	const auto u = detail::to_bits(v);
+	const auto sign = static_cast<std::uint16_t>((u >> 16) & 0x8000u);
+	const auto abs_u = u & 0x7fffffffu;
+	if (abs_u > 0x7f800000u) {
+		// nan (canonical as `__float2half`)
+		return 0x7fffu;
+	}
+	if (abs_u >= 0x477ff000u) {
+		// inf
+		return sign | 0x7c00u;
+	}
+	if (abs_u < 0x38800000u) {
+		// subnormal / zero : a multiple of 2^-24
+		return sign | static_cast<std::uint16_t>(std::ldexp(detail::from_bits(abs_u), 24));
+	}
+	return sign | static_cast<std::uint16_t>((((abs_u >> 23) - 112u) << 10) | ((abs_u >> 13) & 0x3ffu));
+}
+
+// Element type of the hi / lo planes of `split_matrix`.
+// It has the same bits as `half` / `float` on the device (tcec/split.hpp).
+template <class T>
+struct plane_t;
+template <> struct plane_t<fp16> {using type = std::uint16_t;};
+template <> struct plane_t<tf32> {using type = float;};
+
+namespace detail {
+template <class T>
+inline typename plane_t<T>::type to_plane_element(const float v);
+template <> inline std::uint16_t to_plane_element<fp16>(const float v) {return to_fp16_bits(v);}
+template <> inline float         to_plane_element<tf32>(const float v) {return v;}
+} // namespace detail
+
+// Host version of `mtk::wmma::tcec::split_matrix` (tcec/split.hpp).
+// The planes are bit-identical to the device ones.
+// src : m x n (col major view) with the leading dimension ld_src
+// hi / lo : m x n with the leading dimension ld_dst
+template <class T>
+inline void split_matrix(
+		typename plane_t<T>::type* const hi_ptr,
+		typename plane_t<T>::type* const lo_ptr,
+		const unsigned ld_dst,
+		const float* const src_ptr,
+		const unsigned ld_src,
+		const unsigned m,
+		const unsigned n
+		) {
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			float hv, dhv;
+			split<T>(src_ptr[i + j * static_cast<std::size_t>(ld_src)], hv, dhv);
+			hi_ptr[i + j * static_cast<std::size_t>(ld_dst)] = detail::to_plane_element<T>(hv);
+			lo_ptr[i + j * static_cast<std::size_t>(ld_dst)] = detail::to_plane_element<T>(dhv);
+		}
+	}
+}
+
+// Threshold of the correction selection of with_ec_adaptive (tcec/detail/adaptive.hpp)
+// scale_a / scale_b : max|A.x| / max|B.x| over the fragments
+inline float adaptive_threshold(const float tolerance, const float scale_a, const float scale_b) {
+	return tolerance / 2 * (scale_a * scale_b);
+}
+
+// Host reference of the correction selection of with_ec_adaptive in a `mma_sync` of (m, n, k) fragments.
+// A : m x k (col major), B : k x n (col major), (fm, fn, fk) : Policy::{m, n, k}
+// skip_a / skip_b (nullable) : whether the correction mma A.dx * B.x / A.x * B.dx of the sub fragments (bm, bn, bk) is skipped.
+//     They are stored at [bm + bn * (m / fm) + bk * (m / fm) * (n / fn)].
+// Returns the number of the skipped correction mma, which is `num_skipped_mma` of the device.
+template <class T>
+inline unsigned adaptive_correction(
+		bool* const skip_a, bool* const skip_b,
+		const unsigned m, const unsigned n, const unsigned k,
+		const unsigned fm, const unsigned fn, const unsigned fk,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float tolerance
+		) {
+	const auto num_m_block = m / fm;
+	const auto num_n_block = n / fn;
+	const auto num_k_block = k / fk;
+
+	// max(a, b) which propagates nan as the device does
+	const auto max_nan = [](const float a, const float b) {
+		return (std::isnan(b) || b > a) ? b : a;
+	};
+	// max|x| and max|dx| of the sub fragments
+	const auto max_abs = [&](
+			const float* const ptr, const unsigned ld, const unsigned rows, const unsigned cols,
+			float& max_hi, float& max_lo) {
+		max_hi = 0.f;
+		max_lo = 0.f;
+		for (unsigned j = 0; j < cols; j++) {
+			for (unsigned i = 0; i < rows; i++) {
+				float hv, dhv;
+				split<T>(ptr[i + j * static_cast<std::size_t>(ld)], hv, dhv);
+				max_hi = max_nan(max_hi, std::abs(hv));
+				max_lo = max_nan(max_lo, std::abs(dhv));
+			}
+		}
+	};
+	std::vector<float> a_hi(num_m_block * num_k_block), a_lo(num_m_block * num_k_block);
+	std::vector<float> b_hi(num_k_block * num_n_block), b_lo(num_k_block * num_n_block);
+	float scale_a = 0.f, scale_b = 0.f;
+	for (unsigned bk = 0; bk < num_k_block; bk++) {
+		for (unsigned bm = 0; bm < num_m_block; bm++) {
+			const auto index = bm + bk * num_m_block;
+			max_abs(a_ptr + bm * fm + bk * fk * static_cast<std::size_t>(lda), lda, fm, fk, a_hi[index], a_lo[index]);
+			scale_a = max_nan(scale_a, a_hi[index]);
+		}
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			const auto index = bk + bn * num_k_block;
+			max_abs(b_ptr + bk * fk + bn * fn * static_cast<std::size_t>(ldb), ldb, fk, fn, b_hi[index], b_lo[index]);
+			scale_b = max_nan(scale_b, b_hi[index]);
+		}
+	}
+	const auto threshold = adaptive_threshold(tolerance, scale_a, scale_b);
+
+	unsigned num_skipped_mma = 0;
+	for (unsigned bk = 0; bk < num_k_block; bk++) {
+		for (unsigned bn = 0; bn < num_n_block; bn++) {
+			for (unsigned bm = 0; bm < num_m_block; bm++) {
+				const auto a_index = bm + bk * num_m_block;
+				const auto b_index = bk + bn * num_k_block;
+				const auto index = bm + bn * num_m_block + bk * num_m_block * num_n_block;
+				const bool sa = correction_scale_1<T>(a_lo[a_index] * b_hi[b_index]) <= threshold;
+				const bool sb = correction_scale_1<T>(a_hi[a_index] * b_lo[b_index]) <= threshold;
+				if (skip_a) skip_a[index] = sa;
+				if (skip_b) skip_b[index] = sb;
+				num_skipped_mma += sa + sb;
+			}
+		}
+	}
+	return num_skipped_mma;
+}
+
+namespace detail {
+template <class T, class ErrorCorrection>
+struct dot_core;
+
+template <class T>
+struct dot_core<T, mtk::wmma::tcec::with_ec> {
+	float operator()(
+			const unsigned k, const unsigned fk,
+			const float* const a, const unsigned inc_a,
+			const float* const b, const unsigned inc_b,
+			const float c,
+			const float mul_a
+			) const {
+		// As mma_rn_sync of with_ec, the product A.x * B.x of each sub fragment is computed from zero and then added to D,
+		// and the correction terms are accumulated over k.
+		float d = c;
+		float dd = 0.f;
+		for (unsigned bk = 0; bk < k; bk += fk) {
+			float tmp = 0.f;
+			for (unsigned l = bk; l < bk + fk && l < k; l++) {
+				float a_hv, a_dhv, b_hv, b_dhv;
+				split<T>(a[l * inc_a] * mul_a, a_hv, a_dhv);
+				split<T>(b[l * inc_b], b_hv, b_dhv);
+				dd  = std::fma(a_dhv, b_hv, dd);
+				dd  = std::fma(a_hv, b_dhv, dd);
+				tmp = std::fma(a_hv, b_hv, tmp);
+			}
+			d = d + tmp;
+		}
+		return d + correction_scale_1<T>(dd);
+	}
+};
+
+template <class T>
+struct dot_core<T, mtk::wmma::tcec::without_ec> {
+	float operator()(
+			const unsigned k, const unsigned,
+			const float* const a, const unsigned inc_a,
+			const float* const b, const unsigned inc_b,
+			const float c,
+			const float mul_a
+			) const {
+		float d = c;
+		for (unsigned l = 0; l < k; l++) {
+			d = std::fma(cast<T>(a[l * inc_a] * mul_a), cast<T>(b[l * inc_b]), d);
+		}
+		return d;
+	}
+};
+
+// op_simt : each sub fragment mma accumulates from zero and then adds C
+template <>
+struct dot_core<fp32, mtk::wmma::tcec::without_ec> {
+	float operator()(
+			const unsigned k, const unsigned fk,
+			const float* const a, const unsigned inc_a,
+			const float* const b, const unsigned inc_b,
+			const float c,
+			const float mul_a
+			) const {
+		float d = c;
+		for (unsigned bk = 0; bk < k; bk += fk) {
+			float acc = 0.f;
+			for (unsigned l = bk; l < bk + fk && l < k; l++) {
+				acc = std::fma(a[l * inc_a] * mul_a, b[l * inc_b], acc);
+			}
+			d = acc + d;
+		}
+		return d;
+	}
+};
+} // namespace detail
+
+// Emulates an element of D computed by a chain of `tcec::mma_sync` over k
+// The order of the accumulation of the sub fragments is the same as the device (mma_rn_sync),
+// while the accumulation inside a sub fragment mma is a chain of FP32 fma, which is not bitwise identical to the Tensor Cores.
+// fk    : Policy::k
+// mul_a : the scaling factor of `tcec::load_matrix_sync_with_mul` for A
+template <class T, class ErrorCorrection>
+inline float dot(
+		const unsigned k, const unsigned fk,
+		const float* const a, const unsigned inc_a,
+		const float* const b, const unsigned inc_b,
+		const float c = 0.f,
+		const float mul_a = 1.f
+		) {
+	return detail::dot_core<T, ErrorCorrection>{}(k, fk, a, inc_a, b, inc_b, c, mul_a);
+}
+
+// Emulates C[tile_m:tile_m+tile_size_m, tile_n:tile_n+tile_size_n] = alpha * A * B + beta * C
+// in the same way as the TCEC GEMM kernels (A is scaled by alpha when it is loaded).
+// A : row major, B : col major, C : col major
+template <class T, class ErrorCorrection>
+inline void gemm_tile(
+		const unsigned tile_m, const unsigned tile_n,
+		const unsigned tile_size_m, const unsigned tile_size_n,
+		const unsigned k, const unsigned fk,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	for (unsigned j = tile_n; j < tile_n + tile_size_n; j++) {
+		for (unsigned i = tile_m; i < tile_m + tile_size_m; i++) {
+			float* const c = c_ptr + i + j * static_cast<std::size_t>(ldc);
+			float c_in = 0.f;
+			if (beta != 0.f) {
+				c_in = *c * beta;
+			}
+			*c = dot<T, ErrorCorrection>(k, fk, a_ptr + i * static_cast<std::size_t>(lda), 1, b_ptr + j * static_cast<std::size_t>(ldb), 1, c_in, alpha);
+		}
+	}
+}
+
+} // namespace host
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
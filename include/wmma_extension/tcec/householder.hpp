@@ -0,0 +1,378 @@
+#ifndef __WMMAE_TCEC_HOUSEHOLDER_HPP__
+#define __WMMAE_TCEC_HOUSEHOLDER_HPP__
+#include "tcec.hpp"
+#include "householder_host.hpp"
+
+// Batched Householder QR factorization of small (N x N, N = 16 or 32) matrices
+//   QR       : A = Q * R                  (one matrix per warp)
+//   Apply Q  : B = Q^T * B or B = Q * B   (B : N x NRHS)
+// The factorization is stored in the LAPACK (geqrf) format. See householder_host.hpp for the host references.
+// The reflectors are computed column by column in FP32 and applied in the compact WY form
+//   H_p * H_{p+1} * ... * H_{p+15} = I - V * T * V^T
+// with three fragment GEMMs per panel of 16 columns, so that the error correction of tcec gives FP32 accuracy.
+// All matrices are col major.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace householder {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+
+// The number of the columns of a panel
+constexpr unsigned panel = 16;
+
+// The size of the workspace of a warp (floats)
+//   V : N x panel, T : panel x panel, W : panel x panel
+template <unsigned N>
+struct workspace_size {
+	static const unsigned value = N * panel + 2 * panel * panel;
+};
+
+template <unsigned N>
+__device__ inline float warp_sum(float v) {
+	for (unsigned offset = N / 2; offset > 0; offset >>= 1) {
+		v += __shfl_xor_sync(0xffffffff, v, offset);
+	}
+	return v;
+}
+
+// Factorize the columns p:p+panel of A (rows p:N) without updating the trailing matrix
+// The lane `i` owns the row `i` while computing the reflector and the column `k + 1 + i` while applying it.
+template <unsigned N>
+__device__ inline void factorize_panel(
+		const unsigned p,
+		float* const a_ptr, const unsigned lda,
+		float* const tau_ptr
+		) {
+	const unsigned lane_id = threadIdx.x % 32;
+	for (unsigned k = p; k < p + panel; k++) {
+		float* const v_ptr = a_ptr + k * static_cast<std::size_t>(lda);
+		const float alpha = v_ptr[k];
+		const float x = (lane_id > k && lane_id < N) ? v_ptr[lane_id] : 0.f;
+		const float sigma = warp_sum<32>(x * x);
+		__syncwarp();
+
+		// Same as LAPACK slarfg except for the rescaling of tiny columns
+		float tau = 0.f;
+		if (sigma != 0.f) {
+			const float beta = -copysignf(sqrtf(alpha * alpha + sigma), alpha);
+			tau = (beta - alpha) / beta;
+			if (lane_id > k && lane_id < N) {
+				v_ptr[lane_id] = x / (alpha - beta);
+			}
+			if (lane_id == 0) {
+				v_ptr[k] = beta;
+			}
+		}
+		if (lane_id == 0) {
+			tau_ptr[k] = tau;
+		}
+		__syncwarp();
+
+		for (unsigned j = k + 1 + lane_id; j < p + panel; j += 32) {
+			float* const c_ptr = a_ptr + j * static_cast<std::size_t>(lda);
+			float w = c_ptr[k];
+			for (unsigned i = k + 1; i < N; i++) {
+				w += v_ptr[i] * c_ptr[i];
+			}
+			w *= tau;
+			c_ptr[k] -= w;
+			for (unsigned i = k + 1; i < N; i++) {
+				c_ptr[i] -= v_ptr[i] * w;
+			}
+		}
+		__syncwarp();
+	}
+}
+
+// Build V (N x panel, ld = N) with the unit diagonal and zeros above it and the upper triangular T (panel x panel, ld = panel)
+// of the panel `p` from the factorized matrix (LAPACK slarft, forward and columnwise)
+template <unsigned N>
+__device__ inline void build_wy(
+		const unsigned p,
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const v_buf,
+		float* const t_buf
+		) {
+	const unsigned lane_id = threadIdx.x % 32;
+	for (unsigned index = lane_id; index < N * panel; index += 32) {
+		const auto i = index % N;
+		const auto l = index / N;
+		const auto k = p + l;
+		v_buf[index] = i < k ? 0.f : (i == k ? 1.f : qr_ptr[i + k * static_cast<std::size_t>(ldqr)]);
+	}
+	for (unsigned index = lane_id; index < panel * panel; index += 32) {
+		t_buf[index] = 0.f;
+	}
+	__syncwarp();
+
+	// T[0:l, l] = -tau[l] * T[0:l, 0:l] * V[:, 0:l]^T * v_l, T[l, l] = tau[l]
+	for (unsigned l = 0; l < panel; l++) {
+		const float tau = tau_ptr[p + l];
+		if (lane_id < l) {
+			float z = 0.f;
+			for (unsigned i = p + l; i < N; i++) {
+				z += v_buf[i + lane_id * N] * v_buf[i + l * N];
+			}
+			t_buf[lane_id + l * panel] = z;
+		}
+		__syncwarp();
+		float s = 0.f;
+		if (lane_id < l) {
+			for (unsigned j = lane_id; j < l; j++) {
+				s += t_buf[lane_id + j * panel] * t_buf[j + l * panel];
+			}
+		}
+		__syncwarp();
+		if (lane_id < l) {
+			t_buf[lane_id + l * panel] = -tau * s;
+		}
+		if (lane_id == l) {
+			t_buf[l + l * panel] = tau;
+		}
+		__syncwarp();
+	}
+}
+
+// C (N x panel) = (I - V * op(T) * V^T) * C, op(T) = T^T if TRANSPOSE, T otherwise
+//   W = V^T * C, W = op(T) * W, C = C - V * W
+template <unsigned N, bool TRANSPOSE, class T, class Policy>
+__device__ inline void apply_wy(
+		const float* const v_buf,
+		const float* const t_buf,
+		float* const w_buf,
+		float* const c_ptr, const unsigned ldc
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , panel, panel, N, T, nvcuda::wmma::row_major, Policy> frag_vt;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , panel, panel, N, T, nvcuda::wmma::col_major, Policy> frag_c;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, panel, panel, N, T, void                   , Policy> frag_w;
+
+	// V^T is a row major matrix with the same ld
+	mtk::wmma::tcec::load_matrix_sync(frag_vt, v_buf, N, false);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, ldc, false);
+	mtk::wmma::tcec::fill_zero(frag_w);
+	mtk::wmma::tcec::mma_sync(frag_w, frag_vt, frag_c, frag_w);
+	mtk::wmma::tcec::store_matrix_sync(w_buf, frag_w, panel, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , panel, panel, panel, T, nvcuda::wmma::row_major, Policy> frag_t;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , panel, panel, panel, T, nvcuda::wmma::col_major, Policy> frag_tw;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, panel, panel, panel, T, void                   , Policy> frag_tw_acc;
+	if (TRANSPOSE) {
+		mtk::wmma::tcec::load_matrix_sync(frag_t, t_buf, panel, false);
+	} else {
+		mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_t, t_buf, panel, false);
+	}
+	mtk::wmma::tcec::load_matrix_sync(frag_tw, w_buf, panel);
+	mtk::wmma::tcec::fill_zero(frag_tw_acc);
+	mtk::wmma::tcec::mma_sync(frag_tw_acc, frag_t, frag_tw, frag_tw_acc);
+	mtk::wmma::tcec::store_matrix_sync(w_buf, frag_tw_acc, panel, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, panel, panel, T, nvcuda::wmma::row_major, Policy> frag_v;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, panel, panel, T, nvcuda::wmma::col_major, Policy> frag_w2;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, panel, panel, T, void                   , Policy> frag_out;
+	mtk::wmma::tcec::load_matrix_sync_with_mul<nvcuda::wmma::col_major>(frag_v, v_buf, N, -1.f, false);
+	mtk::wmma::tcec::load_matrix_sync(frag_w2, w_buf, panel);
+	mtk::wmma::tcec::load_matrix_sync(frag_out, c_ptr, ldc, nvcuda::wmma::mem_col_major, false);
+	mtk::wmma::tcec::mma_sync(frag_out, frag_v, frag_w2, frag_out);
+	mtk::wmma::tcec::store_matrix_sync(c_ptr, frag_out, ldc, nvcuda::wmma::mem_col_major);
+}
+
+// B (N x NRHS) = op(Q) * B
+template <unsigned N, unsigned NRHS, bool TRANSPOSE, class T, class Policy>
+__device__ inline void apply_q(
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb,
+		float* const work
+		) {
+	static_assert(NRHS % panel == 0, "NRHS must be a multiple of 16");
+	float* const v_buf = work;
+	float* const t_buf = v_buf + N * panel;
+	float* const w_buf = t_buf + panel * panel;
+	// Q^T = (I - V_{N/16-1} T_{N/16-1} V_{N/16-1}^T)^T * ... * (I - V_0 T_0 V_0^T)^T
+	for (unsigned l = 0; l < N / panel; l++) {
+		const unsigned p = (TRANSPOSE ? l : N / panel - 1 - l) * panel;
+		detail::build_wy<N>(p, qr_ptr, ldqr, tau_ptr, v_buf, t_buf);
+		for (unsigned j = 0; j < NRHS; j += panel) {
+			detail::apply_wy<N, TRANSPOSE, T, Policy>(v_buf, t_buf, w_buf, b_ptr + j * static_cast<std::size_t>(ldb), ldb);
+		}
+	}
+}
+} // namespace detail
+
+// A (N x N) = Q * R in the LAPACK (geqrf) format
+// tau_ptr : N floats
+// work    : detail::workspace_size<N>::value floats used by the warp (e.g. shared memory)
+template <unsigned N, class T, class Policy>
+__device__ inline void qr(
+		float* const a_ptr, const unsigned lda,
+		float* const tau_ptr,
+		float* const work
+		) {
+	static_assert(N == 16 || N == 32, "N must be 16 or 32");
+	float* const v_buf = work;
+	float* const t_buf = v_buf + N * detail::panel;
+	float* const w_buf = t_buf + detail::panel * detail::panel;
+	for (unsigned p = 0; p < N; p += detail::panel) {
+		detail::factorize_panel<N>(p, a_ptr, lda, tau_ptr);
+		if (p + detail::panel == N) {
+			break;
+		}
+		// The trailing matrix
+		detail::build_wy<N>(p, a_ptr, lda, tau_ptr, v_buf, t_buf);
+		for (unsigned j = p + detail::panel; j < N; j += detail::panel) {
+			detail::apply_wy<N, true, T, Policy>(v_buf, t_buf, w_buf, a_ptr + j * static_cast<std::size_t>(lda), lda);
+		}
+	}
+}
+
+// B (N x NRHS) = Q^T * B
+// qr_ptr / tau_ptr : the output of qr
+// work             : detail::workspace_size<N>::value floats used by the warp (e.g. shared memory)
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__device__ inline void apply_qt(
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb,
+		float* const work
+		) {
+	detail::apply_q<N, NRHS, true, T, Policy>(qr_ptr, ldqr, tau_ptr, b_ptr, ldb, work);
+}
+
+// B (N x NRHS) = Q * B
+template <unsigned N, unsigned NRHS, class T, class Policy>
+__device__ inline void apply_q(
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb,
+		float* const work
+		) {
+	detail::apply_q<N, NRHS, false, T, Policy>(qr_ptr, ldqr, tau_ptr, b_ptr, ldb, work);
+}
+
+// The matrices of a batch are stored contiguously (A : N x N, ld = N, tau : N).
+template <unsigned N, class T, class Policy>
+__global__ void qr_kernel(
+		const unsigned batch_size,
+		float* const a_ptr,
+		float* const tau_ptr
+		) {
+	__shared__ float smem[detail::num_warps][N * N + detail::workspace_size<N>::value];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const a_smem = smem[warp_id];
+	float* const work = a_smem + N * N;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		float* const a_batch_ptr = a_ptr + static_cast<std::size_t>(batch_id) * N * N;
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			a_smem[i] = a_batch_ptr[i];
+		}
+		__syncwarp();
+		qr<N, T, Policy>(a_smem, N, tau_ptr + static_cast<std::size_t>(batch_id) * N, work);
+		for (unsigned i = lane_id; i < N * N; i += 32) {
+			a_batch_ptr[i] = a_smem[i];
+		}
+		__syncwarp();
+	}
+}
+
+// The matrices of a batch are stored contiguously (QR : N x N, ld = N, tau : N, B : N x NRHS, ld = N).
+template <unsigned N, unsigned NRHS, bool TRANSPOSE, class T, class Policy>
+__global__ void apply_q_kernel(
+		const unsigned batch_size,
+		const float* const qr_ptr,
+		const float* const tau_ptr,
+		float* const b_ptr
+		) {
+	__shared__ float smem[detail::num_warps][detail::workspace_size<N>::value];
+	const unsigned warp_id = threadIdx.x / 32;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		detail::apply_q<N, NRHS, TRANSPOSE, T, Policy>(
+				qr_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				tau_ptr + static_cast<std::size_t>(batch_id) * N,
+				b_ptr + static_cast<std::size_t>(batch_id) * N * NRHS, N,
+				smem[warp_id]
+				);
+	}
+}
+
+// Launch qr_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, class T, class Policy>
+inline void launch_qr(
+		const unsigned batch_size,
+		float* const a_ptr,
+		float* const tau_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	qr_kernel<N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			a_ptr,
+			tau_ptr
+			);
+}
+
+// Launch apply_q_kernel (B = Q^T * B)
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, unsigned NRHS, class T, class Policy>
+inline void launch_apply_qt(
+		const unsigned batch_size,
+		const float* const qr_ptr,
+		const float* const tau_ptr,
+		float* const b_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	apply_q_kernel<N, NRHS, true, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			qr_ptr,
+			tau_ptr,
+			b_ptr
+			);
+}
+
+// Launch apply_q_kernel (B = Q * B)
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, unsigned NRHS, class T, class Policy>
+inline void launch_apply_q(
+		const unsigned batch_size,
+		const float* const qr_ptr,
+		const float* const tau_ptr,
+		float* const b_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	apply_q_kernel<N, NRHS, false, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			qr_ptr,
+			tau_ptr,
+			b_ptr
+			);
+}
+} // namespace householder
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
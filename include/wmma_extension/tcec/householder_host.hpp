@@ -0,0 +1,128 @@
+#ifndef __WMMAE_TCEC_HOUSEHOLDER_HOST_HPP__
+#define __WMMAE_TCEC_HOUSEHOLDER_HOST_HPP__
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// The host references of mtk::wmma::tcec::householder (see householder.hpp)
+// This header does not depend on CUDA.
+// All matrices are col major.
+// The QR factorization is stored in the LAPACK (geqrf) format:
+//   R is in the upper triangle and the Householder vector v_k is below the diagonal of the column k (v_k[k] = 1 is implicit).
+//   Q = H_0 * H_1 * ... * H_{n-1}, H_k = I - tau[k] * v_k * v_k^T
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace householder {
+namespace host {
+// Reference of mtk::wmma::tcec::householder::launch_qr in double
+// A (n x n) = Q * R
+inline void qr(
+		const unsigned n,
+		float* const a_ptr, const unsigned lda,
+		float* const tau_ptr
+		) {
+	std::vector<double> a(static_cast<std::size_t>(n) * n);
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			a[i + j * static_cast<std::size_t>(n)] = a_ptr[i + j * static_cast<std::size_t>(lda)];
+		}
+	}
+	for (unsigned k = 0; k < n; k++) {
+		double* const v = a.data() + k * static_cast<std::size_t>(n);
+		const double alpha = v[k];
+		double sigma = 0.;
+		for (unsigned i = k + 1; i < n; i++) {
+			sigma += v[i] * v[i];
+		}
+		double tau = 0.;
+		if (sigma != 0.) {
+			const double beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+			tau = (beta - alpha) / beta;
+			for (unsigned i = k + 1; i < n; i++) {
+				v[i] /= alpha - beta;
+			}
+			v[k] = beta;
+		}
+		tau_ptr[k] = static_cast<float>(tau);
+
+		// Apply H_k to the trailing columns
+		for (unsigned j = k + 1; j < n; j++) {
+			double* const c = a.data() + j * static_cast<std::size_t>(n);
+			double w = c[k];
+			for (unsigned i = k + 1; i < n; i++) {
+				w += v[i] * c[i];
+			}
+			c[k] -= tau * w;
+			for (unsigned i = k + 1; i < n; i++) {
+				c[i] -= tau * v[i] * w;
+			}
+		}
+	}
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			a_ptr[i + j * static_cast<std::size_t>(lda)] = static_cast<float>(a[i + j * static_cast<std::size_t>(n)]);
+		}
+	}
+}
+
+// B (n x nrhs) = Q^T * B if `transpose`, Q * B otherwise
+// qr_ptr / tau_ptr : the output of qr
+inline void apply_q(
+		const unsigned n, const unsigned nrhs,
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb,
+		const bool transpose
+		) {
+	std::vector<double> b(n);
+	for (unsigned j = 0; j < nrhs; j++) {
+		float* const b_col_ptr = b_ptr + j * static_cast<std::size_t>(ldb);
+		for (unsigned i = 0; i < n; i++) {
+			b[i] = b_col_ptr[i];
+		}
+		// Q^T = H_{n-1} * ... * H_0
+		for (unsigned l = 0; l < n; l++) {
+			const auto k = transpose ? l : n - 1 - l;
+			const float* const v = qr_ptr + k * static_cast<std::size_t>(ldqr);
+			double w = b[k];
+			for (unsigned i = k + 1; i < n; i++) {
+				w += static_cast<double>(v[i]) * b[i];
+			}
+			w *= tau_ptr[k];
+			b[k] -= w;
+			for (unsigned i = k + 1; i < n; i++) {
+				b[i] -= v[i] * w;
+			}
+		}
+		for (unsigned i = 0; i < n; i++) {
+			b_col_ptr[i] = static_cast<float>(b[i]);
+		}
+	}
+}
+
+// B = Q^T * B
+inline void apply_qt(
+		const unsigned n, const unsigned nrhs,
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	apply_q(n, nrhs, qr_ptr, ldqr, tau_ptr, b_ptr, ldb, true);
+}
+
+// B = Q * B
+inline void apply_q(
+		const unsigned n, const unsigned nrhs,
+		const float* const qr_ptr, const unsigned ldqr,
+		const float* const tau_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	apply_q(n, nrhs, qr_ptr, ldqr, tau_ptr, b_ptr, ldb, false);
+}
+} // namespace host
+} // namespace householder
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,443 @@
+#ifndef __WMMAE_TCEC_JACOBI_HPP__
+#define __WMMAE_TCEC_JACOBI_HPP__
+#include <cfloat>
+#include "tcec.hpp"
+#include "jacobi_host.hpp"
+
+// Batched Jacobi SVD and symmetric eigensolver of small (N x N, N = 16 or 32) matrices (one matrix per warp)
+//   SVD   : A = U * diag(S) * V^T   (one-sided Jacobi)
+//   Eigen : A = Z * diag(W) * Z^T   (two-sided Jacobi, A : symmetric)
+// A sweep consists of N - 1 steps of N / 2 disjoint rotations in the round robin ordering (see jacobi_host.hpp).
+// The rotations of a step form an orthogonal matrix J which is built directly in a fragment (the Givens fragment),
+// and the matrices are updated by mma_sync, e.g. W = W * J, so that the error correction of tcec gives FP32 accuracy.
+// All matrices are col major. See jacobi_host.hpp for the host references.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace jacobi {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+
+// The size of the workspace of a warp (floats)
+//   W : N x N, V : N x N, the diagonal and the off diagonal elements of J : N + N
+template <unsigned N>
+struct workspace_size {
+	static const unsigned value = 2 * N * N + 2 * N;
+};
+
+template <unsigned N>
+__device__ inline float warp_sum(float v) {
+	for (unsigned offset = N / 2; offset > 0; offset >>= 1) {
+		v += __shfl_xor_sync(0xffffffff, v, offset);
+	}
+	return v;
+}
+
+template <unsigned N>
+__device__ inline void make_identity(float* const ptr) {
+	for (unsigned index = threadIdx.x % 32; index < N * N; index += 32) {
+		ptr[index] = (index % N == index / N) ? 1.f : 0.f;
+	}
+}
+
+// X (N x N, ld = N) = X * J
+template <unsigned N, class T, class Policy>
+__device__ inline void rotate_columns(
+		float* const x_ptr,
+		const mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b, N, N, N, T, nvcuda::wmma::col_major, Policy>& frag_j
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, nvcuda::wmma::row_major, Policy> frag_x;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void                   , Policy> frag_y;
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_x, x_ptr, N);
+	mtk::wmma::tcec::fill_zero(frag_y);
+	mtk::wmma::tcec::mma_sync(frag_y, frag_x, frag_j, frag_y);
+	mtk::wmma::tcec::store_matrix_sync(x_ptr, frag_y, N, nvcuda::wmma::mem_col_major);
+}
+
+// Compute the rotations of the step `step` and store (c, -s) / (c, s) to diag_buf and off_buf at the columns p / q
+// `pair_entries(p, q, alpha, beta, gamma, threshold)` gives the 2x2 symmetric matrix to be diagonalized and
+// the pair is rotated if |gamma| > threshold_scale * threshold.
+// Returns true if any of the pairs are rotated
+template <unsigned N, class PairEntries>
+__device__ inline bool compute_rotations(
+		const unsigned step,
+		const float threshold_scale,
+		float* const diag_buf,
+		float* const off_buf,
+		PairEntries pair_entries
+		) {
+	const unsigned lane_id = threadIdx.x % 32;
+	bool rotated = false;
+	if (lane_id < N / 2) {
+		unsigned p, q;
+		mtk::wmma::tcec::jacobi::round_robin_pair(N, step, lane_id, p, q);
+		float alpha, beta, gamma, threshold;
+		pair_entries(p, q, alpha, beta, gamma, threshold);
+		float c = 1.f, s = 0.f;
+		if (fabsf(gamma) > threshold_scale * threshold) {
+			mtk::wmma::tcec::jacobi::rotation(alpha, beta, gamma, c, s);
+			rotated = true;
+		}
+		diag_buf[p] = c;
+		diag_buf[q] = c;
+		off_buf[p] = -s;
+		off_buf[q] = s;
+	}
+	__syncwarp();
+	return __any_sync(0xffffffff, rotated);
+}
+
+// Sort the N values held by the lanes (lane j : the value j) and return the rank of the value of the lane
+// The ties are ordered by the index.
+template <unsigned N, bool DESCENDING>
+__device__ inline unsigned rank(const float v) {
+	const unsigned lane_id = threadIdx.x % 32;
+	unsigned r = 0;
+	for (unsigned l = 0; l < N; l++) {
+		const auto u = __shfl_sync(0xffffffff, v, l);
+		r += (DESCENDING ? (u > v) : (u < v)) || (u == v && l < lane_id);
+	}
+	return r;
+}
+} // namespace detail
+
+// Make the (N x N) fragment of the N / 2 disjoint rotations of the step `step` (the Givens fragment)
+//   J[j, j] = diag[j], J[partner(j), j] = off[j], 0 otherwise
+// The transposed J is made if `transpose` (e.g. matrix_a for J^T * X).
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk>
+__device__ void make_rotation_fragment(
+		fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag,
+		const unsigned step,
+		const float* const diag_buf,
+		const float* const off_buf,
+		const bool transpose = false
+		) {
+	static_assert(m == n && n == k, "The fragment must be square");
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto row = transpose ? j + bn * frag_n : i + bm * frag_m;
+						const auto col = transpose ? i + bm * frag_m : j + bn * frag_n;
+						float v = 0.f;
+						if (row == col) {
+							v = diag_buf[col];
+						} else if (row == mtk::wmma::tcec::jacobi::round_robin_partner(n, step, col)) {
+							v = off_buf[col];
+						}
+						const auto hv = mtk::wmma::detail::common::cast<T>(v);
+						const auto dhv = mtk::wmma::detail::common::cast<T>(mtk::wmma::tcec::detail::correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(hv)));
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							const auto frag_index = frag_index_list[f];
+							frag.sub_frag  [bm + frag.num_sub_frag_m * bn].x[frag_index] = hv ;
+							frag.sub_d_frag[bm + frag.num_sub_frag_m * bn].x[frag_index] = dhv;
+						}
+					}
+				}
+			});
+}
+
+// A (N x N) = U * diag(S) * V^T by the one-sided Jacobi method
+//   W = A * J_0 * J_1 * ... converges to U * diag(S) and V = J_0 * J_1 * ...
+// A pair of the columns (p, q) is rotated if |w_p^T w_q| > tolerance * |w_p| * |w_q|.
+// S is in descending order and the columns of U for the zero singular values are zero.
+// work : detail::workspace_size<N>::value floats used by the warp (e.g. shared memory)
+// Returns the number of the sweeps including the last one without any rotation
+template <unsigned N, class T, class Policy>
+__device__ inline unsigned svd(
+		const float* const a_ptr, const unsigned lda,
+		float* const s_ptr,
+		float* const u_ptr, const unsigned ldu,
+		float* const v_ptr, const unsigned ldv,
+		float* const work,
+		const unsigned max_sweeps = 16,
+		const float tolerance = N * FLT_EPSILON
+		) {
+	static_assert(N == 16 || N == 32, "N must be 16 or 32");
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const w_buf = work;
+	float* const v_buf = w_buf + N * N;
+	float* const diag_buf = v_buf + N * N;
+	float* const off_buf = diag_buf + N;
+
+	for (unsigned index = lane_id; index < N * N; index += 32) {
+		w_buf[index] = a_ptr[index % N + index / N * static_cast<std::size_t>(lda)];
+	}
+	detail::make_identity<N>(v_buf);
+	__syncwarp();
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b, N, N, N, T, nvcuda::wmma::col_major, Policy> frag_j;
+	unsigned sweep = 0;
+	while (sweep < max_sweeps) {
+		sweep++;
+		bool rotated = false;
+		for (unsigned step = 0; step + 1 < N; step++) {
+			const auto step_rotated = detail::compute_rotations<N>(step, tolerance, diag_buf, off_buf,
+					[&](const unsigned p, const unsigned q, float& alpha, float& beta, float& gamma, float& threshold) {
+						alpha = beta = gamma = 0.f;
+						for (unsigned i = 0; i < N; i++) {
+							const auto wp = w_buf[i + p * N];
+							const auto wq = w_buf[i + q * N];
+							alpha += wp * wp;
+							beta += wq * wq;
+							gamma += wp * wq;
+						}
+						threshold = sqrtf(alpha * beta);
+					});
+			// Skip the step if all pairs are already orthogonal
+			if (!step_rotated) {
+				continue;
+			}
+			rotated = true;
+			make_rotation_fragment(frag_j, step, diag_buf, off_buf);
+			detail::rotate_columns<N, T, Policy>(w_buf, frag_j);
+			detail::rotate_columns<N, T, Policy>(v_buf, frag_j);
+		}
+		if (!rotated) {
+			break;
+		}
+	}
+
+	// S = the norms of the columns of W
+	float sigma = 0.f;
+	if (lane_id < N) {
+		for (unsigned i = 0; i < N; i++) {
+			sigma += w_buf[i + lane_id * N] * w_buf[i + lane_id * N];
+		}
+		sigma = sqrtf(sigma);
+	}
+	const auto r = detail::rank<N, true>(lane_id < N ? sigma : -1.f);
+	if (lane_id < N) {
+		s_ptr[r] = sigma;
+	}
+	for (unsigned j = 0; j < N; j++) {
+		const auto rj = __shfl_sync(0xffffffff, r, j);
+		const auto sj = __shfl_sync(0xffffffff, sigma, j);
+		for (unsigned i = lane_id; i < N; i += 32) {
+			u_ptr[i + rj * static_cast<std::size_t>(ldu)] = sj == 0.f ? 0.f : w_buf[i + j * N] / sj;
+			v_ptr[i + rj * static_cast<std::size_t>(ldv)] = v_buf[i + j * N];
+		}
+	}
+	__syncwarp();
+	return sweep;
+}
+
+// A (N x N, symmetric) = Z * diag(W) * Z^T by the two-sided Jacobi method
+//   A = J^T * A * J for each step and Z = J_0 * J_1 * ...
+// Only the lower triangle of A is referenced.
+// A pair (p, q) is rotated if |a_pq| > tolerance * |A|_F.
+// W is in ascending order.
+// work : detail::workspace_size<N>::value floats used by the warp (e.g. shared memory)
+// Returns the number of the sweeps including the last one without any rotation
+template <unsigned N, class T, class Policy>
+__device__ inline unsigned eigen(
+		const float* const a_ptr, const unsigned lda,
+		float* const w_ptr,
+		float* const z_ptr, const unsigned ldz,
+		float* const work,
+		const unsigned max_sweeps = 16,
+		const float tolerance = FLT_EPSILON
+		) {
+	static_assert(N == 16 || N == 32, "N must be 16 or 32");
+	const unsigned lane_id = threadIdx.x % 32;
+	float* const x_buf = work;
+	float* const v_buf = x_buf + N * N;
+	float* const diag_buf = v_buf + N * N;
+	float* const off_buf = diag_buf + N;
+
+	float norm2 = 0.f;
+	for (unsigned index = lane_id; index < N * N; index += 32) {
+		const auto i = index % N;
+		const auto j = index / N;
+		const auto v = i >= j ? a_ptr[i + j * static_cast<std::size_t>(lda)] : a_ptr[j + i * static_cast<std::size_t>(lda)];
+		x_buf[index] = v;
+		norm2 += v * v;
+	}
+	const auto norm = sqrtf(detail::warp_sum<32>(norm2));
+	detail::make_identity<N>(v_buf);
+	__syncwarp();
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, nvcuda::wmma::row_major, Policy> frag_jt;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, nvcuda::wmma::col_major, Policy> frag_j;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, nvcuda::wmma::col_major, Policy> frag_x;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void                   , Policy> frag_y;
+	unsigned sweep = 0;
+	while (sweep < max_sweeps) {
+		sweep++;
+		bool rotated = false;
+		for (unsigned step = 0; step + 1 < N; step++) {
+			const auto step_rotated = detail::compute_rotations<N>(step, tolerance, diag_buf, off_buf,
+					[&](const unsigned p, const unsigned q, float& alpha, float& beta, float& gamma, float& threshold) {
+						alpha = x_buf[p + p * N];
+						beta = x_buf[q + q * N];
+						gamma = x_buf[p + q * N];
+						threshold = norm;
+					});
+			if (!step_rotated) {
+				continue;
+			}
+			rotated = true;
+			make_rotation_fragment(frag_j, step, diag_buf, off_buf);
+			make_rotation_fragment(frag_jt, step, diag_buf, off_buf, true);
+			// X = J^T * (X * J)
+			detail::rotate_columns<N, T, Policy>(x_buf, frag_j);
+			mtk::wmma::tcec::load_matrix_sync(frag_x, x_buf, N);
+			mtk::wmma::tcec::fill_zero(frag_y);
+			mtk::wmma::tcec::mma_sync(frag_y, frag_jt, frag_x, frag_y);
+			mtk::wmma::tcec::store_matrix_sync(x_buf, frag_y, N, nvcuda::wmma::mem_col_major);
+			detail::rotate_columns<N, T, Policy>(v_buf, frag_j);
+		}
+		if (!rotated) {
+			break;
+		}
+	}
+
+	const float lambda = lane_id < N ? x_buf[lane_id * (N + 1)] : 0.f;
+	const auto r = detail::rank<N, false>(lane_id < N ? lambda : FLT_MAX);
+	if (lane_id < N) {
+		w_ptr[r] = lambda;
+	}
+	for (unsigned j = 0; j < N; j++) {
+		const auto rj = __shfl_sync(0xffffffff, r, j);
+		for (unsigned i = lane_id; i < N; i += 32) {
+			z_ptr[i + rj * static_cast<std::size_t>(ldz)] = v_buf[i + j * N];
+		}
+	}
+	__syncwarp();
+	return sweep;
+}
+
+// The matrices of a batch are stored contiguously (A / U / V : N x N, ld = N, S : N).
+// num_sweeps_ptr : the number of the sweeps of each matrix (optional, nullptr)
+template <unsigned N, class T, class Policy>
+__global__ void svd_kernel(
+		const unsigned batch_size,
+		const float* const a_ptr,
+		float* const s_ptr,
+		float* const u_ptr,
+		float* const v_ptr,
+		unsigned* const num_sweeps_ptr,
+		const unsigned max_sweeps,
+		const float tolerance
+		) {
+	__shared__ float smem[detail::num_warps][detail::workspace_size<N>::value];
+	const unsigned warp_id = threadIdx.x / 32;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		const auto num_sweeps = svd<N, T, Policy>(
+				a_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				s_ptr + static_cast<std::size_t>(batch_id) * N,
+				u_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				v_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				smem[warp_id],
+				max_sweeps,
+				tolerance
+				);
+		if (num_sweeps_ptr != nullptr && threadIdx.x % 32 == 0) {
+			num_sweeps_ptr[batch_id] = num_sweeps;
+		}
+	}
+}
+
+// The matrices of a batch are stored contiguously (A / Z : N x N, ld = N, W : N).
+// num_sweeps_ptr : the number of the sweeps of each matrix (optional, nullptr)
+template <unsigned N, class T, class Policy>
+__global__ void eigen_kernel(
+		const unsigned batch_size,
+		const float* const a_ptr,
+		float* const w_ptr,
+		float* const z_ptr,
+		unsigned* const num_sweeps_ptr,
+		const unsigned max_sweeps,
+		const float tolerance
+		) {
+	__shared__ float smem[detail::num_warps][detail::workspace_size<N>::value];
+	const unsigned warp_id = threadIdx.x / 32;
+	for (unsigned batch_id = warp_id + blockIdx.x * (blockDim.x / 32); batch_id < batch_size; batch_id += gridDim.x * (blockDim.x / 32)) {
+		const auto num_sweeps = eigen<N, T, Policy>(
+				a_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				w_ptr + static_cast<std::size_t>(batch_id) * N,
+				z_ptr + static_cast<std::size_t>(batch_id) * N * N, N,
+				smem[warp_id],
+				max_sweeps,
+				tolerance
+				);
+		if (num_sweeps_ptr != nullptr && threadIdx.x % 32 == 0) {
+			num_sweeps_ptr[batch_id] = num_sweeps;
+		}
+	}
+}
+
+// Launch svd_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, class T, class Policy>
+inline void launch_svd(
+		const unsigned batch_size,
+		const float* const a_ptr,
+		float* const s_ptr,
+		float* const u_ptr,
+		float* const v_ptr,
+		unsigned* const num_sweeps_ptr = nullptr,
+		const unsigned max_sweeps = 16,
+		const float tolerance = N * FLT_EPSILON,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	svd_kernel<N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			a_ptr,
+			s_ptr,
+			u_ptr,
+			v_ptr,
+			num_sweeps_ptr,
+			max_sweeps,
+			tolerance
+			);
+}
+
+// Launch eigen_kernel
+// num_blocks == 0 : one matrix per warp
+template <unsigned N, class T, class Policy>
+inline void launch_eigen(
+		const unsigned batch_size,
+		const float* const a_ptr,
+		float* const w_ptr,
+		float* const z_ptr,
+		unsigned* const num_sweeps_ptr = nullptr,
+		const unsigned max_sweeps = 16,
+		const float tolerance = FLT_EPSILON,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (batch_size == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (batch_size + detail::num_warps - 1) / detail::num_warps;
+	}
+	eigen_kernel<N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			batch_size,
+			a_ptr,
+			w_ptr,
+			z_ptr,
+			num_sweeps_ptr,
+			max_sweeps,
+			tolerance
+			);
+}
+} // namespace jacobi
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
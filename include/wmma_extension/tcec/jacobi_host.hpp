@@ -0,0 +1,226 @@
+#ifndef __WMMAE_TCEC_JACOBI_HOST_HPP__
+#define __WMMAE_TCEC_JACOBI_HOST_HPP__
+#include <cmath>
+#include <cfloat>
+#include <cstddef>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "../detail/host_device.hpp"
+
+// The rotation ordering and the host references of mtk::wmma::tcec::jacobi (see jacobi.hpp)
+// This header does not depend on CUDA.
+// All matrices are col major.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace jacobi {
+
+// The `k`-th pair (p < q) of the step `step` (0 <= step < n - 1) of a round robin sweep of n (even) columns
+// The n / 2 pairs of a step are disjoint and a sweep covers all n * (n - 1) / 2 pairs once.
+WMMAE_HOST_DEVICE inline void round_robin_pair(const unsigned n, const unsigned step, const unsigned k, unsigned& p, unsigned& q) {
+	unsigned a, b;
+	if (k == 0) {
+		a = step;
+		b = n - 1;
+	} else {
+		a = (step + k) % (n - 1);
+		b = (step + n - 1 - k) % (n - 1);
+	}
+	p = a < b ? a : b;
+	q = a < b ? b : a;
+}
+
+// The column paired with the column `j` in the step `step` (see round_robin_pair)
+WMMAE_HOST_DEVICE inline unsigned round_robin_partner(const unsigned n, const unsigned step, const unsigned j) {
+	if (j == n - 1) {
+		return step;
+	}
+	if (j == step) {
+		return n - 1;
+	}
+	// The pairs of the step are (step + k, step - k) mod (n - 1)
+	return (2 * step + 2 * (n - 1) - j) % (n - 1);
+}
+
+// The rotation J = [[c, s], [-s, c]] such that J^T * [[alpha, gamma], [gamma, beta]] * J is diagonal (gamma != 0)
+template <class T>
+WMMAE_HOST_DEVICE inline void rotation(const T alpha, const T beta, const T gamma, T& c, T& s) {
+	const T zeta = (beta - alpha) / (2 * gamma);
+	const T t = (zeta >= 0 ? T(1) : T(-1)) / (fabs(zeta) + sqrt(1 + zeta * zeta));
+	c = 1 / sqrt(1 + t * t);
+	s = c * t;
+}
+
+namespace host {
+namespace detail {
+// Apply the rotation of the columns p and q to the (n x n) matrix `a` (ld = n)
+//   a_p = c * a_p - s * a_q, a_q = s * a_p + c * a_q
+inline void rotate_columns(const unsigned n, double* const a, const unsigned p, const unsigned q, const double c, const double s) {
+	for (unsigned i = 0; i < n; i++) {
+		const auto ap = a[i + p * static_cast<std::size_t>(n)];
+		const auto aq = a[i + q * static_cast<std::size_t>(n)];
+		a[i + p * static_cast<std::size_t>(n)] = c * ap - s * aq;
+		a[i + q * static_cast<std::size_t>(n)] = s * ap + c * aq;
+	}
+}
+
+inline void rotate_rows(const unsigned n, double* const a, const unsigned p, const unsigned q, const double c, const double s) {
+	for (unsigned j = 0; j < n; j++) {
+		const auto ap = a[p + j * static_cast<std::size_t>(n)];
+		const auto aq = a[q + j * static_cast<std::size_t>(n)];
+		a[p + j * static_cast<std::size_t>(n)] = c * ap - s * aq;
+		a[q + j * static_cast<std::size_t>(n)] = s * ap + c * aq;
+	}
+}
+
+inline std::vector<double> identity(const unsigned n) {
+	std::vector<double> v(static_cast<std::size_t>(n) * n, 0.);
+	for (unsigned i = 0; i < n; i++) {
+		v[i + i * static_cast<std::size_t>(n)] = 1.;
+	}
+	return v;
+}
+} // namespace detail
+
+// Reference of mtk::wmma::tcec::jacobi::launch_svd in double (one-sided Jacobi with the same ordering)
+// A (n x n) = U * diag(S) * V^T, S is in descending order
+// Returns the number of the sweeps including the last one without any rotation
+inline unsigned svd(
+		const unsigned n,
+		const float* const a_ptr, const unsigned lda,
+		float* const s_ptr,
+		float* const u_ptr, const unsigned ldu,
+		float* const v_ptr, const unsigned ldv,
+		const unsigned max_sweeps = 16,
+		const double tolerance = 1e2 * DBL_EPSILON
+		) {
+	std::vector<double> w(static_cast<std::size_t>(n) * n);
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			w[i + j * static_cast<std::size_t>(n)] = a_ptr[i + j * static_cast<std::size_t>(lda)];
+		}
+	}
+	auto v = detail::identity(n);
+
+	unsigned sweep = 0;
+	while (sweep < max_sweeps) {
+		sweep++;
+		bool rotated = false;
+		for (unsigned step = 0; step + 1 < n; step++) {
+			for (unsigned k = 0; k < n / 2; k++) {
+				unsigned p, q;
+				round_robin_pair(n, step, k, p, q);
+				double alpha = 0., beta = 0., gamma = 0.;
+				for (unsigned i = 0; i < n; i++) {
+					const auto wp = w[i + p * static_cast<std::size_t>(n)];
+					const auto wq = w[i + q * static_cast<std::size_t>(n)];
+					alpha += wp * wp;
+					beta += wq * wq;
+					gamma += wp * wq;
+				}
+				if (std::abs(gamma) > tolerance * std::sqrt(alpha * beta)) {
+					double c, s;
+					rotation(alpha, beta, gamma, c, s);
+					detail::rotate_columns(n, w.data(), p, q, c, s);
+					detail::rotate_columns(n, v.data(), p, q, c, s);
+					rotated = true;
+				}
+			}
+		}
+		if (!rotated) {
+			break;
+		}
+	}
+
+	std::vector<double> sigma(n);
+	for (unsigned j = 0; j < n; j++) {
+		double norm2 = 0.;
+		for (unsigned i = 0; i < n; i++) {
+			norm2 += w[i + j * static_cast<std::size_t>(n)] * w[i + j * static_cast<std::size_t>(n)];
+		}
+		sigma[j] = std::sqrt(norm2);
+	}
+	std::vector<unsigned> order(n);
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&](const unsigned a, const unsigned b) {return sigma[a] > sigma[b];});
+	for (unsigned r = 0; r < n; r++) {
+		const auto j = order[r];
+		s_ptr[r] = static_cast<float>(sigma[j]);
+		for (unsigned i = 0; i < n; i++) {
+			// The columns of U for the zero singular values are zero
+			u_ptr[i + r * static_cast<std::size_t>(ldu)] = sigma[j] == 0. ? 0.f : static_cast<float>(w[i + j * static_cast<std::size_t>(n)] / sigma[j]);
+			v_ptr[i + r * static_cast<std::size_t>(ldv)] = static_cast<float>(v[i + j * static_cast<std::size_t>(n)]);
+		}
+	}
+	return sweep;
+}
+
+// Reference of mtk::wmma::tcec::jacobi::launch_eigen in double (two-sided Jacobi with the same ordering)
+// A (n x n, symmetric) = Z * diag(W) * Z^T, W is in ascending order
+// Only the lower triangle of A is referenced.
+// Returns the number of the sweeps including the last one without any rotation
+inline unsigned eigen(
+		const unsigned n,
+		const float* const a_ptr, const unsigned lda,
+		float* const w_ptr,
+		float* const z_ptr, const unsigned ldz,
+		const unsigned max_sweeps = 16,
+		const double tolerance = 1e2 * DBL_EPSILON
+		) {
+	std::vector<double> a(static_cast<std::size_t>(n) * n);
+	double norm2 = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			const double v = i >= j ? a_ptr[i + j * static_cast<std::size_t>(lda)] : a_ptr[j + i * static_cast<std::size_t>(lda)];
+			a[i + j * static_cast<std::size_t>(n)] = v;
+			norm2 += v * v;
+		}
+	}
+	const auto threshold = tolerance * std::sqrt(norm2);
+	auto v = detail::identity(n);
+
+	unsigned sweep = 0;
+	while (sweep < max_sweeps) {
+		sweep++;
+		bool rotated = false;
+		for (unsigned step = 0; step + 1 < n; step++) {
+			for (unsigned k = 0; k < n / 2; k++) {
+				unsigned p, q;
+				round_robin_pair(n, step, k, p, q);
+				const auto gamma = a[p + q * static_cast<std::size_t>(n)];
+				if (std::abs(gamma) > threshold) {
+					double c, s;
+					rotation(a[p + p * static_cast<std::size_t>(n)], a[q + q * static_cast<std::size_t>(n)], gamma, c, s);
+					detail::rotate_columns(n, a.data(), p, q, c, s);
+					detail::rotate_rows(n, a.data(), p, q, c, s);
+					detail::rotate_columns(n, v.data(), p, q, c, s);
+					rotated = true;
+				}
+			}
+		}
+		if (!rotated) {
+			break;
+		}
+	}
+
+	std::vector<unsigned> order(n);
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&](const unsigned i, const unsigned j) {
+			return a[i + i * static_cast<std::size_t>(n)] < a[j + j * static_cast<std::size_t>(n)];
+			});
+	for (unsigned r = 0; r < n; r++) {
+		const auto j = order[r];
+		w_ptr[r] = static_cast<float>(a[j + j * static_cast<std::size_t>(n)]);
+		for (unsigned i = 0; i < n; i++) {
+			z_ptr[i + r * static_cast<std::size_t>(ldz)] = static_cast<float>(v[i + j * static_cast<std::size_t>(n)]);
+		}
+	}
+	return sweep;
+}
+} // namespace host
+} // namespace jacobi
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
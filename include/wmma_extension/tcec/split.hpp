@@ -0,0 +1,156 @@
+#ifndef __WMMAE_TCEC_SPLIT_HPP__
+#define __WMMAE_TCEC_SPLIT_HPP__
+#include "tcec.hpp"
+
+// Pre-split hi / lo planes of an FP32 matrix
+// A matrix which is reused by many GEMMs (e.g. weights) is split once and
+// loaded by `load_split_matrix_sync` without the split arithmetic of `load_matrix_sync`.
+//   hi : cast<T>(v)
+//   lo : cast<T>(correction_scale_0<T>(v - hi))
+// The element type of the planes is `half` for T = half and `float` (rounded to tf32) for T = nvcuda::wmma::precision::tf32.
+// `mtk::wmma::tcec::host::split_matrix` (tcec/host.hpp) makes bit-identical planes on the host.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+
+template <class T>
+struct plane_t {
+	using type = typename mtk::wmma::detail::common::storage_t<T>::type;
+};
+
+namespace detail {
+namespace split {
+constexpr unsigned block_size = 256;
+
+// src : m x n (col major view) with the leading dimension ld_src
+// hi / lo : m x n with the leading dimension ld_dst
+template <class T>
+__global__ void split_matrix_kernel(
+		typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		typename mtk::wmma::tcec::plane_t<T>::type* const lo_ptr,
+		const unsigned ld_dst,
+		const float* const src_ptr,
+		const unsigned ld_src,
+		const unsigned m,
+		const unsigned n
+		) {
+	const std::size_t num_elements = static_cast<std::size_t>(m) * n;
+	for (std::size_t tid = threadIdx.x + static_cast<std::size_t>(blockIdx.x) * blockDim.x; tid < num_elements; tid += static_cast<std::size_t>(gridDim.x) * blockDim.x) {
+		const auto i = tid % m;
+		const auto j = tid / m;
+		const auto v = src_ptr[i + j * ld_src];
+		const auto hv = mtk::wmma::detail::common::cast<T>(v);
+		const auto dhv = mtk::wmma::detail::common::cast<T>(mtk::wmma::tcec::detail::correction_scale_0<T>(v - mtk::wmma::detail::common::cast<float>(hv)));
+		hi_ptr[i + j * ld_dst] = hv;
+		lo_ptr[i + j * ld_dst] = dhv;
+	}
+}
+} // namespace split
+} // namespace detail
+
+// Split an FP32 matrix into hi / lo planes in the device memory.
+// The planes have the same layout as the source, so a row major matrix is given as its transpose (m <-> n).
+// num_blocks == 0 : one element per thread
+template <class T>
+inline void split_matrix(
+		typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		typename mtk::wmma::tcec::plane_t<T>::type* const lo_ptr,
+		const unsigned ld_dst,
+		const float* const src_ptr,
+		const unsigned ld_src,
+		const unsigned m,
+		const unsigned n,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	const std::size_t num_elements = static_cast<std::size_t>(m) * n;
+	if (num_elements == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (num_elements + mtk::wmma::tcec::detail::split::block_size - 1) / mtk::wmma::tcec::detail::split::block_size;
+	}
+	mtk::wmma::tcec::detail::split::split_matrix_kernel<T><<<num_blocks, mtk::wmma::tcec::detail::split::block_size, 0, cuda_stream>>>(
+			hi_ptr, lo_ptr, ld_dst,
+			src_ptr, ld_src,
+			m, n
+			);
+}
+
+// Load the hi / lo planes
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value, bool>::type = false>
+__device__ void load_split_matrix_sync(
+		fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const lo_ptr,
+		const unsigned ldm,
+		const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto hv  = hi_ptr[mem_offset];
+						const auto dhv = lo_ptr[mem_offset];
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							const auto frag_index = frag_index_list[f];
+							frag.sub_frag  [bm + frag.num_sub_frag_m * bn].x[frag_index] = hv ;
+							frag.sub_d_frag[bm + frag.num_sub_frag_m * bn].x[frag_index] = dhv;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+// Without error correction only the hi plane is read (lo_ptr may be nullptr)
+template <class MatrixLayout, class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk,
+				 typename std::enable_if<!std::is_same<Use, nvcuda::wmma::accumulator>::value && (std::is_same<Op, mtk::wmma::tcec::op_mma>::value || std::is_same<Op, mtk::wmma::tcec::op_wmma>::value), bool>::type = false>
+__device__ void load_split_matrix_sync(
+		fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>>& frag,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const,
+		const unsigned ldm,
+		const bool sync = true) {
+	using Policy = mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::without_ec, fm, fn, fk>;
+	constexpr auto frag_m = mtk::wmma::tcec::detail::select_value<Use, Policy::m, Policy::k, Policy::m>::value;
+	constexpr auto frag_n = mtk::wmma::tcec::detail::select_value<Use, Policy::k, Policy::n, Policy::n>::value;
+
+	mtk::wmma::tcec::detail::foreach_ij_wrapper<Use, T, Layout, Policy>{}(
+			[&](const unsigned frag_index_list[], const unsigned frag_index_count, const unsigned i, const unsigned j) {
+				for (unsigned bm = 0; bm < frag.num_sub_frag_m; bm++) {
+					for (unsigned bn = 0; bn < frag.num_sub_frag_n; bn++) {
+						const auto mem_offset = mtk::wmma::tcec::detail::compute_mem_offset<frag_m, frag_n, MatrixLayout>{}(i, j, ldm, bm * frag_m, bn * frag_n);
+						const auto hv = hi_ptr[mem_offset];
+						for (unsigned f = 0; f < frag_index_count; f++) {
+							frag.sub_frag[bm + frag.num_sub_frag_m * bn].x[frag_index_list[f]] = hv;
+						}
+					}
+				}
+			});
+	if (sync) {
+		__syncwarp();
+	}
+}
+
+template <class Use, int m, int n, int k, class T, class Layout, class Policy>
+__device__ void load_split_matrix_sync(
+		fragment<Use, m, n, k, T, Layout, Policy>& frag,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const lo_ptr,
+		const unsigned ldm,
+		const bool sync = true) {
+	load_split_matrix_sync<Layout>(frag, hi_ptr, lo_ptr, ldm, sync);
+}
+
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
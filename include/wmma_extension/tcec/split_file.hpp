@@ -0,0 +1,374 @@
+#ifndef __WMMAE_TCEC_SPLIT_FILE_HPP__
+#define __WMMAE_TCEC_SPLIT_FILE_HPP__
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "host.hpp"
+
+// On-disk format of pre-split hi / lo planes (see tcec/split.hpp)
+//
+// | header (128 B) | padding | hi plane | padding | lo plane |
+//
+// - The matrix is a rows x cols matrix in the col major view (a row major matrix is stored as its transpose as `split_matrix` does).
+// - The matrix is divided into tile_rows x tile_cols tiles. The tiles are stored in the col major order of tiles,
+//   and each tile is a col major matrix with the leading dimension tile_rows, so a tile is given to `load_split_matrix_sync` as it is.
+//   The elements out of the matrix in the last tiles are zero.
+// - The planes start at multiples of `alignment` (the page size by default) so that they can be mapped and registered directly.
+// - All values are little endian.
+// This header does not depend on CUDA (POSIX mmap is used).
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace split_file {
+
+constexpr char magic[8] = {'W', 'M', 'M', 'A', 'E', 'S', 'P', 'F'};
+constexpr std::uint32_t version = 1;
+
+enum class element_type : std::uint32_t {
+	fp16 = 1, // binary16 bits
+	tf32 = 2, // float rounded to tf32
+};
+
+struct header {
+	char          magic[8];
+	std::uint32_t version;
+	std::uint32_t header_size;
+	element_type  type;
+	std::uint32_t element_size;
+	std::uint64_t rows;
+	std::uint64_t cols;
+	std::uint32_t tile_rows;
+	std::uint32_t tile_cols;
+	std::uint64_t num_tiles_m;
+	std::uint64_t num_tiles_n;
+	std::uint64_t alignment;
+	std::uint64_t hi_offset;   // [B] from the beginning of the file
+	std::uint64_t lo_offset;   // [B]
+	std::uint64_t plane_bytes; // [B] of each plane
+	std::uint64_t hi_checksum; // FNV-1a of the hi plane
+	std::uint64_t lo_checksum; // FNV-1a of the lo plane
+	std::uint8_t  reserved[16];
+};
+static_assert(sizeof(header) == 128, "split_file : the header must be 128 bytes");
+
+namespace detail {
+template <class T> struct element_type_of;
+template <> struct element_type_of<mtk::wmma::tcec::host::fp16> {static constexpr element_type value = element_type::fp16;};
+template <> struct element_type_of<mtk::wmma::tcec::host::tf32> {static constexpr element_type value = element_type::tf32;};
+
+constexpr std::uint64_t fnv_offset_basis = 0xcbf29ce484222325ull;
+inline std::uint64_t fnv1a(const void* const ptr, const std::size_t size, std::uint64_t hash = fnv_offset_basis) {
+	const auto p = reinterpret_cast<const std::uint8_t*>(ptr);
+	for (std::size_t i = 0; i < size; i++) {
+		hash = (hash ^ p[i]) * 0x100000001b3ull;
+	}
+	return hash;
+}
+
+inline std::uint64_t ceil_div(const std::uint64_t v, const std::uint64_t unit) {return v / unit + (v % unit != 0);}
+
+// r = a * b, a + b, or v rounded up to a multiple of unit. They return false if the result does not fit in 64 bits.
+inline bool checked_mul(const std::uint64_t a, const std::uint64_t b, std::uint64_t& r) {
+	if (b != 0 && a > UINT64_MAX / b) {
+		return false;
+	}
+	r = a * b;
+	return true;
+}
+inline bool checked_add(const std::uint64_t a, const std::uint64_t b, std::uint64_t& r) {
+	if (a > UINT64_MAX - b) {
+		return false;
+	}
+	r = a + b;
+	return true;
+}
+inline bool checked_round_up(const std::uint64_t v, const std::uint64_t unit, std::uint64_t& r) {
+	if (!checked_add(v, unit - 1, r)) {
+		return false;
+	}
+	r = r / unit * unit;
+	return true;
+}
+
+// The bytes of a plane of rows x cols elements in tile_rows x tile_cols tiles. Return false if it does not fit in 64 bits.
+inline bool plane_size(
+		const std::uint64_t rows, const std::uint64_t cols,
+		const std::uint32_t tile_rows, const std::uint32_t tile_cols,
+		const std::uint64_t element_size,
+		std::uint64_t& bytes
+		) {
+	std::uint64_t tiles_bytes, tile_bytes;
+	return checked_mul(ceil_div(rows, tile_rows), ceil_div(cols, tile_cols), tiles_bytes) &&
+		checked_mul(static_cast<std::uint64_t>(tile_rows) * tile_cols, element_size, tile_bytes) &&
+		checked_mul(tiles_bytes, tile_bytes, bytes);
+}
+} // namespace detail
+
+// Element offset of the tile (tile_m, tile_n) in a plane
+inline std::uint64_t tile_offset(const header& h, const std::uint64_t tile_m, const std::uint64_t tile_n) {
+	return (tile_m + tile_n * h.num_tiles_m) * h.tile_rows * h.tile_cols;
+}
+
+namespace detail {
+// Split the tile (tile_m, tile_n) of the source matrix. The elements out of the matrix are zero.
+template <class T>
+inline void split_tile(
+		typename mtk::wmma::tcec::host::plane_t<T>::type* const hi_ptr,
+		typename mtk::wmma::tcec::host::plane_t<T>::type* const lo_ptr,
+		float* const tile_ptr,
+		const header& h,
+		const float* const src_ptr,
+		const std::uint64_t ld,
+		const std::uint64_t tile_m,
+		const std::uint64_t tile_n
+		) {
+	for (std::uint64_t j = 0; j < h.tile_cols; j++) {
+		for (std::uint64_t i = 0; i < h.tile_rows; i++) {
+			const auto gi = tile_m * h.tile_rows + i;
+			const auto gj = tile_n * h.tile_cols + j;
+			tile_ptr[i + j * h.tile_rows] = (gi < h.rows && gj < h.cols) ? src_ptr[gi + gj * ld] : 0.f;
+		}
+	}
+	mtk::wmma::tcec::host::split_matrix<T>(hi_ptr, lo_ptr, h.tile_rows, tile_ptr, h.tile_rows, h.tile_rows, h.tile_cols);
+}
+} // namespace detail
+
+// Returns an empty string if the header is consistent with a file of `file_size` bytes, or the reason otherwise
+inline std::string check_header(const header& h, const std::uint64_t file_size) {
+	if (std::memcmp(h.magic, magic, sizeof(magic)) != 0) {
+		return "not a split file";
+	}
+	if (h.version != version) {
+		return "unsupported version " + std::to_string(h.version);
+	}
+	if (h.header_size != sizeof(header)) {
+		return "invalid header size";
+	}
+	if (!((h.type == element_type::fp16 && h.element_size == 2) || (h.type == element_type::tf32 && h.element_size == 4))) {
+		return "invalid element type";
+	}
+	if (h.tile_rows == 0 || h.tile_cols == 0 ||
+			h.num_tiles_m != detail::ceil_div(h.rows, h.tile_rows) ||
+			h.num_tiles_n != detail::ceil_div(h.cols, h.tile_cols)) {
+		return "invalid tile size";
+	}
+	// All sizes and offsets are checked against the overflow, so that a crafted header can not pass with wrapped values
+	std::uint64_t plane_bytes;
+	if (!detail::plane_size(h.rows, h.cols, h.tile_rows, h.tile_cols, h.element_size, plane_bytes) || h.plane_bytes != plane_bytes) {
+		return "invalid plane size";
+	}
+	std::uint64_t hi_end, lo_end;
+	if (h.alignment == 0 || h.hi_offset % h.alignment != 0 || h.lo_offset % h.alignment != 0 ||
+			h.hi_offset < sizeof(header) ||
+			!detail::checked_add(h.hi_offset, h.plane_bytes, hi_end) || h.lo_offset < hi_end ||
+			!detail::checked_add(h.lo_offset, h.plane_bytes, lo_end)) {
+		return "invalid plane offset";
+	}
+	if (file_size < lo_end) {
+		return "truncated file";
+	}
+	return "";
+}
+
+// Split a rows x cols FP32 matrix (col major view with the leading dimension ld) and write it to `path`.
+// Throws std::runtime_error on failure.
+template <class T>
+inline header write(
+		const std::string& path,
+		const float* const src_ptr,
+		const std::uint64_t ld,
+		const std::uint64_t rows,
+		const std::uint64_t cols,
+		const std::uint32_t tile_rows,
+		const std::uint32_t tile_cols,
+		const std::uint64_t alignment = 4096
+		) {
+	using plane_t = typename mtk::wmma::tcec::host::plane_t<T>::type;
+	if (tile_rows == 0 || tile_cols == 0 || alignment == 0 || ld < rows) {
+		throw std::runtime_error("split_file : invalid argument");
+	}
+	std::uint64_t plane_bytes, hi_offset, hi_end, lo_offset, lo_end;
+	if (!detail::plane_size(rows, cols, tile_rows, tile_cols, sizeof(plane_t), plane_bytes) ||
+			!detail::checked_round_up(sizeof(header), alignment, hi_offset) ||
+			!detail::checked_add(hi_offset, plane_bytes, hi_end) ||
+			!detail::checked_round_up(hi_end, alignment, lo_offset) ||
+			!detail::checked_add(lo_offset, plane_bytes, lo_end)) {
+		throw std::runtime_error("split_file : too large matrix");
+	}
+
+	header h;
+	std::memset(&h, 0, sizeof(h));
+	std::memcpy(h.magic, magic, sizeof(magic));
+	h.version      = version;
+	h.header_size  = sizeof(header);
+	h.type         = detail::element_type_of<T>::value;
+	h.element_size = sizeof(plane_t);
+	h.rows         = rows;
+	h.cols         = cols;
+	h.tile_rows    = tile_rows;
+	h.tile_cols    = tile_cols;
+	h.num_tiles_m  = detail::ceil_div(rows, tile_rows);
+	h.num_tiles_n  = detail::ceil_div(cols, tile_cols);
+	h.alignment    = alignment;
+	h.plane_bytes  = plane_bytes;
+	h.hi_offset    = hi_offset;
+	h.lo_offset    = lo_offset;
+	h.hi_checksum  = detail::fnv_offset_basis;
+	h.lo_checksum  = detail::fnv_offset_basis;
+
+	std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+	if (!ofs) {
+		throw std::runtime_error("split_file : cannot open " + path);
+	}
+
+	// The tiles are split one by one and written to both planes
+	std::vector<float> tile(static_cast<std::size_t>(tile_rows) * tile_cols);
+	std::vector<plane_t> tile_hi(tile.size()), tile_lo(tile.size());
+	for (std::uint64_t tn = 0; tn < h.num_tiles_n; tn++) {
+		for (std::uint64_t tm = 0; tm < h.num_tiles_m; tm++) {
+			detail::split_tile<T>(tile_hi.data(), tile_lo.data(), tile.data(), h, src_ptr, ld, tm, tn);
+
+			const auto tile_bytes = tile.size() * sizeof(plane_t);
+			const auto offset = tile_offset(h, tm, tn) * sizeof(plane_t);
+			ofs.seekp(static_cast<std::streamoff>(h.hi_offset + offset));
+			ofs.write(reinterpret_cast<const char*>(tile_hi.data()), tile_bytes);
+			ofs.seekp(static_cast<std::streamoff>(h.lo_offset + offset));
+			ofs.write(reinterpret_cast<const char*>(tile_lo.data()), tile_bytes);
+			h.hi_checksum = detail::fnv1a(tile_hi.data(), tile_bytes, h.hi_checksum);
+			h.lo_checksum = detail::fnv1a(tile_lo.data(), tile_bytes, h.lo_checksum);
+		}
+	}
+
+	ofs.seekp(0);
+	ofs.write(reinterpret_cast<const char*>(&h), sizeof(h));
+	if (!ofs) {
+		throw std::runtime_error("split_file : cannot write " + path);
+	}
+	return h;
+}
+
+// Read-only memory mapping of a split file.
+// The planes are used in place (e.g. registered by `cudaHostRegister` with `cudaHostRegisterReadOnly` and copied to the device),
+// so the split is not repeated at startup.
+class mapped_file {
+	void* ptr_ = nullptr;
+	std::size_t size_ = 0;
+	header header_;
+
+	void unmap() {
+		if (ptr_ != nullptr) {
+			munmap(ptr_, size_);
+			ptr_ = nullptr;
+			size_ = 0;
+		}
+	}
+public:
+	mapped_file() = default;
+	// Throws std::runtime_error if the file can not be mapped or the header is invalid
+	explicit mapped_file(const std::string& path) {
+		const int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("split_file : cannot open " + path);
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(header)) {
+			::close(fd);
+			throw std::runtime_error("split_file : too small file " + path);
+		}
+		size_ = static_cast<std::size_t>(st.st_size);
+		ptr_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if (ptr_ == MAP_FAILED) {
+			ptr_ = nullptr;
+			throw std::runtime_error("split_file : cannot map " + path);
+		}
+		std::memcpy(&header_, ptr_, sizeof(header_));
+		const auto reason = check_header(header_, size_);
+		if (!reason.empty()) {
+			unmap();
+			throw std::runtime_error("split_file : " + reason + " (" + path + ")");
+		}
+	}
+	mapped_file(const mapped_file&) = delete;
+	mapped_file& operator=(const mapped_file&) = delete;
+	mapped_file(mapped_file&& o) noexcept : ptr_(o.ptr_), size_(o.size_), header_(o.header_) {
+		o.ptr_ = nullptr;
+		o.size_ = 0;
+	}
+	mapped_file& operator=(mapped_file&& o) noexcept {
+		if (this != &o) {
+			unmap();
+			ptr_ = o.ptr_;
+			size_ = o.size_;
+			header_ = o.header_;
+			o.ptr_ = nullptr;
+			o.size_ = 0;
+		}
+		return *this;
+	}
+	~mapped_file() {unmap();}
+
+	const header& get_header() const {return header_;}
+	const void* data() const {return ptr_;}
+	std::size_t size() const {return size_;}
+
+	const void* hi_plane() const {return static_cast<const std::uint8_t*>(ptr_) + header_.hi_offset;}
+	const void* lo_plane() const {return static_cast<const std::uint8_t*>(ptr_) + header_.lo_offset;}
+
+	// PlaneT : the element type of the planes (e.g. `half` / `std::uint16_t` for fp16, `float` for tf32)
+	template <class PlaneT>
+	const PlaneT* tile_hi(const std::uint64_t tile_m, const std::uint64_t tile_n) const {
+		return static_cast<const PlaneT*>(hi_plane()) + tile_offset(header_, tile_m, tile_n);
+	}
+	template <class PlaneT>
+	const PlaneT* tile_lo(const std::uint64_t tile_m, const std::uint64_t tile_n) const {
+		return static_cast<const PlaneT*>(lo_plane()) + tile_offset(header_, tile_m, tile_n);
+	}
+
+	// Compare the checksums of the planes (reads the whole file)
+	bool verify_checksum() const {
+		return detail::fnv1a(hi_plane(), header_.plane_bytes) == header_.hi_checksum &&
+			detail::fnv1a(lo_plane(), header_.plane_bytes) == header_.lo_checksum;
+	}
+};
+
+// Split the source matrix again and count the tiles which differ from the file.
+// src : rows x cols (col major view) with the leading dimension ld (>= rows), the matrix from which the file was written
+template <class T>
+inline std::uint64_t count_mismatched_tiles(const mapped_file& file, const float* const src_ptr, const std::uint64_t ld) {
+	using plane_t = typename mtk::wmma::tcec::host::plane_t<T>::type;
+	const auto& h = file.get_header();
+	if (h.type != detail::element_type_of<T>::value) {
+		throw std::runtime_error("split_file : element type mismatch");
+	}
+	if (ld < h.rows) {
+		throw std::runtime_error("split_file : invalid argument");
+	}
+	std::vector<float> tile(static_cast<std::size_t>(h.tile_rows) * h.tile_cols);
+	std::vector<plane_t> tile_hi(tile.size()), tile_lo(tile.size());
+	std::uint64_t num_mismatches = 0;
+	for (std::uint64_t tn = 0; tn < h.num_tiles_n; tn++) {
+		for (std::uint64_t tm = 0; tm < h.num_tiles_m; tm++) {
+			detail::split_tile<T>(tile_hi.data(), tile_lo.data(), tile.data(), h, src_ptr, ld, tm, tn);
+			const auto tile_bytes = tile.size() * sizeof(plane_t);
+			if (std::memcmp(tile_hi.data(), file.tile_hi<plane_t>(tm, tn), tile_bytes) ||
+					std::memcmp(tile_lo.data(), file.tile_lo<plane_t>(tm, tn), tile_bytes)) {
+				num_mismatches++;
+			}
+		}
+	}
+	return num_mismatches;
+}
+
+} // namespace split_file
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,352 @@
+#ifndef __WMMAE_TCEC_TRIANGULAR_HPP__
+#define __WMMAE_TCEC_TRIANGULAR_HPP__
+#include "tcec.hpp"
+#include "triangular_host.hpp"
+
+// Triangular and symmetric matrix multiplications
+//   TRMM : C = alpha * L * B                   (L : lower triangular, B / C : dense)
+//   TRSM : B = alpha * inv(L) * B              (L : lower triangular, B : dense)
+//   SYRK : C = alpha * A^T * A + beta * C      (only the lower triangle of C)
+// The tiles in the upper triangle of L and C are neither loaded nor computed.
+// All matrices are col major. See triangular_host.hpp for the host references.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace triangular {
+namespace detail {
+// 4 warps / block
+constexpr unsigned block_size = 128;
+constexpr unsigned num_warps = block_size / 32;
+
+// Copy the lower triangle of the (BLOCK x BLOCK) block to `buf` (ld = BLOCK) and fill the upper triangle with zero
+template <unsigned BLOCK>
+__device__ inline void copy_lower_block(float* const buf, const float* const ptr, const unsigned ldm) {
+	for (unsigned index = threadIdx.x % 32; index < BLOCK * BLOCK; index += 32) {
+		const auto i = index % BLOCK;
+		const auto j = index / BLOCK;
+		buf[index] = i >= j ? ptr[i + j * static_cast<std::size_t>(ldm)] : 0.f;
+	}
+	__syncwarp();
+}
+} // namespace detail
+
+// C[tile_m:tile_m+BLOCK, tile_n:tile_n+WARP_N] = alpha * L * B
+// Only the blocks L[tile_m, 0:tile_m+BLOCK] are multiplied.
+// diag_buf : BLOCK * BLOCK floats used by the warp (e.g. shared memory) for the masked diagonal block
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+__device__ inline void trmm_tile(
+		const unsigned tile_m, const unsigned tile_n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const b_ptr, const unsigned ldb,
+		float* const c_ptr, const unsigned ldc,
+		float* const diag_buf
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , BLOCK, WARP_N, BLOCK, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , BLOCK, WARP_N, BLOCK, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, BLOCK, WARP_N, BLOCK, T, void                   , Policy> frag_c;
+
+	mtk::wmma::tcec::fill_zero(frag_c);
+	for (unsigned bk = 0; bk < tile_m; bk += BLOCK) {
+		mtk::wmma::tcec::load_matrix_sync_with_mul<nvcuda::wmma::col_major>(frag_a, l_ptr + tile_m + bk * static_cast<std::size_t>(ldl), ldl, alpha, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, b_ptr + bk + tile_n * static_cast<std::size_t>(ldb), ldb, false);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	// The diagonal block
+	detail::copy_lower_block<BLOCK>(diag_buf, l_ptr + tile_m + tile_m * static_cast<std::size_t>(ldl), ldl);
+	mtk::wmma::tcec::load_matrix_sync_with_mul<nvcuda::wmma::col_major>(frag_a, diag_buf, BLOCK, alpha);
+	mtk::wmma::tcec::load_matrix_sync(frag_b, b_ptr + tile_m + tile_n * static_cast<std::size_t>(ldb), ldb, false);
+	mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(c_ptr + tile_m + tile_n * static_cast<std::size_t>(ldc), frag_c, ldc, nvcuda::wmma::mem_col_major, false);
+	__syncwarp();
+}
+
+// inv_ptr[block_row * BLOCK * BLOCK:] = inv(L[block_row * BLOCK:, block_row * BLOCK:]) (ld = BLOCK, the upper triangle is zero)
+// The lane `j` solves L * x = e_j by the forward substitution in registers in FP32.
+template <unsigned BLOCK>
+__device__ inline void invert_diagonal_block(
+		const unsigned block_row,
+		const float* const l_ptr, const unsigned ldl,
+		float* const inv_ptr
+		) {
+	static_assert(BLOCK <= 32, "BLOCK must be 32 or less");
+	const float* const diag_ptr = l_ptr + block_row * BLOCK * (static_cast<std::size_t>(ldl) + 1);
+	const unsigned j = threadIdx.x % 32;
+	float x[BLOCK];
+#pragma unroll
+	for (unsigned i = 0; i < BLOCK; i++) {
+		// x[l] = 0 for l < j
+		float s = (i == j) ? 1.f : 0.f;
+#pragma unroll
+		for (unsigned l = 0; l < i; l++) {
+			s -= diag_ptr[i + l * static_cast<std::size_t>(ldl)] * x[l];
+		}
+		x[i] = (i < j) ? 0.f : s / diag_ptr[i + i * static_cast<std::size_t>(ldl)];
+	}
+	if (j < BLOCK) {
+		float* const inv_block_ptr = inv_ptr + block_row * BLOCK * BLOCK;
+#pragma unroll
+		for (unsigned i = 0; i < BLOCK; i++) {
+			inv_block_ptr[i + j * BLOCK] = x[i];
+		}
+	}
+}
+
+// B[0:m, tile_n:tile_n+WARP_N] = alpha * inv(L) * B[0:m, tile_n:tile_n+WARP_N] (blocked forward substitution)
+//   X_i = inv(L_ii) * (alpha * B_i - sum_{j < i} L_ij * X_j)
+// inv_ptr : the inverted diagonal blocks (see invert_diagonal_block)
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+__device__ inline void trsm_strip(
+		const unsigned tile_n,
+		const unsigned m,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const inv_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , BLOCK, WARP_N, BLOCK, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , BLOCK, WARP_N, BLOCK, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, BLOCK, WARP_N, BLOCK, T, void                   , Policy> frag_c;
+
+	float* const b_strip_ptr = b_ptr + tile_n * static_cast<std::size_t>(ldb);
+	for (unsigned bi = 0; bi < m; bi += BLOCK) {
+		mtk::wmma::tcec::load_matrix_sync(frag_c, b_strip_ptr + bi, ldb, nvcuda::wmma::mem_col_major, false);
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= alpha;
+		}
+		// The solved blocks X_j (j < i) are in B
+		for (unsigned bj = 0; bj < bi; bj += BLOCK) {
+			mtk::wmma::tcec::load_matrix_sync_with_mul<nvcuda::wmma::col_major>(frag_a, l_ptr + bi + bj * static_cast<std::size_t>(ldl), ldl, -1.f, false);
+			mtk::wmma::tcec::load_matrix_sync(frag_b, b_strip_ptr + bj, ldb, false);
+			mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+		}
+		// The right hand side goes through B to be used as matrix_b
+		mtk::wmma::tcec::store_matrix_sync(b_strip_ptr + bi, frag_c, ldb, nvcuda::wmma::mem_col_major);
+		mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, inv_ptr + bi * BLOCK, BLOCK, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, b_strip_ptr + bi, ldb);
+		mtk::wmma::tcec::fill_zero(frag_c);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+		mtk::wmma::tcec::store_matrix_sync(b_strip_ptr + bi, frag_c, ldb, nvcuda::wmma::mem_col_major);
+	}
+}
+
+// C[tile_i * BLOCK:, tile_j * BLOCK:] = alpha * A^T * A + beta * C (tile_i >= tile_j)
+// Only the lower triangle of the diagonal tiles is written.
+// diag_buf : BLOCK * BLOCK floats used by the warp (e.g. shared memory) for the diagonal tiles
+template <unsigned BLOCK, unsigned WARP_K, class T, class Policy>
+__device__ inline void syrk_tile(
+		const unsigned tile_i, const unsigned tile_j,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		float* const diag_buf
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , BLOCK, BLOCK, WARP_K, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , BLOCK, BLOCK, WARP_K, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, BLOCK, BLOCK, WARP_K, T, void                   , Policy> frag_c;
+
+	float* const c_tile_ptr = c_ptr + tile_i * BLOCK + tile_j * BLOCK * static_cast<std::size_t>(ldc);
+	if (beta == 0.f) {
+		mtk::wmma::tcec::fill_zero(frag_c);
+	} else {
+		mtk::wmma::tcec::load_matrix_sync(frag_c, c_tile_ptr, ldc, nvcuda::wmma::mem_col_major, false);
+		for (unsigned i = 0; i < frag_c.num_elements; i++) {
+			frag_c.x(i) *= beta;
+		}
+	}
+
+	// A^T is a row major matrix with the same ld
+	const float* const a_i_ptr = a_ptr + tile_i * BLOCK * static_cast<std::size_t>(lda);
+	const float* const a_j_ptr = a_ptr + tile_j * BLOCK * static_cast<std::size_t>(lda);
+	for (unsigned bk = 0; bk < k; bk += WARP_K) {
+		mtk::wmma::tcec::load_matrix_sync_with_mul(frag_a, a_i_ptr + bk, lda, alpha, false);
+		mtk::wmma::tcec::load_matrix_sync(frag_b, a_j_ptr + bk, lda, false);
+		mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+
+	if (tile_i != tile_j) {
+		mtk::wmma::tcec::store_matrix_sync(c_tile_ptr, frag_c, ldc, nvcuda::wmma::mem_col_major, false);
+	} else {
+		mtk::wmma::tcec::store_matrix_sync(diag_buf, frag_c, BLOCK, nvcuda::wmma::mem_col_major);
+		for (unsigned index = threadIdx.x % 32; index < BLOCK * BLOCK; index += 32) {
+			const auto i = index % BLOCK;
+			const auto j = index / BLOCK;
+			if (i >= j) {
+				c_tile_ptr[i + j * static_cast<std::size_t>(ldc)] = diag_buf[index];
+			}
+		}
+	}
+	__syncwarp();
+}
+
+// m and n must be multiples of BLOCK and WARP_N respectively.
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+__global__ void trmm_kernel(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const b_ptr, const unsigned ldb,
+		float* const c_ptr, const unsigned ldc
+		) {
+	__shared__ float diag_buf[detail::num_warps][BLOCK * BLOCK];
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned num_tiles_m = m / BLOCK;
+	const unsigned long num_tiles = static_cast<unsigned long>(num_tiles_m) * (n / WARP_N);
+	for (unsigned long tile_id = warp_id + static_cast<unsigned long>(blockIdx.x) * (blockDim.x / 32); tile_id < num_tiles; tile_id += static_cast<unsigned long>(gridDim.x) * (blockDim.x / 32)) {
+		// The lower tiles have more blocks of L, so the warps of a block take different rows
+		const unsigned tile_m = (tile_id % num_tiles_m) * BLOCK;
+		const unsigned tile_n = (tile_id / num_tiles_m) * WARP_N;
+		trmm_tile<BLOCK, WARP_N, T, Policy>(tile_m, tile_n, alpha, l_ptr, ldl, b_ptr, ldb, c_ptr, ldc, diag_buf[warp_id]);
+	}
+}
+
+template <unsigned BLOCK>
+__global__ void invert_diagonal_blocks_kernel(
+		const unsigned m,
+		const float* const l_ptr, const unsigned ldl,
+		float* const inv_ptr
+		) {
+	for (unsigned block_row = threadIdx.x / 32 + blockIdx.x * (blockDim.x / 32); block_row < m / BLOCK; block_row += gridDim.x * (blockDim.x / 32)) {
+		invert_diagonal_block<BLOCK>(block_row, l_ptr, ldl, inv_ptr);
+	}
+}
+
+// m and n must be multiples of BLOCK and WARP_N respectively.
+// A warp solves a (m x WARP_N) strip of B.
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+__global__ void trsm_kernel(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const inv_ptr,
+		float* const b_ptr, const unsigned ldb
+		) {
+	for (unsigned strip = threadIdx.x / 32 + blockIdx.x * (blockDim.x / 32); strip < n / WARP_N; strip += gridDim.x * (blockDim.x / 32)) {
+		trsm_strip<BLOCK, WARP_N, T, Policy>(strip * WARP_N, m, alpha, l_ptr, ldl, inv_ptr, b_ptr, ldb);
+	}
+}
+
+// n and k must be multiples of BLOCK and WARP_K respectively.
+// A warp computes a (BLOCK x BLOCK) tile of the lower triangle of C.
+template <unsigned BLOCK, unsigned WARP_K, class T, class Policy>
+__global__ void syrk_kernel(
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	__shared__ float diag_buf[detail::num_warps][BLOCK * BLOCK];
+	const unsigned warp_id = threadIdx.x / 32;
+	const auto num_tiles = mtk::wmma::tcec::triangular::num_lower_tiles(n / BLOCK);
+	for (unsigned long tile_id = warp_id + static_cast<unsigned long>(blockIdx.x) * (blockDim.x / 32); tile_id < num_tiles; tile_id += static_cast<unsigned long>(gridDim.x) * (blockDim.x / 32)) {
+		unsigned tile_i, tile_j;
+		mtk::wmma::tcec::triangular::lower_tile(tile_id, tile_i, tile_j);
+		syrk_tile<BLOCK, WARP_K, T, Policy>(tile_i, tile_j, k, alpha, a_ptr, lda, beta, c_ptr, ldc, diag_buf[warp_id]);
+	}
+}
+
+// Launch trmm_kernel
+// num_blocks == 0 : one tile per warp
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+inline void launch_trmm(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const b_ptr, const unsigned ldb,
+		float* const c_ptr, const unsigned ldc,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	const unsigned long num_tiles = static_cast<unsigned long>(m / BLOCK) * (n / WARP_N);
+	if (num_tiles == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (num_tiles + detail::num_warps - 1) / detail::num_warps;
+	}
+	trmm_kernel<BLOCK, WARP_N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			m, n,
+			alpha,
+			l_ptr, ldl,
+			b_ptr, ldb,
+			c_ptr, ldc
+			);
+}
+
+// Launch invert_diagonal_blocks_kernel and trsm_kernel
+// inv_ptr : workspace of m * BLOCK floats for the inverted diagonal blocks
+// num_blocks == 0 : one strip per warp
+template <unsigned BLOCK, unsigned WARP_N, class T, class Policy>
+inline void launch_trsm(
+		const unsigned m,
+		const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		float* const b_ptr, const unsigned ldb,
+		float* const inv_ptr,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	const unsigned num_strips = n / WARP_N;
+	if (m / BLOCK == 0 || num_strips == 0) {
+		return;
+	}
+	invert_diagonal_blocks_kernel<BLOCK><<<(m / BLOCK + detail::num_warps - 1) / detail::num_warps, detail::block_size, 0, cuda_stream>>>(
+			m,
+			l_ptr, ldl,
+			inv_ptr
+			);
+	if (num_blocks == 0) {
+		num_blocks = (num_strips + detail::num_warps - 1) / detail::num_warps;
+	}
+	trsm_kernel<BLOCK, WARP_N, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			m, n,
+			alpha,
+			l_ptr, ldl,
+			inv_ptr,
+			b_ptr, ldb
+			);
+}
+
+// Launch syrk_kernel
+// num_blocks == 0 : one tile per warp
+template <unsigned BLOCK, unsigned WARP_K, class T, class Policy>
+inline void launch_syrk(
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		unsigned num_blocks = 0,
+		cudaStream_t cuda_stream = 0
+		) {
+	const auto num_tiles = mtk::wmma::tcec::triangular::num_lower_tiles(n / BLOCK);
+	if (num_tiles == 0) {
+		return;
+	}
+	if (num_blocks == 0) {
+		num_blocks = (num_tiles + detail::num_warps - 1) / detail::num_warps;
+	}
+	syrk_kernel<BLOCK, WARP_K, T, Policy><<<num_blocks, detail::block_size, 0, cuda_stream>>>(
+			n, k,
+			alpha,
+			a_ptr, lda,
+			beta,
+			c_ptr, ldc
+			);
+}
+} // namespace triangular
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
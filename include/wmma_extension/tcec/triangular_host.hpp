@@ -0,0 +1,109 @@
+#ifndef __WMMAE_TCEC_TRIANGULAR_HOST_HPP__
+#define __WMMAE_TCEC_TRIANGULAR_HOST_HPP__
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include "../detail/host_device.hpp"
+
+// The tile mapping of the lower triangle and the host references of mtk::wmma::tcec::triangular (see triangular.hpp)
+// This header does not depend on CUDA.
+// All matrices are col major.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace triangular {
+
+// The number of the tiles (ti, tj), ti >= tj, of the lower triangle of (num_tiles x num_tiles) tiles
+WMMAE_HOST_DEVICE inline unsigned long num_lower_tiles(const unsigned num_tiles) {
+	return static_cast<unsigned long>(num_tiles) * (num_tiles + 1) / 2;
+}
+
+// The `t`-th tile of the lower triangle. The tiles are numbered row by row:
+//   (0, 0), (1, 0), (1, 1), (2, 0), ...
+WMMAE_HOST_DEVICE inline void lower_tile(const unsigned long t, unsigned& ti, unsigned& tj) {
+	auto i = static_cast<unsigned long>((sqrt(8. * t + 1.) - 1.) / 2.);
+	// Correct the rounding error of sqrt
+	while (i * (i + 1) / 2 > t) {
+		i--;
+	}
+	while ((i + 1) * (i + 2) / 2 <= t) {
+		i++;
+	}
+	ti = static_cast<unsigned>(i);
+	tj = static_cast<unsigned>(t - i * (i + 1) / 2);
+}
+
+namespace host {
+// Reference of mtk::wmma::tcec::triangular::launch_trmm in double
+// C = alpha * L * B
+// L : m x m lower triangular (the upper part is not referenced), B / C : m x n
+inline void trmm(
+		const unsigned m, const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		const float* const b_ptr, const unsigned ldb,
+		float* const c_ptr, const unsigned ldc
+		) {
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			double acc = 0.;
+			for (unsigned l = 0; l <= i; l++) {
+				acc += static_cast<double>(l_ptr[i + l * static_cast<std::size_t>(ldl)]) * b_ptr[l + j * static_cast<std::size_t>(ldb)];
+			}
+			c_ptr[i + j * static_cast<std::size_t>(ldc)] = static_cast<float>(alpha * acc);
+		}
+	}
+}
+
+// Reference of mtk::wmma::tcec::triangular::launch_trsm in double
+// B = alpha * inv(L) * B (forward substitution)
+// L : m x m lower triangular with the non-zero diagonal (the upper part is not referenced), B : m x n
+inline void trsm(
+		const unsigned m, const unsigned n,
+		const float alpha,
+		const float* const l_ptr, const unsigned ldl,
+		float* const b_ptr, const unsigned ldb
+		) {
+	std::vector<double> x(m);
+	for (unsigned j = 0; j < n; j++) {
+		float* const b_col_ptr = b_ptr + j * static_cast<std::size_t>(ldb);
+		for (unsigned i = 0; i < m; i++) {
+			double acc = static_cast<double>(alpha) * b_col_ptr[i];
+			for (unsigned l = 0; l < i; l++) {
+				acc -= static_cast<double>(l_ptr[i + l * static_cast<std::size_t>(ldl)]) * x[l];
+			}
+			x[i] = acc / l_ptr[i + i * static_cast<std::size_t>(ldl)];
+		}
+		for (unsigned i = 0; i < m; i++) {
+			b_col_ptr[i] = static_cast<float>(x[i]);
+		}
+	}
+}
+
+// Reference of mtk::wmma::tcec::triangular::launch_syrk in double
+// C = alpha * A^T * A + beta * C (only the lower triangle of C is referenced and written)
+// A : k x n, C : n x n
+inline void syrk(
+		const unsigned n, const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = j; i < n; i++) {
+			double acc = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				acc += static_cast<double>(a_ptr[l + i * static_cast<std::size_t>(lda)]) * a_ptr[l + j * static_cast<std::size_t>(lda)];
+			}
+			auto& c = c_ptr[i + j * static_cast<std::size_t>(ldc)];
+			c = static_cast<float>(alpha * acc + (beta == 0.f ? 0. : static_cast<double>(beta) * c));
+		}
+	}
+}
+} // namespace host
+} // namespace triangular
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
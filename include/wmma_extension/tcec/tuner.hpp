@@ -0,0 +1,231 @@
+#ifndef __WMMAE_TCEC_TUNER_HPP__
+#define __WMMAE_TCEC_TUNER_HPP__
+#include <string>
+#include <vector>
+#include "tcec.hpp"
+#include "hetero.hpp"
+#include "tuner_host.hpp"
+
+// GPU measurement harness and run time dispatcher of the tuner (see tuner_host.hpp)
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace tuner {
+namespace detail {
+template <class T> inline std::string type_name();
+template <> inline std::string type_name<half                         >() {return "half";}
+template <> inline std::string type_name<nvcuda::wmma::precision::tf32>() {return "tf32";}
+template <> inline std::string type_name<float                        >() {return "float";}
+
+template <class Op> inline std::string op_name();
+template <> inline std::string op_name<mtk::wmma::tcec::op_mma >() {return "mma";}
+template <> inline std::string op_name<mtk::wmma::tcec::op_wmma>() {return "wmma";}
+template <> inline std::string op_name<mtk::wmma::tcec::op_simt>() {return "simt";}
+
+// C = alpha * A * B + beta * C
+// A : row major, B : col major, C : col major
+// m, n, k must be multiples of WARP_M, WARP_N, WARP_K respectively.
+template <unsigned BLOCK_M, unsigned BLOCK_N, unsigned WARP_M, unsigned WARP_N, unsigned WARP_K, class T, class Policy>
+__global__ void gemm_kernel(
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc
+		) {
+	constexpr unsigned num_warps_m = BLOCK_M / WARP_M;
+	const unsigned warp_id = threadIdx.x / 32;
+	const unsigned tile_m = blockIdx.x * BLOCK_M + (warp_id % num_warps_m) * WARP_M;
+	const unsigned tile_n = blockIdx.y * BLOCK_N + (warp_id / num_warps_m) * WARP_N;
+	if (tile_m >= m || tile_n >= n) {
+		return;
+	}
+	mtk::wmma::tcec::hetero::gemm_tile<WARP_M, WARP_N, WARP_K, T, Policy>(tile_m, tile_n, k, alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc);
+}
+} // namespace detail
+
+// A configuration compiled into the binary
+template <class T, class Policy, unsigned BLOCK_M, unsigned BLOCK_N, unsigned WARP_M, unsigned WARP_N, unsigned WARP_K>
+struct candidate {
+	static_assert(BLOCK_M % WARP_M == 0 && BLOCK_N % WARP_N == 0, "The block tile must be a multiple of the warp tile");
+	static const unsigned num_warps = (BLOCK_M / WARP_M) * (BLOCK_N / WARP_N);
+
+	static mtk::wmma::tcec::tuner::config get_config() {
+		return mtk::wmma::tcec::tuner::config{
+			detail::type_name<T>(),
+			detail::op_name<typename Policy::op>(),
+			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value,
+			Policy::m, Policy::n, Policy::k,
+			BLOCK_M, BLOCK_N,
+			WARP_M, WARP_N, WARP_K
+		};
+	}
+
+	static void launch(
+			const unsigned m,
+			const unsigned n,
+			const unsigned k,
+			const float alpha,
+			const float* const a_ptr, const unsigned lda,
+			const float* const b_ptr, const unsigned ldb,
+			const float beta,
+			float* const c_ptr, const unsigned ldc,
+			cudaStream_t cuda_stream = 0
+			) {
+		const dim3 grid((m + BLOCK_M - 1) / BLOCK_M, (n + BLOCK_N - 1) / BLOCK_N);
+		detail::gemm_kernel<BLOCK_M, BLOCK_N, WARP_M, WARP_N, WARP_K, T, Policy><<<grid, num_warps * 32, 0, cuda_stream>>>(
+				m, n, k,
+				alpha,
+				a_ptr, lda,
+				b_ptr, ldb,
+				beta,
+				c_ptr, ldc
+				);
+	}
+};
+
+// List of the candidates compiled into the binary
+template <class... Candidates>
+struct candidate_list {
+	static std::vector<mtk::wmma::tcec::tuner::config> get_configs() {
+		return {Candidates::get_config()...};
+	}
+};
+
+namespace detail {
+template <class... Candidates>
+struct dispatcher;
+
+template <>
+struct dispatcher<> {
+	template <class Func>
+	static bool run(const mtk::wmma::tcec::tuner::config&, Func) {return false;}
+};
+
+template <class Head, class... Tail>
+struct dispatcher<Head, Tail...> {
+	template <class Func>
+	static bool run(const mtk::wmma::tcec::tuner::config& c, Func func) {
+		if (Head::get_config() == c) {
+			func(Head{});
+			return true;
+		}
+		return dispatcher<Tail...>::run(c, func);
+	}
+};
+
+template <class List>
+struct list_dispatcher;
+
+template <class... Candidates>
+struct list_dispatcher<candidate_list<Candidates...>> {
+	using type = dispatcher<Candidates...>;
+};
+} // namespace detail
+
+// "sm_XY:<device name>" of the current device
+inline std::string get_device_string() {
+	int device_id;
+	cudaGetDevice(&device_id);
+	cudaDeviceProp prop;
+	cudaGetDeviceProperties(&prop, device_id);
+	return "sm_" + std::to_string(prop.major) + std::to_string(prop.minor) + ":" + prop.name;
+}
+
+// Launches the GEMM with the configuration.
+// Returns false if the configuration is not in the list or not applicable to the shape.
+template <class List>
+inline bool launch_gemm(
+		const mtk::wmma::tcec::tuner::config& c,
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		cudaStream_t cuda_stream = 0
+		) {
+	if (!mtk::wmma::tcec::tuner::is_applicable(c, m, n, k)) {
+		return false;
+	}
+	return detail::list_dispatcher<List>::type::run(c, [&](auto candidate) {
+		decltype(candidate)::launch(m, n, k, alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc, cuda_stream);
+	});
+}
+
+// Measures the candidates in the list with the given device memory and inserts the results into the cache.
+// The time of a candidate is the average of `num_tests` launches after a warm up launch.
+template <class List>
+inline std::size_t tune(
+		mtk::wmma::tcec::tuner::cache& cache,
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		float* const c_ptr, const unsigned ldc,
+		const unsigned num_tests = 10,
+		cudaStream_t cuda_stream = 0
+		) {
+	cudaEvent_t start, stop;
+	cudaEventCreate(&start);
+	cudaEventCreate(&stop);
+
+	const mtk::wmma::tcec::tuner::problem p{m, n, k, get_device_string()};
+	const auto count = mtk::wmma::tcec::tuner::tune(cache, p, List::get_configs(),
+			[&](const mtk::wmma::tcec::tuner::config& c) {
+				launch_gemm<List>(c, m, n, k, 1.f, a_ptr, lda, b_ptr, ldb, 0.f, c_ptr, ldc, cuda_stream);
+				if (cudaGetLastError() != cudaSuccess) {
+					// e.g. the policy is not supported by the device
+					return -1.;
+				}
+				cudaEventRecord(start, cuda_stream);
+				for (unsigned i = 0; i < num_tests; i++) {
+					launch_gemm<List>(c, m, n, k, 1.f, a_ptr, lda, b_ptr, ldb, 0.f, c_ptr, ldc, cuda_stream);
+				}
+				cudaEventRecord(stop, cuda_stream);
+				if (cudaEventSynchronize(stop) != cudaSuccess) {
+					return -1.;
+				}
+				float elapsed_ms;
+				cudaEventElapsedTime(&elapsed_ms, start, stop);
+				return elapsed_ms * 1e-3 / num_tests;
+			});
+
+	cudaEventDestroy(start);
+	cudaEventDestroy(stop);
+	return count;
+}
+
+// Selects the configuration in the list by the cache (or the cost model) and launches the GEMM.
+// Returns false if no configuration in the list is applicable to the shape.
+template <class List>
+inline bool gemm(
+		const mtk::wmma::tcec::tuner::cache& cache,
+		const unsigned m,
+		const unsigned n,
+		const unsigned k,
+		const float alpha,
+		const float* const a_ptr, const unsigned lda,
+		const float* const b_ptr, const unsigned ldb,
+		const float beta,
+		float* const c_ptr, const unsigned ldc,
+		cudaStream_t cuda_stream = 0
+		) {
+	const auto s = mtk::wmma::tcec::tuner::select(cache, mtk::wmma::tcec::tuner::problem{m, n, k, get_device_string()}, List::get_configs());
+	if (s.source == mtk::wmma::tcec::tuner::selection::none) {
+		return false;
+	}
+	return launch_gemm<List>(s.config, m, n, k, alpha, a_ptr, lda, b_ptr, ldb, beta, c_ptr, ldc, cuda_stream);
+}
+
+} // namespace tuner
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
@@ -0,0 +1,505 @@
+#ifndef __WMMAE_TCEC_TUNER_HOST_HPP__
+#define __WMMAE_TCEC_TUNER_HOST_HPP__
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../detail/json.hpp"
+#include "../detail/occupancy.hpp"
+
+// Policy / tile size tuner of the TCEC GEMM
+//   - config / problem / record : a tuning configuration, a GEMM shape on a device and a result
+//   - cache                     : results persisted as JSON and keyed by the shape and the device
+//   - estimate_time             : cost model for tuning without GPUs
+//   - tune / select             : sweep of candidates and run time selection
+// This header does not depend on CUDA. The GPU measurement harness is in tuner.hpp.
+namespace mtk {
+namespace wmma {
+namespace tcec {
+namespace tuner {
+
+// Configuration of the GEMM kernel (see tuner.hpp)
+struct config {
+	std::string type;        // "half" / "tf32" / "float"
+	std::string op;          // "mma" / "wmma" / "simt"
+	bool error_correction;   // with_ec / without_ec
+	unsigned fm, fn, fk;     // Policy::m, n, k
+	unsigned block_m;        // Tile size of a thread block
+	unsigned block_n;
+	unsigned warp_m;         // Tile size of a warp (size of mtk::wmma::tcec::fragment)
+	unsigned warp_n;
+	unsigned warp_k;
+
+	unsigned num_warps() const {
+		return (block_m / warp_m) * (block_n / warp_n);
+	}
+
+	std::string to_string() const {
+		std::stringstream ss;
+		ss << type << "," << op << "," << (error_correction ? "with_ec" : "without_ec")
+			<< ",policy=" << fm << "x" << fn << "x" << fk
+			<< ",block=" << block_m << "x" << block_n
+			<< ",warp=" << warp_m << "x" << warp_n << "x" << warp_k;
+		return ss.str();
+	}
+};
+
+inline bool operator==(const config& a, const config& b) {
+	return a.type == b.type && a.op == b.op && a.error_correction == b.error_correction &&
+		a.fm == b.fm && a.fn == b.fn && a.fk == b.fk &&
+		a.block_m == b.block_m && a.block_n == b.block_n &&
+		a.warp_m == b.warp_m && a.warp_n == b.warp_n && a.warp_k == b.warp_k;
+}
+inline bool operator!=(const config& a, const config& b) {return !(a == b);}
+
+// GEMM shape on a device
+// device : e.g. "sm_80" or "sm_80:NVIDIA A100-SXM4-40GB"
+struct problem {
+	unsigned m, n, k;
+	std::string device;
+};
+
+inline bool operator==(const problem& a, const problem& b) {
+	return a.m == b.m && a.n == b.n && a.k == b.k && a.device == b.device;
+}
+
+// The architecture part ("sm_XY") of a device string
+inline std::string get_arch(const std::string& device) {
+	return device.substr(0, device.find(':'));
+}
+
+struct record {
+	mtk::wmma::tcec::tuner::problem problem;
+	mtk::wmma::tcec::tuner::config config;
+	double time;          // [s]
+	std::string source;   // "measured" / "cost_model"
+};
+
+// Whether the GEMM kernel supports the shape with the configuration.
+// The kernel requires m, n, k to be multiples of the warp tile and the tile sizes to be consistent.
+inline bool is_applicable(const config& c, const unsigned m, const unsigned n, const unsigned k) {
+	if (c.warp_m == 0 || c.warp_n == 0 || c.warp_k == 0 || c.fm == 0 || c.fn == 0 || c.fk == 0) {
+		return false;
+	}
+	if (c.block_m % c.warp_m != 0 || c.block_n % c.warp_n != 0) {
+		return false;
+	}
+	if (c.warp_m % c.fm != 0 || c.warp_n % c.fn != 0 || c.warp_k % c.fk != 0) {
+		return false;
+	}
+	if (c.op == "simt" && (c.type != "float" || c.error_correction)) {
+		return false;
+	}
+	return m % c.warp_m == 0 && n % c.warp_n == 0 && k % c.warp_k == 0;
+}
+
+// ------------------------------
+// Cost model
+// ------------------------------
+struct device_model {
+	std::string arch;
+	unsigned num_sms;
+	double fp16_tc_flops;     // dense FP16 Tensor Core with FP32 accumulation [flop/s]
+	double tf32_tc_flops;     // 0 if not supported
+	double fp32_flops;
+	double memory_bandwidth;  // DRAM [B/s]
+	double l2_bandwidth;      // [B/s]
+};
+
+// Representative devices of the architectures
+inline device_model get_device_model(const std::string& arch) {
+	if (arch == "sm_70") return {"sm_70", 80 , 125e12, 0.    , 15.7e12, 900e9 , 2.2e12}; // V100
+	if (arch == "sm_75") return {"sm_75", 40 , 65e12 , 0.    , 8.1e12 , 320e9 , 1.2e12}; // T4
+	if (arch == "sm_80") return {"sm_80", 108, 312e12, 156e12, 19.5e12, 1555e9, 5.1e12}; // A100
+	if (arch == "sm_86") return {"sm_86", 82 , 71e12 , 35.6e12, 35.6e12, 936e9 , 2.5e12}; // RTX 3090
+	if (arch == "sm_89") return {"sm_89", 128, 165e12, 82.6e12, 82.6e12, 1008e9, 5.0e12}; // RTX 4090
+	throw std::runtime_error("tuner : no device model for " + arch);
+}
+
+// Number of 32-bit registers per thread for the fragments of a warp tile.
+// A fixed overhead is added for the addresses and the loop counters.
+inline unsigned estimate_registers(const config& c) {
+	const unsigned ab_bytes = (c.type == "half") ? 2 : 4;
+	const unsigned num_ab = (c.warp_m * c.warp_k + c.warp_k * c.warp_n) / 32;
+	const unsigned num_c  = c.warp_m * c.warp_n / 32;
+	const unsigned factor = c.error_correction ? 2 : 1;
+	return (num_ab * ab_bytes / 4 + num_c) * factor + 32;
+}
+
+// Estimated execution time [s] of the GEMM kernel.
+// Returns infinity if the configuration is not applicable or does not fit in the register file.
+//   - compute : (with_ec : 3 products of x and dx) / (peak of an SM), where the peak is reduced when the number of resident warps is too small to hide the latency
+//   - L2      : each block reads its A and B panels (the warps of a block share them in L1) and reads and writes its C tile
+//   - the blocks are executed in waves and the last partial wave is spread over the SMs
+//   - DRAM    : A, B and C are transferred once (lower bound of the whole kernel)
+inline double estimate_time(const device_model& dev, const config& c, const unsigned m, const unsigned n, const unsigned k) {
+	const auto inf = std::numeric_limits<double>::infinity();
+	if (!is_applicable(c, m, n, k)) {
+		return inf;
+	}
+	double peak;
+	if (c.op == "simt") {
+		peak = dev.fp32_flops;
+	} else if (c.type == "half") {
+		peak = dev.fp16_tc_flops;
+	} else if (c.type == "tf32") {
+		peak = dev.tf32_tc_flops;
+	} else {
+		return inf;
+	}
+	if (peak <= 0.) {
+		return inf;
+	}
+	// mma instructions are slightly faster than wmma due to the smaller fragments
+	if (c.op == "wmma") {
+		peak *= 0.9;
+	}
+
+	// The block is not launchable (blocks_per_sm == 0) if it uses more than 255 registers per thread or 1024 threads
+	const auto registers = estimate_registers(c);
+	const auto num_warps = c.num_warps();
+	const auto blocks_per_sm = mtk::wmma::utils::compute_occupancy(
+			mtk::wmma::utils::get_sm_resource(static_cast<unsigned>(std::stoul(dev.arch.substr(3)))),
+			num_warps * 32, registers, 0
+			).blocks_per_sm;
+	if (blocks_per_sm == 0) {
+		return inf;
+	}
+
+	const double num_products = c.error_correction ? 3. : 1.;
+	const auto block_flops = 2. * c.block_m * c.block_n * k * num_products;
+	const auto block_bytes = 4. * ((static_cast<double>(c.block_m) + c.block_n) * k + 2. * c.block_m * c.block_n);
+
+	// Time of a wave in which each of `num_active_sms` SMs has `num_resident_blocks` blocks
+	const auto wave_time = [&](const unsigned num_resident_blocks, const unsigned num_active_sms) {
+		// 8 resident warps per SM are assumed to be enough to hide the latency
+		const auto latency_efficiency = std::min(1., num_resident_blocks * num_warps / 8.);
+		const auto compute_time = num_resident_blocks * block_flops / (peak / dev.num_sms * latency_efficiency);
+		const auto l2_time = num_resident_blocks * block_bytes / (dev.l2_bandwidth / num_active_sms);
+		return std::max(compute_time, l2_time);
+	};
+
+	const auto num_blocks = static_cast<unsigned long>((m + c.block_m - 1) / c.block_m) * ((n + c.block_n - 1) / c.block_n);
+	const auto blocks_per_wave = static_cast<unsigned long>(dev.num_sms) * blocks_per_sm;
+	const auto num_full_waves = num_blocks / blocks_per_wave;
+	const auto num_remaining_blocks = num_blocks % blocks_per_wave;
+
+	double time = num_full_waves * wave_time(blocks_per_sm, dev.num_sms);
+	if (num_remaining_blocks) {
+		time += wave_time(
+				static_cast<unsigned>((num_remaining_blocks + dev.num_sms - 1) / dev.num_sms),
+				static_cast<unsigned>(std::min<unsigned long>(num_remaining_blocks, dev.num_sms))
+				);
+	}
+	const auto dram_time = 4. * (static_cast<double>(m) * k + static_cast<double>(k) * n + 2. * m * n) / dev.memory_bandwidth;
+	return std::max(time, dram_time);
+}
+
+// ------------------------------
+// Cache
+// ------------------------------
+// The cache keeps one record per (problem, config).
+//
+// {
+//   "version": 1,
+//   "records": [
+//     {"device": "sm_80", "m": 1024, "n": 1024, "k": 1024,
+//      "type": "half", "op": "mma", "error_correction": true, "fm": 16, "fn": 8, "fk": 16,
+//      "block_m": 64, "block_n": 64, "warp_m": 32, "warp_n": 32, "warp_k": 32,
+//      "time": 1.2e-4, "source": "measured"},
+//     ...
+//   ]
+// }
+struct cache {
+	static const unsigned version = 1;
+	std::vector<record> records;
+
+	// Inserts a record or updates the record of the same (problem, config)
+	void insert(const record& r) {
+		for (auto& e : records) {
+			if (e.problem == r.problem && e.config == r.config) {
+				e = r;
+				return;
+			}
+		}
+		records.push_back(r);
+	}
+
+	// The fastest record of the problem (nullptr if none)
+	const record* find_best(const problem& p) const {
+		const record* best = nullptr;
+		for (const auto& e : records) {
+			if (e.problem == p && (best == nullptr || e.time < best->time)) {
+				best = &e;
+			}
+		}
+		return best;
+	}
+
+	// The fastest record of the nearest problem on the same device among the records applicable to the problem.
+	// The distance is |log(m/m')| + |log(n/n')| + |log(k/k')|.
+	const record* find_nearest(const problem& p) const {
+		const record* best = nullptr;
+		double best_distance = 0.;
+		for (const auto& e : records) {
+			if (e.problem.device != p.device || !is_applicable(e.config, p.m, p.n, p.k)) {
+				continue;
+			}
+			const auto distance =
+				std::abs(std::log(static_cast<double>(e.problem.m) / p.m)) +
+				std::abs(std::log(static_cast<double>(e.problem.n) / p.n)) +
+				std::abs(std::log(static_cast<double>(e.problem.k) / p.k));
+			if (best == nullptr || distance < best_distance || (distance == best_distance && e.time < best->time)) {
+				best = &e;
+				best_distance = distance;
+			}
+		}
+		return best;
+	}
+
+	std::string to_json() const {
+		using mtk::wmma::detail::json::escape;
+		using mtk::wmma::detail::json::to_string;
+		std::stringstream ss;
+		ss << "{\n  \"version\": " << version << ",\n  \"records\": [";
+		for (std::size_t i = 0; i < records.size(); i++) {
+			const auto& r = records[i];
+			ss << (i == 0 ? "\n" : ",\n")
+				<< "    {\"device\": " << escape(r.problem.device)
+				<< ", \"m\": " << r.problem.m << ", \"n\": " << r.problem.n << ", \"k\": " << r.problem.k
+				<< ", \"type\": " << escape(r.config.type)
+				<< ", \"op\": " << escape(r.config.op)
+				<< ", \"error_correction\": " << (r.config.error_correction ? "true" : "false")
+				<< ", \"fm\": " << r.config.fm << ", \"fn\": " << r.config.fn << ", \"fk\": " << r.config.fk
+				<< ", \"block_m\": " << r.config.block_m << ", \"block_n\": " << r.config.block_n
+				<< ", \"warp_m\": " << r.config.warp_m << ", \"warp_n\": " << r.config.warp_n << ", \"warp_k\": " << r.config.warp_k
+				<< ", \"time\": " << to_string(r.time)
+				<< ", \"source\": " << escape(r.source)
+				<< "}";
+		}
+		ss << "\n  ]\n}\n";
+		return ss.str();
+	}
+
+	// Throws std::runtime_error if the string is not a tuning cache
+	static cache from_json(const std::string& str) {
+		using value = mtk::wmma::detail::json::value;
+		const auto root = mtk::wmma::detail::json::parse(str);
+		if (root.type != value::object_t) {
+			throw std::runtime_error("tuner : the root of the cache is not an object");
+		}
+		if (static_cast<unsigned>(root.at("version", value::number_t).number) != version) {
+			throw std::runtime_error("tuner : unsupported cache version");
+		}
+		const auto get_uint = [](const value& v, const char* key) {
+			return static_cast<unsigned>(v.at(key, value::number_t).number);
+		};
+		cache res;
+		for (const auto& v : root.at("records", value::array_t).array) {
+			record r;
+			r.problem.device = v.at("device", value::string_t).string;
+			r.problem.m = get_uint(v, "m");
+			r.problem.n = get_uint(v, "n");
+			r.problem.k = get_uint(v, "k");
+			r.config.type = v.at("type", value::string_t).string;
+			r.config.op = v.at("op", value::string_t).string;
+			r.config.error_correction = v.at("error_correction", value::bool_t).boolean;
+			r.config.fm = get_uint(v, "fm");
+			r.config.fn = get_uint(v, "fn");
+			r.config.fk = get_uint(v, "fk");
+			r.config.block_m = get_uint(v, "block_m");
+			r.config.block_n = get_uint(v, "block_n");
+			r.config.warp_m = get_uint(v, "warp_m");
+			r.config.warp_n = get_uint(v, "warp_n");
+			r.config.warp_k = get_uint(v, "warp_k");
+			r.time = v.at("time", value::number_t).number;
+			r.source = v.at("source", value::string_t).string;
+			res.insert(r);
+		}
+		return res;
+	}
+
+	void save(const std::string& path) const {
+		std::ofstream ofs(path);
+		if (!ofs) {
+			throw std::runtime_error("tuner : cannot open " + path);
+		}
+		ofs << to_json();
+	}
+
+	// Returns an empty cache if the file does not exist
+	static cache load(const std::string& path) {
+		std::ifstream ifs(path);
+		if (!ifs) {
+			return cache{};
+		}
+		std::stringstream ss;
+		ss << ifs.rdbuf();
+		return from_json(ss.str());
+	}
+};
+
+// ------------------------------
+// Candidates
+// ------------------------------
+// Sweep of the policies and the tile sizes available on the architecture for the cost model mode.
+// require_ec : only the configurations which give FP32 accuracy (with_ec or simt)
+inline std::vector<config> default_candidates(const std::string& arch, const bool require_ec = true) {
+	const auto sm = std::stoi(arch.substr(3));
+	struct policy_t {const char* type; const char* op; unsigned fm, fn, fk;};
+	std::vector<policy_t> policies;
+	policies.push_back({"half", "wmma", 16, 16, 16});
+	if (sm >= 75) {
+		policies.push_back({"half", "mma", 16, 8, (sm >= 80 ? 16u : 8u)});
+	}
+	if (sm >= 80) {
+		policies.push_back({"tf32", "wmma", 16, 16, 8});
+		policies.push_back({"tf32", "mma" , 16, 8 , 8});
+	}
+	policies.push_back({"float", "simt", 16, 16, 16});
+
+	std::vector<config> res;
+	for (const auto& p : policies) {
+		for (const auto ec : {true, false}) {
+			if (p.op == std::string("simt") && ec) continue;
+			if (p.op != std::string("simt") && require_ec && !ec) continue;
+			for (const auto warp_m : {16u, 32u, 64u}) {
+				for (const auto warp_n : {16u, 32u, 64u}) {
+					for (const auto warp_k : {16u, 32u}) {
+						for (const auto block_m : {32u, 64u, 128u}) {
+							for (const auto block_n : {32u, 64u, 128u}) {
+								const config c{p.type, p.op, ec, p.fm, p.fn, p.fk, block_m, block_n, warp_m, warp_n, warp_k};
+								if (c.block_m % c.warp_m != 0 || c.block_n % c.warp_n != 0 || c.warp_m % c.fm != 0 || c.warp_n % c.fn != 0 || c.warp_k % c.fk != 0) {
+									continue;
+								}
+								if (c.num_warps() > 16) {
+									continue;
+								}
+								res.push_back(c);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return res;
+}
+
+// ------------------------------
+// Tuning
+// ------------------------------
+// Measures the applicable candidates by `measure(config)` (returning the time [s]) and inserts the results into the cache.
+// Returns the number of measured candidates.
+template <class Measure>
+inline std::size_t tune(
+		cache& c,
+		const problem& p,
+		const std::vector<config>& candidates,
+		Measure measure,
+		const std::string& source = "measured"
+		) {
+	std::size_t count = 0;
+	for (const auto& candidate : candidates) {
+		if (!is_applicable(candidate, p.m, p.n, p.k)) {
+			continue;
+		}
+		const double time = measure(candidate);
+		if (!std::isfinite(time) || time <= 0.) {
+			continue;
+		}
+		c.insert(record{p, candidate, time, source});
+		count++;
+	}
+	return count;
+}
+
+// Host-only tuning by the cost model
+inline std::size_t tune_with_cost_model(
+		cache& c,
+		const problem& p,
+		const std::vector<config>& candidates
+		) {
+	const auto dev = get_device_model(get_arch(p.device));
+	return tune(c, p, candidates,
+			[&](const config& candidate) {return estimate_time(dev, candidate, p.m, p.n, p.k);},
+			"cost_model");
+}
+
+// ------------------------------
+// Selection
+// ------------------------------
+struct selection {
+	enum source_t {
+		exact,       // the best record of the problem
+		nearest,     // the best record of the nearest shape on the same device
+		cost_model,  // the cost model
+		fallback,    // the first applicable candidate (no device model of the architecture)
+		none,        // no applicable candidate
+	};
+	source_t source;
+	mtk::wmma::tcec::tuner::config config;
+};
+
+// Selects the configuration for the problem at run time.
+// Only the configurations in `candidates` are selected (e.g. the kernels compiled in the binary).
+// If `candidates` is empty, any configuration in the cache can be selected.
+inline selection select(
+		const cache& c,
+		const problem& p,
+		const std::vector<config>& candidates = {}
+		) {
+	const auto is_candidate = [&](const config& x) {
+		return candidates.empty() || std::find(candidates.begin(), candidates.end(), x) != candidates.end();
+	};
+
+	cache filtered;
+	for (const auto& r : c.records) {
+		if (is_candidate(r.config)) {
+			filtered.records.push_back(r);
+		}
+	}
+
+	if (const auto r = filtered.find_best(p)) {
+		return selection{selection::exact, r->config};
+	}
+	if (const auto r = filtered.find_nearest(p)) {
+		return selection{selection::nearest, r->config};
+	}
+
+	device_model dev;
+	try {
+		dev = get_device_model(get_arch(p.device));
+	} catch (const std::runtime_error&) {
+		for (const auto& candidate : candidates) {
+			if (is_applicable(candidate, p.m, p.n, p.k)) {
+				return selection{selection::fallback, candidate};
+			}
+		}
+		return selection{selection::none, config{}};
+	}
+
+	const config* best = nullptr;
+	double best_time = std::numeric_limits<double>::infinity();
+	for (const auto& candidate : candidates) {
+		const auto time = estimate_time(dev, candidate, p.m, p.n, p.k);
+		if (time < best_time) {
+			best_time = time;
+			best = &candidate;
+		}
+	}
+	if (best != nullptr) {
+		return selection{selection::cost_model, *best};
+	}
+	return selection{selection::none, config{}};
+}
+
+} // namespace tuner
+} // namespace tcec
+} // namespace wmma
+} // namespace mtk
+#endif
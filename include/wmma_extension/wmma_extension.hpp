@@ -108,6 +108,42 @@ __device__ inline void map(
 	__syncwarp();
 }
 
+// ------------------------------
+// Bounds-checked LD/ST functions for matrices
+// ------------------------------
+// Only the elements in [0, rows) x [0, cols) of the fragment matrix are accessed.
+// The other elements are filled with zero on load and are not written on store.
+template <class Use, int M, int N, int K, class FT, class Layout, class T>
+__device__ inline void load_matrix_sync(nvcuda::wmma::fragment<Use, M, N, K, FT, Layout>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols) {
+	mtk::wmma::foreach_ij<decltype(frag)>(
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(ptr[mtk::wmma::detail::common::get_mem_offset<Layout>(i, j, ldm)])
+				: mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++)
+				frag.x[frag_index_list[f]] = v;
+		});
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void load_matrix_sync(nvcuda::wmma::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	mtk::wmma::foreach_ij<decltype(frag)>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(ptr[mtk::wmma::detail::common::get_mem_offset(i, j, ldm, layout)])
+				: mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++)
+				frag.x[frag_index_list[f]] = v;
+		});
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void store_matrix_sync(T* const ptr, const nvcuda::wmma::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	mtk::wmma::foreach_ij<nvcuda::wmma::fragment<nvcuda::wmma::accumulator, M, N, K, FT>>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			if (i < rows && j < cols)
+				ptr[mtk::wmma::detail::common::get_mem_offset(i, j, ldm, layout)] = mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<T>::type>(frag.x[frag_index_list[0]]);
+		});
+}
+
 // ------------------------------
 // LD/ST functions for vectors
 // ------------------------------
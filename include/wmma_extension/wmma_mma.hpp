@@ -5,6 +5,8 @@
 #include "detail/m16n8k8.hpp"
 #include "detail/m16n8k8_tf32.hpp"
 #include "detail/m8n8k4.hpp"
+#include "detail/m16n8k16_sp.hpp"
+#include "detail/m16n8k32_sp.hpp"
 
 namespace mtk {
 namespace wmma {
@@ -103,6 +105,60 @@ __device__ inline void store_matrix_sync(T* const ptr, const mtk::wmma::mma::fra
 		__syncwarp();
 }
 
+// Load the metadata of a 2:4 sparse matrix A encoded by `mtk::wmma::mma::sparse::compress`.
+// `ptr` is the first metadata word of the M x K tile and `ldm` is the leading dimension of the metadata in words.
+template <int M, int N, int K, class T>
+__device__ inline void load_metadata_sync(mtk::wmma::mma::fragment<mtk::wmma::mma::metadata, M, N, K, T>& frag, const std::uint16_t* const ptr, const unsigned ldm, const bool sync = true) {
+	frag.x[0] = mtk::wmma::mma::sparse::detail::get_metadata<K>(ptr, ldm, mtk::wmma::detail::common::get_lane_id());
+	if (sync)
+		__syncwarp();
+}
+
+// ------------------------------
+// Bounds-checked LD/ST functions for mma fragments
+// ------------------------------
+// Only the elements in [0, rows) x [0, cols) of the fragment matrix are accessed.
+// The other elements are filled with zero on load and are not written on store.
+template <class Use, int M, int N, int K, class FT, class Layout, class T>
+__device__ inline void load_matrix_sync(mtk::wmma::mma::fragment<Use, M, N, K, FT, Layout>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const bool sync = true) {
+	mtk::wmma::mma::foreach_ij<decltype(frag)>(
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(ptr[mtk::wmma::detail::common::get_mem_offset<Layout>(i, j, ldm)])
+				: mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++) {
+				frag.x[frag_index_list[f]] = v;
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void load_matrix_sync(mtk::wmma::mma::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const T* const ptr, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	mtk::wmma::mma::foreach_ij<decltype(frag)>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			const auto v = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(ptr[mtk::wmma::detail::common::get_mem_offset(i, j, ldm, layout)])
+				: mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<FT>::type>(0.0f);
+			for (unsigned f = 0; f < fragment_index_count; f++) {
+				frag.x[frag_index_list[f]] = v;
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
+template <int M, int N, int K, class FT, class T>
+__device__ inline void store_matrix_sync(T* const ptr, const mtk::wmma::mma::fragment<nvcuda::wmma::accumulator, M, N, K, FT>& frag, const unsigned ldm, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout, const bool sync = true) {
+	mtk::wmma::mma::foreach_ij<decltype(frag)>(layout,
+		[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+			if (i < rows && j < cols) {
+				ptr[mtk::wmma::detail::common::get_mem_offset(i, j, ldm, layout)] = mtk::wmma::detail::common::cast<typename mtk::wmma::detail::common::storage_t<T>::type>(frag.x[frag_index_list[0]]);
+			}
+		});
+	if (sync)
+		__syncwarp();
+}
+
 // ------------------------------
 // LD/ST vector functions for mma fragments
 // ------------------------------
@@ -139,6 +195,19 @@ __device__ inline void store_vector(T* const ptr, const mtk::wmma::mma::fragment
 		});
 }
 
+// Returns true if all elements of the fragment are zero in the warp (warp vote, the same value in all threads)
+// A GEMM main loop can skip the mma of an all-zero operand, e.g.
+//   if (!mtk::wmma::mma::is_zero(frag_a)) {mtk::wmma::mma::mma_sync(frag_c, frag_a, frag_b, frag_c);}
+// which changes the result only when the other operand has inf or nan.
+template <class Use, int M, int N, int K, class FT, class Layout>
+__device__ inline bool is_zero(const mtk::wmma::mma::fragment<Use, M, N, K, FT, Layout>& frag) {
+	bool zero = true;
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		zero = zero && (mtk::wmma::detail::common::cast<float>(frag.x[i]) == 0.f);
+	}
+	return __all_sync(0xffffffff, zero);
+}
+
 template <class MatrixType, int M, int N, int K, class MemMajor, class T>
 __device__ inline void print_fragment(const mtk::wmma::mma::fragment<MatrixType, M, N, K, T, MemMajor>& frag, const char* name = "") {
 	if ((threadIdx.x & 0x1f) == 0) {
@@ -0,0 +1,498 @@
+// Benchmark driver of the primitives
+//   ./benchmark.test [--warmup=N] [--iterations=N] [--filter=STR] [--format=text|json|csv] [--output=PATH]
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+#include <mma.h>
+#include <cublas_v2.h>
+#include <wmma_extension/wmma_extension.hpp>
+#include <wmma_extension/tcec/tuner.hpp>
+#include "benchmark.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+#ifndef BENCH_CHECK_ERROR
+#define BENCH_CHECK_ERROR(status) bench_check_error(status, __FILE__, __LINE__)
+#endif
+
+inline void bench_check_error(const cudaError_t error, const std::string filename, const std::size_t line) {
+	if (error != cudaSuccess) {
+		std::stringstream ss;
+		ss << cudaGetErrorString(error) << " [" << filename << ":" << line << "]";
+		throw std::runtime_error(ss.str());
+	}
+}
+
+inline void bench_check_error(const cublasStatus_t error, const std::string filename, const std::size_t line) {
+	if (error != CUBLAS_STATUS_SUCCESS) {
+		std::stringstream ss;
+		ss << "cuBLAS error " << static_cast<int>(error) << " [" << filename << ":" << line << "]";
+		throw std::runtime_error(ss.str());
+	}
+}
+
+namespace {
+namespace bench = mtk::bench;
+
+constexpr unsigned warp_size = 32;
+constexpr unsigned num_warps_per_block = 8;
+constexpr unsigned tile_size = 16 * 16;
+// Each warp processes a 16x16 tile
+constexpr unsigned num_tiles = 1u << 15;
+
+// ------------------------------
+// Timer
+// ------------------------------
+class event_timer {
+	cudaEvent_t start, stop;
+public:
+	event_timer() {
+		BENCH_CHECK_ERROR(cudaEventCreate(&start));
+		BENCH_CHECK_ERROR(cudaEventCreate(&stop));
+	}
+	~event_timer() {
+		cudaEventDestroy(start);
+		cudaEventDestroy(stop);
+	}
+	// Returns the elapsed time of `func` on the device [s]
+	template <class Func>
+	double operator()(Func func) {
+		BENCH_CHECK_ERROR(cudaEventRecord(start));
+		func();
+		BENCH_CHECK_ERROR(cudaEventRecord(stop));
+		BENCH_CHECK_ERROR(cudaEventSynchronize(stop));
+		BENCH_CHECK_ERROR(cudaGetLastError());
+		float elapsed_ms;
+		BENCH_CHECK_ERROR(cudaEventElapsedTime(&elapsed_ms, start, stop));
+		return elapsed_ms * 1e-3;
+	}
+};
+
+bench::machine get_machine() {
+	int device_id;
+	BENCH_CHECK_ERROR(cudaGetDevice(&device_id));
+	cudaDeviceProp prop;
+	BENCH_CHECK_ERROR(cudaGetDeviceProperties(&prop, device_id));
+
+	bench::machine m;
+	m.name = mtk::wmma::tcec::tuner::get_device_string();
+	try {
+		const auto dev = mtk::wmma::tcec::tuner::get_device_model(mtk::wmma::tcec::tuner::get_arch(m.name));
+		m.fp16_tc_flops = dev.fp16_tc_flops;
+		m.tf32_tc_flops = dev.tf32_tc_flops;
+		m.fp32_flops = dev.fp32_flops;
+	} catch (const std::runtime_error&) {
+		// Unknown architecture : the compute roofs are not available
+	}
+	// DDR
+	m.memory_bandwidth = 2. * prop.memoryClockRate * 1e3 * (prop.memoryBusWidth / 8);
+	return m;
+}
+
+// ------------------------------
+// Primitive microbenchmarks
+// ------------------------------
+// The sum of the elements is written so that the loads are not removed by the compiler
+template <class Frag>
+__device__ void write_sink(float* const out, const Frag& frag) {
+	float sum = 0.f;
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		sum += mtk::wmma::detail::common::cast<float>(frag.x[i]);
+	}
+	out[blockIdx.x * blockDim.x + threadIdx.x] = sum;
+}
+
+__device__ const float* get_tile_ptr(const float* const src) {
+	return src + ((blockIdx.x * blockDim.x + threadIdx.x) / warp_size) * tile_size;
+}
+
+// Native : the tile is converted in the shared memory and loaded by `load_matrix_sync`
+template <class Frag>
+__device__ void load_native(Frag& frag, const float* const tile) {
+	using storage_t = typename mtk::wmma::detail::common::storage_t<typename std::remove_reference<decltype(frag.x[0])>::type>::type;
+	__shared__ storage_t smem[num_warps_per_block * tile_size];
+	const auto warp_smem = smem + (threadIdx.x / warp_size) * tile_size;
+	for (unsigned i = threadIdx.x % warp_size; i < tile_size; i += warp_size) {
+		warp_smem[i] = mtk::wmma::detail::common::cast<storage_t>(tile[i]);
+	}
+	__syncwarp();
+	nvcuda::wmma::load_matrix_sync(frag, warp_smem, 16);
+}
+
+using frag_a_t = nvcuda::wmma::fragment<nvcuda::wmma::matrix_a, 16, 16, 16, half, nvcuda::wmma::col_major>;
+
+template <bool WMMAE>
+__global__ void foreach_kernel(float* const out, const float* const src) {
+	const auto tile = get_tile_ptr(src);
+	frag_a_t frag;
+	if (WMMAE) {
+		mtk::wmma::foreach<frag_a_t>(
+				[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned mem_index) {
+					const auto v = __float2half(tile[mem_index]);
+					for (unsigned i = 0; i < fragment_index_count; i++) {
+						frag.x[frag_index_list[i]] = v;
+					}
+				});
+	} else {
+		load_native(frag, tile);
+	}
+	write_sink(out, frag);
+}
+
+template <bool WMMAE>
+__global__ void foreach_ij_kernel(float* const out, const float* const src) {
+	const auto tile = get_tile_ptr(src);
+	frag_a_t frag;
+	if (WMMAE) {
+		mtk::wmma::foreach_ij<frag_a_t>(
+				[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+					const auto v = __float2half(tile[i + j * 16]);
+					for (unsigned f = 0; f < fragment_index_count; f++) {
+						frag.x[frag_index_list[f]] = v;
+					}
+				});
+	} else {
+		load_native(frag, tile);
+	}
+	write_sink(out, frag);
+}
+
+template <bool WMMAE>
+__global__ void map_kernel(float* const out, const float* const src) {
+	const auto tile = get_tile_ptr(src);
+	frag_a_t frag;
+	if (WMMAE) {
+		const auto lane_id = threadIdx.x % warp_size;
+		for (unsigned i = 0; i < 16; i++) {
+			for (unsigned j = 0; j < 16; j++) {
+				unsigned tid_list[2];
+				unsigned fid_list[2];
+				unsigned list_size;
+				mtk::wmma::map<frag_a_t>(tid_list, fid_list, list_size, i, j);
+				for (unsigned k = 0; k < list_size; k++) {
+					if (lane_id == tid_list[k]) {
+						frag.x[fid_list[k]] = __float2half(tile[i + j * 16]);
+					}
+				}
+			}
+		}
+	} else {
+		load_native(frag, tile);
+	}
+	write_sink(out, frag);
+}
+
+// A 16-element vector per warp
+template <bool WMMAE>
+__global__ void load_vector_kernel(float* const out, const float* const src) {
+	const auto vec = src + ((blockIdx.x * blockDim.x + threadIdx.x) / warp_size) * 16;
+	frag_a_t frag;
+	if (WMMAE) {
+		mtk::wmma::load_vector(frag, vec);
+	} else {
+		__shared__ half smem[num_warps_per_block * tile_size];
+		const auto warp_smem = smem + (threadIdx.x / warp_size) * tile_size;
+		for (unsigned i = threadIdx.x % warp_size; i < tile_size; i += warp_size) {
+			warp_smem[i] = __float2half(i < 16 ? vec[i] : 0.f);
+		}
+		__syncwarp();
+		nvcuda::wmma::load_matrix_sync(frag, warp_smem, 16);
+	}
+	write_sink(out, frag);
+}
+
+// C += I
+template <bool WMMAE>
+__global__ void add_eye_kernel(float* const dst, const float* const src) {
+	const auto offset = ((blockIdx.x * blockDim.x + threadIdx.x) / warp_size) * tile_size;
+	nvcuda::wmma::fragment<nvcuda::wmma::accumulator, 16, 16, 16, float> frag;
+	nvcuda::wmma::load_matrix_sync(frag, src + offset, 16, nvcuda::wmma::mem_col_major);
+	if (WMMAE) {
+		mtk::wmma::add_eye(frag, 1.f);
+	} else {
+		__shared__ float smem[num_warps_per_block * tile_size];
+		const auto warp_smem = smem + (threadIdx.x / warp_size) * tile_size;
+		for (unsigned i = threadIdx.x % warp_size; i < tile_size; i += warp_size) {
+			warp_smem[i] = (i % 17 == 0) ? 1.f : 0.f;
+		}
+		__syncwarp();
+		nvcuda::wmma::fragment<nvcuda::wmma::accumulator, 16, 16, 16, float> frag_eye;
+		nvcuda::wmma::load_matrix_sync(frag_eye, warp_smem, 16, nvcuda::wmma::mem_col_major);
+		for (unsigned i = 0; i < frag.num_elements; i++) {
+			frag.x[i] += frag_eye.x[i];
+		}
+	}
+	nvcuda::wmma::store_matrix_sync(dst + offset, frag, 16, nvcuda::wmma::mem_col_major);
+}
+
+// Measures the WMMA-e and the native implementations and checks that their outputs are the same
+template <class Kernel>
+void bench_primitive(
+		bench::suite& s,
+		const std::string& group,
+		Kernel wmmae_kernel, Kernel native_kernel,
+		const std::size_t out_size,
+		const float* const src,
+		const double bytes
+		) {
+	const unsigned num_blocks = num_tiles / num_warps_per_block;
+	float *out_wmmae, *out_native;
+	BENCH_CHECK_ERROR(cudaMallocManaged(&out_wmmae , sizeof(float) * out_size));
+	BENCH_CHECK_ERROR(cudaMallocManaged(&out_native, sizeof(float) * out_size));
+	event_timer timer;
+
+	bench::result r;
+	r.group = group;
+	r.params = "tiles=" + std::to_string(num_tiles);
+	r.bytes = bytes;
+
+	r.name = group + "/native";
+	r.variant = "native";
+	s.run(r, [&]() {return timer([&]() {native_kernel<<<num_blocks, num_warps_per_block * warp_size>>>(out_native, src);});});
+
+	r.name = group + "/wmmae";
+	r.variant = "wmmae";
+	s.run(r,
+			[&]() {return timer([&]() {wmmae_kernel<<<num_blocks, num_warps_per_block * warp_size>>>(out_wmmae, src);});},
+			[&]() {
+				if (!s.is_enabled(group + "/native")) {
+					native_kernel<<<num_blocks, num_warps_per_block * warp_size>>>(out_native, src);
+				}
+				BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+				for (std::size_t i = 0; i < out_size; i++) {
+					if (out_wmmae[i] != out_native[i]) {
+						return false;
+					}
+				}
+				return true;
+			});
+
+	BENCH_CHECK_ERROR(cudaFree(out_wmmae));
+	BENCH_CHECK_ERROR(cudaFree(out_native));
+}
+
+void run_primitive_benchmarks(bench::suite& s) {
+	float* src;
+	BENCH_CHECK_ERROR(cudaMallocManaged(&src, sizeof(float) * num_tiles * tile_size));
+	std::mt19937 mt(0);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	for (std::size_t i = 0; i < static_cast<std::size_t>(num_tiles) * tile_size; i++) {
+		src[i] = dist(mt);
+	}
+	BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+
+	const std::size_t sink_size = static_cast<std::size_t>(num_tiles) * warp_size;
+	const double tile_bytes = 4. * num_tiles * tile_size + 4. * sink_size;
+	bench_primitive(s, "foreach"    , foreach_kernel<true>    , foreach_kernel<false>    , sink_size, src, tile_bytes);
+	bench_primitive(s, "foreach_ij" , foreach_ij_kernel<true> , foreach_ij_kernel<false> , sink_size, src, tile_bytes);
+	bench_primitive(s, "map"        , map_kernel<true>        , map_kernel<false>        , sink_size, src, tile_bytes);
+	bench_primitive(s, "load_vector", load_vector_kernel<true>, load_vector_kernel<false>, sink_size, src, 4. * num_tiles * 16 + 4. * sink_size);
+	bench_primitive(s, "add_eye"    , add_eye_kernel<true>    , add_eye_kernel<false>    , static_cast<std::size_t>(num_tiles) * tile_size, src, 2 * 4. * num_tiles * tile_size);
+
+	BENCH_CHECK_ERROR(cudaFree(src));
+}
+
+// ------------------------------
+// GEMM benchmarks (TCEC vs native WMMA vs cuBLAS)
+// A : row major, B : col major, C : col major
+// ------------------------------
+// Native WMMA without error correction. A and B are converted to half in advance.
+__global__ void native_wmma_gemm_kernel(
+		const unsigned m, const unsigned n, const unsigned k,
+		const half* const a_ptr, const half* const b_ptr, float* const c_ptr
+		) {
+	const unsigned warp_id = (blockIdx.x * blockDim.x + threadIdx.x) / warp_size;
+	const unsigned tile_m = (warp_id % (m / 16)) * 16;
+	const unsigned tile_n = (warp_id / (m / 16)) * 16;
+	if (tile_n >= n) {
+		return;
+	}
+	nvcuda::wmma::fragment<nvcuda::wmma::matrix_a, 16, 16, 16, half, nvcuda::wmma::row_major> frag_a;
+	nvcuda::wmma::fragment<nvcuda::wmma::matrix_b, 16, 16, 16, half, nvcuda::wmma::col_major> frag_b;
+	nvcuda::wmma::fragment<nvcuda::wmma::accumulator, 16, 16, 16, float> frag_c;
+	nvcuda::wmma::fill_fragment(frag_c, 0.f);
+	for (unsigned kk = 0; kk < k; kk += 16) {
+		nvcuda::wmma::load_matrix_sync(frag_a, a_ptr + tile_m * k + kk, k);
+		nvcuda::wmma::load_matrix_sync(frag_b, b_ptr + tile_n * k + kk, k);
+		nvcuda::wmma::mma_sync(frag_c, frag_a, frag_b, frag_c);
+	}
+	nvcuda::wmma::store_matrix_sync(c_ptr + tile_m + tile_n * m, frag_c, m, nvcuda::wmma::mem_col_major);
+}
+
+__global__ void convert_to_half_kernel(half* const dst, const float* const src, const std::size_t size) {
+	const auto tid = static_cast<std::size_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+	if (tid < size) {
+		dst[tid] = __float2half(src[tid]);
+	}
+}
+
+#if TEST_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif TEST_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+
+template <class T, class EC, class Op>
+using policy_t = typename mtk::wmma::tcec::detail::default_policy<T, EC, Op, sm_t>::type;
+using simt_policy_t = typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type;
+
+struct gemm_buffers {
+	unsigned m, n, k;
+	float *a, *b, *c, *c_ref;
+	half *a_h, *b_h;
+};
+
+double relative_residual(const gemm_buffers& buf) {
+	double base = 0., diff = 0.;
+	for (std::size_t i = 0; i < static_cast<std::size_t>(buf.m) * buf.n; i++) {
+		base += static_cast<double>(buf.c_ref[i]) * buf.c_ref[i];
+		diff += (static_cast<double>(buf.c[i]) - buf.c_ref[i]) * (static_cast<double>(buf.c[i]) - buf.c_ref[i]);
+	}
+	return std::sqrt(diff / base);
+}
+
+bench::result make_gemm_result(const gemm_buffers& buf, const std::string& name, const std::string& variant, const bench::unit u) {
+	bench::result r;
+	r.name = "gemm/" + name;
+	r.group = "gemm";
+	r.variant = variant;
+	r.params = "m=" + std::to_string(buf.m) + ",n=" + std::to_string(buf.n) + ",k=" + std::to_string(buf.k);
+	r.bound_unit = u;
+	r.flop = 2. * buf.m * buf.n * buf.k;
+	r.bytes = 4. * (static_cast<double>(buf.m) * buf.k + static_cast<double>(buf.k) * buf.n + static_cast<double>(buf.m) * buf.n);
+	return r;
+}
+
+template <class Candidate>
+void bench_tcec_gemm(bench::suite& s, const gemm_buffers& buf, const std::string& name, const bench::unit u, const double threshold) {
+	event_timer timer;
+	const auto config = Candidate::get_config();
+	auto r = make_gemm_result(buf, name, "wmmae", u);
+	r.params += "," + config.to_string();
+	s.run(r,
+			[&]() {return timer([&]() {Candidate::launch(buf.m, buf.n, buf.k, 1.f, buf.a, buf.k, buf.b, buf.k, 0.f, buf.c, buf.m);});},
+			[&]() {
+				BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+				return relative_residual(buf) < threshold;
+			});
+}
+
+void run_gemm_benchmarks(bench::suite& s, cublasHandle_t cublas_handle, const unsigned n) {
+	gemm_buffers buf;
+	buf.m = buf.n = buf.k = n;
+	const std::size_t size = static_cast<std::size_t>(n) * n;
+	BENCH_CHECK_ERROR(cudaMallocManaged(&buf.a, sizeof(float) * size));
+	BENCH_CHECK_ERROR(cudaMallocManaged(&buf.b, sizeof(float) * size));
+	BENCH_CHECK_ERROR(cudaMallocManaged(&buf.c, sizeof(float) * size));
+	BENCH_CHECK_ERROR(cudaMallocManaged(&buf.c_ref, sizeof(float) * size));
+	BENCH_CHECK_ERROR(cudaMalloc(&buf.a_h, sizeof(half) * size));
+	BENCH_CHECK_ERROR(cudaMalloc(&buf.b_h, sizeof(half) * size));
+
+	std::mt19937 mt(n);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	for (std::size_t i = 0; i < size; i++) {
+		buf.a[i] = dist(mt);
+		buf.b[i] = dist(mt);
+	}
+	convert_to_half_kernel<<<(size + 255) / 256, 256>>>(buf.a_h, buf.a, size);
+	convert_to_half_kernel<<<(size + 255) / 256, 256>>>(buf.b_h, buf.b, size);
+	BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+
+	const float alpha = 1.f, beta = 0.f;
+	event_timer timer;
+
+	// cuBLAS SGEMM (also the reference of the result checks)
+	s.run(make_gemm_result(buf, "cublas_sgemm", "cublas", bench::unit::fp32),
+			[&]() {
+				return timer([&]() {
+					BENCH_CHECK_ERROR(cublasSgemm(cublas_handle, CUBLAS_OP_T, CUBLAS_OP_N, n, n, n, &alpha, buf.a, n, buf.b, n, &beta, buf.c_ref, n));
+				});
+			});
+	BENCH_CHECK_ERROR(cublasSgemm(cublas_handle, CUBLAS_OP_T, CUBLAS_OP_N, n, n, n, &alpha, buf.a, n, buf.b, n, &beta, buf.c_ref, n));
+	BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+
+#if CUDART_VERSION >= 11000
+	// cuBLAS with the FP16 Tensor Cores (no error correction)
+	s.run(make_gemm_result(buf, "cublas_fast_16f", "cublas", bench::unit::fp16_tc),
+			[&]() {
+				return timer([&]() {
+					BENCH_CHECK_ERROR(cublasGemmEx(cublas_handle, CUBLAS_OP_T, CUBLAS_OP_N, n, n, n,
+								&alpha, buf.a, CUDA_R_32F, n, buf.b, CUDA_R_32F, n,
+								&beta, buf.c, CUDA_R_32F, n,
+								CUBLAS_COMPUTE_32F_FAST_16F, CUBLAS_GEMM_DEFAULT_TENSOR_OP));
+				});
+			},
+			[&]() {
+				BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+				return relative_residual(buf) < 1e-2;
+			});
+#endif
+
+	// Native WMMA (FP16 inputs, no error correction)
+	const unsigned num_warps = (n / 16) * (n / 16);
+	s.run(make_gemm_result(buf, "native_wmma", "native", bench::unit::fp16_tc),
+			[&]() {
+				return timer([&]() {
+					native_wmma_gemm_kernel<<<(num_warps + 3) / 4, 4 * warp_size>>>(n, n, n, buf.a_h, buf.b_h, buf.c);
+				});
+			},
+			[&]() {
+				BENCH_CHECK_ERROR(cudaDeviceSynchronize());
+				return relative_residual(buf) < 1e-2;
+			});
+
+	// TCEC
+	using mtk::wmma::tcec::with_ec;
+	using mtk::wmma::tcec::without_ec;
+	using mtk::wmma::tcec::op_mma;
+	using mtk::wmma::tcec::op_wmma;
+	using mtk::wmma::tcec::tuner::candidate;
+	bench_tcec_gemm<candidate<half, policy_t<half, with_ec   , op_wmma>, 64, 64, 32, 32, 16>>(s, buf, "tcec_wmma_half_with_ec"   , bench::unit::fp16_tc, 1e-5);
+	bench_tcec_gemm<candidate<half, policy_t<half, without_ec, op_wmma>, 64, 64, 32, 32, 16>>(s, buf, "tcec_wmma_half_without_ec", bench::unit::fp16_tc, 1e-2);
+#if TEST_ARCH >= 75
+	bench_tcec_gemm<candidate<half, policy_t<half, with_ec   , op_mma >, 64, 64, 32, 32, 16>>(s, buf, "tcec_mma_half_with_ec"    , bench::unit::fp16_tc, 1e-5);
+	bench_tcec_gemm<candidate<half, policy_t<half, without_ec, op_mma >, 64, 64, 32, 32, 16>>(s, buf, "tcec_mma_half_without_ec" , bench::unit::fp16_tc, 1e-2);
+#endif
+#if TEST_ARCH >= 80
+	using tf32 = nvcuda::wmma::precision::tf32;
+	bench_tcec_gemm<candidate<tf32, policy_t<tf32, with_ec, op_wmma>, 64, 64, 32, 32, 16>>(s, buf, "tcec_wmma_tf32_with_ec", bench::unit::tf32_tc, 1e-5);
+	bench_tcec_gemm<candidate<tf32, policy_t<tf32, with_ec, op_mma >, 64, 64, 32, 32, 16>>(s, buf, "tcec_mma_tf32_with_ec" , bench::unit::tf32_tc, 1e-5);
+#endif
+	bench_tcec_gemm<candidate<float, simt_policy_t, 64, 64, 32, 32, 16>>(s, buf, "tcec_simt_float", bench::unit::fp32, 1e-5);
+
+	BENCH_CHECK_ERROR(cudaFree(buf.a));
+	BENCH_CHECK_ERROR(cudaFree(buf.b));
+	BENCH_CHECK_ERROR(cudaFree(buf.c));
+	BENCH_CHECK_ERROR(cudaFree(buf.c_ref));
+	BENCH_CHECK_ERROR(cudaFree(buf.a_h));
+	BENCH_CHECK_ERROR(cudaFree(buf.b_h));
+}
+} // noname namespace
+
+int main(int argc, char** argv) {
+	try {
+		const auto opt = bench::parse_options(argc, argv);
+		bench::suite s(opt, get_machine());
+
+		run_primitive_benchmarks(s);
+
+		cublasHandle_t cublas_handle;
+		BENCH_CHECK_ERROR(cublasCreate(&cublas_handle));
+		for (const auto n : {1024u, 4096u}) {
+			run_gemm_benchmarks(s, cublas_handle, n);
+		}
+		BENCH_CHECK_ERROR(cublasDestroy(cublas_handle));
+
+		bench::write(s);
+		return s.num_failed() ? 1 : 0;
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+}
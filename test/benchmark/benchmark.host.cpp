@@ -0,0 +1,272 @@
+// Host emulator mode of the benchmark suite (no GPU is required)
+// The harness (statistics, roofline summary, JSON/CSV output) is tested with the host emulators of the library.
+//   ./benchmark.host.test [--warmup=N] [--iterations=N] [--filter=STR] [--format=text|json|csv] [--output=PATH]
+#include <cstdio>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/host.hpp>
+#include <wmma_extension/tcec/detail/hetero_schedule.hpp>
+#include <wmma_extension/detail/sparse_24.hpp>
+#include "benchmark.hpp"
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace bench = mtk::bench;
+namespace tc_host = mtk::wmma::tcec::host;
+
+// ------------------------------
+// Host benchmarks
+// ------------------------------
+template <class T, class ErrorCorrection>
+void bench_tcec_host_gemm(bench::suite& s, const std::string& type_name, const unsigned fk, const unsigned n) {
+	std::mt19937 mt(n);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	std::vector<float> a(n * n), b(n * n), c(n * n);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+
+	const bool ec = std::is_same<ErrorCorrection, mtk::wmma::tcec::with_ec>::value;
+	bench::result r;
+	r.name = "tcec_gemm/" + type_name + "/" + (ec ? "with_ec" : "without_ec");
+	r.group = "tcec_gemm";
+	r.variant = "host";
+	r.params = "n=" + std::to_string(n);
+	r.bound_unit = (type_name == "half") ? bench::unit::fp16_tc : (type_name == "tf32" ? bench::unit::tf32_tc : bench::unit::fp32);
+	r.flop = 2. * n * n * n;
+	r.bytes = 4. * 4 * n * n;
+	s.run(r,
+			[&]() {
+				return bench::host_time([&]() {
+					tc_host::gemm_tile<T, ErrorCorrection>(0, 0, n, n, n, fk, 1.f, a.data(), n, b.data(), n, 0.f, c.data(), n);
+				});
+			},
+			[&]() {
+				double base = 0., diff = 0.;
+				for (unsigned i = 0; i < n; i++) {
+					for (unsigned j = 0; j < n; j++) {
+						double v = 0.;
+						for (unsigned l = 0; l < n; l++) {
+							v += static_cast<double>(a[l + i * n]) * b[l + j * n];
+						}
+						base += v * v;
+						diff += (v - c[i + j * n]) * (v - c[i + j * n]);
+					}
+				}
+				return std::sqrt(diff / base) < (ec || type_name == "float" ? 1e-5 : 1e-2);
+			});
+}
+
+void bench_sparse_compress(bench::suite& s, const unsigned m, const unsigned k) {
+	std::mt19937 mt(m + k);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	std::vector<float> dense(m * k), compressed(m * k / 2);
+	std::vector<std::uint16_t> metadata(m * k / 16);
+	for (auto& v : dense) v = dist(mt);
+
+	bench::result r;
+	r.name = "sparse_24/compress";
+	r.group = "sparse_24";
+	r.variant = "host";
+	r.params = "m=" + std::to_string(m) + ",k=" + std::to_string(k);
+	r.bytes = 4. * m * k + 4. * m * k / 2 + 2. * m * k / 16;
+	s.run(r,
+			[&]() {
+				return bench::host_time([&]() {
+					mtk::wmma::mma::sparse::compress(m, k, dense.data(), k, compressed.data(), k / 2, metadata.data(), k / 16);
+				});
+			});
+}
+
+void bench_hetero_schedule(bench::suite& s, const unsigned num_tiles, const unsigned num_blocks) {
+	using schedule_t = mtk::wmma::tcec::hetero::schedule<4, 4, mtk::wmma::tcec::hetero::ratio<3, 1>>;
+	mtk::wmma::tcec::hetero::tile_split_report report;
+
+	bench::result r;
+	r.name = "hetero/simulate_tile_split";
+	r.group = "hetero";
+	r.variant = "host";
+	r.params = "tiles=" + std::to_string(num_tiles) + ",blocks=" + std::to_string(num_blocks);
+	s.run(r,
+			[&]() {
+				return bench::host_time([&]() {
+					report = mtk::wmma::tcec::hetero::simulate_tile_split<schedule_t>(num_tiles, num_blocks);
+				});
+			},
+			[&]() {
+				return report.num_tc_tiles + report.num_simt_tiles == num_tiles && report.num_duplicated_tiles == 0;
+			});
+}
+
+void run_host_benchmarks(bench::suite& s) {
+	bench_tcec_host_gemm<tc_host::fp16, mtk::wmma::tcec::with_ec   >(s, "half" , 16, 64);
+	bench_tcec_host_gemm<tc_host::fp16, mtk::wmma::tcec::without_ec>(s, "half" , 16, 64);
+	bench_tcec_host_gemm<tc_host::tf32, mtk::wmma::tcec::with_ec   >(s, "tf32" , 8 , 64);
+	bench_tcec_host_gemm<tc_host::fp32, mtk::wmma::tcec::without_ec>(s, "float", 16, 64);
+	bench_sparse_compress(s, 256, 256);
+	bench_hetero_schedule(s, 1024, 16);
+}
+
+// ------------------------------
+// Tests of the harness
+// ------------------------------
+void test_statistics() {
+	const auto s = bench::compute_statistics({4., 1., 3., 2.});
+	const auto s1 = bench::compute_statistics({5.});
+	const auto s0 = bench::compute_statistics({});
+	const bool passed =
+		s.count == 4 && s.min == 1. && s.max == 4. && s.mean == 2.5 && s.median == 2.5 &&
+		std::abs(s.stddev - std::sqrt(5. / 3.)) < 1e-12 &&
+		s1.median == 5. && s1.stddev == 0. &&
+		s0.count == 0;
+	std::printf("[statistics] median:%e, stddev:%e (%6s)\n", s.median, s.stddev, result_string(passed));
+}
+
+void test_measure() {
+	bench::options opt;
+	opt.num_warmup = 2;
+	opt.num_iterations = 5;
+	// A fake clock : the warm-up runs are slow and must be discarded
+	unsigned count = 0;
+	const auto stat = bench::measure(opt, [&]() {return count++ < opt.num_warmup ? 100. : static_cast<double>(count);});
+	const bool passed = count == 7 && stat.count == 5 && stat.min == 3. && stat.max == 7. && stat.median == 5.;
+	std::printf("[measure] runs:%u, min:%e, max:%e (%6s)\n", count, stat.min, stat.max, result_string(passed));
+}
+
+void test_roofline() {
+	bench::machine m;
+	m.name = "test";
+	m.fp16_tc_flops = 100e12;
+	m.memory_bandwidth = 1e12;
+
+	bench::result compute_bound;
+	compute_bound.bound_unit = bench::unit::fp16_tc;
+	compute_bound.flop = 1e12;
+	compute_bound.bytes = 1e9;   // 1000 flop/B
+	compute_bound.time.median = 0.02; // 50 TFlop/s
+
+	bench::result memory_bound = compute_bound;
+	memory_bound.bytes = 1e11;   // 10 flop/B -> 10 TFlop/s roof
+
+	bench::result copy;
+	copy.bytes = 1e9;
+	copy.time.median = 2e-3;     // 500 GB/s
+
+	bench::result unknown = compute_bound;
+	unknown.bound_unit = bench::unit::tf32_tc;
+
+	const auto p0 = bench::get_roofline_point(m, compute_bound);
+	const auto p1 = bench::get_roofline_point(m, memory_bound);
+	const auto p2 = bench::get_roofline_point(m, copy);
+	const auto p3 = bench::get_roofline_point(m, unknown);
+
+	const bool passed =
+		p0.bound == "compute" && std::abs(p0.efficiency - 0.5) < 1e-12 &&
+		p1.bound == "memory"  && std::abs(p1.attainable - 10e12) < 1 && std::abs(p1.efficiency - 5.) < 1e-12 &&
+		p2.bound == "memory"  && std::abs(p2.efficiency - 0.5) < 1e-12 &&
+		p3.bound == "unknown";
+	std::printf("[roofline] compute:%s, memory:%s, copy:%s, unknown:%s (%6s)\n",
+			p0.bound.c_str(), p1.bound.c_str(), p2.bound.c_str(), p3.bound.c_str(),
+			result_string(passed));
+}
+
+void test_options() {
+	const char* const argv[] = {"bench", "--warmup=1", "--iterations=7", "--filter=tcec", "--format=csv", "--output=out.csv"};
+	const auto opt = bench::parse_options(6, argv);
+	bool passed = opt.num_warmup == 1 && opt.num_iterations == 7 && opt.filter == "tcec" && opt.format == "csv" && opt.output == "out.csv";
+
+	for (const auto arg : {"--format=xml", "--iterations=0", "--unknown=1", "-v"}) {
+		const char* const argv_invalid[] = {"bench", arg};
+		bool thrown = false;
+		try {
+			bench::parse_options(2, argv_invalid);
+		} catch (const std::exception&) {
+			thrown = true;
+		}
+		passed = passed && thrown;
+	}
+	std::printf("[options] (%6s)\n", result_string(passed));
+}
+
+std::size_t count_csv_columns(const std::string& line) {
+	std::size_t count = 1;
+	bool quoted = false;
+	for (const auto c : line) {
+		if (c == '"') {
+			quoted = !quoted;
+		} else if (c == ',' && !quoted) {
+			count++;
+		}
+	}
+	return count;
+}
+
+void test_output(const bench::suite& s) {
+	namespace json = mtk::wmma::detail::json;
+	const auto& results = s.get_results();
+
+	// JSON
+	bool json_passed = false;
+	try {
+		const auto root = json::parse(bench::to_json(s.get_machine(), results));
+		const auto& list = root.at("results", json::value::array_t).array;
+		json_passed = root.at("machine", json::value::object_t).at("name", json::value::string_t).string == s.get_machine().name &&
+			list.size() == results.size();
+		for (std::size_t i = 0; json_passed && i < list.size(); i++) {
+			const auto& time = list[i].at("time", json::value::object_t);
+			json_passed = json_passed &&
+				list[i].at("name", json::value::string_t).string == results[i].name &&
+				list[i].at("passed", json::value::bool_t).boolean == results[i].passed &&
+				time.at("median", json::value::number_t).number == results[i].time.median &&
+				time.at("count", json::value::number_t).number == results[i].time.count &&
+				list[i].find("roofline") != nullptr;
+		}
+	} catch (const std::runtime_error& e) {
+		std::printf("%s\n", e.what());
+	}
+
+	// CSV
+	std::istringstream csv(bench::to_csv(s.get_machine(), results));
+	std::string line;
+	std::getline(csv, line);
+	const auto num_columns = count_csv_columns(line);
+	std::size_t num_lines = 0;
+	bool csv_passed = true;
+	while (std::getline(csv, line)) {
+		csv_passed = csv_passed && count_csv_columns(line) == num_columns;
+		num_lines++;
+	}
+	csv_passed = csv_passed && num_lines == results.size() && num_columns == 20;
+
+	std::printf("[output] results:%zu, json:%d, csv:%d (%6s)\n", results.size(), json_passed, csv_passed, result_string(json_passed && csv_passed));
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	bench::options opt;
+	try {
+		opt = bench::parse_options(argc, argv);
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+
+	// The host has no peak performance model
+	bench::machine host;
+	host.name = "host";
+	bench::suite s(opt, host);
+	run_host_benchmarks(s);
+
+	test_statistics();
+	test_measure();
+	test_roofline();
+	test_options();
+	test_output(s);
+	std::printf("[benchmarks] results:%zu, failed:%zu (%6s)\n", s.get_results().size(), s.num_failed(), result_string(s.num_failed() == 0));
+
+	bench::write(s);
+
+	return mtk::test_utils::host_test::exit_code();
+}
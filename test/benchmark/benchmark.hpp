@@ -0,0 +1,388 @@
+#ifndef __WMMAE_TEST_BENCHMARK_HPP__
+#define __WMMAE_TEST_BENCHMARK_HPP__
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <wmma_extension/detail/json.hpp>
+
+// Benchmark harness shared by the GPU driver (benchmark.cu) and the host emulator mode (benchmark.host.cpp).
+// This header does not depend on CUDA.
+namespace mtk {
+namespace bench {
+
+struct statistics {
+	std::size_t count = 0;
+	double min    = 0.;
+	double max    = 0.;
+	double mean   = 0.;
+	double median = 0.;
+	double stddev = 0.;
+};
+
+inline statistics compute_statistics(std::vector<double> samples) {
+	statistics s;
+	s.count = samples.size();
+	if (samples.empty()) {
+		return s;
+	}
+	std::sort(samples.begin(), samples.end());
+	s.min = samples.front();
+	s.max = samples.back();
+	const auto n = samples.size();
+	s.median = (n % 2) ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+	double sum = 0.;
+	for (const auto v : samples) {
+		sum += v;
+	}
+	s.mean = sum / n;
+	double var = 0.;
+	for (const auto v : samples) {
+		var += (v - s.mean) * (v - s.mean);
+	}
+	// Sample standard deviation
+	s.stddev = (n > 1) ? std::sqrt(var / (n - 1)) : 0.;
+	return s;
+}
+
+// The unit which bounds a benchmark in the roofline summary
+enum class unit {
+	fp16_tc,
+	tf32_tc,
+	fp32,
+	none, // memory / instruction bound primitives (no floating point operations are counted)
+};
+
+inline std::string to_string(const unit u) {
+	switch (u) {
+	case unit::fp16_tc: return "fp16_tc";
+	case unit::tf32_tc: return "tf32_tc";
+	case unit::fp32   : return "fp32";
+	default:            return "none";
+	}
+}
+
+// Peak performance for the roofline summary. 0 means unknown.
+struct machine {
+	std::string name;
+	double fp16_tc_flops    = 0.;
+	double tf32_tc_flops    = 0.;
+	double fp32_flops       = 0.;
+	double memory_bandwidth = 0.; // [B/s]
+
+	double peak(const unit u) const {
+		switch (u) {
+		case unit::fp16_tc: return fp16_tc_flops;
+		case unit::tf32_tc: return tf32_tc_flops;
+		case unit::fp32   : return fp32_flops;
+		default:            return 0.;
+		}
+	}
+};
+
+struct result {
+	std::string name;    // e.g. "foreach/matrix_a/half"
+	std::string group;   // primitive
+	std::string variant; // e.g. "wmmae", "native", "cublas", "host"
+	std::string params;  // free form parameters of the benchmark
+	unit bound_unit = unit::none;
+	double flop  = 0.;   // per run
+	double bytes = 0.;   // per run (bytes moved from/to the device memory)
+	bool passed = true;  // result check of the benchmark
+	statistics time;     // [s]
+
+	double flops() const {return time.median > 0. ? flop / time.median : 0.;}
+	double bandwidth() const {return time.median > 0. ? bytes / time.median : 0.;}
+	// [flop/B], infinity if no memory traffic is counted
+	double intensity() const {return bytes > 0. ? flop / bytes : std::numeric_limits<double>::infinity();}
+};
+
+// Roofline position of a result
+struct roofline_point {
+	double attainable = 0.; // [flop/s] 0 if unknown
+	double efficiency = 0.; // flops / attainable, or bandwidth / memory_bandwidth for `unit::none`
+	std::string bound;      // "compute", "memory" or "unknown"
+};
+
+inline roofline_point get_roofline_point(const machine& m, const result& r) {
+	roofline_point p;
+	p.bound = "unknown";
+	if (r.bound_unit == unit::none) {
+		if (m.memory_bandwidth > 0. && r.bytes > 0.) {
+			p.bound = "memory";
+			p.efficiency = r.bandwidth() / m.memory_bandwidth;
+		}
+		return p;
+	}
+	const auto peak = m.peak(r.bound_unit);
+	if (peak <= 0.) {
+		return p;
+	}
+	const auto memory_roof = (m.memory_bandwidth > 0.) ? r.intensity() * m.memory_bandwidth : std::numeric_limits<double>::infinity();
+	p.attainable = std::min(peak, memory_roof);
+	p.bound = (memory_roof < peak) ? "memory" : "compute";
+	p.efficiency = r.flops() / p.attainable;
+	return p;
+}
+
+struct options {
+	unsigned num_warmup = 3;
+	unsigned num_iterations = 20;
+	std::string filter;          // run only the benchmarks whose name contains this string
+	std::string format = "text"; // text / json / csv
+	std::string output;          // stdout if empty
+};
+
+// --warmup=N --iterations=N --filter=STR --format=text|json|csv --output=PATH
+inline options parse_options(const int argc, const char* const* const argv) {
+	options opt;
+	for (int i = 1; i < argc; i++) {
+		const std::string arg = argv[i];
+		const auto eq = arg.find('=');
+		if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+			throw std::runtime_error("bench : invalid argument \"" + arg + "\"");
+		}
+		const auto key = arg.substr(2, eq - 2);
+		const auto value = arg.substr(eq + 1);
+		if (key == "warmup") {
+			opt.num_warmup = std::stoul(value);
+		} else if (key == "iterations") {
+			opt.num_iterations = std::stoul(value);
+		} else if (key == "filter") {
+			opt.filter = value;
+		} else if (key == "format") {
+			if (value != "text" && value != "json" && value != "csv") {
+				throw std::runtime_error("bench : unknown format \"" + value + "\"");
+			}
+			opt.format = value;
+		} else if (key == "output") {
+			opt.output = value;
+		} else {
+			throw std::runtime_error("bench : unknown option \"" + key + "\"");
+		}
+	}
+	if (opt.num_iterations == 0) {
+		throw std::runtime_error("bench : the number of iterations must be positive");
+	}
+	return opt;
+}
+
+// Runs `run_once` (num_warmup + num_iterations) times and returns the statistics of the last num_iterations.
+// `run_once` returns the elapsed time of a run [s].
+template <class Func>
+inline statistics measure(const options& opt, Func run_once) {
+	for (unsigned i = 0; i < opt.num_warmup; i++) {
+		run_once();
+	}
+	std::vector<double> samples(opt.num_iterations);
+	for (auto& s : samples) {
+		s = run_once();
+	}
+	return compute_statistics(samples);
+}
+
+// Measures a host function by the wall clock
+template <class Func>
+inline double host_time(Func func) {
+	const auto start = std::chrono::steady_clock::now();
+	func();
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double>(end - start).count();
+}
+
+class suite {
+	options opt;
+	machine mach;
+	std::vector<result> results;
+
+public:
+	suite(const options& opt, const machine& mach) : opt(opt), mach(mach) {}
+
+	bool is_enabled(const std::string& name) const {
+		return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+	}
+
+	// `r` holds the description of the benchmark (its time is overwritten).
+	// `check` is called once after the measurement and returns the result of the verification.
+	template <class Func, class Check>
+	void run(result r, Func run_once, Check check) {
+		if (!is_enabled(r.name)) {
+			return;
+		}
+		r.time = measure(opt, run_once);
+		r.passed = check();
+		results.push_back(r);
+	}
+
+	template <class Func>
+	void run(result r, Func run_once) {
+		run(r, run_once, []() {return true;});
+	}
+
+	const std::vector<result>& get_results() const {return results;}
+	const machine& get_machine() const {return mach;}
+	const options& get_options() const {return opt;}
+
+	std::size_t num_failed() const {
+		return std::count_if(results.begin(), results.end(), [](const result& r) {return !r.passed;});
+	}
+};
+
+// ------------------------------
+// Output
+// ------------------------------
+inline std::string to_json(const machine& m, const std::vector<result>& results) {
+	using mtk::wmma::detail::json::escape;
+	const auto to_str = [](const double v) {
+		// JSON does not have infinity
+		return std::isfinite(v) ? mtk::wmma::detail::json::to_string(v) : std::string("null");
+	};
+	std::ostringstream ss;
+	ss << "{\n";
+	ss << "  \"machine\": {\"name\": " << escape(m.name)
+		<< ", \"fp16_tc_flops\": " << to_str(m.fp16_tc_flops)
+		<< ", \"tf32_tc_flops\": " << to_str(m.tf32_tc_flops)
+		<< ", \"fp32_flops\": " << to_str(m.fp32_flops)
+		<< ", \"memory_bandwidth\": " << to_str(m.memory_bandwidth) << "},\n";
+	ss << "  \"results\": [";
+	for (std::size_t i = 0; i < results.size(); i++) {
+		const auto& r = results[i];
+		const auto p = get_roofline_point(m, r);
+		ss << (i ? ",\n" : "\n");
+		ss << "    {\"name\": " << escape(r.name)
+			<< ", \"group\": " << escape(r.group)
+			<< ", \"variant\": " << escape(r.variant)
+			<< ", \"params\": " << escape(r.params)
+			<< ", \"unit\": " << escape(to_string(r.bound_unit))
+			<< ", \"passed\": " << (r.passed ? "true" : "false")
+			<< ", \"flop\": " << to_str(r.flop)
+			<< ", \"bytes\": " << to_str(r.bytes)
+			<< ", \"time\": {\"count\": " << r.time.count
+			<< ", \"min\": " << to_str(r.time.min)
+			<< ", \"max\": " << to_str(r.time.max)
+			<< ", \"mean\": " << to_str(r.time.mean)
+			<< ", \"median\": " << to_str(r.time.median)
+			<< ", \"stddev\": " << to_str(r.time.stddev) << "}"
+			<< ", \"flops\": " << to_str(r.flops())
+			<< ", \"bandwidth\": " << to_str(r.bandwidth())
+			<< ", \"intensity\": " << to_str(r.intensity())
+			<< ", \"roofline\": {\"bound\": " << escape(p.bound)
+			<< ", \"attainable\": " << to_str(p.attainable)
+			<< ", \"efficiency\": " << to_str(p.efficiency) << "}}";
+	}
+	ss << "\n  ]\n}\n";
+	return ss.str();
+}
+
+inline std::string to_csv(const machine& m, const std::vector<result>& results) {
+	const auto quote = [](const std::string& str) {
+		std::string res = "\"";
+		for (const auto c : str) {
+			if (c == '"') {
+				res += "\"\"";
+			} else {
+				res.push_back(c);
+			}
+		}
+		return res + "\"";
+	};
+	const auto to_str = [](const double v) {
+		return std::isfinite(v) ? mtk::wmma::detail::json::to_string(v) : std::string("");
+	};
+	std::ostringstream ss;
+	ss << "name,group,variant,params,unit,passed,flop,bytes,count,min,max,mean,median,stddev,flops,bandwidth,intensity,bound,attainable,efficiency\n";
+	for (const auto& r : results) {
+		const auto p = get_roofline_point(m, r);
+		ss << quote(r.name) << ","
+			<< quote(r.group) << ","
+			<< quote(r.variant) << ","
+			<< quote(r.params) << ","
+			<< to_string(r.bound_unit) << ","
+			<< (r.passed ? 1 : 0) << ","
+			<< to_str(r.flop) << ","
+			<< to_str(r.bytes) << ","
+			<< r.time.count << ","
+			<< to_str(r.time.min) << ","
+			<< to_str(r.time.max) << ","
+			<< to_str(r.time.mean) << ","
+			<< to_str(r.time.median) << ","
+			<< to_str(r.time.stddev) << ","
+			<< to_str(r.flops()) << ","
+			<< to_str(r.bandwidth()) << ","
+			<< to_str(r.intensity()) << ","
+			<< p.bound << ","
+			<< to_str(p.attainable) << ","
+			<< to_str(p.efficiency) << "\n";
+	}
+	return ss.str();
+}
+
+// Human readable table and roofline summary
+inline std::string to_text(const machine& m, const std::vector<result>& results) {
+	std::ostringstream ss;
+	char buf[512];
+	ss << "# machine : " << m.name << "\n";
+	for (const auto& r : results) {
+		std::snprintf(buf, sizeof(buf), "[%-10s] %-40s %-8s median:%e s (stddev:%.1f%%), %9.3f TFlop/s, %9.3f GB/s (%6s)\n",
+				r.group.c_str(),
+				r.name.c_str(),
+				r.variant.c_str(),
+				r.time.median,
+				r.time.mean > 0. ? r.time.stddev / r.time.mean * 100 : 0.,
+				r.flops() * 1e-12,
+				r.bandwidth() * 1e-9,
+				r.passed ? "PASSED" : "FAILED"
+				);
+		ss << buf;
+	}
+	ss << "# roofline summary\n";
+	for (const auto& r : results) {
+		const auto p = get_roofline_point(m, r);
+		if (p.bound == "unknown") {
+			continue;
+		}
+		std::snprintf(buf, sizeof(buf), "%-40s %-8s unit:%-7s intensity:%8.2f flop/B, bound:%-7s efficiency:%5.1f%%\n",
+				r.name.c_str(),
+				r.variant.c_str(),
+				to_string(r.bound_unit).c_str(),
+				std::isfinite(r.intensity()) ? r.intensity() : 0.,
+				p.bound.c_str(),
+				p.efficiency * 100
+				);
+		ss << buf;
+	}
+	return ss.str();
+}
+
+// Writes the results in the format of the options
+inline void write(const suite& s) {
+	const auto& opt = s.get_options();
+	std::string str;
+	if (opt.format == "json") {
+		str = to_json(s.get_machine(), s.get_results());
+	} else if (opt.format == "csv") {
+		str = to_csv(s.get_machine(), s.get_results());
+	} else {
+		str = to_text(s.get_machine(), s.get_results());
+	}
+	if (opt.output.empty()) {
+		std::cout << str;
+	} else {
+		std::ofstream ofs(opt.output);
+		if (!ofs) {
+			throw std::runtime_error("bench : failed to open " + opt.output);
+		}
+		ofs << str;
+	}
+}
+
+} // namespace bench
+} // namespace mtk
+#endif
@@ -0,0 +1,37 @@
+#ifndef __WMMAE_TEST_HOST_TEST_HPP__
+#define __WMMAE_TEST_HOST_TEST_HPP__
+#include <cstdio>
+
+// Helpers of the host tests (*.host.cpp). This header does not depend on CUDA.
+//   std::printf("... (%6s)\n", mtk::test_utils::host_test::result_string(passed));
+//   ...
+//   return mtk::test_utils::host_test::exit_code();
+namespace mtk {
+namespace test_utils {
+namespace host_test {
+// The number of the failed tests in the executable
+inline unsigned& num_failed() {
+	static unsigned n = 0;
+	return n;
+}
+
+// "PASSED" / "FAILED" (see get_test_result_string in primitive/common.hpp), counting the failures
+inline const char* result_string(const bool passed) {
+	if (!passed) {
+		num_failed()++;
+	}
+	return passed ? "PASSED" : "FAILED";
+}
+
+// The exit status of main : 1 if a test failed
+inline int exit_code() {
+	if (num_failed()) {
+		std::printf("%u test(s) failed\n", num_failed());
+		return 1;
+	}
+	return 0;
+}
+} // namespace host_test
+} // namespace test_utils
+} // namespace mtk
+#endif
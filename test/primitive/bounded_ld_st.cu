@@ -0,0 +1,243 @@
+#include <iostream>
+#include <type_traits>
+#include <mma.h>
+#include <wmma_extension/wmma_mma.hpp>
+#include "common.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+// Test for the bounds-checked load/store functions.
+// Elements out of [0, rows) x [0, cols) must be zero after loading and must not be written by storing.
+
+constexpr float guard_value = -100.0f;
+
+__device__ float get_value(const unsigned i, const unsigned j) {
+	return static_cast<float>(i * 64 + j);
+}
+
+template <class Layout>
+__device__ unsigned get_mem_index(const unsigned i, const unsigned j, const unsigned ld) {
+	return std::is_same<Layout, nvcuda::wmma::col_major>::value ? (i + j * ld) : (i * ld + j);
+}
+
+__device__ unsigned get_mem_index(const unsigned i, const unsigned j, const unsigned ld, const nvcuda::wmma::layout_t layout) {
+	return (layout == nvcuda::wmma::mem_col_major) ? (i + j * ld) : (i * ld + j);
+}
+
+template <class Layout>
+__device__ void init_src(float* const src, const unsigned ld, const unsigned rows, const unsigned cols) {
+	for (unsigned i = threadIdx.x; i < ld * 64; i += blockDim.x) {
+		// NaN is loaded if the range check does not work
+		src[i] = __int_as_float(0x7fffffff);
+	}
+	__syncwarp();
+	for (unsigned i = 0; i < rows; i++) {
+		for (unsigned j = threadIdx.x; j < cols; j += blockDim.x) {
+			src[get_mem_index<Layout>(i, j, ld)] = get_value(i, j);
+		}
+	}
+	__syncwarp();
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+__global__ void mma_ab_test_kernel(unsigned* const error_count, float* const src, const unsigned ld, const unsigned rows, const unsigned cols) {
+	init_src<Layout>(src, ld, rows, cols);
+
+	mtk::wmma::mma::fragment<Use, M, N, K, T, Layout> frag;
+	mtk::wmma::mma::load_matrix_sync(frag, src, ld, rows, cols);
+
+	mtk::wmma::mma::foreach_ij<decltype(frag)>(
+			[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+				const float correct = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<float>(mtk::wmma::detail::common::cast<T>(get_value(i, j))) : 0.f;
+				for (unsigned f = 0; f < fragment_index_count; f++) {
+					if (mtk::wmma::detail::common::cast<float>(frag.x[frag_index_list[f]]) != correct) {
+						atomicAdd(error_count, 1u);
+					}
+				}
+			});
+}
+
+template <int M, int N, int K, class T>
+__global__ void mma_acc_test_kernel(unsigned* const error_count, float* const src, float* const dst, const unsigned ld, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		init_src<nvcuda::wmma::col_major>(src, ld, rows, cols);
+	} else {
+		init_src<nvcuda::wmma::row_major>(src, ld, rows, cols);
+	}
+	for (unsigned i = threadIdx.x; i < ld * 64; i += blockDim.x) {
+		dst[i] = guard_value;
+	}
+	__syncwarp();
+
+	mtk::wmma::mma::fragment<nvcuda::wmma::accumulator, M, N, K, T> frag;
+	mtk::wmma::mma::load_matrix_sync(frag, src, ld, rows, cols, layout);
+	mtk::wmma::mma::store_matrix_sync(dst, frag, ld, rows, cols, layout);
+
+	for (unsigned i = 0; i < M; i++) {
+		for (unsigned j = threadIdx.x; j < N; j += blockDim.x) {
+			const auto correct = (i < rows && j < cols) ? get_value(i, j) : guard_value;
+			if (dst[get_mem_index(i, j, ld, layout)] != correct) {
+				atomicAdd(error_count, 1u);
+			}
+		}
+	}
+}
+
+template <int M, int N, int K, class T, class Layout>
+__global__ void wmma_ab_test_kernel(unsigned* const error_count, float* const src, const unsigned ld, const unsigned rows, const unsigned cols) {
+	init_src<Layout>(src, ld, rows, cols);
+
+	nvcuda::wmma::fragment<nvcuda::wmma::matrix_a, M, N, K, T, Layout> frag;
+	mtk::wmma::load_matrix_sync(frag, src, ld, rows, cols);
+
+	mtk::wmma::foreach_ij<decltype(frag)>(
+			[&](const unsigned* frag_index_list, const unsigned fragment_index_count, const unsigned i, const unsigned j) {
+				const float correct = (i < rows && j < cols) ? mtk::wmma::detail::common::cast<float>(mtk::wmma::detail::common::cast<T>(get_value(i, j))) : 0.f;
+				for (unsigned f = 0; f < fragment_index_count; f++) {
+					if (mtk::wmma::detail::common::cast<float>(frag.x[frag_index_list[f]]) != correct) {
+						atomicAdd(error_count, 1u);
+					}
+				}
+			});
+}
+
+template <int M, int N, int K>
+__global__ void wmma_acc_test_kernel(unsigned* const error_count, float* const src, float* const dst, const unsigned ld, const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		init_src<nvcuda::wmma::col_major>(src, ld, rows, cols);
+	} else {
+		init_src<nvcuda::wmma::row_major>(src, ld, rows, cols);
+	}
+	for (unsigned i = threadIdx.x; i < ld * 64; i += blockDim.x) {
+		dst[i] = guard_value;
+	}
+	__syncwarp();
+
+	nvcuda::wmma::fragment<nvcuda::wmma::accumulator, M, N, K, float> frag;
+	mtk::wmma::load_matrix_sync(frag, src, ld, rows, cols, layout);
+	mtk::wmma::store_matrix_sync(dst, frag, ld, rows, cols, layout);
+	__syncwarp();
+
+	for (unsigned i = 0; i < M; i++) {
+		for (unsigned j = threadIdx.x; j < N; j += blockDim.x) {
+			const auto correct = (i < rows && j < cols) ? get_value(i, j) : guard_value;
+			if (dst[get_mem_index(i, j, ld, layout)] != correct) {
+				atomicAdd(error_count, 1u);
+			}
+		}
+	}
+}
+
+void print_result(const std::string name, const unsigned rows, const unsigned cols, const unsigned error_count) {
+	std::printf("[%s] ARCH=%d, %-40s, rows=%2u, cols=%2u : error_count = %u [%s]\n",
+			__FILE__,
+			TEST_ARCH,
+			name.c_str(),
+			rows, cols,
+			error_count,
+			mtk::test_utils::get_test_result_string(error_count == 0)
+			);
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+void test_mma_ab(const unsigned rows, const unsigned cols) {
+	const unsigned ld = 37;
+	float* src;
+	unsigned* error_count;
+	cudaMalloc(&src, sizeof(float) * ld * 64);
+	cudaMallocHost(&error_count, sizeof(unsigned));
+	*error_count = 0;
+
+	mma_ab_test_kernel<Use, M, N, K, T, Layout><<<1, 32>>>(error_count, src, ld, rows, cols);
+	cudaDeviceSynchronize();
+
+	print_result("mma::" + mtk::test_utils::get_string<Use>() + "<" + std::to_string(M) + "," + std::to_string(N) + "," + std::to_string(K) + ","
+			+ mtk::test_utils::get_string<T>() + "," + mtk::test_utils::get_string<Layout>() + ">", rows, cols, *error_count);
+
+	cudaFree(src);
+	cudaFreeHost(error_count);
+}
+
+template <int M, int N, int K, class T>
+void test_mma_acc(const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	const unsigned ld = 37;
+	float *src, *dst;
+	unsigned* error_count;
+	cudaMalloc(&src, sizeof(float) * ld * 64);
+	cudaMalloc(&dst, sizeof(float) * ld * 64);
+	cudaMallocHost(&error_count, sizeof(unsigned));
+	*error_count = 0;
+
+	mma_acc_test_kernel<M, N, K, T><<<1, 32>>>(error_count, src, dst, ld, rows, cols, layout);
+	cudaDeviceSynchronize();
+
+	print_result("mma::accumulator<" + std::to_string(M) + "," + std::to_string(N) + "," + std::to_string(K) + ","
+			+ mtk::test_utils::get_string<T>() + "," + (layout == nvcuda::wmma::mem_col_major ? "col_major" : "row_major") + ">", rows, cols, *error_count);
+
+	cudaFree(src);
+	cudaFree(dst);
+	cudaFreeHost(error_count);
+}
+
+template <int M, int N, int K, class T, class Layout>
+void test_wmma_ab(const unsigned rows, const unsigned cols) {
+	const unsigned ld = 37;
+	float* src;
+	unsigned* error_count;
+	cudaMalloc(&src, sizeof(float) * ld * 64);
+	cudaMallocHost(&error_count, sizeof(unsigned));
+	*error_count = 0;
+
+	wmma_ab_test_kernel<M, N, K, T, Layout><<<1, 32>>>(error_count, src, ld, rows, cols);
+	cudaDeviceSynchronize();
+
+	print_result("wmma::matrix_a<" + std::to_string(M) + "," + std::to_string(N) + "," + std::to_string(K) + ","
+			+ mtk::test_utils::get_string<T>() + "," + mtk::test_utils::get_string<Layout>() + ">", rows, cols, *error_count);
+
+	cudaFree(src);
+	cudaFreeHost(error_count);
+}
+
+template <int M, int N, int K>
+void test_wmma_acc(const unsigned rows, const unsigned cols, const nvcuda::wmma::layout_t layout) {
+	const unsigned ld = 37;
+	float *src, *dst;
+	unsigned* error_count;
+	cudaMalloc(&src, sizeof(float) * ld * 64);
+	cudaMalloc(&dst, sizeof(float) * ld * 64);
+	cudaMallocHost(&error_count, sizeof(unsigned));
+	*error_count = 0;
+
+	wmma_acc_test_kernel<M, N, K><<<1, 32>>>(error_count, src, dst, ld, rows, cols, layout);
+	cudaDeviceSynchronize();
+
+	print_result("wmma::accumulator<" + std::to_string(M) + "," + std::to_string(N) + "," + std::to_string(K) + ",float,"
+			+ (layout == nvcuda::wmma::mem_col_major ? "col_major" : "row_major") + ">", rows, cols, *error_count);
+
+	cudaFree(src);
+	cudaFree(dst);
+	cudaFreeHost(error_count);
+}
+
+int main() {
+	for (const auto rc : {std::make_pair(16u, 16u), std::make_pair(7u, 13u), std::make_pair(1u, 16u), std::make_pair(16u, 1u), std::make_pair(0u, 5u)}) {
+		const auto rows = rc.first;
+		const auto cols = rc.second;
+#if TEST_ARCH >= 80
+		test_mma_ab<nvcuda::wmma::matrix_a, 16, 8, 16, half, nvcuda::wmma::row_major>(rows, cols);
+		test_mma_ab<nvcuda::wmma::matrix_b, 16, 8, 16, half, nvcuda::wmma::col_major>(rows, cols);
+		test_mma_acc<16, 8, 16, float>(rows, cols, nvcuda::wmma::mem_col_major);
+		test_mma_acc<16, 8, 16, float>(rows, cols, nvcuda::wmma::mem_row_major);
+#endif
+#if TEST_ARCH >= 75
+		test_mma_ab<nvcuda::wmma::matrix_a, 16, 8, 8, half, nvcuda::wmma::row_major>(rows, cols);
+		test_mma_acc<16, 8, 8, float>(rows, cols, nvcuda::wmma::mem_col_major);
+#endif
+		test_wmma_ab<16, 16, 16, half, nvcuda::wmma::col_major>(rows, cols);
+		test_wmma_ab<16, 16, 16, half, nvcuda::wmma::row_major>(rows, cols);
+		test_wmma_acc<16, 16, 16>(rows, cols, nvcuda::wmma::mem_col_major);
+		test_wmma_acc<16, 16, 16>(rows, cols, nvcuda::wmma::mem_row_major);
+	}
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <random>
+#include <mma.h>
+#include <wmma_extension/wmma_mma.hpp>
+#include <wmma_extension/expression.hpp>
+#include "common.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+// Test for the expression templates
+// r = a * 3 + b - b * 2 - a / 4 (evaluated in a single loop)
+
+template <class Frag>
+__device__ float compute_error(const Frag& frag_r, const Frag& frag_a, const Frag& frag_b) {
+	float e = 0.f;
+	for (unsigned i = 0; i < frag_r.num_elements; i++) {
+		const auto va = mtk::wmma::detail::common::cast<float>(frag_a.x[i]);
+		const auto vb = mtk::wmma::detail::common::cast<float>(frag_b.x[i]);
+		const auto diff = std::abs(mtk::wmma::detail::common::cast<float>(frag_r.x[i]) - (va * 3.f + vb - vb * 2.f - va / 4.f));
+		e = (e > diff) ? e : diff;
+	}
+	return e;
+}
+
+template <class Frag>
+__device__ void compute_expression(Frag& frag_r, const Frag& frag_a, const Frag& frag_b) {
+	using storage_t = typename std::remove_reference<decltype(frag_r.x[0])>::type;
+	namespace expr = mtk::wmma::expr;
+	expr::eval(frag_r,
+			expr::lazy(frag_a) * mtk::wmma::detail::common::cast<storage_t>(3.f)
+			+ expr::lazy(frag_b)
+			- expr::lazy(frag_b) * mtk::wmma::detail::common::cast<storage_t>(2.f)
+			- expr::lazy(frag_a) / mtk::wmma::detail::common::cast<storage_t>(4.f)
+			);
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+__global__ void wmma_test_kernel(float* const error, const float* const a, const float* const b) {
+	using storage_t = typename mtk::wmma::detail::common::storage_t<T>::type;
+	constexpr unsigned ldm = mtk::wmma::detail::common::get_M<Use, M, N, K>::value;
+	__shared__ storage_t smem_a[ldm * ldm];
+	__shared__ storage_t smem_b[ldm * ldm];
+	for (unsigned i = threadIdx.x; i < ldm * ldm; i += blockDim.x) {
+		smem_a[i] = mtk::wmma::detail::common::cast<storage_t>(a[i]);
+		smem_b[i] = mtk::wmma::detail::common::cast<storage_t>(b[i]);
+	}
+	__syncthreads();
+
+	nvcuda::wmma::fragment<Use, M, N, K, T, Layout> frag_a, frag_b, frag_r;
+	nvcuda::wmma::load_matrix_sync(frag_a, smem_a, ldm);
+	nvcuda::wmma::load_matrix_sync(frag_b, smem_b, ldm);
+
+	compute_expression(frag_r, frag_a, frag_b);
+	atomicAdd(error, compute_error(frag_r, frag_a, frag_b));
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+__global__ void mma_test_kernel(float* const error, const float* const a, const float* const b) {
+	using storage_t = typename mtk::wmma::detail::common::storage_t<T>::type;
+	mtk::wmma::mma::fragment<Use, M, N, K, T, Layout> frag_a, frag_b, frag_r;
+	// The expressions are element-wise, so the mapping of the elements does not matter
+	for (unsigned i = 0; i < frag_a.num_elements; i++) {
+		frag_a.x[i] = mtk::wmma::detail::common::cast<storage_t>(a[threadIdx.x * frag_a.num_elements + i]);
+		frag_b.x[i] = mtk::wmma::detail::common::cast<storage_t>(b[threadIdx.x * frag_b.num_elements + i]);
+	}
+
+	compute_expression(frag_r, frag_a, frag_b);
+	atomicAdd(error, compute_error(frag_r, frag_a, frag_b));
+}
+
+template <bool is_mma, class Use, int M, int N, int K, class T, class Layout>
+void test() {
+	constexpr unsigned size = 16 * 16;
+	float *a, *b, *error;
+	cudaMallocHost(&a, size * sizeof(float));
+	cudaMallocHost(&b, size * sizeof(float));
+	cudaMallocHost(&error, sizeof(float));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1, 1);
+	for (unsigned i = 0; i < size; i++) {
+		a[i] = dist(mt);
+		b[i] = dist(mt);
+	}
+	*error = 0.f;
+
+	if constexpr (is_mma) {
+		mma_test_kernel<Use, M, N, K, T, Layout><<<1, 32>>>(error, a, b);
+	} else {
+		wmma_test_kernel<Use, M, N, K, T, Layout><<<1, 32>>>(error, a, b);
+	}
+	cudaDeviceSynchronize();
+
+	std::printf("[%s] ARCH=%d, %s, %s, <%2d,%2d,%2d>, %s, error = %e [%s]\n",
+			__FILE__,
+			TEST_ARCH,
+			(is_mma ? "mma" : "wmma"),
+			mtk::test_utils::get_string<Use>().c_str(),
+			M, N, K,
+			mtk::test_utils::get_string<T>().c_str(),
+			*error,
+			mtk::test_utils::get_test_result_string(*error < mtk::test_utils::get_machine_eps<T>() * 16)
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(error);
+}
+
+int main() {
+	test<false, nvcuda::wmma::matrix_a, 16, 16, 16, half, nvcuda::wmma::col_major>();
+	test<false, nvcuda::wmma::matrix_b, 16, 16, 16, half, nvcuda::wmma::row_major>();
+#if TEST_ARCH >= 80
+	test<true , nvcuda::wmma::matrix_a   , 16, 8, 16, half , nvcuda::wmma::row_major>();
+	test<true , nvcuda::wmma::accumulator, 16, 8, 16, float, void                   >();
+#endif
+}
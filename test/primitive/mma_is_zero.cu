@@ -0,0 +1,71 @@
+#include <iostream>
+#include <cmath>
+#include <utility>
+#include <wmma_extension/wmma_mma.hpp>
+#include "common.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+// The element `index` of the lane `lane` is set to `v` in a zero fragment
+template <class Use, int M, int N, int K, class T, class Layout>
+__global__ void is_zero_test_kernel(unsigned* const num_mismatches, const unsigned lane, const unsigned index, const float v, const bool expected) {
+	mtk::wmma::mma::fragment<Use, M, N, K, T, Layout> frag;
+	mtk::wmma::mma::fill_zero(frag);
+	if (threadIdx.x == lane) {
+		frag.x[index % frag.num_elements] = mtk::wmma::detail::common::cast<T>(v);
+	}
+	const bool zero = mtk::wmma::mma::is_zero(frag);
+	if (zero != expected) {
+		atomicAdd(num_mismatches, 1u);
+	}
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+void test() {
+	unsigned *num_mismatches;
+	cudaMallocHost(&num_mismatches, sizeof(unsigned));
+	*num_mismatches = 0;
+	// (value, whether the fragment is regarded as zero)
+	const std::pair<float, bool> cases[] = {{0.f, true}, {-0.f, true}, {1.f, false}, {-2.f, false}, {INFINITY, false}, {NAN, false}};
+	for (const auto& c : cases) {
+		for (const auto lane : {0u, 17u, 31u}) {
+			for (const auto index : {0u, 1u, 3u}) {
+				is_zero_test_kernel<Use, M, N, K, T, Layout><<<1, 32>>>(num_mismatches, lane, index, c.first, c.second);
+			}
+		}
+	}
+	cudaDeviceSynchronize();
+	std::printf("[%s] ARCH=%d, %11s, %2d, %2d, %2d, %5s, %10s, mismatches=%u [%s]\n",
+			__FILE__,
+			TEST_ARCH,
+			mtk::test_utils::get_string<Use>().c_str(),
+			M, N, K,
+			mtk::test_utils::get_string<T>().c_str(),
+			mtk::test_utils::get_string<Layout>().c_str(),
+			*num_mismatches,
+			mtk::test_utils::get_test_result_string(*num_mismatches == 0)
+			);
+	cudaFreeHost(num_mismatches);
+}
+
+int main() {
+#if TEST_ARCH >= 80
+	test<nvcuda::wmma::matrix_a   , 16, 8, 16, half , nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::matrix_b   , 16, 8, 16, half , nvcuda::wmma::col_major>();
+	test<nvcuda::wmma::accumulator, 16, 8, 16, float, void                   >();
+	test<nvcuda::wmma::matrix_a   , 16, 8, 8 , nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::matrix_b   , 16, 8, 8 , nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major>();
+#endif
+#if TEST_ARCH >= 75
+	test<nvcuda::wmma::matrix_a   , 16, 8, 8 , half , nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::matrix_b   , 16, 8, 8 , half , nvcuda::wmma::col_major>();
+	test<nvcuda::wmma::accumulator, 16, 8, 8 , half , void                   >();
+#endif
+#if TEST_ARCH == 75 || TEST_ARCH ==70
+	test<nvcuda::wmma::matrix_a   , 8, 8, 4 , half, nvcuda::wmma::col_major>();
+	test<nvcuda::wmma::matrix_b   , 8, 8, 4 , half, nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::accumulator, 8, 8, 4 , half, void                   >();
+#endif
+}
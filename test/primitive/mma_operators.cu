@@ -0,0 +1,84 @@
+#include <iostream>
+#include <random>
+#include <mma.h>
+#include <wmma_extension/wmma_mma.hpp>
+#include <wmma_extension/operators.hpp>
+#include "common.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+// Test for the operators of mtk::wmma::mma::fragment
+// r = fma(3, a, b) - a * 2 + b / 4
+
+template <class Use, int M, int N, int K, class T, class Layout>
+__global__ void test_kernel(float* const error, const float* const a, const float* const b) {
+	using storage_t = typename mtk::wmma::detail::common::storage_t<T>::type;
+	mtk::wmma::mma::fragment<Use, M, N, K, T, Layout> frag_a, frag_b;
+	// The operators are element-wise, so the mapping of the elements does not matter
+	for (unsigned i = 0; i < frag_a.num_elements; i++) {
+		frag_a.x[i] = mtk::wmma::detail::common::cast<storage_t>(a[threadIdx.x * frag_a.num_elements + i]);
+		frag_b.x[i] = mtk::wmma::detail::common::cast<storage_t>(b[threadIdx.x * frag_b.num_elements + i]);
+	}
+
+	const auto frag_r = mtk::wmma::mma::fma(mtk::wmma::detail::common::cast<storage_t>(3.f), frag_a, frag_b)
+		- frag_a * mtk::wmma::detail::common::cast<storage_t>(2.f)
+		+ frag_b / mtk::wmma::detail::common::cast<storage_t>(4.f);
+
+	float e = 0.f;
+	for (unsigned i = 0; i < frag_r.num_elements; i++) {
+		const auto va = mtk::wmma::detail::common::cast<float>(frag_a.x[i]);
+		const auto vb = mtk::wmma::detail::common::cast<float>(frag_b.x[i]);
+		const auto diff = std::abs(mtk::wmma::detail::common::cast<float>(frag_r.x[i]) - (3.f * va + vb - 2.f * va + vb / 4.f));
+		e = (e > diff) ? e : diff;
+	}
+	atomicAdd(error, e);
+}
+
+template <class Use, int M, int N, int K, class T, class Layout>
+void test() {
+	constexpr unsigned size = mtk::wmma::detail::common::get_M<Use, M, N, K>::value * mtk::wmma::detail::common::get_N<Use, M, N, K>::value;
+	float *a, *b, *error;
+	cudaMallocHost(&a, size * sizeof(float));
+	cudaMallocHost(&b, size * sizeof(float));
+	cudaMallocHost(&error, sizeof(float));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1, 1);
+	for (unsigned i = 0; i < size; i++) {
+		a[i] = dist(mt);
+		b[i] = dist(mt);
+	}
+	*error = 0.f;
+
+	test_kernel<Use, M, N, K, T, Layout><<<1, 32>>>(error, a, b);
+	cudaDeviceSynchronize();
+
+	std::printf("[%s] ARCH=%d, %s, <%2d,%2d,%2d>, %s, error = %e [%s]\n",
+			__FILE__,
+			TEST_ARCH,
+			mtk::test_utils::get_string<Use>().c_str(),
+			M, N, K,
+			mtk::test_utils::get_string<T>().c_str(),
+			*error,
+			mtk::test_utils::get_test_result_string(*error < mtk::test_utils::get_machine_eps<T>() * 16)
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(error);
+}
+
+int main() {
+#if TEST_ARCH >= 80
+	test<nvcuda::wmma::matrix_a   , 16, 8, 16, half , nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::matrix_b   , 16, 8, 16, half , nvcuda::wmma::col_major>();
+	test<nvcuda::wmma::accumulator, 16, 8, 16, float, void                   >();
+	test<nvcuda::wmma::accumulator, 16, 8, 16, half , void                   >();
+#endif
+#if TEST_ARCH >= 75
+	test<nvcuda::wmma::matrix_a   , 16, 8, 8 , half , nvcuda::wmma::row_major>();
+	test<nvcuda::wmma::accumulator, 16, 8, 8 , float, void                   >();
+#endif
+}
@@ -0,0 +1,109 @@
+#include <iostream>
+#include <random>
+#include <mma.h>
+#include <wmma_extension/wmma_mma.hpp>
+#include "common.hpp"
+
+#ifndef TEST_ARCH
+#define TEST_ARCH (-1)
+#endif
+
+// Test for the 2:4 sparse mma (mma.sp)
+// D = A * B + C where A is pruned and compressed by `mtk::wmma::mma::sparse::compress`
+
+template <int M, int N, int K, nvcuda::wmma::layout_t c_layout, nvcuda::wmma::layout_t d_layout>
+__global__ void test_kernel(
+		float* const d,
+		const half* const a_compressed,
+		const std::uint16_t* const metadata,
+		const half* const b,
+		const float* const c) {
+	mtk::wmma::mma::fragment<mtk::wmma::mma::sparse_matrix_a, M, N, K, half, nvcuda::wmma::row_major> frag_a;
+	mtk::wmma::mma::fragment<mtk::wmma::mma::metadata       , M, N, K, half> frag_e;
+	mtk::wmma::mma::fragment<nvcuda::wmma::matrix_b         , M, N, K, half, nvcuda::wmma::col_major> frag_b;
+	mtk::wmma::mma::fragment<nvcuda::wmma::accumulator      , M, N, K, float> frag_c;
+	mtk::wmma::mma::fragment<nvcuda::wmma::accumulator      , M, N, K, float> frag_d;
+
+	const unsigned ldc = (c_layout == nvcuda::wmma::mem_col_major) ? M : N;
+	const unsigned ldd = (d_layout == nvcuda::wmma::mem_col_major) ? M : N;
+
+	mtk::wmma::mma::load_matrix_sync(frag_a, a_compressed, K / 2);
+	mtk::wmma::mma::load_metadata_sync(frag_e, metadata, K / 16);
+	mtk::wmma::mma::load_matrix_sync(frag_b, b, K);
+	mtk::wmma::mma::load_matrix_sync(frag_c, c, ldc, c_layout);
+
+	mtk::wmma::mma::mma_sync(frag_d, frag_a, frag_b, frag_c, frag_e);
+
+	mtk::wmma::mma::store_matrix_sync(d, frag_d, ldd, d_layout);
+}
+
+std::string get_layout_name(const nvcuda::wmma::layout_t layout) {
+	if (layout == nvcuda::wmma::mem_col_major) {
+		return mtk::test_utils::get_string<nvcuda::wmma::col_major>();
+	} else {
+		return mtk::test_utils::get_string<nvcuda::wmma::row_major>();
+	}
+}
+
+template <int M, int N, int K, nvcuda::wmma::layout_t c_layout, nvcuda::wmma::layout_t d_layout>
+void test() {
+	half *a_ptr, *a_compressed_ptr, *b_ptr;
+	std::uint16_t* metadata_ptr;
+	float *c_ptr, *d_ptr;
+
+	cudaMallocHost(&a_ptr, M * K * sizeof(half));
+	cudaMallocHost(&a_compressed_ptr, M * K / 2 * sizeof(half));
+	cudaMallocHost(&metadata_ptr, M * K / 16 * sizeof(std::uint16_t));
+	cudaMallocHost(&b_ptr, K * N * sizeof(half));
+	cudaMallocHost(&c_ptr, M * N * sizeof(float));
+	cudaMallocHost(&d_ptr, M * N * sizeof(float));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	for (std::size_t i = 0; i < M * K; i++) {
+		a_ptr[i] = mtk::wmma::detail::common::cast<half>(dist(mt));
+	}
+	for (std::size_t i = 0; i < K * N; i++) {
+		b_ptr[i] = mtk::wmma::detail::common::cast<half>(dist(mt));
+	}
+	for (std::size_t i = 0; i < M * N; i++) {
+		c_ptr[i] = dist(mt);
+	}
+
+	// Prune A and keep the pruned dense matrix for the reference
+	mtk::wmma::mma::sparse::compress(M, K, a_ptr, K, a_compressed_ptr, K / 2, metadata_ptr, K / 16);
+	mtk::wmma::mma::sparse::decompress(M, K, a_ptr, K, a_compressed_ptr, K / 2, metadata_ptr, K / 16);
+
+	cudaDeviceSynchronize();
+	test_kernel<M, N, K, c_layout, d_layout><<<1, 32>>>(d_ptr, a_compressed_ptr, metadata_ptr, b_ptr, c_ptr);
+	cudaDeviceSynchronize();
+	const auto error = mtk::test_utils::get_max_relative_error<M, N, K, half, float, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, c_layout, d_layout>(a_ptr, b_ptr, c_ptr, d_ptr);
+	std::printf("[%s] ARCH=%d, M=%2d, N=%2d, K=%2d, a_sparse_half_row_major, b_half_col_major, c_float_%s, d_float_%s : res = %e [%s]\n",
+			__FILE__,
+			TEST_ARCH,
+			M, N, K,
+			get_layout_name(c_layout).c_str(),
+			get_layout_name(d_layout).c_str(),
+			error,
+			mtk::test_utils::get_test_result_string(error < mtk::test_utils::get_machine_eps<half>() * 16)
+			);
+
+	cudaFreeHost(a_ptr);
+	cudaFreeHost(a_compressed_ptr);
+	cudaFreeHost(metadata_ptr);
+	cudaFreeHost(b_ptr);
+	cudaFreeHost(c_ptr);
+	cudaFreeHost(d_ptr);
+}
+
+int main() {
+#if TEST_ARCH >= 80
+	test<16, 8, 16, nvcuda::wmma::mem_col_major, nvcuda::wmma::mem_col_major>();
+	test<16, 8, 16, nvcuda::wmma::mem_row_major, nvcuda::wmma::mem_row_major>();
+	test<16, 8, 32, nvcuda::wmma::mem_col_major, nvcuda::wmma::mem_col_major>();
+	test<16, 8, 32, nvcuda::wmma::mem_col_major, nvcuda::wmma::mem_row_major>();
+	test<16, 8, 32, nvcuda::wmma::mem_row_major, nvcuda::wmma::mem_col_major>();
+	test<16, 8, 32, nvcuda::wmma::mem_row_major, nvcuda::wmma::mem_row_major>();
+#endif
+}
@@ -0,0 +1,129 @@
+// Host test of the 2:4 sparse compressor and the mma.sp emulator (no GPU is required)
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/detail/sparse_24.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+// Small integers so that the sums are exact
+std::vector<float> make_random_matrix(const unsigned size, std::mt19937& mt) {
+	std::uniform_int_distribution<int> dist(-8, 8);
+	std::vector<float> mat(size);
+	for (auto& v : mat) {
+		v = static_cast<float>(dist(mt));
+	}
+	return mat;
+}
+
+void test_compress(const unsigned m, const unsigned k) {
+	std::mt19937 mt(m * 100 + k);
+	const unsigned ldd = k + 3;
+	const unsigned ldc = k / 2 + 1;
+	const unsigned ldm = k / 16 + 1;
+	const auto dense = make_random_matrix(m * ldd, mt);
+	std::vector<float> compressed(m * ldc);
+	std::vector<std::uint16_t> metadata(m * ldm);
+	std::vector<float> pruned(m * ldd);
+
+	mtk::wmma::mma::sparse::compress(m, k, dense.data(), ldd, compressed.data(), ldc, metadata.data(), ldm);
+	mtk::wmma::mma::sparse::decompress(m, k, pruned.data(), ldd, compressed.data(), ldc, metadata.data(), ldm);
+
+	bool passed = mtk::wmma::mma::sparse::is_2_4_sparse(m, k, pruned.data(), ldd);
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned q = 0; q < k / 4; q++) {
+			// The kept elements are the two largest magnitudes and keep their values
+			float min_kept = 1e9f, max_dropped = 0.f;
+			for (unsigned l = 0; l < 4; l++) {
+				const auto index = i * ldd + q * 4 + l;
+				const unsigned nibble = (metadata[i * ldm + q / 4] >> ((q % 4) * 4)) & 0xf;
+				const bool kept = (nibble & 0x3) == l || (nibble >> 2) == l;
+				if (kept) {
+					passed = passed && (pruned[index] == dense[index]);
+					min_kept = std::min(min_kept, std::abs(dense[index]));
+				} else {
+					passed = passed && (pruned[index] == 0.f);
+					max_dropped = std::max(max_dropped, std::abs(dense[index]));
+				}
+			}
+			// Indices must be ascending
+			const unsigned nibble = (metadata[i * ldm + q / 4] >> ((q % 4) * 4)) & 0xf;
+			passed = passed && ((nibble & 0x3) < (nibble >> 2)) && (min_kept >= max_dropped);
+		}
+	}
+
+	// A 2:4 sparse matrix is not changed by compress + decompress
+	std::vector<float> pruned2(m * ldd);
+	mtk::wmma::mma::sparse::compress(m, k, pruned.data(), ldd, compressed.data(), ldc, metadata.data(), ldm);
+	mtk::wmma::mma::sparse::decompress(m, k, pruned2.data(), ldd, compressed.data(), ldc, metadata.data(), ldm);
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned l = 0; l < k; l++) {
+			passed = passed && (pruned[i * ldd + l] == pruned2[i * ldd + l]);
+		}
+	}
+	passed = passed && !mtk::wmma::mma::sparse::is_2_4_sparse(m, k, dense.data(), ldd);
+
+	std::printf("[compress] m=%3u, k=%3u (%s)\n", m, k, result_string(passed));
+}
+
+template <int K>
+void test_emulate_mma(const unsigned selector) {
+	using layout = mtk::wmma::mma::sparse::detail::layout<K>;
+	constexpr unsigned M = 16, N = 8;
+	std::mt19937 mt(K + selector);
+	const auto dense_a = make_random_matrix(M * K, mt);
+	const auto mat_b = make_random_matrix(K * N, mt); // col major
+	const auto mat_c = make_random_matrix(M * N, mt); // row major
+
+	float compressed[M * K / 2];
+	std::uint16_t metadata[M * K / 16];
+	mtk::wmma::mma::sparse::compress(M, K, dense_a.data(), K, compressed, K / 2, metadata, K / 16);
+	float pruned_a[M * K];
+	mtk::wmma::mma::sparse::decompress(M, K, pruned_a, K, compressed, K / 2, metadata, K / 16);
+
+	// Load the fragments as the device functions do
+	float a[32][K / 4], b[32][K / 4], c[32][4], d[32][4];
+	std::uint32_t e[32];
+	for (unsigned lane = 0; lane < 32; lane++) {
+		for (unsigned x = 0; x < layout::a_size; x++) a[lane][x] = compressed[layout::a_row(lane, x) * (K / 2) + layout::a_col(lane, x)];
+		for (unsigned x = 0; x < layout::b_size; x++) b[lane][x] = mat_b[layout::b_row(lane, x) + layout::b_col(lane, x) * K];
+		for (unsigned x = 0; x < layout::c_size; x++) c[lane][x] = mat_c[layout::c_row(lane, x) * N + layout::c_col(lane, x)];
+		// Only the threads chosen by the selector have valid metadata
+		e[lane] = ((lane % 4) / 2 == selector) ? mtk::wmma::mma::sparse::detail::get_metadata<K>(metadata, K / 16, lane) : 0xffffffffu;
+	}
+
+	mtk::wmma::mma::sparse::emulate_mma_sync<K>(d, a, b, c, e, selector);
+
+	double max_error = 0.;
+	for (unsigned lane = 0; lane < 32; lane++) {
+		for (unsigned x = 0; x < layout::c_size; x++) {
+			const auto i = layout::c_row(lane, x);
+			const auto j = layout::c_col(lane, x);
+			double ref = mat_c[i * N + j];
+			for (unsigned l = 0; l < K; l++) {
+				ref += static_cast<double>(pruned_a[i * K + l]) * mat_b[l + j * K];
+			}
+			max_error = std::max(max_error, std::abs(ref - d[lane][x]));
+		}
+	}
+
+	std::printf("[emulate_mma_sync] m16n8k%d, selector=%u, max_error=%e (%s)\n", K, selector, max_error, result_string(max_error == 0.));
+}
+} // namespace
+
+int main() {
+	test_compress(16, 16);
+	test_compress(16, 32);
+	test_compress(37, 64);
+	test_emulate_mma<16>(0);
+	test_emulate_mma<16>(1);
+	test_emulate_mma<32>(0);
+	test_emulate_mma<32>(1);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,231 @@
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <wmma_extension/tcec/tcec.hpp>
+#include <wmma_extension/tcec/host.hpp>
+#include "utils.hpp"
+
+// Test for the adaptive error correction (with_ec_adaptive):
+// 1. The number of the skipped mma is the same as the host reference (host::adaptive_correction)
+// 2. max|D_adaptive - D_with_ec| <= tolerance * k * max|A.x| * max|B.x| (+ the rounding of the accumulation)
+// 3. A sub fragment which has only zeros and nan is not skipped, so D has nan at the same positions as with_ec (also with with_ec_adaptive_zero_tile)
+
+namespace {
+template <class T>
+struct host_t;
+template <> struct host_t<half                         > {using type = mtk::wmma::tcec::host::fp16;};
+template <> struct host_t<nvcuda::wmma::precision::tf32> {using type = mtk::wmma::tcec::host::tf32;};
+
+template <unsigned N, class T, class A_Layout, class B_Layout, class Policy>
+__global__ void mma_kernel(float* const d_ptr, unsigned* const counters, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr, const float tolerance) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, A_Layout, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, B_Layout, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void    , Policy> frag_c, frag_d;
+
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, a_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_b, b_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, N, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c, tolerance);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+	if (threadIdx.x == 0) {
+		counters[0] = frag_d.num_correction_mma;
+		counters[1] = frag_d.num_skipped_mma;
+	}
+}
+
+template <unsigned N, class T, class A_Layout, class B_Layout, class Policy>
+__global__ void with_ec_kernel(float* const d_ptr, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, A_Layout, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, B_Layout, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void    , Policy> frag_c, frag_d;
+
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, a_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_b, b_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, N, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+}
+
+// Each (tile_rows x tile_cols) sub tile has a random exponent offset in [-spread, 0]
+void fill_tiles(float* const ptr, const unsigned N, const unsigned tile_rows, const unsigned tile_cols, const int spread, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> spread_dist(-spread, 0);
+	for (unsigned tj = 0; tj < N; tj += tile_cols) {
+		for (unsigned ti = 0; ti < N; ti += tile_rows) {
+			const auto e = spread_dist(mt);
+			for (unsigned j = tj; j < tj + tile_cols; j++) {
+				for (unsigned i = ti; i < ti + tile_rows; i++) {
+					ptr[i + j * N] = std::ldexp(dist(mt), e);
+				}
+			}
+		}
+	}
+}
+
+template <unsigned N, class T, class A_Layout, class B_Layout, class Op>
+void test_adaptive(const int spread, const float tolerance) {
+	using with_ec_policy  = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec         , Op>::type;
+	using adaptive_policy = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec_adaptive, Op>::type;
+	using host_type = typename host_t<T>::type;
+
+	float *a, *b, *c, *d_ec, *d_adaptive;
+	unsigned* counters;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&a         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&b         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&c         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_ec      , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_adaptive, sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&counters  , sizeof(unsigned) * 2));
+
+	std::mt19937 mt(std::random_device{}());
+	fill_tiles(a, N, adaptive_policy::m, adaptive_policy::k, spread, mt);
+	fill_tiles(b, N, adaptive_policy::k, adaptive_policy::n, spread, mt);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < N * N; i++) {
+		c[i] = dist(mt);
+	}
+
+	with_ec_kernel<N, T, A_Layout, B_Layout, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_ec, a, b, c);
+	mma_kernel<N, T, A_Layout, B_Layout, adaptive_policy><<<1, mtk::test_utils::warp_size>>>(d_adaptive, counters, a, b, c, tolerance);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	const auto expected_num_skipped_mma = mtk::wmma::tcec::host::adaptive_correction<host_type>(
+			nullptr, nullptr,
+			N, N, N,
+			adaptive_policy::m, adaptive_policy::n, adaptive_policy::k,
+			a, N,
+			b, N,
+			tolerance
+			);
+	const auto expected_num_correction_mma = 2 * (N / adaptive_policy::m) * (N / adaptive_policy::n) * (N / adaptive_policy::k);
+
+	double scale_a = 0., scale_b = 0.;
+	for (unsigned i = 0; i < N * N; i++) {
+		float hv, dhv;
+		mtk::wmma::tcec::host::split<host_type>(a[i], hv, dhv);
+		scale_a = std::max(scale_a, static_cast<double>(std::abs(hv)));
+		mtk::wmma::tcec::host::split<host_type>(b[i], hv, dhv);
+		scale_b = std::max(scale_b, static_cast<double>(std::abs(hv)));
+	}
+	// The rounding of the accumulation in FP32
+	const auto bound = (tolerance + 1e-6) * N * scale_a * scale_b;
+
+	double max_diff = 0.;
+	for (unsigned i = 0; i < N * N; i++) {
+		max_diff = std::max(max_diff, std::abs(static_cast<double>(d_ec[i]) - d_adaptive[i]));
+	}
+	const bool passed = max_diff <= bound && counters[0] == expected_num_correction_mma && counters[1] == expected_num_skipped_mma;
+
+	std::printf("[adaptive] Type:%5s, N:%3u, Op:%7s, spread:%2d, tolerance:%e, skipped:%4u/%4u (expected:%4u/%4u), max_diff:%e, bound:%e (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Op>().c_str(),
+			spread,
+			tolerance,
+			counters[1], counters[0],
+			expected_num_skipped_mma, expected_num_correction_mma,
+			max_diff,
+			bound,
+			(passed ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(c);
+	cudaFreeHost(d_ec);
+	cudaFreeHost(d_adaptive);
+	cudaFreeHost(counters);
+}
+// Adaptive_EC : with_ec_adaptive or with_ec_adaptive_zero_tile
+template <unsigned N, class T, class A_Layout, class B_Layout, class Op, class Adaptive_EC>
+void test_nan(const float tolerance) {
+	using with_ec_policy  = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec, Op>::type;
+	using adaptive_policy = typename mtk::wmma::tcec::default_policy<T, Adaptive_EC             , Op>::type;
+	constexpr bool skip_zero_tile = std::is_same<Adaptive_EC, mtk::wmma::tcec::with_ec_adaptive_zero_tile>::value;
+
+	float *a, *b, *c, *d_ec, *d_adaptive;
+	unsigned* counters;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&a         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&b         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&c         , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_ec      , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_adaptive, sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&counters  , sizeof(unsigned) * 2));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < N * N; i++) {
+		a[i] = dist(mt);
+		b[i] = dist(mt);
+		c[i] = dist(mt);
+	}
+	// The first sub tile of A has only zeros and a nan
+	for (unsigned j = 0; j < adaptive_policy::k; j++) {
+		for (unsigned i = 0; i < adaptive_policy::m; i++) {
+			a[i + j * N] = 0.f;
+		}
+	}
+	a[adaptive_policy::m / 2 + (adaptive_policy::k / 2) * N] = NAN;
+
+	with_ec_kernel<N, T, A_Layout, B_Layout, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_ec, a, b, c);
+	mma_kernel<N, T, A_Layout, B_Layout, adaptive_policy><<<1, mtk::test_utils::warp_size>>>(d_adaptive, counters, a, b, c, tolerance);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	unsigned num_nan = 0, num_nan_mismatches = 0;
+	for (unsigned i = 0; i < N * N; i++) {
+		num_nan += std::isnan(d_ec[i]);
+		num_nan_mismatches += std::isnan(d_ec[i]) != std::isnan(d_adaptive[i]);
+	}
+	const bool passed = num_nan != 0 && num_nan_mismatches == 0 && counters[1] == 0;
+
+	std::printf("[nan%s] Type:%5s, N:%3u, Op:%7s, tolerance:%e, skipped:%4u/%4u, nan:%4u, nan mismatches:%4u (%6s)\n",
+			(skip_zero_tile ? "_zero_tile" : ""),
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Op>().c_str(),
+			tolerance,
+			counters[1], counters[0],
+			num_nan,
+			num_nan_mismatches,
+			(passed ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(c);
+	cudaFreeHost(d_ec);
+	cudaFreeHost(d_adaptive);
+	cudaFreeHost(counters);
+}
+} // namespace
+
+int main() {
+	for (const auto spread : {0, 12}) {
+		for (const auto tolerance : {0.f, 1e-6f, 1e-4f, 1e-2f}) {
+			test_adaptive<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma >(spread, tolerance);
+			test_adaptive<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma>(spread, tolerance);
+#ifdef TEST_TF32
+			test_adaptive<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma >(spread, tolerance);
+			test_adaptive<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma>(spread, tolerance);
+#endif
+		}
+	}
+	for (const auto tolerance : {0.f, 1e-2f}) {
+		test_nan<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_adaptive          >(tolerance);
+		test_nan<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_adaptive          >(tolerance);
+		test_nan<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_adaptive_zero_tile>(tolerance);
+		test_nan<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_adaptive_zero_tile>(tolerance);
+#ifdef TEST_TF32
+		test_nan<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_adaptive          >(tolerance);
+		test_nan<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_adaptive          >(tolerance);
+		test_nan<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_adaptive_zero_tile>(tolerance);
+		test_nan<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_adaptive_zero_tile>(tolerance);
+#endif
+	}
+}
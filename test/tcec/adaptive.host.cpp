@@ -0,0 +1,187 @@
+// Host test of the correction selection of with_ec_adaptive (no GPU is required)
+// 1. The difference from with_ec is bounded by tolerance * k * max|A.x| * max|B.x|
+// 2. tolerance = 0 skips only the correction mma of the zero residuals
+// 3. The number of the skipped mma is monotonic in the tolerance
+// 4. No correction mma is skipped if an operand has nan
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace host = mtk::wmma::tcec::host;
+
+template <class T> const char* get_type_name();
+template <> const char* get_type_name<host::fp16>() {return "fp16";}
+template <> const char* get_type_name<host::tf32>() {return "tf32";}
+
+// Each (tile_rows x tile_cols) sub tile has a random exponent offset in [-max_spread, 0]
+// integer_ratio : the ratio of the integer-valued sub tiles (residuals are zero)
+void fill_tiles(std::vector<float>& mat, const unsigned rows, const unsigned cols, const unsigned tile_rows, const unsigned tile_cols, const int max_spread, const double integer_ratio, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	std::uniform_real_distribution<double> ratio_dist(0., 1.);
+	std::uniform_int_distribution<int> int_dist(-8, 8);
+	std::uniform_int_distribution<int> spread_dist(-max_spread, 0);
+	for (unsigned tj = 0; tj < cols; tj += tile_cols) {
+		for (unsigned ti = 0; ti < rows; ti += tile_rows) {
+			const auto integer = ratio_dist(mt) < integer_ratio;
+			const auto e = spread_dist(mt);
+			for (unsigned j = tj; j < tj + tile_cols; j++) {
+				for (unsigned i = ti; i < ti + tile_rows; i++) {
+					mat[i + j * rows] = integer ? static_cast<float>(int_dist(mt)) : std::ldexp(dist(mt), e);
+				}
+			}
+		}
+	}
+}
+
+// max|D_adaptive - D_with_ec| in double where the skipped correction terms are removed
+template <class T>
+double max_difference(
+		const unsigned m, const unsigned n, const unsigned k,
+		const unsigned fm, const unsigned fn, const unsigned fk,
+		const std::vector<float>& a, const std::vector<float>& b,
+		const std::vector<bool>& skip_a, const std::vector<bool>& skip_b) {
+	double max_diff = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			double diff = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				float a_hv, a_dhv, b_hv, b_dhv;
+				host::split<T>(a[i + l * m], a_hv, a_dhv);
+				host::split<T>(b[l + j * k], b_hv, b_dhv);
+				const auto index = i / fm + (j / fn) * (m / fm) + (l / fk) * (m / fm) * (n / fn);
+				if (skip_a[index]) {
+					diff += static_cast<double>(host::correction_scale_1<T>(a_dhv)) * b_hv;
+				}
+				if (skip_b[index]) {
+					diff += static_cast<double>(a_hv) * host::correction_scale_1<T>(b_dhv);
+				}
+			}
+			max_diff = std::max(max_diff, std::abs(diff));
+		}
+	}
+	return max_diff;
+}
+
+template <class T>
+double max_abs_hi(const std::vector<float>& mat) {
+	double v = 0.;
+	for (const auto x : mat) {
+		float hv, dhv;
+		host::split<T>(x, hv, dhv);
+		v = std::max(v, static_cast<double>(std::abs(hv)));
+	}
+	return v;
+}
+
+template <class T>
+void test_bound(const unsigned m, const unsigned n, const unsigned k, const unsigned fm, const unsigned fn, const unsigned fk, const int max_spread) {
+	std::mt19937 mt(m * n * k + max_spread);
+	std::vector<float> a(m * k), b(k * n);
+	fill_tiles(a, m, k, fm, fk, max_spread, 0., mt);
+	fill_tiles(b, k, n, fk, fn, max_spread, 0., mt);
+	const auto scale = max_abs_hi<T>(a) * max_abs_hi<T>(b);
+
+	const auto num_blocks = (m / fm) * (n / fn) * (k / fk);
+	unsigned prev_num_skipped = 0;
+	for (const auto tolerance : {0.f, 1e-7f, 1e-6f, 1e-5f, 1e-4f, 1e-3f, 1e-2f}) {
+		bool skip_a[1024], skip_b[1024];
+		const auto num_skipped = host::adaptive_correction<T>(skip_a, skip_b, m, n, k, fm, fn, fk, a.data(), m, b.data(), k, tolerance);
+		const auto max_diff = max_difference<T>(m, n, k, fm, fn, fk, a, b,
+				std::vector<bool>(skip_a, skip_a + num_blocks),
+				std::vector<bool>(skip_b, skip_b + num_blocks));
+		const auto bound = static_cast<double>(tolerance) * k * scale;
+		std::printf("[bound] %s, m:%3u, n:%3u, k:%3u, spread:%3d, tolerance:%e, skipped:%4u/%4u, max_diff:%e, bound:%e (%6s)\n",
+				get_type_name<T>(),
+				m, n, k,
+				max_spread,
+				tolerance,
+				num_skipped, 2 * num_blocks,
+				max_diff,
+				bound,
+				result_string(max_diff <= bound && num_skipped >= prev_num_skipped)
+				);
+		prev_num_skipped = num_skipped;
+	}
+}
+
+// tolerance = 0 : only the correction mma with zero residuals (the same as with_ec_skip) are skipped
+template <class T>
+void test_zero_tolerance(const unsigned m, const unsigned n, const unsigned k, const unsigned fm, const unsigned fn, const unsigned fk) {
+	std::mt19937 mt(m + n + k);
+	std::vector<float> a(m * k), b(k * n);
+	fill_tiles(a, m, k, fm, fk, 4, 0.5, mt);
+	fill_tiles(b, k, n, fk, fn, 4, 0.5, mt);
+
+	const auto num_skipped = host::adaptive_correction<T>(nullptr, nullptr, m, n, k, fm, fn, fk, a.data(), m, b.data(), k, 0.f);
+
+	const auto is_exact = [](const float* const ptr, const unsigned ld, const unsigned rows, const unsigned cols) {
+		for (unsigned j = 0; j < cols; j++) {
+			for (unsigned i = 0; i < rows; i++) {
+				float hv, dhv;
+				host::split<T>(ptr[i + j * ld], hv, dhv);
+				if (dhv != 0.f) {
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+	unsigned expected = 0;
+	for (unsigned bk = 0; bk < k / fk; bk++) {
+		for (unsigned bn = 0; bn < n / fn; bn++) {
+			for (unsigned bm = 0; bm < m / fm; bm++) {
+				expected += is_exact(a.data() + bm * fm + bk * fk * m, m, fm, fk);
+				expected += is_exact(b.data() + bk * fk + bn * fn * k, k, fk, fn);
+			}
+		}
+	}
+	std::printf("[zero tolerance] %s, m:%3u, n:%3u, k:%3u, skipped:%4u, expected:%4u (%6s)\n",
+			get_type_name<T>(),
+			m, n, k,
+			num_skipped, expected,
+			result_string(num_skipped == expected)
+			);
+}
+// A sub tile of A which has only zeros and a nan must not be regarded as zero, and the nan makes the threshold nan
+template <class T>
+void test_nan(const unsigned m, const unsigned n, const unsigned k, const unsigned fm, const unsigned fn, const unsigned fk) {
+	std::mt19937 mt(m * n + k);
+	std::vector<float> a(m * k), b(k * n);
+	fill_tiles(a, m, k, fm, fk, 4, 0., mt);
+	fill_tiles(b, k, n, fk, fn, 4, 0., mt);
+	for (unsigned j = 0; j < fk; j++) {
+		for (unsigned i = 0; i < fm; i++) {
+			a[i + j * m] = 0.f;
+		}
+	}
+	a[fm / 2 + (fk / 2) * m] = NAN;
+
+	const auto num_skipped = host::adaptive_correction<T>(nullptr, nullptr, m, n, k, fm, fn, fk, a.data(), m, b.data(), k, 1e-2f);
+	std::printf("[nan] %s, m:%3u, n:%3u, k:%3u, skipped:%4u (%6s)\n",
+			get_type_name<T>(),
+			m, n, k,
+			num_skipped,
+			result_string(num_skipped == 0)
+			);
+}
+} // namespace
+
+int main() {
+	for (const auto spread : {0, 6, 12}) {
+		test_bound<host::fp16>(32, 32, 64, 16, 8, 16, spread);
+		test_bound<host::tf32>(32, 32, 64, 16, 8, 8 , spread);
+	}
+	test_zero_tolerance<host::fp16>(32, 32, 64, 16, 8, 16);
+	test_zero_tolerance<host::tf32>(32, 32, 64, 16, 8, 8 );
+	test_nan<host::fp16>(32, 32, 64, 16, 8, 16);
+	test_nan<host::tf32>(32, 32, 64, 16, 8, 8 );
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <random>
+#include <type_traits>
+#include <wmma_extension/tcec/tcec.hpp>
+#include "utils.hpp"
+
+// Test for the asymmetric error correction:
+// When one operand is exactly representable in T, (with_ec x without_ec) and (without_ec x with_ec)
+// make bit-identical results to (with_ec x with_ec).
+
+namespace {
+template <unsigned N, class T, class A_Layout, class B_Layout, class A_Policy, class B_Policy, class C_Policy>
+__global__ void mma_kernel(float* const d_ptr, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, A_Layout, A_Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, B_Layout, B_Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void    , C_Policy> frag_c, frag_d;
+
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, a_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_b, b_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, N, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+}
+
+template <unsigned N, class T, class A_Layout, class B_Layout, class Op, class A_EC, class B_EC>
+void test_asymmetric() {
+	using with_ec_policy = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec, Op>::type;
+	using A_Policy = typename mtk::wmma::tcec::default_policy<T, A_EC, Op>::type;
+	using B_Policy = typename mtk::wmma::tcec::default_policy<T, B_EC, Op>::type;
+	constexpr bool a_is_exact = std::is_same<A_EC, mtk::wmma::tcec::without_ec>::value;
+
+	float *a, *b, *c, *d_sym, *d_asym;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&a     , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&b     , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&c     , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_sym , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_asym, sizeof(float) * N * N));
+
+	// The exact operand is integer-valued
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> int_dist(-8, 8);
+	for (unsigned i = 0; i < N * N; i++) {
+		a[i] = a_is_exact ? static_cast<float>(int_dist(mt)) : dist(mt);
+		b[i] = a_is_exact ? dist(mt) : static_cast<float>(int_dist(mt));
+		c[i] = dist(mt);
+	}
+
+	mma_kernel<N, T, A_Layout, B_Layout, with_ec_policy, with_ec_policy, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_sym, a, b, c);
+	mma_kernel<N, T, A_Layout, B_Layout, A_Policy, B_Policy, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_asym, a, b, c);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	unsigned num_mismatches = 0;
+	double max_error = 0.;
+	for (unsigned m = 0; m < N; m++) {
+		for (unsigned n = 0; n < N; n++) {
+			double cor_d = c[m + n * N];
+			for (unsigned k = 0; k < N; k++) {
+				cor_d += static_cast<double>(a[m + k * N]) * static_cast<double>(b[k + n * N]);
+			}
+			max_error = std::max(max_error, std::abs(cor_d - d_asym[m + n * N]));
+			num_mismatches += d_sym[m + n * N] != d_asym[m + n * N];
+		}
+	}
+
+	std::printf("[asymmetric] Type:%5s, N:%3u, Op:%7s, A:%9s, B:%9s, max_error:%e, mismatches:%u (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Op>().c_str(),
+			a_is_exact ? "{w/o ec}" : "{w/ ec}",
+			a_is_exact ? "{w/ ec}" : "{w/o ec}",
+			max_error,
+			num_mismatches,
+			(num_mismatches == 0 && max_error < 1e-5 * N ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(c);
+	cudaFreeHost(d_sym);
+	cudaFreeHost(d_asym);
+}
+} // namespace
+
+int main() {
+	test_asymmetric<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::without_ec>();
+	test_asymmetric<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::without_ec, mtk::wmma::tcec::with_ec   >();
+	test_asymmetric<32, half, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::without_ec>();
+	test_asymmetric<32, half, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::with_ec   >();
+#ifdef TEST_TF32
+	test_asymmetric<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::without_ec>();
+	test_asymmetric<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::without_ec, mtk::wmma::tcec::with_ec   >();
+	test_asymmetric<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::without_ec>();
+#endif
+}
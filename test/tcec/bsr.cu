@@ -0,0 +1,225 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <wmma_extension/tcec/bsr.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned block_m = 16;
+constexpr unsigned block_n = 16;
+constexpr unsigned warp_n = 32;
+constexpr unsigned warp_k = 32;
+template <class ErrorCorrection>
+constexpr double error_threshold = 0.0;
+template <>
+constexpr double error_threshold<mtk::wmma::tcec::with_ec   > = 1e-5;
+template <>
+constexpr double error_threshold<mtk::wmma::tcec::without_ec> = 1e-2;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+// without_ec : the no-correction path, whose sub fragments are mtk::wmma::mma::fragment
+template <class ErrorCorrection>
+using policy_t = typename mtk::wmma::tcec::detail::default_policy<tc_t, ErrorCorrection, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class ErrorCorrection>
+const char* ec_name() {
+	return std::is_same<ErrorCorrection, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : "{w/o ec}";
+}
+
+// A dense matrix (col major) whose (block_m x block_n) blocks are non-zero with the probability `density`
+std::vector<float> make_block_sparse(const unsigned m, const unsigned n, const double density, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<double> density_dist(0., 1.);
+	std::vector<float> mat(static_cast<std::size_t>(m) * n, 0.f);
+	for (unsigned bj = 0; bj < n / block_n; bj++) {
+		for (unsigned bi = 0; bi < m / block_m; bi++) {
+			if (density_dist(mt) >= density) {
+				continue;
+			}
+			for (unsigned j = bj * block_n; j < (bj + 1) * block_n; j++) {
+				for (unsigned i = bi * block_m; i < (bi + 1) * block_m; i++) {
+					mat[i + j * static_cast<std::size_t>(m)] = dist(mt);
+				}
+			}
+		}
+	}
+	return mat;
+}
+
+template <class T>
+T* to_device(const std::vector<T>& v) {
+	T* ptr;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&ptr, sizeof(T) * std::max<std::size_t>(v.size(), 1)));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ptr, v.data(), sizeof(T) * v.size(), cudaMemcpyDefault));
+	return ptr;
+}
+
+double relative_residual(const std::vector<float>& target, const std::vector<float>& ref) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (std::size_t i = 0; i < ref.size(); i++) {
+		const auto diff = static_cast<double>(target[i]) - ref[i];
+		base_norm += static_cast<double>(ref[i]) * ref[i];
+		diff_norm += diff * diff;
+	}
+	return base_norm == 0. ? std::sqrt(diff_norm) : std::sqrt(diff_norm / base_norm);
+}
+
+// C = alpha * A * B + beta * C, A : BSR (m x k)
+template <class ErrorCorrection>
+void test_spmm(const unsigned m, const unsigned n, const unsigned k, const double density) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	const auto a_dense = make_block_sparse(m, k, density, mt);
+	const auto a = mtk::wmma::tcec::bsr::host::build(a_dense.data(), m, m, k, block_m, block_n);
+	std::vector<float> b(static_cast<std::size_t>(k) * n), c(static_cast<std::size_t>(m) * n);
+	for (auto& v : b) v = dist(mt);
+	for (auto& v : c) v = dist(mt);
+	const float alpha = 1.5f, beta = -0.5f;
+
+	auto d_row_ptr = to_device(a.row_ptr);
+	auto d_col_idx = to_device(a.col_idx);
+	auto d_values  = to_device(a.values);
+	auto d_b       = to_device(b);
+	auto d_c       = to_device(c);
+
+	mtk::wmma::tcec::bsr::launch_spmm<block_m, block_n, warp_n, tc_t, policy_t<ErrorCorrection>>(
+			m, n,
+			alpha,
+			d_row_ptr, d_col_idx, d_values,
+			d_b, k,
+			beta,
+			d_c, m
+			);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> result(c.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(result.data(), d_c, sizeof(float) * c.size(), cudaMemcpyDefault));
+	mtk::wmma::tcec::bsr::host::spmm(n, alpha, a, b.data(), k, beta, c.data(), m);
+	const auto residual = relative_residual(result, c);
+
+	// Throughput (the flops of the non-zero blocks)
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		mtk::wmma::tcec::bsr::launch_spmm<block_m, block_n, warp_n, tc_t, policy_t<ErrorCorrection>>(
+				m, n,
+				alpha,
+				d_row_ptr, d_col_idx, d_values,
+				d_b, k,
+				0.f,
+				d_c, m
+				);
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	const auto elapsed_time = std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+	const auto performance = 2. * a.num_blocks() * block_m * block_n * n / elapsed_time / 1e12;
+
+	std::printf("[spmm ] %-8s m:%5u, n:%5u, k:%5u, density:%.2f, nnz blocks:%7u, residual:%e, time:%e s, throughput:%e TFlop/s (%6s)\n",
+			ec_name<ErrorCorrection>(),
+			m, n, k,
+			a.density(),
+			a.num_blocks(),
+			residual,
+			elapsed_time,
+			performance,
+			(residual < error_threshold<ErrorCorrection> ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_row_ptr));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_col_idx));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_values));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_c));
+}
+
+// C = alpha * (A * B) o spy(C) + beta * C, C : BSR (m x n)
+template <class ErrorCorrection>
+void test_sddmm(const unsigned m, const unsigned n, const unsigned k, const double density) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	const auto c_dense = make_block_sparse(m, n, density, mt);
+	auto c = mtk::wmma::tcec::bsr::host::build(c_dense.data(), m, m, n, block_m, block_n);
+	std::vector<float> a(static_cast<std::size_t>(m) * k), b(static_cast<std::size_t>(k) * n);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+	const float alpha = 1.5f, beta = -0.5f;
+
+	auto d_a       = to_device(a);
+	auto d_b       = to_device(b);
+	auto d_row_ptr = to_device(c.row_ptr);
+	auto d_col_idx = to_device(c.col_idx);
+	auto d_values  = to_device(c.values);
+
+	// A : row major, B : col major
+	mtk::wmma::tcec::bsr::launch_sddmm<block_m, block_n, warp_k, tc_t, policy_t<ErrorCorrection>>(
+			m, k,
+			alpha,
+			d_a, k,
+			d_b, k,
+			beta,
+			d_row_ptr, d_col_idx, d_values,
+			c.num_blocks()
+			);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> result(c.values.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(result.data(), d_values, sizeof(float) * result.size(), cudaMemcpyDefault));
+	mtk::wmma::tcec::bsr::host::sddmm(k, alpha, a.data(), k, b.data(), k, beta, c);
+	const auto residual = relative_residual(result, c.values);
+
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		mtk::wmma::tcec::bsr::launch_sddmm<block_m, block_n, warp_k, tc_t, policy_t<ErrorCorrection>>(
+				m, k,
+				alpha,
+				d_a, k,
+				d_b, k,
+				0.f,
+				d_row_ptr, d_col_idx, d_values,
+				c.num_blocks()
+				);
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	const auto elapsed_time = std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+	const auto performance = 2. * c.num_blocks() * block_m * block_n * k / elapsed_time / 1e12;
+
+	std::printf("[sddmm] %-8s m:%5u, n:%5u, k:%5u, density:%.2f, nnz blocks:%7u, residual:%e, time:%e s, throughput:%e TFlop/s (%6s)\n",
+			ec_name<ErrorCorrection>(),
+			m, n, k,
+			c.density(),
+			c.num_blocks(),
+			residual,
+			elapsed_time,
+			performance,
+			(residual < error_threshold<ErrorCorrection> ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_row_ptr));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_col_idx));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_values));
+}
+} // noname namespace
+
+int main() {
+	for (const auto density : {1.0, 0.3, 0.1, 0.0}) {
+		test_spmm <mtk::wmma::tcec::with_ec   >(1u << 11, 1u << 10, 1u << 11, density);
+		test_sddmm<mtk::wmma::tcec::with_ec   >(1u << 11, 1u << 11, 1u << 10, density);
+		test_spmm <mtk::wmma::tcec::without_ec>(1u << 11, 1u << 10, 1u << 11, density);
+		test_sddmm<mtk::wmma::tcec::without_ec>(1u << 11, 1u << 11, 1u << 10, density);
+	}
+}
@@ -0,0 +1,161 @@
+// Host test of the BSR builder and the references (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/bsr_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace bsr = mtk::wmma::tcec::bsr;
+
+// A dense matrix (col major, ld) whose (block_m x block_n) blocks are non-zero with the probability `density`
+std::vector<float> make_block_sparse(const unsigned m, const unsigned n, const unsigned ld, const unsigned block_m, const unsigned block_n, const double density, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_real_distribution<double> density_dist(0., 1.);
+	std::vector<float> mat(static_cast<std::size_t>(ld) * n, 0.f);
+	for (unsigned bj = 0; bj < n / block_n; bj++) {
+		for (unsigned bi = 0; bi < m / block_m; bi++) {
+			if (density_dist(mt) >= density) {
+				continue;
+			}
+			for (unsigned j = bj * block_n; j < (bj + 1) * block_n; j++) {
+				for (unsigned i = bi * block_m; i < (bi + 1) * block_m; i++) {
+					// Some zero elements in non-zero blocks
+					mat[i + j * ld] = (mt() % 4 == 0) ? 0.f : dist(mt);
+				}
+			}
+		}
+	}
+	return mat;
+}
+
+void test_build(const unsigned m, const unsigned n, const unsigned ld, const unsigned block_m, const unsigned block_n, const double density) {
+	std::mt19937 mt(m * n + block_m);
+	const auto dense = make_block_sparse(m, n, ld, block_m, block_n, density, mt);
+	const auto mat = bsr::host::build(dense.data(), ld, m, n, block_m, block_n);
+
+	// The number of the non-zero blocks
+	unsigned expected_num_blocks = 0;
+	for (unsigned bj = 0; bj < n / block_n; bj++) {
+		for (unsigned bi = 0; bi < m / block_m; bi++) {
+			bool zero = true;
+			for (unsigned j = bj * block_n; j < (bj + 1) * block_n; j++) {
+				for (unsigned i = bi * block_m; i < (bi + 1) * block_m; i++) {
+					zero = zero && dense[i + j * ld] == 0.f;
+				}
+			}
+			expected_num_blocks += !zero;
+		}
+	}
+
+	// The structure
+	bool valid = mat.row_ptr.size() == m / block_m + 1 && mat.row_ptr.front() == 0 && mat.row_ptr.back() == mat.num_blocks() && mat.values.size() == mat.num_blocks() * mat.block_size();
+	for (unsigned bi = 0; valid && bi < mat.num_block_rows(); bi++) {
+		for (unsigned p = mat.row_ptr[bi]; p < mat.row_ptr[bi + 1]; p++) {
+			valid = valid && mat.col_idx[p] < mat.num_block_cols() && (p == mat.row_ptr[bi] || mat.col_idx[p - 1] < mat.col_idx[p]);
+		}
+	}
+
+	// Round trip
+	std::vector<float> round_trip(static_cast<std::size_t>(ld) * n, 0.f);
+	bsr::host::to_dense(round_trip.data(), ld, mat);
+	unsigned num_mismatches = 0;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			num_mismatches += round_trip[i + j * ld] != dense[i + j * ld];
+		}
+	}
+
+	std::printf("[build] m:%4u, n:%4u, ld:%4u, block:%2ux%2u, density:%.2f, nnz blocks:%5u (expected:%5u), valid:%d, mismatches:%u (%6s)\n",
+			m, n, ld,
+			block_m, block_n,
+			mat.density(),
+			mat.num_blocks(), expected_num_blocks,
+			valid,
+			num_mismatches,
+			result_string(valid && mat.num_blocks() == expected_num_blocks && num_mismatches == 0)
+			);
+}
+
+// The references equal the dense computation
+void test_reference(const unsigned m, const unsigned n, const unsigned k, const unsigned block_m, const unsigned block_n, const double density) {
+	std::mt19937 mt(m + n + k);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	const float alpha = 1.5f, beta = -0.5f;
+
+	// SpMM : A (m x k, BSR), B (k x n), C (m x n)
+	const auto a_dense = make_block_sparse(m, k, m, block_m, block_n, density, mt);
+	const auto a = bsr::host::build(a_dense.data(), m, m, k, block_m, block_n);
+	std::vector<float> b(k * n), c(m * n);
+	for (auto& v : b) v = dist(mt);
+	for (auto& v : c) v = dist(mt);
+	std::vector<float> c_ref = c;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			double acc = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				acc += static_cast<double>(a_dense[i + l * m]) * b[l + j * k];
+			}
+			c_ref[i + j * m] = static_cast<float>(alpha * acc + static_cast<double>(beta) * c[i + j * m]);
+		}
+	}
+	bsr::host::spmm(n, alpha, a, b.data(), k, beta, c.data(), m);
+	double spmm_error = 0.;
+	for (unsigned i = 0; i < m * n; i++) {
+		spmm_error = std::max(spmm_error, std::abs(static_cast<double>(c[i]) - c_ref[i]));
+	}
+
+	// SDDMM : A (m x k, row major), B (k x n, col major), C (m x n, BSR)
+	std::vector<float> at(m * k);
+	for (auto& v : at) v = dist(mt);
+	const auto s_dense = make_block_sparse(m, n, m, block_m, block_n, density, mt);
+	auto s = bsr::host::build(s_dense.data(), m, m, n, block_m, block_n);
+	bsr::host::sddmm(k, alpha, at.data(), k, b.data(), k, beta, s);
+	std::vector<float> s_result(m * n);
+	bsr::host::to_dense(s_result.data(), m, s);
+	double sddmm_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			double expected = 0.;
+			// The non-zero blocks of the pattern
+			bool in_pattern = false;
+			const auto bi = i / block_m;
+			for (unsigned p = s.row_ptr[bi]; p < s.row_ptr[bi + 1]; p++) {
+				in_pattern = in_pattern || s.col_idx[p] == j / block_n;
+			}
+			if (in_pattern) {
+				double acc = 0.;
+				for (unsigned l = 0; l < k; l++) {
+					acc += static_cast<double>(at[l + i * k]) * b[l + j * k];
+				}
+				expected = alpha * acc + static_cast<double>(beta) * s_dense[i + j * m];
+			}
+			sddmm_error = std::max(sddmm_error, std::abs(expected - s_result[i + j * m]));
+		}
+	}
+
+	std::printf("[reference] m:%4u, n:%4u, k:%4u, block:%2ux%2u, density:%.2f, spmm error:%e, sddmm error:%e (%6s)\n",
+			m, n, k,
+			block_m, block_n,
+			density,
+			spmm_error,
+			sddmm_error,
+			result_string(spmm_error < 1e-5 && sddmm_error < 1e-5)
+			);
+}
+} // namespace
+
+int main() {
+	for (const auto density : {1.0, 0.3, 0.1, 0.0}) {
+		test_build(128, 96, 128, 16, 16, density);
+		test_build(64, 128, 80, 16, 32, density);
+		test_reference(64, 48, 96, 16, 16, density);
+		test_reference(64, 64, 64, 32, 16, density);
+	}
+
+	return mtk::test_utils::host_test::exit_code();
+}
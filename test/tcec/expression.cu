@@ -0,0 +1,129 @@
+#include <iostream>
+#include <random>
+#include <limits>
+#include <cmath>
+#include "utils.hpp"
+
+// Test for the expression templates:
+// D = (A0 + A1 * alpha) * B + fma(alpha, C0, C1) - C1 / alpha
+// The correction terms have to be kept by the evaluation so that the error of the fragments with EC stays small.
+
+template <class T, class ErrorCorrection>
+constexpr double error_threshold = 0.0;
+template <>
+constexpr double error_threshold<half                         , mtk::wmma::tcec::with_ec   > = 1e-5;
+template <>
+constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   > = 1e-5;
+template <>
+constexpr double error_threshold<half                         , mtk::wmma::tcec::without_ec> = 1e-2;
+template <>
+constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec> = 1e-2;
+template <>
+constexpr double error_threshold<float                        , mtk::wmma::tcec::without_ec> = 1e-5;
+
+template <unsigned N, class T, class Policy>
+__global__ void expression_kernel(
+		float* const d_ptr,
+		const float* const a0_ptr,
+		const float* const a1_ptr,
+		const float* const b_ptr,
+		const float* const c0_ptr,
+		const float* const c1_ptr,
+		const float alpha
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, nvcuda::wmma::row_major, Policy> frag_a0, frag_a1;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void                   , Policy> frag_c0, frag_c1;
+
+	mtk::wmma::tcec::load_matrix_sync(frag_a0, a0_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_a1, a1_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_b , b_ptr , N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c0, c0_ptr, N, nvcuda::wmma::mem_col_major);
+	mtk::wmma::tcec::load_matrix_sync(frag_c1, c1_ptr, N, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void                   , Policy> frag_c;
+	mtk::wmma::tcec::eval(frag_a, mtk::wmma::tcec::lazy(frag_a0) + mtk::wmma::tcec::lazy(frag_a1) * alpha);
+	mtk::wmma::tcec::eval(frag_c, mtk::wmma::expr::fma(alpha, mtk::wmma::tcec::lazy(frag_c0), mtk::wmma::tcec::lazy(frag_c1)) - mtk::wmma::tcec::lazy(frag_c1) / alpha);
+
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void, Policy> frag_d;
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+}
+
+template <unsigned N, class T, class Policy>
+void test_expression() {
+	float *hA0, *hA1, *hB, *hC0, *hC1, *hD;
+	cudaMallocHost(&hA0, N * N * sizeof(float));
+	cudaMallocHost(&hA1, N * N * sizeof(float));
+	cudaMallocHost(&hB , N * N * sizeof(float));
+	cudaMallocHost(&hC0, N * N * sizeof(float));
+	cudaMallocHost(&hC1, N * N * sizeof(float));
+	cudaMallocHost(&hD , N * N * sizeof(float));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < N * N; i++) {
+		hA0[i] = dist(mt);
+		hA1[i] = dist(mt);
+		hB [i] = dist(mt);
+		hC0[i] = dist(mt);
+		hC1[i] = dist(mt);
+	}
+	const float alpha = 1.f / 3;
+	cudaDeviceSynchronize();
+
+	expression_kernel<N, T, Policy><<<1, mtk::test_utils::warp_size>>>(hD, hA0, hA1, hB, hC0, hC1, alpha);
+
+	const auto stat = cudaDeviceSynchronize();
+	if (stat != cudaSuccess) {
+		std::printf("[error] %s\n", cudaGetErrorString(stat));
+	}
+
+	double max_error = 0.;
+	for (unsigned i = 0; i < N; i++) {
+		for (unsigned j = 0; j < N; j++) {
+			double cor_d = static_cast<double>(alpha) * hC0[i + j * N] + hC1[i + j * N] - hC1[i + j * N] / static_cast<double>(alpha);
+			for (unsigned l = 0; l < N; l++) {
+				cor_d += (static_cast<double>(hA0[i * N + l]) + static_cast<double>(hA1[i * N + l]) * alpha) * static_cast<double>(hB[l + j * N]);
+			}
+			const auto diff = std::abs(cor_d - hD[i + j * N]);
+			max_error = std::isnan(diff) ? std::numeric_limits<double>::infinity() : std::max(max_error, diff);
+		}
+	}
+
+	std::printf(
+			"[Type:%5s, N:%3u, Policy<%7s,%9s,%2u,%2u,%2u>] max_error: %e (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<typename Policy::op>().c_str(),
+			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : "{w/o ec}",
+			Policy::m,
+			Policy::n,
+			Policy::k,
+			max_error,
+			(max_error < error_threshold<T, typename Policy::error_correction> ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(hA0);
+	cudaFreeHost(hA1);
+	cudaFreeHost(hB);
+	cudaFreeHost(hC0);
+	cudaFreeHost(hC1);
+	cudaFreeHost(hD);
+}
+
+int main() {
+	test_expression<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_wmma>::type>();
+	test_expression<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_wmma>::type>();
+	test_expression<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_expression<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma >::type>();
+#ifdef TEST_TF32
+	test_expression<32, nvcuda::wmma::precision::tf32, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma>::type>();
+	test_expression<32, nvcuda::wmma::precision::tf32, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma>::type>();
+#endif
+#ifdef TEST_SIMT
+	test_expression<32, float, typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type>();
+#endif
+}
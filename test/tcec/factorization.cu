@@ -0,0 +1,223 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <wmma_extension/tcec/factorization.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned nrhs = 16;
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using policy = typename mtk::wmma::tcec::default_policy<tc_t, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class T>
+T* to_device(const std::vector<T>& v) {
+	T* ptr;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&ptr, sizeof(T) * std::max<std::size_t>(v.size(), 1)));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ptr, v.data(), sizeof(T) * v.size(), cudaMemcpyDefault));
+	return ptr;
+}
+
+double relative_residual(const std::vector<float>& target, const std::vector<float>& ref) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (std::size_t i = 0; i < ref.size(); i++) {
+		const auto diff = static_cast<double>(target[i]) - ref[i];
+		base_norm += static_cast<double>(ref[i]) * ref[i];
+		diff_norm += diff * diff;
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+template <class Func>
+double measure_time(Func func) {
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		func();
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+}
+
+// P * A = L * U and B = inv(A) * B
+template <unsigned N>
+void test_lu(const unsigned batch_size) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(batch_size) * N * N), b(static_cast<std::size_t>(batch_size) * N * nrhs);
+	std::vector<unsigned> ipiv(static_cast<std::size_t>(batch_size) * N);
+	std::vector<int> info(batch_size);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+
+	auto d_a    = to_device(a);
+	auto d_b    = to_device(b);
+	auto d_ipiv = to_device(ipiv);
+	auto d_info = to_device(info);
+
+	mtk::wmma::tcec::factorization::launch_lu<N, tc_t, policy>(batch_size, d_a, d_ipiv, d_info);
+	mtk::wmma::tcec::factorization::launch_lu_solve<N, nrhs, tc_t, policy>(batch_size, d_a, d_ipiv, d_b);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> lu_result(a.size()), b_result(b.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(lu_result.data(), d_a, sizeof(float) * a.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(b_result.data(), d_b, sizeof(float) * b.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ipiv.data(), d_ipiv, sizeof(unsigned) * ipiv.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(info.data(), d_info, sizeof(int) * info.size(), cudaMemcpyDefault));
+
+	// The reference of a part of the batch
+	const unsigned num_checked = std::min(batch_size, 1u << 10);
+	std::vector<float> lu_ref(a.begin(), a.begin() + static_cast<std::size_t>(num_checked) * N * N);
+	std::vector<float> b_ref(b.begin(), b.begin() + static_cast<std::size_t>(num_checked) * N * nrhs);
+	std::vector<unsigned> ipiv_ref(N);
+	unsigned num_mismatched_pivots = 0;
+	for (unsigned i = 0; i < num_checked; i++) {
+		float* const lu_ref_ptr = lu_ref.data() + static_cast<std::size_t>(i) * N * N;
+		mtk::wmma::tcec::factorization::host::lu(N, lu_ref_ptr, N, ipiv_ref.data());
+		mtk::wmma::tcec::factorization::host::lu_solve(N, nrhs, lu_ref_ptr, N, ipiv_ref.data(), b_ref.data() + static_cast<std::size_t>(i) * N * nrhs, N);
+		// The pivots may differ only if two candidates are almost equal in magnitude
+		num_mismatched_pivots += !std::equal(ipiv_ref.begin(), ipiv_ref.end(), ipiv.begin() + static_cast<std::size_t>(i) * N);
+	}
+	const auto num_failed = std::count_if(info.begin(), info.end(), [](const int v) {return v != 0;});
+	lu_result.resize(lu_ref.size());
+	b_result.resize(b_ref.size());
+	const auto lu_residual = relative_residual(lu_result, lu_ref);
+	const auto solve_residual = relative_residual(b_result, b_ref);
+
+	// A and B are overwritten, so the values are meaningless here
+	const auto lu_time = measure_time([&]() {
+			mtk::wmma::tcec::factorization::launch_lu<N, tc_t, policy>(batch_size, d_a, d_ipiv);
+			});
+	const auto solve_time = measure_time([&]() {
+			mtk::wmma::tcec::factorization::launch_lu_solve<N, nrhs, tc_t, policy>(batch_size, d_a, d_ipiv, d_b);
+			});
+
+	std::printf("[lu] N:%3u, batch:%8u, info != 0:%ld, pivot mismatch:%u/%u, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, batch_size,
+			num_failed,
+			num_mismatched_pivots, num_checked,
+			lu_residual,
+			batch_size / lu_time,
+			(num_failed == 0 && num_mismatched_pivots == 0 && lu_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+	std::printf("[lu_solve] N:%3u, nrhs:%3u, batch:%8u, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, nrhs, batch_size,
+			solve_residual,
+			batch_size / solve_time,
+			(solve_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_ipiv));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_info));
+}
+
+// A = L * L^T and B = inv(A) * B (A = R * R^T + N * I)
+template <unsigned N>
+void test_cholesky(const unsigned batch_size) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(batch_size) * N * N), b(static_cast<std::size_t>(batch_size) * N * nrhs);
+	std::vector<float> r(N * N);
+	std::vector<int> info(batch_size);
+	for (unsigned m = 0; m < batch_size; m++) {
+		for (auto& v : r) v = dist(mt);
+		float* const a_ptr = a.data() + static_cast<std::size_t>(m) * N * N;
+		for (unsigned j = 0; j < N; j++) {
+			for (unsigned i = 0; i < N; i++) {
+				float acc = i == j ? N : 0.f;
+				for (unsigned k = 0; k < N; k++) {
+					acc += r[i + k * N] * r[j + k * N];
+				}
+				a_ptr[i + j * N] = acc;
+			}
+		}
+	}
+	for (auto& v : b) v = dist(mt);
+
+	auto d_a    = to_device(a);
+	auto d_b    = to_device(b);
+	auto d_info = to_device(info);
+
+	mtk::wmma::tcec::factorization::launch_cholesky<N, tc_t, policy>(batch_size, d_a, d_info);
+	mtk::wmma::tcec::factorization::launch_cholesky_solve<N, nrhs, tc_t, policy>(batch_size, d_a, d_b);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> l_result(a.size()), b_result(b.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(l_result.data(), d_a, sizeof(float) * a.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(b_result.data(), d_b, sizeof(float) * b.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(info.data(), d_info, sizeof(int) * info.size(), cudaMemcpyDefault));
+
+	// The reference of a part of the batch
+	const unsigned num_checked = std::min(batch_size, 1u << 10);
+	std::vector<float> l_ref(a.begin(), a.begin() + static_cast<std::size_t>(num_checked) * N * N);
+	std::vector<float> b_ref(b.begin(), b.begin() + static_cast<std::size_t>(num_checked) * N * nrhs);
+	for (unsigned i = 0; i < num_checked; i++) {
+		float* const l_ref_ptr = l_ref.data() + static_cast<std::size_t>(i) * N * N;
+		mtk::wmma::tcec::factorization::host::cholesky(N, l_ref_ptr, N);
+		mtk::wmma::tcec::factorization::host::cholesky_solve(N, nrhs, l_ref_ptr, N, b_ref.data() + static_cast<std::size_t>(i) * N * nrhs, N);
+	}
+	const auto num_failed = std::count_if(info.begin(), info.end(), [](const int v) {return v != 0;});
+	// Only the lower triangle is compared
+	std::vector<float> l_lower, l_ref_lower;
+	for (unsigned m = 0; m < num_checked; m++) {
+		for (unsigned j = 0; j < N; j++) {
+			for (unsigned i = j; i < N; i++) {
+				const auto index = static_cast<std::size_t>(m) * N * N + i + j * N;
+				l_lower.push_back(l_result[index]);
+				l_ref_lower.push_back(l_ref[index]);
+			}
+		}
+	}
+	b_result.resize(b_ref.size());
+	const auto cholesky_residual = relative_residual(l_lower, l_ref_lower);
+	const auto solve_residual = relative_residual(b_result, b_ref);
+
+	// A and B are overwritten, so the values are meaningless here
+	const auto cholesky_time = measure_time([&]() {
+			mtk::wmma::tcec::factorization::launch_cholesky<N, tc_t, policy>(batch_size, d_a);
+			});
+	const auto solve_time = measure_time([&]() {
+			mtk::wmma::tcec::factorization::launch_cholesky_solve<N, nrhs, tc_t, policy>(batch_size, d_a, d_b);
+			});
+
+	std::printf("[cholesky] N:%3u, batch:%8u, info != 0:%ld, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, batch_size,
+			num_failed,
+			cholesky_residual,
+			batch_size / cholesky_time,
+			(num_failed == 0 && cholesky_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+	std::printf("[cholesky_solve] N:%3u, nrhs:%3u, batch:%8u, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, nrhs, batch_size,
+			solve_residual,
+			batch_size / solve_time,
+			(solve_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_info));
+}
+} // noname namespace
+
+int main() {
+	for (unsigned batch_size = 1u << 14; batch_size <= (1u << 20); batch_size <<= 3) {
+		test_lu<16>(batch_size);
+		test_lu<32>(batch_size);
+		test_cholesky<16>(batch_size);
+		test_cholesky<32>(batch_size);
+	}
+}
@@ -0,0 +1,161 @@
+// Host test of the references of the batched LU and Cholesky factorizations (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/factorization_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace factorization = mtk::wmma::tcec::factorization;
+
+// The max norm of A * X - B
+double solve_residual(const unsigned n, const unsigned nrhs, const std::vector<float>& a, const std::vector<float>& x, const std::vector<float>& b, const unsigned ld) {
+	double residual = 0.;
+	for (unsigned j = 0; j < nrhs; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k < n; k++) {
+				acc += static_cast<double>(a[i + k * ld]) * x[k + j * ld];
+			}
+			residual = std::max(residual, std::abs(acc - b[i + j * ld]));
+		}
+	}
+	return residual;
+}
+
+// P * A = L * U and A * X = B
+void test_lu(const unsigned n, const unsigned nrhs, const unsigned ld) {
+	std::mt19937 mt(n + ld);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(ld) * n), b(static_cast<std::size_t>(ld) * nrhs);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+	auto lu = a;
+	std::vector<unsigned> ipiv(n);
+	const auto info = factorization::host::lu(n, lu.data(), ld, ipiv.data());
+
+	// P * A
+	auto pa = a;
+	for (unsigned k = 0; k < n; k++) {
+		for (unsigned j = 0; j < n; j++) {
+			std::swap(pa[k + j * ld], pa[ipiv[k] + j * ld]);
+		}
+	}
+	double factorization_error = 0.;
+	unsigned num_invalid_pivots = 0;
+	for (unsigned j = 0; j < n; j++) {
+		num_invalid_pivots += ipiv[j] < j || ipiv[j] >= n;
+		for (unsigned i = 0; i < n; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k <= std::min(i, j); k++) {
+				acc += (k == i ? 1. : static_cast<double>(lu[i + k * ld])) * lu[k + j * ld];
+			}
+			factorization_error = std::max(factorization_error, std::abs(acc - pa[i + j * ld]));
+		}
+	}
+
+	auto x = b;
+	factorization::host::lu_solve(n, nrhs, lu.data(), ld, ipiv.data(), x.data(), ld);
+	const auto residual = solve_residual(n, nrhs, a, x, b, ld);
+
+	std::printf("[lu] n:%3u, nrhs:%3u, ld:%3u, info:%d, invalid pivots:%u, PA - LU error:%e, AX - B error:%e (%6s)\n",
+			n, nrhs, ld,
+			info,
+			num_invalid_pivots,
+			factorization_error,
+			residual,
+			result_string(info == 0 && num_invalid_pivots == 0 && factorization_error < 1e-5 && residual < 1e-4)
+			);
+}
+
+// A = L * L^T and A * X = B
+void test_cholesky(const unsigned n, const unsigned nrhs, const unsigned ld) {
+	std::mt19937 mt(n * ld);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> r(static_cast<std::size_t>(ld) * n), a(static_cast<std::size_t>(ld) * n), b(static_cast<std::size_t>(ld) * nrhs);
+	for (auto& v : r) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+	// A = R * R^T + n * I
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double acc = i == j ? n : 0.;
+			for (unsigned k = 0; k < n; k++) {
+				acc += static_cast<double>(r[i + k * ld]) * r[j + k * ld];
+			}
+			a[i + j * ld] = static_cast<float>(acc);
+		}
+	}
+	// The upper triangle must not be referenced
+	auto l = a;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < j; i++) {
+			l[i + j * ld] = 1e30f;
+		}
+	}
+	const auto info = factorization::host::cholesky(n, l.data(), ld);
+
+	double factorization_error = 0.;
+	unsigned num_upper_written = 0;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			if (i < j) {
+				num_upper_written += l[i + j * ld] != 1e30f;
+				continue;
+			}
+			double acc = 0.;
+			for (unsigned k = 0; k <= j; k++) {
+				acc += static_cast<double>(l[i + k * ld]) * l[j + k * ld];
+			}
+			factorization_error = std::max(factorization_error, std::abs(acc - a[i + j * ld]));
+		}
+	}
+
+	auto x = b;
+	factorization::host::cholesky_solve(n, nrhs, l.data(), ld, x.data(), ld);
+	const auto residual = solve_residual(n, nrhs, a, x, b, ld);
+
+	std::printf("[cholesky] n:%3u, nrhs:%3u, ld:%3u, info:%d, upper written:%u, A - LL^T error:%e, AX - B error:%e (%6s)\n",
+			n, nrhs, ld,
+			info,
+			num_upper_written,
+			factorization_error,
+			residual,
+			result_string(info == 0 && num_upper_written == 0 && factorization_error < 1e-4 && residual < 1e-4)
+			);
+}
+
+// The info of a singular / not positive definite matrix
+void test_info(const unsigned n, const unsigned k) {
+	std::vector<float> a(static_cast<std::size_t>(n) * n, 0.f);
+	for (unsigned i = 0; i < n; i++) {
+		a[i + i * n] = i == k ? 0.f : 2.f;
+	}
+	auto lu = a;
+	std::vector<unsigned> ipiv(n);
+	const auto lu_info = factorization::host::lu(n, lu.data(), n, ipiv.data());
+	a[k + k * n] = -1.f;
+	const auto cholesky_info = factorization::host::cholesky(n, a.data(), n);
+
+	std::printf("[info] n:%3u, k:%3u, lu info:%d, cholesky info:%d (%6s)\n",
+			n, k,
+			lu_info,
+			cholesky_info,
+			result_string(lu_info == static_cast<int>(k) + 1 && cholesky_info == static_cast<int>(k) + 1)
+			);
+}
+} // namespace
+
+int main() {
+	test_lu(16, 16, 16);
+	test_lu(32, 32, 40);
+	test_cholesky(16, 16, 16);
+	test_cholesky(32, 32, 40);
+	test_info(32, 0);
+	test_info(32, 20);
+
+	return mtk::test_utils::host_test::exit_code();
+}
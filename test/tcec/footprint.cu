@@ -0,0 +1,128 @@
+#include <iostream>
+#include <type_traits>
+#include <wmma_extension/tcec/tcec.hpp>
+#include "utils.hpp"
+
+namespace {
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+constexpr unsigned test_arch = 75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+constexpr unsigned test_arch = 70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+constexpr unsigned test_arch = 80;
+#endif
+
+template <class T, class EC>
+using policy_t = typename mtk::wmma::tcec::detail::default_policy<T, EC, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class Use, int m, int n, int k, class Layout, class Policy>
+using frag_t = mtk::wmma::tcec::fragment<Use, m, n, k, half, Layout, Policy>;
+
+// Error correction doubles the registers of a fragment
+using frag_with_ec_t    = frag_t<nvcuda::wmma::matrix_a, 32, 32, 16, nvcuda::wmma::row_major, policy_t<half, mtk::wmma::tcec::with_ec   >>;
+using frag_without_ec_t = frag_t<nvcuda::wmma::matrix_a, 32, 32, 16, nvcuda::wmma::row_major, policy_t<half, mtk::wmma::tcec::without_ec>>;
+static_assert(mtk::wmma::utils::footprint<frag_with_ec_t>::registers == 2 * mtk::wmma::utils::footprint<frag_without_ec_t>::registers, "footprint : error correction");
+// A 32x16 FP16 matrix is 32x16x2 / 4 / 32 = 8 registers per lane without error correction
+static_assert(mtk::wmma::utils::footprint<frag_without_ec_t>::registers == 8, "footprint : registers");
+static_assert(mtk::wmma::utils::footprint<frag_with_ec_t>::smem_bytes() == 32 * 16 * sizeof(float), "footprint : smem_bytes");
+static_assert(mtk::wmma::utils::footprint<frag_with_ec_t>::smem_bytes<float, nvcuda::wmma::col_major>(40) == 40 * 16 * sizeof(float), "footprint : smem_bytes with ldm");
+static_assert(mtk::wmma::utils::footprint<nvcuda::wmma::fragment<nvcuda::wmma::accumulator, 16, 16, 16, float>>::registers == 8, "footprint : wmma accumulator");
+static_assert(mtk::wmma::utils::footprint<nvcuda::wmma::fragment<nvcuda::wmma::matrix_b, 16, 16, 16, half, nvcuda::wmma::row_major>>::smem_bytes() == 16 * 16 * sizeof(half), "footprint : wmma smem_bytes");
+
+// with_ec_recompute holds only the FP32 source of the operands, which halves the registers of TF32 operands.
+template <class T, class EC>
+using operand_frag_t = mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a, 32, 32, 16, T, nvcuda::wmma::row_major, policy_t<T, EC>>;
+static_assert(2 * mtk::wmma::utils::footprint<operand_frag_t<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute>>::registers == mtk::wmma::utils::footprint<operand_frag_t<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec>>::registers, "footprint : recompute (tf32)");
+
+template <unsigned block_size, unsigned min_blocks_per_sm, int m, int n, int k, class Policy>
+__global__ void __launch_bounds__(block_size, min_blocks_per_sm) gemm_kernel(
+		float* const c_ptr,
+		const float* const a_ptr,
+		const float* const b_ptr
+		) {
+	using frag_a_t = frag_t<nvcuda::wmma::matrix_a   , m, n, k, nvcuda::wmma::row_major, Policy>;
+	using frag_b_t = frag_t<nvcuda::wmma::matrix_b   , m, n, k, nvcuda::wmma::col_major, Policy>;
+	using frag_c_t = frag_t<nvcuda::wmma::accumulator, m, n, k, void                   , Policy>;
+	// The fragments must fit in the register budget of `__launch_bounds__`
+	static_assert(
+			mtk::wmma::utils::total_registers<frag_a_t, frag_b_t, frag_c_t>() <=
+			mtk::wmma::utils::get_register_budget(mtk::wmma::utils::get_sm_resource(test_arch), block_size, min_blocks_per_sm),
+			"register budget");
+
+	constexpr unsigned num_warps = block_size / mtk::test_utils::warp_size;
+	__shared__ float smem_c[num_warps][mtk::wmma::utils::footprint<frag_c_t>::smem_bytes() / sizeof(float)];
+
+	frag_a_t frag_a;
+	frag_b_t frag_b;
+	frag_c_t frag_c;
+	mtk::wmma::tcec::fill_zero(frag_c);
+	mtk::wmma::tcec::load_matrix_sync(frag_a, a_ptr, k);
+	mtk::wmma::tcec::load_matrix_sync(frag_b, b_ptr, k);
+	mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+
+	const auto warp_id = threadIdx.x / mtk::test_utils::warp_size;
+	mtk::wmma::tcec::store_matrix_sync(smem_c[warp_id], frag_c, m, nvcuda::wmma::mem_col_major);
+	__syncwarp();
+	for (unsigned i = threadIdx.x % mtk::test_utils::warp_size; i < m * n; i += mtk::test_utils::warp_size) {
+		atomicAdd(c_ptr + i, smem_c[warp_id][i]);
+	}
+}
+
+const char* get_limiter_name(const mtk::wmma::utils::occupancy_limiter l) {
+	switch (l) {
+	case mtk::wmma::utils::occupancy_limiter::warps        : return "warps";
+	case mtk::wmma::utils::occupancy_limiter::blocks       : return "blocks";
+	case mtk::wmma::utils::occupancy_limiter::registers    : return "registers";
+	case mtk::wmma::utils::occupancy_limiter::shared_memory: return "shared_memory";
+	default: return "invalid";
+	}
+}
+
+// Compare the occupancy calculator with the CUDA runtime using the registers and the shared memory reported by the compiler
+template <unsigned block_size, unsigned min_blocks_per_sm, int m, int n, int k, class EC>
+void test_occupancy() {
+	using policy = policy_t<half, EC>;
+	const auto kernel = gemm_kernel<block_size, min_blocks_per_sm, m, n, k, policy>;
+
+	int device;
+	cudaDeviceProp prop;
+	WMMAE_CUDA_CHECK_ERROR(cudaGetDevice(&device));
+	WMMAE_CUDA_CHECK_ERROR(cudaGetDeviceProperties(&prop, device));
+	const auto res = mtk::wmma::utils::get_sm_resource(prop.major * 10 + prop.minor);
+
+	cudaFuncAttributes attr;
+	WMMAE_CUDA_CHECK_ERROR(cudaFuncGetAttributes(&attr, kernel));
+	int num_blocks;
+	WMMAE_CUDA_CHECK_ERROR(cudaOccupancyMaxActiveBlocksPerMultiprocessor(&num_blocks, kernel, block_size, 0));
+
+	using frag_c_t = frag_t<nvcuda::wmma::accumulator, m, n, k, void, policy>;
+	const auto occ = mtk::wmma::utils::compute_occupancy(res, block_size, attr.numRegs, attr.sharedSizeBytes);
+
+	// Unknown architectures are not compared
+	const bool passed = res.arch == 0 || occ.blocks_per_sm == static_cast<unsigned>(num_blocks);
+
+	std::printf("[%s] arch:sm_%d%d, %s, block:%u, fragment_registers:%u, registers:%d, smem:%zu, blocks:%u (cuda:%d), ratio:%4.2f, limiter:%s (%6s)\n",
+			__func__,
+			prop.major, prop.minor,
+			std::is_same<EC, mtk::wmma::tcec::with_ec>::value ? "with_ec" : "without_ec",
+			block_size,
+			mtk::wmma::utils::footprint<frag_c_t>::registers,
+			attr.numRegs,
+			attr.sharedSizeBytes,
+			occ.blocks_per_sm, num_blocks,
+			occ.ratio(),
+			get_limiter_name(occ.limiter),
+			(passed ? "PASSED" : "FAILED")
+			);
+}
+} // namespace
+
+int main() {
+	test_occupancy<128, 1, 32, 32, 16, mtk::wmma::tcec::with_ec   >();
+	test_occupancy<128, 1, 32, 32, 16, mtk::wmma::tcec::without_ec>();
+	test_occupancy<256, 2, 32, 32, 16, mtk::wmma::tcec::with_ec   >();
+	test_occupancy<256, 2, 32, 32, 16, mtk::wmma::tcec::without_ec>();
+}
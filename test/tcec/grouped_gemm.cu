@@ -0,0 +1,129 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <wmma_extension/tcec/grouped.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned warp_m = 32;
+constexpr unsigned warp_n = 32;
+constexpr unsigned warp_k = 32;
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using policy = typename mtk::wmma::tcec::default_policy<tc_t, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+// num_problems GEMMs of random (m, n) in [1, max_mn] and the common k (e.g. the experts of an MoE layer)
+void test_grouped_gemm(const unsigned num_problems, const unsigned max_mn, const unsigned k) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_int_distribution<unsigned> size_dist(1, max_mn);
+
+	std::vector<mtk::wmma::tcec::grouped::problem> problems(num_problems);
+	std::vector<float*> a_ptrs(num_problems), b_ptrs(num_problems), c_ptrs(num_problems);
+	double flop = 0.;
+	for (unsigned i = 0; i < num_problems; i++) {
+		auto& p = problems[i];
+		p.m = size_dist(mt);
+		p.n = size_dist(mt);
+		p.k = k;
+		p.alpha = 1.f;
+		p.beta = 0.f;
+		p.lda = p.k;
+		p.ldb = p.k;
+		p.ldc = p.m;
+		WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&a_ptrs[i], sizeof(float) * p.m * p.k));
+		WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&b_ptrs[i], sizeof(float) * p.k * p.n));
+		WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&c_ptrs[i], sizeof(float) * p.m * p.n));
+		for (unsigned j = 0; j < p.m * p.k; j++) a_ptrs[i][j] = dist(mt);
+		for (unsigned j = 0; j < p.k * p.n; j++) b_ptrs[i][j] = dist(mt);
+		for (unsigned j = 0; j < p.m * p.n; j++) c_ptrs[i][j] = 0.f;
+		p.a_ptr = a_ptrs[i];
+		p.b_ptr = b_ptrs[i];
+		p.c_ptr = c_ptrs[i];
+		flop += 2. * p.m * p.n * p.k;
+	}
+	const auto num_tiles = mtk::wmma::tcec::grouped::num_tiles<warp_m, warp_n>(problems.data(), num_problems);
+
+	mtk::wmma::tcec::grouped::problem* d_problems;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&d_problems, sizeof(mtk::wmma::tcec::grouped::problem) * num_problems));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(d_problems, problems.data(), sizeof(mtk::wmma::tcec::grouped::problem) * num_problems, cudaMemcpyDefault));
+
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	mtk::wmma::tcec::grouped::launch_gemm<warp_m, warp_n, warp_k, tc_t, policy>(d_problems, num_problems, num_tiles);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	double max_residual = 0.;
+	for (unsigned i = 0; i < num_problems; i++) {
+		const auto& p = problems[i];
+		double base_norm = 0.;
+		double diff_norm = 0.;
+#pragma omp parallel for collapse(2) reduction(+: base_norm) reduction(+: diff_norm)
+		for (unsigned r = 0; r < p.m; r++) {
+			for (unsigned j = 0; j < p.n; j++) {
+				double c = 0.;
+				for (unsigned l = 0; l < p.k; l++) {
+					c += static_cast<double>(p.a_ptr[l + r * p.lda]) * static_cast<double>(p.b_ptr[l + j * p.ldb]);
+				}
+				const auto diff = p.c_ptr[r + j * p.ldc] - c;
+				base_norm += c * c;
+				diff_norm += diff * diff;
+			}
+		}
+		max_residual = std::max(max_residual, std::sqrt(diff_norm / base_norm));
+	}
+
+	// Throughput of the grouped launch and of one launch per problem
+	constexpr unsigned test_count = 1u << 4;
+	auto start_clock = std::chrono::system_clock::now();
+	for (unsigned c = 0; c < test_count; c++) {
+		mtk::wmma::tcec::grouped::launch_gemm<warp_m, warp_n, warp_k, tc_t, policy>(d_problems, num_problems, num_tiles);
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	auto end_clock = std::chrono::system_clock::now();
+	const auto grouped_time = std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+
+	start_clock = std::chrono::system_clock::now();
+	for (unsigned c = 0; c < test_count; c++) {
+		for (unsigned i = 0; i < num_problems; i++) {
+			mtk::wmma::tcec::grouped::launch_gemm<warp_m, warp_n, warp_k, tc_t, policy>(d_problems + i, 1, mtk::wmma::tcec::grouped::num_tiles<warp_m, warp_n>(problems[i]));
+		}
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	end_clock = std::chrono::system_clock::now();
+	const auto separate_time = std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+
+	std::printf("[grouped] problems:%4u, max m/n:%5u, k:%5u, tiles:%7lu, max residual:%e, throughput(grouped):%e TFlop/s, throughput(separate):%e TFlop/s (%6s)\n",
+			num_problems,
+			max_mn, k,
+			num_tiles,
+			max_residual,
+			flop / grouped_time / 1e12,
+			flop / separate_time / 1e12,
+			(max_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	for (unsigned i = 0; i < num_problems; i++) {
+		WMMAE_CUDA_CHECK_ERROR(cudaFree(a_ptrs[i]));
+		WMMAE_CUDA_CHECK_ERROR(cudaFree(b_ptrs[i]));
+		WMMAE_CUDA_CHECK_ERROR(cudaFree(c_ptrs[i]));
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_problems));
+}
+} // noname namespace
+
+int main() {
+	test_grouped_gemm(8  , 1000, 1024);
+	test_grouped_gemm(64 , 300 , 1024);
+	test_grouped_gemm(256, 100 , 512 );
+}
@@ -0,0 +1,145 @@
+// Host test of the grouped GEMM (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/grouped_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+constexpr unsigned warp_m = 32;
+constexpr unsigned warp_n = 32;
+
+// Problems of random sizes in [0, max_size] (the pointers are not set)
+std::vector<mtk::wmma::tcec::grouped::problem> make_problems(const unsigned num_problems, const unsigned max_size, std::mt19937& mt) {
+	std::uniform_int_distribution<unsigned> dist(0, max_size);
+	std::vector<mtk::wmma::tcec::grouped::problem> problems(num_problems);
+	for (auto& p : problems) {
+		p.m = dist(mt);
+		p.n = dist(mt);
+		p.k = dist(mt);
+		p.alpha = 1.f;
+		p.beta = 0.f;
+		p.a_ptr = nullptr;
+		p.b_ptr = nullptr;
+		p.c_ptr = nullptr;
+		p.lda = p.ldb = p.ldc = 0;
+	}
+	return problems;
+}
+
+void test_tile_assignment(const unsigned num_problems, const unsigned max_size, const unsigned num_blocks, const unsigned num_warps) {
+	std::mt19937 mt(num_problems * max_size + num_blocks);
+	auto problems = make_problems(num_problems, max_size, mt);
+	// An empty problem in the middle of the group
+	if (num_problems > 2) {
+		problems[num_problems / 2].m = 0;
+	}
+	const auto report = mtk::wmma::tcec::grouped::simulate_tile_assignment<warp_m, warp_n>(problems.data(), num_problems, num_blocks, num_warps);
+	const auto num_tiles = mtk::wmma::tcec::grouped::num_tiles<warp_m, warp_n>(problems.data(), num_problems);
+
+	// Every tile is computed exactly once and the tiles are balanced among the warps
+	const auto num_all_warps = static_cast<unsigned long>(num_blocks) * num_warps;
+	const auto max_tiles = (num_tiles + num_all_warps - 1) / num_all_warps;
+	const bool passed = report.num_missing_tiles == 0 && report.num_duplicated_tiles == 0 && report.num_invalid_tiles == 0 &&
+		report.max_tiles_per_warp == max_tiles && report.min_tiles_per_warp == num_tiles / num_all_warps;
+
+	std::printf("[tile_assignment] problems:%4u, max size:%5u, blocks:%4u, warps:%2u, tiles:%7lu, tiles/warp:[%4lu, %4lu], missing:%lu, duplicated:%lu, invalid:%lu (%6s)\n",
+			num_problems,
+			max_size,
+			num_blocks,
+			num_warps,
+			num_tiles,
+			report.min_tiles_per_warp,
+			report.max_tiles_per_warp,
+			report.num_missing_tiles,
+			report.num_duplicated_tiles,
+			report.num_invalid_tiles,
+			result_string(passed)
+			);
+}
+
+template <class T>
+void test_gemm(const unsigned num_problems, const unsigned max_size, const unsigned num_blocks, const char* const type_name) {
+	std::mt19937 mt(num_problems + max_size);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	auto problems = make_problems(num_problems, max_size, mt);
+
+	// Each problem has its own leading dimensions and scalars
+	std::vector<std::vector<float>> a(num_problems), b(num_problems), c(num_problems), c_init(num_problems);
+	for (unsigned i = 0; i < num_problems; i++) {
+		auto& p = problems[i];
+		p.lda = p.k + i % 3;
+		p.ldb = p.k + i % 5;
+		p.ldc = p.m + i % 7;
+		p.alpha = 1.5f - 0.25f * (i % 4);
+		p.beta = (i % 2) ? -0.5f : 0.f;
+		a[i].resize(static_cast<std::size_t>(p.lda) * p.m);
+		b[i].resize(static_cast<std::size_t>(p.ldb) * p.n);
+		c[i].resize(static_cast<std::size_t>(p.ldc) * p.n);
+		for (auto& v : a[i]) v = dist(mt);
+		for (auto& v : b[i]) v = dist(mt);
+		for (auto& v : c[i]) v = dist(mt);
+		c_init[i] = c[i];
+		p.a_ptr = a[i].data();
+		p.b_ptr = b[i].data();
+		p.c_ptr = c[i].data();
+	}
+
+	mtk::wmma::tcec::grouped::host::gemm<warp_m, warp_n, T, mtk::wmma::tcec::with_ec, 16>(problems.data(), num_problems, num_blocks, 4);
+
+	double max_residual = 0.;
+	unsigned num_overwritten = 0;
+	for (unsigned i = 0; i < num_problems; i++) {
+		const auto& p = problems[i];
+		double base_norm = 0.;
+		double diff_norm = 0.;
+		for (unsigned j = 0; j < p.n; j++) {
+			for (unsigned r = 0; r < p.m; r++) {
+				double ref = p.beta == 0.f ? 0. : static_cast<double>(p.beta) * c_init[i][r + j * p.ldc];
+				for (unsigned l = 0; l < p.k; l++) {
+					ref += static_cast<double>(p.alpha) * a[i][l + r * p.lda] * b[i][l + j * p.ldb];
+				}
+				const auto diff = ref - c[i][r + j * p.ldc];
+				base_norm += ref * ref;
+				diff_norm += diff * diff;
+			}
+			// The padding of C must not be written
+			for (unsigned r = p.m; r < p.ldc; r++) {
+				num_overwritten += c[i][r + j * p.ldc] != c_init[i][r + j * p.ldc];
+			}
+		}
+		if (base_norm > 0.) {
+			max_residual = std::max(max_residual, std::sqrt(diff_norm / base_norm));
+		}
+	}
+
+	std::printf("[gemm] type:%5s, problems:%4u, max size:%4u, blocks:%3u, max residual:%e, overwritten:%u (%6s)\n",
+			type_name,
+			num_problems,
+			max_size,
+			num_blocks,
+			max_residual,
+			num_overwritten,
+			result_string(max_residual < 1e-5 && num_overwritten == 0)
+			);
+}
+} // noname namespace
+
+int main() {
+	test_tile_assignment(1, 1024, 8, 4);
+	test_tile_assignment(64, 300, 16, 4);
+	test_tile_assignment(64, 300, 1, 1);
+	test_tile_assignment(200, 100, 108, 4);
+	test_tile_assignment(7, 31, 3, 4);
+	test_tile_assignment(0, 100, 4, 4);
+
+	test_gemm<mtk::wmma::tcec::host::fp16>(16, 100, 5, "half");
+	test_gemm<mtk::wmma::tcec::host::tf32>(16, 100, 5, "tf32");
+	test_gemm<mtk::wmma::tcec::host::fp16>(3, 200, 64, "half");
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,108 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <wmma_extension/tcec/hetero.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned warp_m = 32;
+constexpr unsigned warp_n = 32;
+constexpr unsigned warp_k = 32;
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using tc_policy   = typename mtk::wmma::tcec::hetero::default_policy<tc_t, sm_t>::tc_policy;
+using simt_policy = typename mtk::wmma::tcec::hetero::default_policy<tc_t, sm_t>::simt_policy;
+using ratio_t     = typename mtk::wmma::tcec::hetero::default_ratio<sm_t>::type;
+
+template <class Schedule>
+void test_hetero_gemm(const std::string mode, const unsigned m, const unsigned n, const unsigned k) {
+	float *d_a, *d_b, *d_c;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_a, sizeof(float) * m * k));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_b, sizeof(float) * k * n));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_c, sizeof(float) * m * n));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < m * k; i++) d_a[i] = dist(mt);
+	for (unsigned i = 0; i < k * n; i++) d_b[i] = dist(mt);
+	for (unsigned i = 0; i < m * n; i++) d_c[i] = 0.f;
+
+	// A : row major, B : col major, C : col major
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	mtk::wmma::tcec::hetero::launch_gemm<warp_m, warp_n, warp_k, tc_t, tc_policy, simt_policy, Schedule>(
+			m, n, k,
+			1.f,
+			d_a, k,
+			d_b, k,
+			0.f,
+			d_c, m
+			);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	double base_norm = 0.;
+	double diff_norm = 0.;
+#pragma omp parallel for collapse(2) reduction(+: base_norm) reduction(+: diff_norm)
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned j = 0; j < n; j++) {
+			double c = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				c += static_cast<double>(d_a[l + i * k]) * static_cast<double>(d_b[l + j * k]);
+			}
+			const auto diff = d_c[i + j * m] - c;
+			base_norm += c * c;
+			diff_norm += diff * diff;
+		}
+	}
+	const auto residual = std::sqrt(diff_norm / base_norm);
+
+	// Throughput
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned c = 0; c < test_count; c++) {
+		mtk::wmma::tcec::hetero::launch_gemm<warp_m, warp_n, warp_k, tc_t, tc_policy, simt_policy, Schedule>(
+				m, n, k,
+				1.f,
+				d_a, k,
+				d_b, k,
+				0.f,
+				d_c, m
+				);
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	const auto elapsed_time = std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+	const auto performance = 2. * m * n * k / elapsed_time / 1e12;
+
+	std::printf("[%6s] TC warps:%2u, SIMT warps:%2u, ratio:%u:%u, m:%5u, n:%5u, k:%5u, residual:%e, throughput:%e TFlop/s (%6s)\n",
+			mode.c_str(),
+			Schedule::num_tc_warps,
+			Schedule::num_simt_warps,
+			ratio_t::tc,
+			ratio_t::simt,
+			m, n, k,
+			residual,
+			performance,
+			(residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_c));
+}
+} // noname namespace
+
+int main() {
+	for (unsigned n = 1u << 10; n <= (1u << 12); n <<= 1) {
+		test_hetero_gemm<mtk::wmma::tcec::hetero::schedule<4, 4, ratio_t>>("hetero", n, n, n);
+		test_hetero_gemm<mtk::wmma::tcec::hetero::schedule<8, 0, ratio_t>>("tc"    , n, n, n);
+		test_hetero_gemm<mtk::wmma::tcec::hetero::schedule<0, 8, ratio_t>>("simt"  , n, n, n);
+	}
+}
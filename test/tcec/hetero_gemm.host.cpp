@@ -0,0 +1,126 @@
+// Host test of the heterogeneous GEMM (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/hetero_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+template <class Schedule>
+void test_tile_split(const unsigned num_tiles, const unsigned num_blocks) {
+	const auto report = mtk::wmma::tcec::hetero::simulate_tile_split<Schedule>(num_tiles, num_blocks, 1., 3.);
+
+	// Every tile is computed exactly once
+	bool passed = report.num_missing_tiles == 0 && report.num_duplicated_tiles == 0 && report.num_tc_tiles + report.num_simt_tiles == num_tiles;
+
+	// The ratio of the tile counts follows the schedule when no round is partial
+	if (num_tiles % Schedule::tiles_per_round == 0) {
+		const auto num_rounds = num_tiles / Schedule::tiles_per_round;
+		// The SIMT tiles of a round start at the offset of the first SIMT warp
+		passed = passed && report.num_tc_tiles == num_rounds * Schedule::offset_in_round(Schedule::num_tc_warps);
+	}
+
+	std::printf("[tile_split] TC warps:%2u, SIMT warps:%2u, tiles/round:%3u, tiles:%5u, blocks:%4u, TC tiles:%5u, SIMT tiles:%5u, missing:%u, duplicated:%u, makespan:%6.1f (%6s)\n",
+			Schedule::num_tc_warps,
+			Schedule::num_simt_warps,
+			Schedule::tiles_per_round,
+			num_tiles,
+			num_blocks,
+			report.num_tc_tiles,
+			report.num_simt_tiles,
+			report.num_missing_tiles,
+			report.num_duplicated_tiles,
+			report.makespan,
+			result_string(passed)
+			);
+}
+
+template <unsigned WARP_M, unsigned WARP_N, class TC_T, class Schedule>
+double compute_residual(
+		const unsigned m, const unsigned n, const unsigned k,
+		const float alpha,
+		const std::vector<float>& a,
+		const std::vector<float>& b,
+		const float beta,
+		const std::vector<float>& c
+		) {
+	std::vector<float> d = c;
+	const auto num_blocks = Schedule::num_blocks(static_cast<unsigned long>(m / WARP_M) * (n / WARP_N)) / 2 + 1;
+	mtk::wmma::tcec::hetero::host::gemm<WARP_M, WARP_N, TC_T, 16, 16, Schedule>(
+			m, n, k,
+			alpha,
+			a.data(), k,
+			b.data(), k,
+			beta,
+			d.data(), m,
+			num_blocks
+			);
+
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned j = 0; j < n; j++) {
+			double ref = static_cast<double>(beta) * c[i + j * m];
+			for (unsigned l = 0; l < k; l++) {
+				ref += static_cast<double>(alpha) * static_cast<double>(a[l + i * k]) * static_cast<double>(b[l + j * k]);
+			}
+			const auto diff = ref - d[i + j * m];
+			base_norm += ref * ref;
+			diff_norm += diff * diff;
+		}
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+template <class TC_T>
+void test_gemm(const unsigned m, const unsigned n, const unsigned k, const char* const type_name) {
+	constexpr unsigned warp_m = 32;
+	constexpr unsigned warp_n = 32;
+	std::vector<float> a(m * k), b(k * n), c(m * n);
+	std::mt19937 mt(m + n + k);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+	for (auto& v : c) v = dist(mt);
+	const float alpha = 1.5f;
+	const float beta = -0.5f;
+
+	using ratio_t = mtk::wmma::tcec::hetero::ratio<3, 1>;
+	const auto hetero_residual = compute_residual<warp_m, warp_n, TC_T, mtk::wmma::tcec::hetero::schedule<4, 4, ratio_t>>(m, n, k, alpha, a, b, beta, c);
+	const auto tc_residual     = compute_residual<warp_m, warp_n, TC_T, mtk::wmma::tcec::hetero::schedule<4, 0, ratio_t>>(m, n, k, alpha, a, b, beta, c);
+	const auto simt_residual   = compute_residual<warp_m, warp_n, TC_T, mtk::wmma::tcec::hetero::schedule<0, 4, ratio_t>>(m, n, k, alpha, a, b, beta, c);
+
+	// The heterogeneous GEMM must be as accurate as the worse of the two paths
+	const auto threshold = std::max(tc_residual, simt_residual) * 1.5;
+	std::printf("[gemm] TC type:%5s, m:%4u, n:%4u, k:%4u, residual(hetero):%e, residual(TC only):%e, residual(SIMT only):%e (%6s)\n",
+			type_name,
+			m, n, k,
+			hetero_residual,
+			tc_residual,
+			simt_residual,
+			result_string(hetero_residual < threshold && hetero_residual < 1e-5)
+			);
+}
+} // noname namespace
+
+int main() {
+	using ratio_t = mtk::wmma::tcec::hetero::ratio<3, 1>;
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<4, 4, ratio_t>>(1024, 16);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<4, 4, ratio_t>>(1000, 7);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<4, 4, ratio_t>>(10, 3);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<2, 6, ratio_t>>(4096, 80);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<8, 0, ratio_t>>(777, 5);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<0, 8, ratio_t>>(777, 5);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<4, 4, mtk::wmma::tcec::hetero::ratio<1, 0>>>(640, 9);
+	test_tile_split<mtk::wmma::tcec::hetero::schedule<4, 4, typename mtk::wmma::tcec::hetero::default_ratio<mtk::wmma::tcec::sm_80>::type>>(0, 1);
+
+	test_gemm<mtk::wmma::tcec::host::fp16>(256, 256, 256, "half");
+	test_gemm<mtk::wmma::tcec::host::tf32>(256, 256, 256, "tf32");
+	test_gemm<mtk::wmma::tcec::host::fp16>(192, 96, 512, "half");
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,123 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <wmma_extension/tcec/householder.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned nrhs = 16;
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using policy = typename mtk::wmma::tcec::default_policy<tc_t, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class T>
+T* to_device(const std::vector<T>& v) {
+	T* ptr;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&ptr, sizeof(T) * std::max<std::size_t>(v.size(), 1)));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ptr, v.data(), sizeof(T) * v.size(), cudaMemcpyDefault));
+	return ptr;
+}
+
+double relative_residual(const std::vector<float>& target, const std::vector<float>& ref) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (std::size_t i = 0; i < ref.size(); i++) {
+		const auto diff = static_cast<double>(target[i]) - ref[i];
+		base_norm += static_cast<double>(ref[i]) * ref[i];
+		diff_norm += diff * diff;
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+template <class Func>
+double measure_time(Func func) {
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		func();
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+}
+
+// A = Q * R and B = Q^T * B (e.g. the least squares problems min |A x - b|)
+template <unsigned N>
+void test_qr(const unsigned batch_size) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(batch_size) * N * N), b(static_cast<std::size_t>(batch_size) * N * nrhs);
+	std::vector<float> tau(static_cast<std::size_t>(batch_size) * N);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : b) v = dist(mt);
+
+	auto d_a   = to_device(a);
+	auto d_b   = to_device(b);
+	auto d_tau = to_device(tau);
+
+	mtk::wmma::tcec::householder::launch_qr<N, tc_t, policy>(batch_size, d_a, d_tau);
+	mtk::wmma::tcec::householder::launch_apply_qt<N, nrhs, tc_t, policy>(batch_size, d_a, d_tau, d_b);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> qr_result(a.size()), b_result(b.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(qr_result.data(), d_a, sizeof(float) * a.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(b_result.data(), d_b, sizeof(float) * b.size(), cudaMemcpyDefault));
+
+	// The reference of a part of the batch
+	const unsigned num_checked = std::min(batch_size, 1u << 10);
+	std::vector<float> qr_ref(a.begin(), a.begin() + static_cast<std::size_t>(num_checked) * N * N);
+	std::vector<float> b_ref(b.begin(), b.begin() + static_cast<std::size_t>(num_checked) * N * nrhs);
+	for (unsigned i = 0; i < num_checked; i++) {
+		float* const qr_ref_ptr = qr_ref.data() + static_cast<std::size_t>(i) * N * N;
+		float* const tau_ref_ptr = tau.data() + static_cast<std::size_t>(i) * N;
+		mtk::wmma::tcec::householder::host::qr(N, qr_ref_ptr, N, tau_ref_ptr);
+		mtk::wmma::tcec::householder::host::apply_qt(N, nrhs, qr_ref_ptr, N, tau_ref_ptr, b_ref.data() + static_cast<std::size_t>(i) * N * nrhs, N);
+	}
+	qr_result.resize(qr_ref.size());
+	b_result.resize(b_ref.size());
+	const auto qr_residual = relative_residual(qr_result, qr_ref);
+	const auto apply_residual = relative_residual(b_result, b_ref);
+
+	// A and B are overwritten, so the values are meaningless here
+	const auto qr_time = measure_time([&]() {
+			mtk::wmma::tcec::householder::launch_qr<N, tc_t, policy>(batch_size, d_a, d_tau);
+			});
+	const auto apply_time = measure_time([&]() {
+			mtk::wmma::tcec::householder::launch_apply_qt<N, nrhs, tc_t, policy>(batch_size, d_a, d_tau, d_b);
+			});
+
+	std::printf("[qr] N:%3u, batch:%8u, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, batch_size,
+			qr_residual,
+			batch_size / qr_time,
+			(qr_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+	std::printf("[apply_qt] N:%3u, nrhs:%3u, batch:%8u, residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, nrhs, batch_size,
+			apply_residual,
+			batch_size / apply_time,
+			(apply_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_tau));
+}
+} // noname namespace
+
+int main() {
+	for (unsigned batch_size = 1u << 14; batch_size <= (1u << 20); batch_size <<= 3) {
+		test_qr<16>(batch_size);
+		test_qr<32>(batch_size);
+	}
+}
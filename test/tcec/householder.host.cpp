@@ -0,0 +1,109 @@
+// Host test of the references of the batched Householder QR (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/householder_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace householder = mtk::wmma::tcec::householder;
+
+// Q * R = A, Q^T * Q = I and Q * Q^T * B = B
+void test_qr(const unsigned n, const unsigned ld) {
+	std::mt19937 mt(n + ld);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(ld) * n);
+	for (auto& v : a) v = dist(mt);
+	auto qr = a;
+	std::vector<float> tau(n);
+	householder::host::qr(n, qr.data(), ld, tau.data());
+
+	// Q = Q * I
+	std::vector<float> q(static_cast<std::size_t>(ld) * n, 0.f);
+	for (unsigned i = 0; i < n; i++) {
+		q[i + i * ld] = 1.f;
+	}
+	householder::host::apply_q(n, n, qr.data(), ld, tau.data(), q.data(), ld);
+
+	double qr_error = 0.;
+	double orthogonality_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k <= j; k++) {
+				acc += static_cast<double>(q[i + k * ld]) * qr[k + j * ld];
+			}
+			qr_error = std::max(qr_error, std::abs(acc - a[i + j * ld]));
+
+			double qtq = 0.;
+			for (unsigned k = 0; k < n; k++) {
+				qtq += static_cast<double>(q[k + i * ld]) * q[k + j * ld];
+			}
+			orthogonality_error = std::max(orthogonality_error, std::abs(qtq - (i == j ? 1. : 0.)));
+		}
+	}
+
+	// Q^T * B computed by Q^T = Q^T * I
+	std::vector<float> b(static_cast<std::size_t>(ld) * n);
+	for (auto& v : b) v = dist(mt);
+	auto qtb = b;
+	householder::host::apply_qt(n, n, qr.data(), ld, tau.data(), qtb.data(), ld);
+	double apply_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k < n; k++) {
+				acc += static_cast<double>(q[k + i * ld]) * b[k + j * ld];
+			}
+			apply_error = std::max(apply_error, std::abs(acc - qtb[i + j * ld]));
+		}
+	}
+	householder::host::apply_q(n, n, qr.data(), ld, tau.data(), qtb.data(), ld);
+	double round_trip_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			round_trip_error = std::max(round_trip_error, std::abs(static_cast<double>(qtb[i + j * ld]) - b[i + j * ld]));
+		}
+	}
+
+	std::printf("[qr] n:%3u, ld:%3u, QR error:%e, Q^TQ error:%e, Q^TB error:%e, QQ^TB error:%e (%6s)\n",
+			n, ld,
+			qr_error,
+			orthogonality_error,
+			apply_error,
+			round_trip_error,
+			result_string(qr_error < 1e-5 && orthogonality_error < 1e-5 && apply_error < 1e-5 && round_trip_error < 1e-5)
+			);
+}
+
+// A column which is already zero below the diagonal gives tau = 0 (H = I)
+void test_zero_column(const unsigned n) {
+	std::vector<float> a(static_cast<std::size_t>(n) * n, 0.f);
+	for (unsigned i = 0; i < n; i++) {
+		a[i + i * n] = static_cast<float>(i + 1);
+	}
+	auto qr = a;
+	std::vector<float> tau(n);
+	householder::host::qr(n, qr.data(), n, tau.data());
+	const auto num_non_zero_tau = std::count_if(tau.begin(), tau.end(), [](const float v) {return v != 0.f;});
+	std::printf("[qr] n:%3u, diagonal, non-zero tau:%ld, R == A:%d (%6s)\n",
+			n,
+			static_cast<long>(num_non_zero_tau),
+			qr == a ? 1 : 0,
+			result_string(num_non_zero_tau == 0 && qr == a)
+			);
+}
+} // namespace
+
+int main() {
+	test_qr(16, 16);
+	test_qr(32, 32);
+	test_qr(32, 40);
+	test_zero_column(16);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,192 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <wmma_extension/tcec/jacobi.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using policy = typename mtk::wmma::tcec::default_policy<tc_t, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class T>
+T* to_device(const std::vector<T>& v) {
+	T* ptr;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&ptr, sizeof(T) * std::max<std::size_t>(v.size(), 1)));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ptr, v.data(), sizeof(T) * v.size(), cudaMemcpyDefault));
+	return ptr;
+}
+
+double relative_residual(const std::vector<float>& target, const std::vector<float>& ref) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (std::size_t i = 0; i < ref.size(); i++) {
+		const auto diff = static_cast<double>(target[i]) - ref[i];
+		base_norm += static_cast<double>(ref[i]) * ref[i];
+		diff_norm += diff * diff;
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+template <class Func>
+double measure_time(Func func) {
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		func();
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+}
+
+// The relative residual of U * diag(S) * V^T to A of a batch
+template <unsigned N>
+double reconstruction_residual(const float* const a, const float* const s, const float* const u, const float* const v) {
+	std::vector<float> usv(N * N), ref(a, a + N * N);
+	for (unsigned j = 0; j < N; j++) {
+		for (unsigned i = 0; i < N; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k < N; k++) {
+				acc += static_cast<double>(u[i + k * N]) * s[k] * v[j + k * N];
+			}
+			usv[i + j * N] = static_cast<float>(acc);
+		}
+	}
+	return relative_residual(usv, ref);
+}
+
+template <unsigned N>
+void test_svd(const unsigned batch_size) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(batch_size) * N * N);
+	for (auto& v : a) v = dist(mt);
+
+	auto d_a = to_device(a);
+	auto d_s = to_device(std::vector<float>(static_cast<std::size_t>(batch_size) * N));
+	auto d_u = to_device(std::vector<float>(a.size()));
+	auto d_v = to_device(std::vector<float>(a.size()));
+	auto d_num_sweeps = to_device(std::vector<unsigned>(batch_size));
+
+	mtk::wmma::tcec::jacobi::launch_svd<N, tc_t, policy>(batch_size, d_a, d_s, d_u, d_v, d_num_sweeps);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> s(static_cast<std::size_t>(batch_size) * N), u(a.size()), v(a.size());
+	std::vector<unsigned> num_sweeps(batch_size);
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(s.data(), d_s, sizeof(float) * s.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(u.data(), d_u, sizeof(float) * u.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(v.data(), d_v, sizeof(float) * v.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(num_sweeps.data(), d_num_sweeps, sizeof(unsigned) * num_sweeps.size(), cudaMemcpyDefault));
+
+	// The reference of a part of the batch
+	const unsigned num_checked = std::min(batch_size, 1u << 8);
+	std::vector<float> s_ref(static_cast<std::size_t>(num_checked) * N), u_ref(N * N), v_ref(N * N);
+	double max_reconstruction_residual = 0.;
+	for (unsigned i = 0; i < num_checked; i++) {
+		const auto offset = static_cast<std::size_t>(i) * N * N;
+		mtk::wmma::tcec::jacobi::host::svd(N, a.data() + offset, N, s_ref.data() + i * N, u_ref.data(), N, v_ref.data(), N);
+		max_reconstruction_residual = std::max(max_reconstruction_residual, reconstruction_residual<N>(a.data() + offset, s.data() + i * N, u.data() + offset, v.data() + offset));
+	}
+	s.resize(s_ref.size());
+	const auto s_residual = relative_residual(s, s_ref);
+	const auto max_num_sweeps = *std::max_element(num_sweeps.begin(), num_sweeps.end());
+
+	const auto time = measure_time([&]() {
+			mtk::wmma::tcec::jacobi::launch_svd<N, tc_t, policy>(batch_size, d_a, d_s, d_u, d_v);
+			});
+
+	std::printf("[svd] N:%3u, batch:%8u, max sweeps:%2u, S residual:%e, max USV^T residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, batch_size,
+			max_num_sweeps,
+			s_residual,
+			max_reconstruction_residual,
+			batch_size / time,
+			(s_residual < error_threshold && max_reconstruction_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_s));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_u));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_v));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_num_sweeps));
+}
+
+template <unsigned N>
+void test_eigen(const unsigned batch_size) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(batch_size) * N * N);
+	for (std::size_t b = 0; b < batch_size; b++) {
+		for (unsigned j = 0; j < N; j++) {
+			for (unsigned i = j; i < N; i++) {
+				a[b * N * N + i + j * N] = a[b * N * N + j + i * N] = dist(mt);
+			}
+		}
+	}
+
+	auto d_a = to_device(a);
+	auto d_w = to_device(std::vector<float>(static_cast<std::size_t>(batch_size) * N));
+	auto d_z = to_device(std::vector<float>(a.size()));
+	auto d_num_sweeps = to_device(std::vector<unsigned>(batch_size));
+
+	mtk::wmma::tcec::jacobi::launch_eigen<N, tc_t, policy>(batch_size, d_a, d_w, d_z, d_num_sweeps);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> w(static_cast<std::size_t>(batch_size) * N), z(a.size());
+	std::vector<unsigned> num_sweeps(batch_size);
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(w.data(), d_w, sizeof(float) * w.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(z.data(), d_z, sizeof(float) * z.size(), cudaMemcpyDefault));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(num_sweeps.data(), d_num_sweeps, sizeof(unsigned) * num_sweeps.size(), cudaMemcpyDefault));
+
+	// The reference of a part of the batch
+	const unsigned num_checked = std::min(batch_size, 1u << 8);
+	std::vector<float> w_ref(static_cast<std::size_t>(num_checked) * N), z_ref(N * N);
+	double max_reconstruction_residual = 0.;
+	for (unsigned i = 0; i < num_checked; i++) {
+		const auto offset = static_cast<std::size_t>(i) * N * N;
+		mtk::wmma::tcec::jacobi::host::eigen(N, a.data() + offset, N, w_ref.data() + i * N, z_ref.data(), N);
+		// Z * diag(W) * Z^T = A
+		max_reconstruction_residual = std::max(max_reconstruction_residual, reconstruction_residual<N>(a.data() + offset, w.data() + i * N, z.data() + offset, z.data() + offset));
+	}
+	w.resize(w_ref.size());
+	const auto w_residual = relative_residual(w, w_ref);
+	const auto max_num_sweeps = *std::max_element(num_sweeps.begin(), num_sweeps.end());
+
+	const auto time = measure_time([&]() {
+			mtk::wmma::tcec::jacobi::launch_eigen<N, tc_t, policy>(batch_size, d_a, d_w, d_z);
+			});
+
+	std::printf("[eigen] N:%3u, batch:%8u, max sweeps:%2u, W residual:%e, max ZWZ^T residual:%e, throughput:%e matrices/s (%6s)\n",
+			N, batch_size,
+			max_num_sweeps,
+			w_residual,
+			max_reconstruction_residual,
+			batch_size / time,
+			(w_residual < error_threshold && max_reconstruction_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_w));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_z));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_num_sweeps));
+}
+} // noname namespace
+
+int main() {
+	for (unsigned batch_size = 1u << 12; batch_size <= (1u << 18); batch_size <<= 3) {
+		test_svd<16>(batch_size);
+		test_svd<32>(batch_size);
+		test_eigen<16>(batch_size);
+		test_eigen<32>(batch_size);
+	}
+}
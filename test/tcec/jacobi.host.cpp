@@ -0,0 +1,135 @@
+// Host test of the rotation ordering and the references of the Jacobi solvers (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/jacobi_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace jacobi = mtk::wmma::tcec::jacobi;
+
+void test_round_robin(const unsigned n) {
+	std::vector<unsigned> count(n * n, 0);
+	unsigned num_not_disjoint = 0;
+	unsigned num_partner_mismatches = 0;
+	for (unsigned step = 0; step + 1 < n; step++) {
+		std::vector<unsigned> used(n, 0);
+		for (unsigned k = 0; k < n / 2; k++) {
+			unsigned p, q;
+			jacobi::round_robin_pair(n, step, k, p, q);
+			count[p + q * n]++;
+			used[p]++;
+			used[q]++;
+			num_partner_mismatches += jacobi::round_robin_partner(n, step, p) != q;
+			num_partner_mismatches += jacobi::round_robin_partner(n, step, q) != p;
+		}
+		num_not_disjoint += std::count_if(used.begin(), used.end(), [](const unsigned c) {return c != 1;});
+	}
+	// Every pair p < q exactly once in a sweep
+	unsigned num_mismatches = 0;
+	for (unsigned q = 0; q < n; q++) {
+		for (unsigned p = 0; p < n; p++) {
+			num_mismatches += count[p + q * n] != (p < q ? 1u : 0u);
+		}
+	}
+	std::printf("[round_robin] n:%3u, not disjoint:%u, mismatches:%u, partner mismatches:%u (%6s)\n",
+			n,
+			num_not_disjoint,
+			num_mismatches,
+			num_partner_mismatches,
+			result_string(num_not_disjoint == 0 && num_mismatches == 0 && num_partner_mismatches == 0)
+			);
+}
+
+// U * diag(S) * V^T = A, U^T * U = I, V^T * V = I and S is in descending order
+void test_svd(const unsigned n, const unsigned ld) {
+	std::mt19937 mt(n + ld);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(ld) * n);
+	for (auto& v : a) v = dist(mt);
+	std::vector<float> s(n), u(static_cast<std::size_t>(ld) * n), v(static_cast<std::size_t>(ld) * n);
+	const auto num_sweeps = jacobi::host::svd(n, a.data(), ld, s.data(), u.data(), ld, v.data(), ld);
+
+	double reconstruction_error = 0.;
+	double orthogonality_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double usv = 0., utu = 0., vtv = 0.;
+			for (unsigned k = 0; k < n; k++) {
+				usv += static_cast<double>(u[i + k * ld]) * s[k] * v[j + k * ld];
+				utu += static_cast<double>(u[k + i * ld]) * u[k + j * ld];
+				vtv += static_cast<double>(v[k + i * ld]) * v[k + j * ld];
+			}
+			const double eye = i == j ? 1. : 0.;
+			reconstruction_error = std::max(reconstruction_error, std::abs(usv - a[i + j * ld]));
+			orthogonality_error = std::max({orthogonality_error, std::abs(utu - eye), std::abs(vtv - eye)});
+		}
+	}
+	const auto sorted = std::is_sorted(s.begin(), s.end(), [](const float a, const float b) {return a > b;});
+
+	std::printf("[svd] n:%3u, ld:%3u, sweeps:%2u, reconstruction error:%e, orthogonality error:%e, sorted:%d (%6s)\n",
+			n, ld,
+			num_sweeps,
+			reconstruction_error,
+			orthogonality_error,
+			sorted ? 1 : 0,
+			result_string(reconstruction_error < 1e-5 && orthogonality_error < 1e-5 && sorted && num_sweeps < 16)
+			);
+}
+
+// A * Z = Z * diag(W), Z^T * Z = I and W is in ascending order
+void test_eigen(const unsigned n, const unsigned ld) {
+	std::mt19937 mt(n * ld);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(ld) * n);
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < ld; i++) {
+			// The upper triangle must not be referenced
+			a[i + j * ld] = i >= j ? dist(mt) : 1e30f;
+		}
+	}
+	std::vector<float> w(n), z(static_cast<std::size_t>(ld) * n);
+	const auto num_sweeps = jacobi::host::eigen(n, a.data(), ld, w.data(), z.data(), ld);
+
+	double residual = 0.;
+	double orthogonality_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			double az = 0., ztz = 0.;
+			for (unsigned k = 0; k < n; k++) {
+				const auto a_ik = i >= k ? a[i + k * ld] : a[k + i * ld];
+				az += static_cast<double>(a_ik) * z[k + j * ld];
+				ztz += static_cast<double>(z[k + i * ld]) * z[k + j * ld];
+			}
+			residual = std::max(residual, std::abs(az - static_cast<double>(w[j]) * z[i + j * ld]));
+			orthogonality_error = std::max(orthogonality_error, std::abs(ztz - (i == j ? 1. : 0.)));
+		}
+	}
+	const auto sorted = std::is_sorted(w.begin(), w.end());
+
+	std::printf("[eigen] n:%3u, ld:%3u, sweeps:%2u, residual:%e, orthogonality error:%e, sorted:%d (%6s)\n",
+			n, ld,
+			num_sweeps,
+			residual,
+			orthogonality_error,
+			sorted ? 1 : 0,
+			result_string(residual < 1e-5 && orthogonality_error < 1e-5 && sorted && num_sweeps < 16)
+			);
+}
+} // namespace
+
+int main() {
+	for (const auto n : {2u, 16u, 32u, 64u}) {
+		test_round_robin(n);
+	}
+	test_svd(16, 16);
+	test_svd(32, 40);
+	test_eigen(16, 16);
+	test_eigen(32, 40);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -14,6 +14,8 @@ template <>
 constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec> = 1e-2;
 template <>
 constexpr double error_threshold<float                        , mtk::wmma::tcec::without_ec> = 1e-5;
+template <>
+constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute> = 1e-5;
 
 template <unsigned N, class T, class A_Layout, class B_Layout, class MEM_A_Layout, class MEM_B_Layout, class Policy>
 __global__ void mma_kernel_abcd(float* const d_ptr, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr, const nvcuda::wmma::layout_t cd_layout) {
@@ -130,7 +132,7 @@ void test_mma(const nvcuda::wmma::layout_t cd_layout) {
 			mtk::test_utils::to_string<MEM_B_Layout>().c_str(),
 			(cd_layout == nvcuda::wmma::mem_col_major) ? mtk::test_utils::to_string<nvcuda::wmma::col_major>().c_str() : mtk::test_utils::to_string<nvcuda::wmma::row_major>().c_str(),
 			mtk::test_utils::to_string<typename Policy::op>().c_str(),
-			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : "{w/o ec}",
+			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : (std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec_recompute>::value ? "{w/ ec recompute}" : "{w/o ec}"),
 			Policy::m,
 			Policy::n,
 			Policy::k,
@@ -407,6 +409,54 @@ int main() {
 	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type, false>(nvcuda::wmma::mem_row_major);
 	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type, false>(nvcuda::wmma::mem_row_major);
 	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 16>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 16, 8, 8>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, float, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, mtk::wmma::tcec::Policy<mtk::wmma::tcec::op_simt, mtk::wmma::tcec::without_ec, 8, 8, 4>, false>(nvcuda::wmma::mem_row_major);
 #endif
 #ifdef TEST_TF32
 	// wmma TF32 test
@@ -603,5 +653,14 @@ int main() {
 	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma>::type, false>(nvcuda::wmma::mem_col_major);
 	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma>::type, false>(nvcuda::wmma::mem_row_major);
 	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma>::type, false>(nvcuda::wmma::mem_row_major);
+	// with_ec_recompute TF32 test
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_wmma>::type, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_wmma>::type, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_wmma>::type, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_wmma>::type, false>(nvcuda::wmma::mem_row_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_mma >::type, true >(nvcuda::wmma::mem_col_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_mma >::type, true >(nvcuda::wmma::mem_row_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_mma >::type, false>(nvcuda::wmma::mem_col_major);
+	test_mma<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec_recompute, mtk::wmma::tcec::op_mma >::type, false>(nvcuda::wmma::mem_row_major);
 #endif
 }
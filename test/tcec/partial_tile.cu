@@ -0,0 +1,144 @@
+#include <iostream>
+#include <random>
+#include <limits>
+#include <cmath>
+#include "utils.hpp"
+
+// Test for the bounds-checked load/store functions:
+// D[0:m, 0:n] = A[0:m, 0:k] * B[0:k, 0:n] + C[0:m, 0:n] computed by a single N x N x N fragment
+// where the matrices are not padded to N.
+
+template <class T, class ErrorCorrection>
+constexpr double error_threshold = 0.0;
+template <>
+constexpr double error_threshold<half                         , mtk::wmma::tcec::with_ec   > = 1e-5;
+template <>
+constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   > = 1e-5;
+template <>
+constexpr double error_threshold<half                         , mtk::wmma::tcec::without_ec> = 1e-2;
+template <>
+constexpr double error_threshold<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec> = 1e-2;
+template <>
+constexpr double error_threshold<float                        , mtk::wmma::tcec::without_ec> = 1e-5;
+
+// Out-of-range elements of D must not be written
+constexpr float guard_value = -100.0f;
+
+template <unsigned N, class T, class Policy>
+__global__ void partial_tile_kernel(
+		float* const d_ptr,
+		const float* const a_ptr,
+		const float* const b_ptr,
+		const float* const c_ptr,
+		const unsigned ld,
+		const unsigned m, const unsigned n, const unsigned k,
+		const nvcuda::wmma::layout_t cd_layout
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, nvcuda::wmma::row_major, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, nvcuda::wmma::col_major, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void                   , Policy> frag_c;
+
+	mtk::wmma::tcec::load_matrix_sync(frag_a, a_ptr, ld, m, k);
+	mtk::wmma::tcec::load_matrix_sync(frag_b, b_ptr, ld, k, n);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, ld, m, n, cd_layout);
+
+	mtk::wmma::tcec::mma_sync(frag_c, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_c, ld, m, n, cd_layout);
+}
+
+template <unsigned N, class T, class Policy>
+void test_partial_tile(const unsigned m, const unsigned n, const unsigned k, const nvcuda::wmma::layout_t cd_layout) {
+	// The leading dimension is not a multiple of 8 on purpose
+	const unsigned ld = N + 3;
+	const unsigned mem_size = ld * N;
+	float *hA, *hB, *hC, *hD;
+	cudaMallocHost(&hA, mem_size * sizeof(float));
+	cudaMallocHost(&hB, mem_size * sizeof(float));
+	cudaMallocHost(&hC, mem_size * sizeof(float));
+	cudaMallocHost(&hD, mem_size * sizeof(float));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	// Out-of-range elements are filled with NaN so that reading them breaks the result
+	for (unsigned i = 0; i < mem_size; i++) {
+		hA[i] = hB[i] = hC[i] = std::numeric_limits<float>::quiet_NaN();
+		hD[i] = guard_value;
+	}
+	for (unsigned i = 0; i < m; i++) for (unsigned l = 0; l < k; l++) hA[i * ld + l] = dist(mt);
+	for (unsigned l = 0; l < k; l++) for (unsigned j = 0; j < n; j++) hB[l + j * ld] = dist(mt);
+	for (unsigned i = 0; i < m; i++) for (unsigned j = 0; j < n; j++) {
+		hC[(cd_layout == nvcuda::wmma::mem_col_major) ? (i + j * ld) : (i * ld + j)] = dist(mt);
+	}
+	cudaDeviceSynchronize();
+
+	partial_tile_kernel<N, T, Policy><<<1, mtk::test_utils::warp_size>>>(hD, hA, hB, hC, ld, m, n, k, cd_layout);
+
+	const auto stat = cudaDeviceSynchronize();
+	if (stat != cudaSuccess) {
+		std::printf("[error] %s\n", cudaGetErrorString(stat));
+	}
+
+	double max_error = 0.;
+	bool guard_ok = true;
+	for (unsigned i = 0; i < N; i++) {
+		for (unsigned j = 0; j < N; j++) {
+			const auto c_mem_index = (cd_layout == nvcuda::wmma::mem_col_major) ? (i + j * ld) : (i * ld + j);
+			if (i >= m || j >= n) {
+				guard_ok = guard_ok && (hD[c_mem_index] == guard_value);
+				continue;
+			}
+			double cor_d = hC[c_mem_index];
+			for (unsigned l = 0; l < k; l++) {
+				cor_d += static_cast<double>(hA[i * ld + l]) * static_cast<double>(hB[l + j * ld]);
+			}
+			const auto diff = std::abs(cor_d - hD[c_mem_index]);
+			max_error = std::isnan(diff) ? std::numeric_limits<double>::infinity() : std::max(max_error, diff);
+		}
+	}
+
+	std::printf(
+			"[Type:%5s, N:%3u, m:%3u, n:%3u, k:%3u, C_Layout:%10s, Policy<%7s,%9s,%2u,%2u,%2u>] max_error: %e, guard: %s (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N, m, n, k,
+			(cd_layout == nvcuda::wmma::mem_col_major) ? mtk::test_utils::to_string<nvcuda::wmma::col_major>().c_str() : mtk::test_utils::to_string<nvcuda::wmma::row_major>().c_str(),
+			mtk::test_utils::to_string<typename Policy::op>().c_str(),
+			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : "{w/o ec}",
+			Policy::m,
+			Policy::n,
+			Policy::k,
+			max_error,
+			(guard_ok ? "OK" : "NG"),
+			((max_error < error_threshold<T, typename Policy::error_correction> && guard_ok) ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(hA);
+	cudaFreeHost(hB);
+	cudaFreeHost(hC);
+	cudaFreeHost(hD);
+}
+
+template <unsigned N, class T, class Policy>
+void test_partial_tile_shapes() {
+	for (const auto cd_layout : {nvcuda::wmma::mem_col_major, nvcuda::wmma::mem_row_major}) {
+		test_partial_tile<N, T, Policy>(N    , N    , N    , cd_layout);
+		test_partial_tile<N, T, Policy>(N - 1, N - 3, N - 5, cd_layout);
+		test_partial_tile<N, T, Policy>(1    , N    , 7    , cd_layout);
+		test_partial_tile<N, T, Policy>(N / 2 + 1, 1, N    , cd_layout);
+	}
+}
+
+int main() {
+	test_partial_tile_shapes<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_wmma>::type>();
+	test_partial_tile_shapes<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_wmma>::type>();
+	test_partial_tile_shapes<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_partial_tile_shapes<32, half, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma >::type>();
+#ifdef TEST_TF32
+	test_partial_tile_shapes<32, nvcuda::wmma::precision::tf32, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma>::type>();
+	test_partial_tile_shapes<32, nvcuda::wmma::precision::tf32, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma>::type>();
+#endif
+#ifdef TEST_SIMT
+	test_partial_tile_shapes<32, float, typename mtk::wmma::tcec::default_policy<float, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_simt>::type>();
+#endif
+}
@@ -0,0 +1,283 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <type_traits>
+#include <wmma_extension/tcec/tcec.hpp>
+#include <wmma_extension/tcec/host.hpp>
+#include "utils.hpp"
+
+// Test for the runtime skip of the correction mma (with_ec_skip):
+// 1. The results are bit-identical to with_ec
+// 2. The number of the skipped mma is the number of (sub tile, correction) pairs whose residuals are all zero
+// 3. All mma of the pairs of the sub tiles one of which is all zero are skipped by with_ec_skip_zero_tile only
+// 4. The correction mma with inf or nan in the other operand are not skipped (the results have the same nan as with_ec)
+
+namespace {
+template <class T>
+struct host_t;
+template <> struct host_t<half                         > {using type = mtk::wmma::tcec::host::fp16;};
+template <> struct host_t<nvcuda::wmma::precision::tf32> {using type = mtk::wmma::tcec::host::tf32;};
+
+template <class Frag>
+__device__ void store_counters(unsigned* const, const Frag&) {}
+template <int m, int n, int k, class T, class Op, int fm, int fn, int fk, bool skip_zero_tile>
+__device__ void store_counters(
+		unsigned* const counters,
+		const mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, m, n, k, T, void, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec_skip_t<skip_zero_tile>, fm, fn, fk>>& frag
+		) {
+	if (threadIdx.x == 0) {
+		counters[0] = frag.num_correction_mma;
+		counters[1] = frag.num_skipped_mma;
+		counters[2] = frag.num_tile_mma;
+		counters[3] = frag.num_skipped_tile_mma;
+	}
+}
+
+template <unsigned N, class T, class A_Layout, class B_Layout, class Policy>
+__global__ void mma_kernel(float* const d_ptr, unsigned* const counters, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, A_Layout, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, B_Layout, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void    , Policy> frag_c, frag_d;
+
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, a_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_b, b_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, N, nvcuda::wmma::mem_col_major);
+
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+	store_counters(counters, frag_d);
+}
+
+// The same as mma_kernel except that an element of B.x is set to `value` with a zero residual
+// (e.g. modified by x() / dx() or loaded from split planes)
+template <unsigned N, class T, class A_Layout, class B_Layout, class Policy>
+__global__ void mma_non_finite_kernel(float* const d_ptr, unsigned* const counters, const float* const a_ptr, const float* const b_ptr, const float* const c_ptr, const float value) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a   , N, N, N, T, A_Layout, Policy> frag_a;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_b   , N, N, N, T, B_Layout, Policy> frag_b;
+	mtk::wmma::tcec::fragment<nvcuda::wmma::accumulator, N, N, N, T, void    , Policy> frag_c, frag_d;
+
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_a, a_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync<nvcuda::wmma::col_major>(frag_b, b_ptr, N);
+	mtk::wmma::tcec::load_matrix_sync(frag_c, c_ptr, N, nvcuda::wmma::mem_col_major);
+	if (threadIdx.x == 0) {
+		using sub_t = typename mtk::wmma::tcec::detail::sub_frag_t<nvcuda::wmma::matrix_b, T>::type;
+		frag_b.x(0) = mtk::wmma::detail::common::cast<sub_t>(value);
+		frag_b.dx(0) = mtk::wmma::detail::common::cast<sub_t>(0.f);
+	}
+
+	mtk::wmma::tcec::mma_sync(frag_d, frag_a, frag_b, frag_c);
+
+	mtk::wmma::tcec::store_matrix_sync(d_ptr, frag_d, N, nvcuda::wmma::mem_col_major);
+	store_counters(counters, frag_d);
+}
+
+// Returns true if all elements of the (rows x cols) sub matrix are representable in T
+template <class T>
+bool is_exact(const float* const ptr, const unsigned ld, const unsigned rows, const unsigned cols) {
+	for (unsigned j = 0; j < cols; j++) {
+		for (unsigned i = 0; i < rows; i++) {
+			float hv, dhv;
+			mtk::wmma::tcec::host::split<typename host_t<T>::type>(ptr[i + j * ld], hv, dhv);
+			if (dhv != 0.f) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// Returns true if all elements of the (rows x cols) sub matrix are zero
+bool is_zero(const float* const ptr, const unsigned ld, const unsigned rows, const unsigned cols) {
+	for (unsigned j = 0; j < cols; j++) {
+		for (unsigned i = 0; i < rows; i++) {
+			if (ptr[i + j * ld] != 0.f) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+// exact_ratio : the ratio of the integer-valued sub tiles
+// zero_ratio  : the ratio of the all zero sub tiles
+// Skip_EC     : with_ec_skip or with_ec_skip_zero_tile
+template <unsigned N, class T, class A_Layout, class B_Layout, class Op, class Skip_EC>
+void test_skip(const double exact_ratio, const double zero_ratio) {
+	using with_ec_policy = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec, Op>::type;
+	using skip_policy    = typename mtk::wmma::tcec::default_policy<T, Skip_EC                 , Op>::type;
+	constexpr bool skip_zero_tile = std::is_same<Skip_EC, mtk::wmma::tcec::with_ec_skip_zero_tile>::value;
+	constexpr unsigned tile_m = skip_policy::m;
+	constexpr unsigned tile_n = skip_policy::n;
+	constexpr unsigned tile_k = skip_policy::k;
+
+	float *a, *b, *c, *d_ec, *d_skip;
+	unsigned* counters;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&a       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&b       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&c       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_ec    , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_skip  , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&counters, sizeof(unsigned) * 4));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> int_dist(-8, 8);
+	const auto fill = [&](float* const ptr, const unsigned tile_rows, const unsigned tile_cols) {
+		for (unsigned tj = 0; tj < N; tj += tile_cols) {
+			for (unsigned ti = 0; ti < N; ti += tile_rows) {
+				const bool zero = dist(mt) * 0.5 + 0.5 < zero_ratio;
+				const bool exact = dist(mt) * 0.5 + 0.5 < exact_ratio;
+				for (unsigned j = tj; j < tj + tile_cols; j++) {
+					for (unsigned i = ti; i < ti + tile_rows; i++) {
+						ptr[i + j * N] = zero ? 0.f : (exact ? static_cast<float>(int_dist(mt)) : dist(mt));
+					}
+				}
+			}
+		}
+	};
+	fill(a, tile_m, tile_k);
+	fill(b, tile_k, tile_n);
+	for (unsigned i = 0; i < N * N; i++) {
+		c[i] = dist(mt);
+	}
+
+	mma_kernel<N, T, A_Layout, B_Layout, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_ec  , counters, a, b, c);
+	mma_kernel<N, T, A_Layout, B_Layout, skip_policy   ><<<1, mtk::test_utils::warp_size>>>(d_skip, counters, a, b, c);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	unsigned num_mismatches = 0;
+	for (unsigned i = 0; i < N * N; i++) {
+		num_mismatches += d_ec[i] != d_skip[i];
+	}
+
+	// Expected counters
+	unsigned expected_num_correction_mma = 0;
+	unsigned expected_num_skipped_mma = 0;
+	unsigned expected_num_tile_mma = 0;
+	unsigned expected_num_skipped_tile_mma = 0;
+	for (unsigned bm = 0; bm < N / tile_m; bm++) {
+		for (unsigned bn = 0; bn < N / tile_n; bn++) {
+			for (unsigned bk = 0; bk < N / tile_k; bk++) {
+				const auto a_tile_ptr = a + bm * tile_m + bk * tile_k * N;
+				const auto b_tile_ptr = b + bk * tile_k + bn * tile_n * N;
+				expected_num_correction_mma += 2;
+				expected_num_tile_mma++;
+				if (skip_zero_tile && (is_zero(a_tile_ptr, N, tile_m, tile_k) || is_zero(b_tile_ptr, N, tile_k, tile_n))) {
+					expected_num_skipped_mma += 2;
+					expected_num_skipped_tile_mma++;
+					continue;
+				}
+				expected_num_skipped_mma += is_exact<T>(a_tile_ptr, N, tile_m, tile_k);
+				expected_num_skipped_mma += is_exact<T>(b_tile_ptr, N, tile_k, tile_n);
+			}
+		}
+	}
+	const bool passed = num_mismatches == 0 &&
+		counters[0] == expected_num_correction_mma && counters[1] == expected_num_skipped_mma &&
+		counters[2] == expected_num_tile_mma && counters[3] == expected_num_skipped_tile_mma;
+
+	std::printf("[skip%s] Type:%5s, N:%3u, Op:%7s, exact_ratio:%.2f, zero_ratio:%.2f, skipped:%4u/%4u (expected:%4u/%4u), skipped tiles:%4u/%4u (expected:%4u/%4u), mismatches:%u (%6s)\n",
+			(skip_zero_tile ? "_zero_tile" : ""),
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Op>().c_str(),
+			exact_ratio,
+			zero_ratio,
+			counters[1], counters[0],
+			expected_num_skipped_mma, expected_num_correction_mma,
+			counters[3], counters[2],
+			expected_num_skipped_tile_mma, expected_num_tile_mma,
+			num_mismatches,
+			(passed ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(c);
+	cudaFreeHost(d_ec);
+	cudaFreeHost(d_skip);
+	cudaFreeHost(counters);
+}
+
+// A : small integers (all residuals are zero), B : random with `value` (inf or nan) in an element whose residual is zero
+template <unsigned N, class T, class A_Layout, class B_Layout, class Op>
+void test_non_finite(const float value) {
+	using with_ec_policy = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec     , Op>::type;
+	using skip_policy    = typename mtk::wmma::tcec::default_policy<T, mtk::wmma::tcec::with_ec_skip, Op>::type;
+
+	float *a, *b, *c, *d_ec, *d_skip;
+	unsigned* counters;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&a       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&b       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&c       , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_ec    , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&d_skip  , sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&counters, sizeof(unsigned) * 4));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::uniform_int_distribution<int> int_dist(1, 8);
+	for (unsigned i = 0; i < N * N; i++) {
+		a[i] = static_cast<float>(int_dist(mt));
+		b[i] = dist(mt);
+		c[i] = dist(mt);
+	}
+
+	mma_non_finite_kernel<N, T, A_Layout, B_Layout, with_ec_policy><<<1, mtk::test_utils::warp_size>>>(d_ec  , counters, a, b, c, value);
+	mma_non_finite_kernel<N, T, A_Layout, B_Layout, skip_policy   ><<<1, mtk::test_utils::warp_size>>>(d_skip, counters, a, b, c, value);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	unsigned num_nan = 0;
+	unsigned num_mismatches = 0;
+	for (unsigned i = 0; i < N * N; i++) {
+		num_nan += std::isnan(d_ec[i]);
+		num_mismatches += d_ec[i] != d_skip[i] && !(std::isnan(d_ec[i]) && std::isnan(d_skip[i]));
+	}
+	const bool passed = num_mismatches == 0 && num_nan != 0;
+
+	std::printf("[skip] Type:%5s, N:%3u, Op:%7s, value:%4.1f, skipped:%4u/%4u, nan:%4u, mismatches:%u (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Op>().c_str(),
+			value,
+			counters[1], counters[0],
+			num_nan,
+			num_mismatches,
+			(passed ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(a);
+	cudaFreeHost(b);
+	cudaFreeHost(c);
+	cudaFreeHost(d_ec);
+	cudaFreeHost(d_skip);
+	cudaFreeHost(counters);
+}
+} // namespace
+
+int main() {
+	for (const auto zero_ratio : {0.0, 0.5}) {
+		for (const auto exact_ratio : {0.0, 0.5, 1.0}) {
+			test_skip<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_skip          >(exact_ratio, zero_ratio);
+			test_skip<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_skip          >(exact_ratio, zero_ratio);
+			test_skip<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_skip_zero_tile>(exact_ratio, zero_ratio);
+			test_skip<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_skip_zero_tile>(exact_ratio, zero_ratio);
+#ifdef TEST_TF32
+			test_skip<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_skip          >(exact_ratio, zero_ratio);
+			test_skip<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_skip          >(exact_ratio, zero_ratio);
+			test_skip<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma , mtk::wmma::tcec::with_ec_skip_zero_tile>(exact_ratio, zero_ratio);
+			test_skip<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma, mtk::wmma::tcec::with_ec_skip_zero_tile>(exact_ratio, zero_ratio);
+#endif
+		}
+	}
+	for (const auto value : {INFINITY, NAN}) {
+		test_non_finite<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma >(value);
+		test_non_finite<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma>(value);
+#ifdef TEST_TF32
+		test_non_finite<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, mtk::wmma::tcec::op_mma >(value);
+		test_non_finite<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, mtk::wmma::tcec::op_wmma>(value);
+#endif
+	}
+}
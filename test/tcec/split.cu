@@ -0,0 +1,163 @@
+#include <iostream>
+#include <random>
+#include <cstring>
+#include <vector>
+#include <wmma_extension/tcec/split.hpp>
+#include <wmma_extension/tcec/host.hpp>
+#include "utils.hpp"
+
+// Test for the pre-split hi / lo planes:
+// 1. `split_matrix` on the device and `host::split_matrix` make bit-identical planes
+// 2. `load_split_matrix_sync` makes bit-identical fragments to `load_matrix_sync`
+
+namespace {
+template <class T>
+struct host_t;
+template <> struct host_t<half                         > {using type = mtk::wmma::tcec::host::fp16;};
+template <> struct host_t<nvcuda::wmma::precision::tf32> {using type = mtk::wmma::tcec::host::tf32;};
+
+__device__ unsigned get_bits(const half  v) {return __half_as_ushort(v);}
+__device__ unsigned get_bits(const float v) {return __float_as_uint(v);}
+
+// The lo plane is read only with error correction
+template <class Frag>
+__device__ unsigned count_lo_mismatches(const Frag&, const Frag&) {return 0;}
+template <class Use, int m, int n, int k, class T, class Layout, class Op, int fm, int fn, int fk>
+__device__ unsigned count_lo_mismatches(
+		const mtk::wmma::tcec::fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_a,
+		const mtk::wmma::tcec::fragment<Use, m, n, k, T, Layout, mtk::wmma::tcec::Policy<Op, mtk::wmma::tcec::with_ec, fm, fn, fk>>& frag_b
+		) {
+	unsigned count = 0;
+	for (unsigned i = 0; i < frag_a.num_elements; i++) {
+		count += get_bits(frag_a.dx(i)) != get_bits(frag_b.dx(i));
+	}
+	return count;
+}
+
+template <class T>
+void test_split(const unsigned m, const unsigned n, const unsigned ld_src, const unsigned ld_dst) {
+	using plane_t = typename mtk::wmma::tcec::plane_t<T>::type;
+	using host_plane_t = typename mtk::wmma::tcec::host::plane_t<typename host_t<T>::type>::type;
+	static_assert(sizeof(plane_t) == sizeof(host_plane_t), "plane_t");
+
+	float* src;
+	plane_t *hi, *lo;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&src, sizeof(float) * ld_src * n));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&hi, sizeof(plane_t) * ld_dst * n));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&lo, sizeof(plane_t) * ld_dst * n));
+
+	// A wide range of exponents including subnormals of the residual
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < ld_src * n; i++) {
+		src[i] = std::ldexp(dist(mt), static_cast<int>(mt() % 40) - 30);
+	}
+
+	mtk::wmma::tcec::split_matrix<T>(hi, lo, ld_dst, src, ld_src, m, n);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	std::vector<host_plane_t> host_hi(ld_dst * n), host_lo(ld_dst * n);
+	mtk::wmma::tcec::host::split_matrix<typename host_t<T>::type>(host_hi.data(), host_lo.data(), ld_dst, src, ld_src, m, n);
+
+	unsigned num_mismatches = 0;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			const auto index = i + j * ld_dst;
+			if (std::memcmp(hi + index, host_hi.data() + index, sizeof(plane_t)) || std::memcmp(lo + index, host_lo.data() + index, sizeof(plane_t))) {
+				num_mismatches++;
+			}
+		}
+	}
+
+	std::printf("[split] Type:%5s, m:%4u, n:%4u, ld_src:%4u, ld_dst:%4u, mismatches:%u (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			m, n, ld_src, ld_dst,
+			num_mismatches,
+			(num_mismatches == 0 ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(src);
+	cudaFreeHost(hi);
+	cudaFreeHost(lo);
+}
+
+template <unsigned N, class T, class Layout, class MemLayout, class Policy>
+__global__ void load_kernel(
+		unsigned* const num_mismatches,
+		const float* const src_ptr,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const hi_ptr,
+		const typename mtk::wmma::tcec::plane_t<T>::type* const lo_ptr
+		) {
+	mtk::wmma::tcec::fragment<nvcuda::wmma::matrix_a, N, N, N, T, Layout, Policy> frag, frag_split;
+	mtk::wmma::tcec::load_matrix_sync<MemLayout>(frag, src_ptr, N);
+	mtk::wmma::tcec::load_split_matrix_sync<MemLayout>(frag_split, hi_ptr, lo_ptr, N);
+
+	unsigned count = count_lo_mismatches(frag, frag_split);
+	for (unsigned i = 0; i < frag.num_elements; i++) {
+		count += get_bits(frag.x(i)) != get_bits(frag_split.x(i));
+	}
+	atomicAdd(num_mismatches, count);
+}
+
+template <unsigned N, class T, class Layout, class MemLayout, class Policy>
+void test_load() {
+	using plane_t = typename mtk::wmma::tcec::plane_t<T>::type;
+	float* src;
+	plane_t *hi, *lo;
+	unsigned* num_mismatches;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&src, sizeof(float) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&hi, sizeof(plane_t) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&lo, sizeof(plane_t) * N * N));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocHost(&num_mismatches, sizeof(unsigned)));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < N * N; i++) {
+		src[i] = dist(mt);
+	}
+	*num_mismatches = 0;
+
+	mtk::wmma::tcec::split_matrix<T>(hi, lo, N, src, N, N, N);
+	load_kernel<N, T, Layout, MemLayout, Policy><<<1, mtk::test_utils::warp_size>>>(num_mismatches, src, hi, lo);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	std::printf("[load] Type:%5s, N:%3u, Layout:%10s, MemLayout:%10s, Policy<%7s,%9s,%2u,%2u,%2u>, mismatches:%u (%6s)\n",
+			mtk::test_utils::to_string<T>().c_str(),
+			N,
+			mtk::test_utils::to_string<Layout>().c_str(),
+			mtk::test_utils::to_string<MemLayout>().c_str(),
+			mtk::test_utils::to_string<typename Policy::op>().c_str(),
+			std::is_same<typename Policy::error_correction, mtk::wmma::tcec::with_ec>::value ? "{w/ ec}" : "{w/o ec}",
+			Policy::m,
+			Policy::n,
+			Policy::k,
+			*num_mismatches,
+			(*num_mismatches == 0 ? "PASSED" : "FAILED")
+			);
+
+	cudaFreeHost(src);
+	cudaFreeHost(hi);
+	cudaFreeHost(lo);
+	cudaFreeHost(num_mismatches);
+}
+} // namespace
+
+int main() {
+	test_split<half>(1024, 1024, 1024, 1024);
+	test_split<half>(1000, 333 , 1003, 1001);
+#ifdef TEST_TF32
+	test_split<nvcuda::wmma::precision::tf32>(1024, 1024, 1024, 1024);
+	test_split<nvcuda::wmma::precision::tf32>(1000, 333 , 1003, 1001);
+#endif
+
+	test_load<32, half, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_load<32, half, nvcuda::wmma::row_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_load<32, half, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_mma >::type>();
+	test_load<32, half, nvcuda::wmma::col_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_wmma>::type>();
+	test_load<32, half, nvcuda::wmma::col_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<half, mtk::wmma::tcec::without_ec, mtk::wmma::tcec::op_wmma>::type>();
+#ifdef TEST_TF32
+	test_load<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_load<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::row_major, nvcuda::wmma::col_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_mma >::type>();
+	test_load<32, nvcuda::wmma::precision::tf32, nvcuda::wmma::col_major, nvcuda::wmma::row_major, typename mtk::wmma::tcec::default_policy<nvcuda::wmma::precision::tf32, mtk::wmma::tcec::with_ec   , mtk::wmma::tcec::op_wmma>::type>();
+#endif
+}
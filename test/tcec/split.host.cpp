@@ -0,0 +1,110 @@
+// Host test of the hi / lo plane splitter (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace host = mtk::wmma::tcec::host;
+
+template <class T> const char* get_type_name();
+template <> const char* get_type_name<host::fp16>() {return "fp16";}
+template <> const char* get_type_name<host::tf32>() {return "tf32";}
+
+template <class T> float from_plane_element(const typename host::plane_t<T>::type v);
+// Decode binary16 bits
+template <> float from_plane_element<host::fp16>(const std::uint16_t v) {
+	const auto sign = (v & 0x8000u) ? -1.f : 1.f;
+	const auto e = (v >> 10) & 0x1fu;
+	const auto m = v & 0x3ffu;
+	if (e == 0) {
+		return sign * std::ldexp(static_cast<float>(m), -24);
+	}
+	if (e == 31) {
+		return m ? NAN : sign * INFINITY;
+	}
+	return sign * std::ldexp(static_cast<float>(m | 0x400u), static_cast<int>(e) - 25);
+}
+template <> float from_plane_element<host::tf32>(const float v) {return v;}
+
+void test_fp16_bits(const float v, const std::uint16_t expected) {
+	const auto bits = host::to_fp16_bits(host::round_to_fp16(v));
+	std::printf("[fp16_bits] %+e -> 0x%04x, expected:0x%04x (%6s)\n",
+			v, bits, expected,
+			result_string(bits == expected)
+			);
+}
+
+template <class T>
+void test_split_matrix(const unsigned m, const unsigned n, const unsigned ld_src, const unsigned ld_dst) {
+	using plane_t = typename host::plane_t<T>::type;
+	std::mt19937 mt(m * n);
+	std::uniform_real_distribution<float> dist(0.5f, 1.f);
+	std::vector<float> src(ld_src * n);
+	for (auto& v : src) {
+		v = std::ldexp((mt() % 2 ? -1.f : 1.f) * dist(mt), static_cast<int>(mt() % 20) - 10);
+	}
+
+	// The padding of the planes must not be written
+	const plane_t guard = 7;
+	std::vector<plane_t> hi(ld_dst * n, guard), lo(ld_dst * n, guard);
+	host::split_matrix<T>(hi.data(), lo.data(), ld_dst, src.data(), ld_src, m, n);
+
+	bool planes_ok = true;
+	double max_relative_error = 0;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < ld_dst; i++) {
+			const auto index = i + j * ld_dst;
+			if (i >= m) {
+				planes_ok = planes_ok && hi[index] == guard && lo[index] == guard;
+				continue;
+			}
+			const auto v = src[i + j * ld_src];
+			float hv, dhv;
+			host::split<T>(v, hv, dhv);
+			const auto hi_v = from_plane_element<T>(hi[index]);
+			const auto lo_v = from_plane_element<T>(lo[index]);
+			planes_ok = planes_ok && hi_v == hv && lo_v == dhv;
+
+			// hi + lo keeps about 22 bits of the mantissa
+			const double reconstructed = static_cast<double>(hi_v) + host::correction_scale_1<T>(lo_v);
+			max_relative_error = std::max(max_relative_error, std::abs(reconstructed - v) / std::abs(v));
+		}
+	}
+
+	const bool passed = planes_ok && max_relative_error < std::ldexp(1., -20);
+	std::printf("[split_matrix] %s, m:%4u, n:%4u, ld_src:%4u, ld_dst:%4u, planes:%s, max_relative_error:%e (%6s)\n",
+			get_type_name<T>(),
+			m, n, ld_src, ld_dst,
+			(planes_ok ? "OK" : "NG"),
+			max_relative_error,
+			result_string(passed)
+			);
+}
+} // namespace
+
+int main() {
+	test_fp16_bits(0.f              , 0x0000u);
+	test_fp16_bits(-0.f             , 0x8000u);
+	test_fp16_bits(1.f              , 0x3c00u);
+	test_fp16_bits(-2.f             , 0xc000u);
+	test_fp16_bits(65504.f          , 0x7bffu);
+	test_fp16_bits(65520.f          , 0x7c00u);
+	test_fp16_bits(std::ldexp(1, -14), 0x0400u);
+	test_fp16_bits(std::ldexp(1, -24), 0x0001u);
+	test_fp16_bits(std::ldexp(3, -25), 0x0002u);
+	test_fp16_bits(-INFINITY        , 0xfc00u);
+	test_fp16_bits(NAN              , 0x7fffu);
+
+	test_split_matrix<host::fp16>(64, 64, 64, 64);
+	test_split_matrix<host::fp16>(37, 29, 40, 41);
+	test_split_matrix<host::tf32>(64, 64, 64, 64);
+	test_split_matrix<host::tf32>(37, 29, 40, 41);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,186 @@
+// Host test of the pre-split operand files (no GPU is required)
+#include <cstdio>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <wmma_extension/tcec/split_file.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace host = mtk::wmma::tcec::host;
+namespace split_file = mtk::wmma::tcec::split_file;
+
+template <class T> const char* get_type_name();
+template <> const char* get_type_name<host::fp16>() {return "fp16";}
+template <> const char* get_type_name<host::tf32>() {return "tf32";}
+
+template <class Func>
+bool throws(Func func) {
+	try {
+		func();
+	} catch (const std::runtime_error&) {
+		return true;
+	}
+	return false;
+}
+
+// Overwrite `size` bytes at `offset` of a file
+void patch_file(const std::string& path, const std::size_t offset, const void* const ptr, const std::size_t size) {
+	std::fstream fs(path, std::ios::binary | std::ios::in | std::ios::out);
+	fs.seekp(static_cast<std::streamoff>(offset));
+	fs.write(reinterpret_cast<const char*>(ptr), size);
+}
+
+template <class T>
+void test_round_trip(const unsigned rows, const unsigned cols, const unsigned ld, const unsigned tile_rows, const unsigned tile_cols) {
+	using plane_t = typename host::plane_t<T>::type;
+	std::mt19937 mt(rows * cols);
+	std::uniform_real_distribution<float> dist(-1.f, 1.f);
+	std::vector<float> src(ld * cols);
+	for (auto& v : src) {
+		v = dist(mt);
+	}
+
+	const std::string path = std::string("split_file.host.") + get_type_name<T>() + ".wsf";
+	split_file::write<T>(path, src.data(), ld, rows, cols, tile_rows, tile_cols);
+
+	bool passed;
+	{
+		split_file::mapped_file file(path);
+		const auto& h = file.get_header();
+		passed = h.rows == rows && h.cols == cols && h.type == split_file::detail::element_type_of<T>::value;
+		passed = passed && h.hi_offset % 4096 == 0 && h.lo_offset % 4096 == 0;
+		passed = passed && file.verify_checksum();
+		passed = passed && split_file::count_mismatched_tiles<T>(file, src.data(), ld) == 0;
+
+		// Each tile is a col major tile_rows x tile_cols matrix which is the same as the split of the source
+		std::vector<plane_t> hi(rows * cols), lo(rows * cols);
+		host::split_matrix<T>(hi.data(), lo.data(), rows, src.data(), ld, rows, cols);
+		for (unsigned j = 0; passed && j < h.num_tiles_n * tile_cols; j++) {
+			for (unsigned i = 0; i < h.num_tiles_m * tile_rows; i++) {
+				const auto index = (i % tile_rows) + (j % tile_cols) * tile_rows;
+				const auto tile_hi = file.tile_hi<plane_t>(i / tile_rows, j / tile_cols)[index];
+				const auto tile_lo = file.tile_lo<plane_t>(i / tile_rows, j / tile_cols)[index];
+				if (i < rows && j < cols) {
+					passed = passed && std::memcmp(&tile_hi, &hi[i + j * rows], sizeof(plane_t)) == 0 && std::memcmp(&tile_lo, &lo[i + j * rows], sizeof(plane_t)) == 0;
+				} else {
+					passed = passed && tile_hi == 0 && tile_lo == 0;
+				}
+			}
+		}
+
+		// A modified source is detected
+		src[rows / 2] += 1.f;
+		passed = passed && split_file::count_mismatched_tiles<T>(file, src.data(), ld) == 1;
+
+		// Moved mapping
+		split_file::mapped_file moved(std::move(file));
+		passed = passed && file.data() == nullptr && moved.verify_checksum();
+	}
+
+	std::printf("[round_trip] %s, rows:%4u, cols:%4u, ld:%4u, tile:%2ux%2u (%6s)\n",
+			get_type_name<T>(),
+			rows, cols, ld, tile_rows, tile_cols,
+			result_string(passed)
+			);
+	std::remove(path.c_str());
+}
+
+void test_invalid_files() {
+	std::vector<float> src(64 * 64, 1.f);
+	const std::string path = "split_file.host.invalid.wsf";
+	const auto h = split_file::write<host::fp16>(path, src.data(), 64, 64, 64, 32, 32);
+
+	// Corrupted plane : the header is valid but the checksum is not
+	const std::uint16_t corrupted = 0x1234;
+	patch_file(path, h.lo_offset + 10, &corrupted, sizeof(corrupted));
+	bool passed = !split_file::mapped_file(path).verify_checksum();
+
+	// Corrupted header
+	const std::uint32_t wrong_version = split_file::version + 1;
+	patch_file(path, offsetof(split_file::header, version), &wrong_version, sizeof(wrong_version));
+	passed = passed && throws([&]() {split_file::mapped_file file(path);});
+	patch_file(path, 0, "NOTSPLIT", 8);
+	passed = passed && throws([&]() {split_file::mapped_file file(path);});
+
+	// Truncated file
+	split_file::write<host::fp16>(path, src.data(), 64, 64, 64, 32, 32);
+	{
+		std::vector<char> bytes(h.lo_offset + h.plane_bytes - 1);
+		std::ifstream ifs(path, std::ios::binary);
+		ifs.read(bytes.data(), bytes.size());
+		ifs.close();
+		std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+		ofs.write(bytes.data(), bytes.size());
+	}
+	passed = passed && throws([&]() {split_file::mapped_file file(path);});
+	std::remove(path.c_str());
+
+	// Wrapping sizes : rows = 2^63, cols = 2 and 1 x 1 tiles make the plane size 2^65 bytes, which wraps to 0
+	{
+		split_file::header wrapped;
+		std::memset(&wrapped, 0, sizeof(wrapped));
+		std::memcpy(wrapped.magic, split_file::magic, sizeof(split_file::magic));
+		wrapped.version      = split_file::version;
+		wrapped.header_size  = sizeof(split_file::header);
+		wrapped.type         = split_file::element_type::fp16;
+		wrapped.element_size = 2;
+		wrapped.rows         = 1ull << 63;
+		wrapped.cols         = 2;
+		wrapped.tile_rows    = 1;
+		wrapped.tile_cols    = 1;
+		wrapped.num_tiles_m  = wrapped.rows;
+		wrapped.num_tiles_n  = wrapped.cols;
+		wrapped.alignment    = 4096;
+		wrapped.hi_offset    = 4096;
+		wrapped.lo_offset    = 4096;
+		wrapped.plane_bytes  = 0;
+		passed = passed && !split_file::check_header(wrapped, 8192).empty();
+
+		std::vector<char> bytes(8192, 0);
+		std::memcpy(bytes.data(), &wrapped, sizeof(wrapped));
+		std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), bytes.size());
+		passed = passed && throws([&]() {split_file::mapped_file file(path);});
+
+		// Wrapping plane end
+		wrapped.rows        = 64;
+		wrapped.cols        = 64;
+		wrapped.tile_rows   = 32;
+		wrapped.tile_cols   = 32;
+		wrapped.num_tiles_m = 2;
+		wrapped.num_tiles_n = 2;
+		wrapped.plane_bytes = 64 * 64 * 2;
+		wrapped.lo_offset   = 0ull - 4096;
+		passed = passed && !split_file::check_header(wrapped, 1ull << 20).empty();
+	}
+	std::remove(path.c_str());
+
+	// ld < rows of the source
+	split_file::write<host::fp16>(path, src.data(), 64, 64, 64, 32, 32);
+	passed = passed && throws([&]() {split_file::count_mismatched_tiles<host::fp16>(split_file::mapped_file(path), src.data(), 63);});
+	passed = passed && throws([&]() {split_file::write<host::fp16>(path, src.data(), 63, 64, 64, 32, 32);});
+	std::remove(path.c_str());
+
+	// Nonexistent file
+	passed = passed && throws([&]() {split_file::mapped_file file("split_file.host.not_exist.wsf");});
+
+	std::printf("[invalid_files] (%6s)\n",
+			result_string(passed)
+			);
+}
+} // namespace
+
+int main() {
+	test_round_trip<host::fp16>(64, 64, 64, 32, 32);
+	test_round_trip<host::fp16>(100, 37, 103, 32, 16);
+	test_round_trip<host::tf32>(64, 64, 64, 32, 32);
+	test_round_trip<host::tf32>(100, 37, 103, 16, 32);
+	test_invalid_files();
+
+	return mtk::test_utils::host_test::exit_code();
+}
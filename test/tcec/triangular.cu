@@ -0,0 +1,169 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <wmma_extension/tcec/triangular.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr unsigned block = 32;
+constexpr unsigned warp_n = 32;
+constexpr unsigned warp_k = 32;
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using tc_t = half;
+using policy = typename mtk::wmma::tcec::default_policy<tc_t, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma, sm_t>::type;
+
+template <class T>
+T* to_device(const std::vector<T>& v) {
+	T* ptr;
+	WMMAE_CUDA_CHECK_ERROR(cudaMalloc(&ptr, sizeof(T) * std::max<std::size_t>(v.size(), 1)));
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(ptr, v.data(), sizeof(T) * v.size(), cudaMemcpyDefault));
+	return ptr;
+}
+
+double relative_residual(const std::vector<float>& target, const std::vector<float>& ref) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+	for (std::size_t i = 0; i < ref.size(); i++) {
+		const auto diff = static_cast<double>(target[i]) - ref[i];
+		base_norm += static_cast<double>(ref[i]) * ref[i];
+		diff_norm += diff * diff;
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+// A lower triangular matrix with the dominant diagonal and nan in the upper part, which must not be referenced
+std::vector<float> make_lower(const unsigned m, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> l(static_cast<std::size_t>(m) * m);
+	for (unsigned j = 0; j < m; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			l[i + j * static_cast<std::size_t>(m)] = i < j ? std::nanf("") : dist(mt) / std::sqrt(static_cast<float>(m));
+		}
+		l[j + j * static_cast<std::size_t>(m)] = 1.f + std::abs(dist(mt));
+	}
+	return l;
+}
+
+template <class Func>
+double measure_time(Func func) {
+	constexpr unsigned test_count = 1u << 4;
+	const auto start_clock = std::chrono::system_clock::now();
+	for (unsigned t = 0; t < test_count; t++) {
+		func();
+	}
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto end_clock = std::chrono::system_clock::now();
+	return std::chrono::duration_cast<std::chrono::microseconds>(end_clock - start_clock).count() * 1e-6 / test_count;
+}
+
+// C = alpha * L * B and B = alpha * inv(L) * B
+void test_trmm_trsm(const unsigned m, const unsigned n) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	const auto l = make_lower(m, mt);
+	std::vector<float> b(static_cast<std::size_t>(m) * n), c(static_cast<std::size_t>(m) * n, 0.f);
+	for (auto& v : b) v = dist(mt);
+	const float alpha = 1.5f;
+
+	auto d_l   = to_device(l);
+	auto d_b   = to_device(b);
+	auto d_c   = to_device(c);
+	auto d_inv = to_device(std::vector<float>(static_cast<std::size_t>(m) * block));
+
+	// TRMM
+	mtk::wmma::tcec::triangular::launch_trmm<block, warp_n, tc_t, policy>(m, n, alpha, d_l, m, d_b, m, d_c, m);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> result(c.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(result.data(), d_c, sizeof(float) * c.size(), cudaMemcpyDefault));
+	mtk::wmma::tcec::triangular::host::trmm(m, n, alpha, l.data(), m, b.data(), m, c.data(), m);
+	const auto trmm_residual = relative_residual(result, c);
+	const auto trmm_time = measure_time([&]() {
+			mtk::wmma::tcec::triangular::launch_trmm<block, warp_n, tc_t, policy>(m, n, alpha, d_l, m, d_b, m, d_c, m);
+			});
+
+	// TRSM
+	mtk::wmma::tcec::triangular::launch_trsm<block, warp_n, tc_t, policy>(m, n, alpha, d_l, m, d_b, m, d_inv);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(result.data(), d_b, sizeof(float) * b.size(), cudaMemcpyDefault));
+	mtk::wmma::tcec::triangular::host::trsm(m, n, alpha, l.data(), m, b.data(), m);
+	const auto trsm_residual = relative_residual(result, b);
+	const auto trsm_time = measure_time([&]() {
+			// B is overwritten, so the values are meaningless here
+			mtk::wmma::tcec::triangular::launch_trsm<block, warp_n, tc_t, policy>(m, n, 1.f, d_l, m, d_c, m, d_inv);
+			});
+
+	// The flops of the lower triangle
+	const auto flop = static_cast<double>(m) * m * n;
+	std::printf("[trmm] m:%5u, n:%5u, residual:%e, throughput:%e TFlop/s (%6s)\n",
+			m, n,
+			trmm_residual,
+			flop / trmm_time / 1e12,
+			(trmm_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+	std::printf("[trsm] m:%5u, n:%5u, residual:%e, throughput:%e TFlop/s (%6s)\n",
+			m, n,
+			trsm_residual,
+			flop / trsm_time / 1e12,
+			(trsm_residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_l));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_c));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_inv));
+}
+
+// C = alpha * A^T * A + beta * C (lower)
+void test_syrk(const unsigned n, const unsigned k) {
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(k) * n), c(static_cast<std::size_t>(n) * n);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : c) v = dist(mt);
+	const float alpha = 1.5f, beta = -0.5f;
+
+	auto d_a = to_device(a);
+	auto d_c = to_device(c);
+
+	mtk::wmma::tcec::triangular::launch_syrk<block, warp_k, tc_t, policy>(n, k, alpha, d_a, k, beta, d_c, n);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	std::vector<float> result(c.size());
+	WMMAE_CUDA_CHECK_ERROR(cudaMemcpy(result.data(), d_c, sizeof(float) * c.size(), cudaMemcpyDefault));
+	// The upper triangle is compared, too (it must not be written)
+	mtk::wmma::tcec::triangular::host::syrk(n, k, alpha, a.data(), k, beta, c.data(), n);
+	const auto residual = relative_residual(result, c);
+	const auto time = measure_time([&]() {
+			mtk::wmma::tcec::triangular::launch_syrk<block, warp_k, tc_t, policy>(n, k, alpha, d_a, k, 0.f, d_c, n);
+			});
+
+	std::printf("[syrk] n:%5u, k:%5u, tiles:%7lu / %7lu, residual:%e, throughput:%e TFlop/s (%6s)\n",
+			n, k,
+			mtk::wmma::tcec::triangular::num_lower_tiles(n / block),
+			static_cast<unsigned long>(n / block) * (n / block),
+			residual,
+			static_cast<double>(n) * (n + 1) * k / time / 1e12,
+			(residual < error_threshold ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_c));
+}
+} // noname namespace
+
+int main() {
+	for (unsigned n = 1u << 9; n <= (1u << 12); n <<= 1) {
+		test_trmm_trsm(n, n);
+		test_syrk(n, n);
+	}
+}
@@ -0,0 +1,140 @@
+// Host test of the lower tile mapping and the references of the triangular kernels (no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <wmma_extension/tcec/triangular_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace triangular = mtk::wmma::tcec::triangular;
+
+void test_lower_tile(const unsigned num_tiles) {
+	std::vector<unsigned> count(num_tiles * num_tiles, 0);
+	const auto num_lower_tiles = triangular::num_lower_tiles(num_tiles);
+	unsigned num_invalid = 0;
+	for (unsigned long t = 0; t < num_lower_tiles; t++) {
+		unsigned ti, tj;
+		triangular::lower_tile(t, ti, tj);
+		if (ti >= num_tiles || tj > ti) {
+			num_invalid++;
+			continue;
+		}
+		count[ti + tj * num_tiles]++;
+	}
+	// Every tile of the lower triangle exactly once
+	unsigned num_mismatches = 0;
+	for (unsigned tj = 0; tj < num_tiles; tj++) {
+		for (unsigned ti = 0; ti < num_tiles; ti++) {
+			num_mismatches += count[ti + tj * num_tiles] != (ti >= tj ? 1u : 0u);
+		}
+	}
+	std::printf("[lower_tile] tiles:%5u x %5u, lower tiles:%9lu, invalid:%u, mismatches:%u (%6s)\n",
+			num_tiles, num_tiles,
+			num_lower_tiles,
+			num_invalid,
+			num_mismatches,
+			result_string(num_invalid == 0 && num_mismatches == 0)
+			);
+}
+
+// A lower triangular matrix with the dominant diagonal and garbage in the upper part, which must not be referenced
+std::vector<float> make_lower(const unsigned m, const unsigned ld, std::mt19937& mt) {
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> l(static_cast<std::size_t>(ld) * m);
+	for (unsigned j = 0; j < m; j++) {
+		for (unsigned i = 0; i < ld; i++) {
+			l[i + j * ld] = i < j ? 1e30f : dist(mt);
+		}
+		l[j + j * ld] = 4.f + dist(mt);
+	}
+	return l;
+}
+
+// trsm(trmm(B)) = B
+void test_trmm_trsm(const unsigned m, const unsigned n, const unsigned ld) {
+	std::mt19937 mt(m + n);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	const auto l = make_lower(m, ld, mt);
+	std::vector<float> b(static_cast<std::size_t>(ld) * n), c(static_cast<std::size_t>(ld) * n, 0.f);
+	for (auto& v : b) v = dist(mt);
+	const float alpha = 2.f;
+
+	triangular::host::trmm(m, n, alpha, l.data(), ld, b.data(), ld, c.data(), ld);
+	// The dense product of the lower part
+	double trmm_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			double acc = 0.;
+			for (unsigned k = 0; k < m; k++) {
+				acc += (k <= i ? static_cast<double>(l[i + k * ld]) : 0.) * b[k + j * ld];
+			}
+			trmm_error = std::max(trmm_error, std::abs(alpha * acc - c[i + j * ld]));
+		}
+	}
+
+	triangular::host::trsm(m, n, 1.f / alpha, l.data(), ld, c.data(), ld);
+	double trsm_error = 0.;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < m; i++) {
+			trsm_error = std::max(trsm_error, std::abs(static_cast<double>(c[i + j * ld]) - b[i + j * ld]));
+		}
+	}
+
+	std::printf("[trmm/trsm] m:%4u, n:%4u, ld:%4u, trmm error:%e, trsm(trmm(B)) error:%e (%6s)\n",
+			m, n, ld,
+			trmm_error,
+			trsm_error,
+			result_string(trmm_error < 1e-5 && trsm_error < 1e-5)
+			);
+}
+
+void test_syrk(const unsigned n, const unsigned k, const unsigned ld) {
+	std::mt19937 mt(n * k);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	std::vector<float> a(static_cast<std::size_t>(ld) * n), c(static_cast<std::size_t>(ld) * n);
+	for (auto& v : a) v = dist(mt);
+	for (auto& v : c) v = dist(mt);
+	const auto c_init = c;
+	const float alpha = 1.5f, beta = -0.5f;
+
+	triangular::host::syrk(n, k, alpha, a.data(), ld, beta, c.data(), ld);
+	double error = 0.;
+	unsigned num_upper_written = 0;
+	for (unsigned j = 0; j < n; j++) {
+		for (unsigned i = 0; i < n; i++) {
+			if (i < j) {
+				num_upper_written += c[i + j * ld] != c_init[i + j * ld];
+				continue;
+			}
+			double acc = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				acc += static_cast<double>(a[l + i * ld]) * a[l + j * ld];
+			}
+			error = std::max(error, std::abs(alpha * acc + static_cast<double>(beta) * c_init[i + j * ld] - c[i + j * ld]));
+		}
+	}
+
+	std::printf("[syrk] n:%4u, k:%4u, ld:%4u, error:%e, upper written:%u (%6s)\n",
+			n, k, ld,
+			error,
+			num_upper_written,
+			result_string(error < 1e-5 && num_upper_written == 0)
+			);
+}
+} // namespace
+
+int main() {
+	for (const auto num_tiles : {0u, 1u, 2u, 7u, 64u, 1000u}) {
+		test_lower_tile(num_tiles);
+	}
+	test_trmm_trsm(64, 32, 64);
+	test_trmm_trsm(96, 64, 100);
+	test_syrk(64, 32, 64);
+	test_syrk(96, 64, 100);
+
+	return mtk::test_utils::host_test::exit_code();
+}
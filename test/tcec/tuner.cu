@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include <wmma_extension/tcec/tuner.hpp>
+#include "utils.hpp"
+
+namespace {
+constexpr double error_threshold = 1e-5;
+
+#if defined(SM_ARCH) && SM_ARCH == 75
+using sm_t = mtk::wmma::tcec::sm_75;
+#elif defined(SM_ARCH) && SM_ARCH == 70
+using sm_t = mtk::wmma::tcec::sm_70;
+#else
+using sm_t = mtk::wmma::tcec::sm_80;
+#endif
+using mma_policy  = typename mtk::wmma::tcec::detail::default_policy<half, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_mma , sm_t>::type;
+using wmma_policy = typename mtk::wmma::tcec::detail::default_policy<half, mtk::wmma::tcec::with_ec, mtk::wmma::tcec::op_wmma, sm_t>::type;
+
+using candidates_t = mtk::wmma::tcec::tuner::candidate_list<
+	mtk::wmma::tcec::tuner::candidate<half, mma_policy , 64 , 64 , 32, 32, 16>,
+	mtk::wmma::tcec::tuner::candidate<half, mma_policy , 128, 64 , 32, 32, 32>,
+	mtk::wmma::tcec::tuner::candidate<half, wmma_policy, 64 , 64 , 32, 32, 16>,
+	mtk::wmma::tcec::tuner::candidate<half, wmma_policy, 128, 128, 32, 32, 16>
+	>;
+
+double compute_residual(const unsigned m, const unsigned n, const unsigned k, const float* const a, const float* const b, const float* const c) {
+	double base_norm = 0.;
+	double diff_norm = 0.;
+#pragma omp parallel for collapse(2) reduction(+: base_norm) reduction(+: diff_norm)
+	for (unsigned i = 0; i < m; i++) {
+		for (unsigned j = 0; j < n; j++) {
+			double r = 0.;
+			for (unsigned l = 0; l < k; l++) {
+				r += static_cast<double>(a[l + i * k]) * static_cast<double>(b[l + j * k]);
+			}
+			const auto diff = c[i + j * m] - r;
+			base_norm += r * r;
+			diff_norm += diff * diff;
+		}
+	}
+	return std::sqrt(diff_norm / base_norm);
+}
+
+void test_tuner(const unsigned m, const unsigned n, const unsigned k) {
+	float *d_a, *d_b, *d_c;
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_a, sizeof(float) * m * k));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_b, sizeof(float) * k * n));
+	WMMAE_CUDA_CHECK_ERROR(cudaMallocManaged(&d_c, sizeof(float) * m * n));
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+	for (unsigned i = 0; i < m * k; i++) d_a[i] = dist(mt);
+	for (unsigned i = 0; i < k * n; i++) d_b[i] = dist(mt);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+
+	// Measurement
+	mtk::wmma::tcec::tuner::cache cache;
+	const auto num_measured = mtk::wmma::tcec::tuner::tune<candidates_t>(cache, m, n, k, d_a, k, d_b, k, d_c, m);
+	const mtk::wmma::tcec::tuner::problem p{m, n, k, mtk::wmma::tcec::tuner::get_device_string()};
+	const auto best = cache.find_best(p);
+
+	// Dispatch by the cache
+	for (unsigned i = 0; i < m * n; i++) d_c[i] = 0.f;
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto launched = mtk::wmma::tcec::tuner::gemm<candidates_t>(cache, m, n, k, 1.f, d_a, k, d_b, k, 0.f, d_c, m);
+	WMMAE_CUDA_CHECK_ERROR(cudaDeviceSynchronize());
+	const auto residual = compute_residual(m, n, k, d_a, d_b, d_c);
+
+	// Reload
+	const auto reloaded = mtk::wmma::tcec::tuner::cache::from_json(cache.to_json());
+	const auto reloaded_best = reloaded.find_best(p);
+
+	const bool passed = num_measured > 0 && best != nullptr && launched && residual < error_threshold
+		&& reloaded_best != nullptr && reloaded_best->config == best->config;
+
+	std::printf("[tuner] device:%s, m:%5u, n:%5u, k:%5u, measured:%zu, best:%s, time:%e, residual:%e (%6s)\n",
+			p.device.c_str(),
+			m, n, k,
+			num_measured,
+			best ? best->config.to_string().c_str() : "-",
+			best ? best->time : 0.,
+			residual,
+			(passed ? "PASSED" : "FAILED")
+			);
+
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_a));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_b));
+	WMMAE_CUDA_CHECK_ERROR(cudaFree(d_c));
+}
+} // noname namespace
+
+int main() {
+	test_tuner(256, 256, 256);
+	test_tuner(1024, 512, 2048);
+}
@@ -0,0 +1,164 @@
+// Host test of the tuner (cost model mode, no GPU is required)
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+#include <wmma_extension/tcec/tuner_host.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace tuner = mtk::wmma::tcec::tuner;
+
+bool is_same_record(const tuner::record& a, const tuner::record& b) {
+	return a.problem == b.problem && a.config == b.config && a.time == b.time && a.source == b.source;
+}
+
+void test_cost_model(const std::string& arch, const unsigned m, const unsigned n, const unsigned k) {
+	tuner::cache cache;
+	const tuner::problem p{m, n, k, arch};
+	const auto candidates = tuner::default_candidates(arch);
+	const auto count = tuner::tune_with_cost_model(cache, p, candidates);
+	const auto best = cache.find_best(p);
+
+	bool passed = count > 0 && best != nullptr;
+	if (passed) {
+		// FP32 accuracy is required by default
+		passed = passed && (best->config.error_correction || best->config.op == "simt");
+		// The best record is the minimum of the estimated times
+		const auto dev = tuner::get_device_model(arch);
+		for (const auto& c : candidates) {
+			passed = passed && tuner::estimate_time(dev, c, m, n, k) >= best->time;
+		}
+	}
+
+	std::printf("[cost_model] %s, (%5u, %5u, %5u), candidates:%4zu, best:%s, time:%e (%6s)\n",
+			arch.c_str(), m, n, k, count,
+			best ? best->config.to_string().c_str() : "-",
+			best ? best->time : 0.,
+			result_string(passed)
+			);
+}
+
+void test_cost_model_properties() {
+	const auto dev = tuner::get_device_model("sm_80");
+	const tuner::config small{"half", "mma", true, 16, 8, 16, 32 , 32 , 32, 32, 16};
+	const tuner::config large{"half", "mma", true, 16, 8, 16, 128, 128, 32, 32, 16};
+	const tuner::config no_ec{"half", "mma", false, 16, 8, 16, 128, 128, 64, 32, 16};
+	const tuner::config ec   {"half", "mma", true , 16, 8, 16, 128, 128, 64, 32, 16};
+	const tuner::config spill{"half", "mma", true, 16, 8, 16, 64, 64, 64, 64, 32};
+	const tuner::config tf32_on_volta{"tf32", "mma", true, 16, 8, 8, 64, 64, 32, 32, 16};
+
+	// A large block tile leaves SMs idle on a small problem
+	const bool wave = tuner::estimate_time(dev, small, 64, 64, 4096) < tuner::estimate_time(dev, large, 64, 64, 4096);
+	// Error correction costs three products
+	const bool ec_cost = tuner::estimate_time(dev, no_ec, 4096, 4096, 4096) < tuner::estimate_time(dev, ec, 4096, 4096, 4096);
+	// Infeasible configurations
+	const bool infeasible =
+		std::isinf(tuner::estimate_time(dev, spill, 4096, 4096, 4096)) &&
+		std::isinf(tuner::estimate_time(tuner::get_device_model("sm_70"), tf32_on_volta, 4096, 4096, 4096)) &&
+		std::isinf(tuner::estimate_time(dev, ec, 4096, 4096, 4100));
+
+	std::printf("[cost_model] wave quantization:%d, ec cost:%d, infeasible:%d (%6s)\n",
+			wave, ec_cost, infeasible,
+			result_string(wave && ec_cost && infeasible)
+			);
+}
+
+void test_json() {
+	tuner::cache cache;
+	tuner::tune_with_cost_model(cache, tuner::problem{1024, 1024, 1024, "sm_80"}, tuner::default_candidates("sm_80"));
+	tuner::tune_with_cost_model(cache, tuner::problem{256, 512, 128, "sm_86:GPU \"name\" \\ with escapes"}, tuner::default_candidates("sm_86", false));
+
+	// Insertion of the same (problem, config) updates the record
+	const auto num_records = cache.records.size();
+	auto r = cache.records[0];
+	r.time = 1.;
+	r.source = "measured";
+	cache.insert(r);
+	bool passed = cache.records.size() == num_records && is_same_record(cache.records[0], r);
+
+	const std::string path = "tuner.host.cache.json";
+	cache.save(path);
+	const auto loaded = tuner::cache::load(path);
+	std::remove(path.c_str());
+
+	passed = passed && loaded.records.size() == cache.records.size();
+	for (std::size_t i = 0; passed && i < cache.records.size(); i++) {
+		passed = passed && is_same_record(loaded.records[i], cache.records[i]);
+	}
+
+	// A file which does not exist is an empty cache
+	passed = passed && tuner::cache::load("tuner.host.not_exist.json").records.empty();
+
+	// Malformed caches
+	for (const auto str : {"", "{", "[]", "{\"version\": 2, \"records\": []}", "{\"version\": 1}", "{\"version\": 1, \"records\": [{\"m\": 1}]}"}) {
+		bool thrown = false;
+		try {
+			tuner::cache::from_json(str);
+		} catch (const std::runtime_error&) {
+			thrown = true;
+		}
+		passed = passed && thrown;
+	}
+
+	std::printf("[json] records:%4zu (%6s)\n", cache.records.size(), result_string(passed));
+}
+
+void test_select() {
+	const tuner::config c0{"half", "mma", true, 16, 8, 16, 64, 64, 32, 32, 16};
+	const tuner::config c1{"half", "mma", true, 16, 8, 16, 32, 32, 32, 32, 16};
+	const tuner::config c2{"half", "wmma", true, 16, 16, 16, 64, 64, 32, 32, 16};
+	const std::vector<tuner::config> compiled = {c0, c1};
+	const std::string device = "sm_80:test device";
+
+	tuner::cache cache;
+	cache.insert(tuner::record{tuner::problem{1024, 1024, 1024, device}, c0, 2e-3, "measured"});
+	cache.insert(tuner::record{tuner::problem{1024, 1024, 1024, device}, c1, 1e-3, "measured"});
+	cache.insert(tuner::record{tuner::problem{1024, 1024, 1024, device}, c2, 1e-4, "measured"});
+	cache.insert(tuner::record{tuner::problem{128, 128, 128, device}, c0, 1e-5, "measured"});
+
+	// The best compiled configuration of the shape
+	const auto s_exact = tuner::select(cache, tuner::problem{1024, 1024, 1024, device}, compiled);
+	// Any configuration in the cache
+	const auto s_any = tuner::select(cache, tuner::problem{1024, 1024, 1024, device});
+	// The nearest shape
+	const auto s_nearest = tuner::select(cache, tuner::problem{192, 160, 128, device}, compiled);
+	// Another device of the same architecture : cost model
+	const auto s_cost = tuner::select(cache, tuner::problem{1024, 1024, 1024, "sm_80:another device"}, compiled);
+	// Unknown architecture : the first applicable candidate
+	const auto s_fallback = tuner::select(cache, tuner::problem{1024, 1024, 1024, "sm_100"}, compiled);
+	// No applicable candidate
+	const auto s_none = tuner::select(cache, tuner::problem{8, 8, 8, device}, compiled);
+
+	const bool passed =
+		s_exact.source == tuner::selection::exact && s_exact.config == c1 &&
+		s_any.source == tuner::selection::exact && s_any.config == c2 &&
+		s_nearest.source == tuner::selection::nearest && s_nearest.config == c0 &&
+		s_cost.source == tuner::selection::cost_model &&
+		s_fallback.source == tuner::selection::fallback && s_fallback.config == c0 &&
+		s_none.source == tuner::selection::none;
+
+	std::printf("[select] exact:%s, nearest:%s, cost_model:%s (%6s)\n",
+			s_exact.config.to_string().c_str(),
+			s_nearest.config.to_string().c_str(),
+			s_cost.config.to_string().c_str(),
+			result_string(passed)
+			);
+}
+} // namespace
+
+int main() {
+	test_cost_model("sm_70", 1024, 1024, 1024);
+	test_cost_model("sm_75", 1024, 1024, 1024);
+	test_cost_model("sm_80", 1024, 1024, 1024);
+	test_cost_model("sm_80", 64, 64, 4096);
+	test_cost_model("sm_80", 8192, 8192, 256);
+	test_cost_model("sm_86", 2048, 512, 1024);
+	test_cost_model("sm_89", 4096, 4096, 4096);
+	test_cost_model_properties();
+	test_json();
+	test_select();
+
+	return mtk::test_utils::host_test::exit_code();
+}
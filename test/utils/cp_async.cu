@@ -1,4 +1,5 @@
 #include <iostream>
+#include <type_traits>
 #include <wmma_extension/utils.hpp>
 
 template <class T>
@@ -21,7 +22,23 @@ __global__ void cp_async_test_kernel(
 	dst_ptr[threadIdx.x] = smem[threadIdx.x];
 }
 
-template <class T, unsigned block_size>
+// Odd threads copy nothing and zero-fill the destination
+template <class T, unsigned block_size, class CacheOp>
+__global__ void cp_async_zfill_test_kernel(
+		T* const dst_ptr,
+		const T* const src_ptr
+		) {
+	__shared__ T smem[block_size];
+
+	const auto l2_policy = mtk::wmma::utils::cp_async::create_l2_policy<mtk::wmma::utils::cp_async::evict_first>();
+	mtk::wmma::utils::cp_async::cp_async_zfill<get_size_in_byte<T>(), CacheOp>(smem + threadIdx.x, src_ptr + threadIdx.x, (threadIdx.x % 2 == 0) ? get_size_in_byte<T>() : 0, l2_policy);
+	mtk::wmma::utils::cp_async::commit();
+
+	mtk::wmma::utils::cp_async::wait_all();
+	dst_ptr[threadIdx.x] = smem[threadIdx.x];
+}
+
+template <class T, unsigned block_size, class CacheOp = void>
 void cp_async_test() {
 	T* d_input;
 	T* d_output;
@@ -39,17 +56,24 @@ void cp_async_test() {
 
 	cudaMemcpy(d_input, h_input, block_size * sizeof(T), cudaMemcpyDefault);
 
-	cp_async_test_kernel<T, block_size><<<1, block_size>>>(d_output, d_input);
+	if (std::is_same<CacheOp, void>::value) {
+		cp_async_test_kernel<T, block_size><<<1, block_size>>>(d_output, d_input);
+	} else {
+		cp_async_zfill_test_kernel<T, block_size, typename std::conditional<std::is_same<CacheOp, void>::value, mtk::wmma::utils::cp_async::cache_all, CacheOp>::type><<<1, block_size>>>(d_output, d_input);
+	}
 
 	cudaMemcpy(h_output, d_output, block_size * sizeof(T), cudaMemcpyDefault);
 
 	double max_error = 0;
 	for (unsigned i = 0; i < block_size * get_size_in_byte<T>() / 4; i++) {
-		const double diff = reinterpret_cast<float*>(h_output)[i] - reinterpret_cast<float*>(h_input)[i];
+		const auto expected = (std::is_same<CacheOp, void>::value || (i / (get_size_in_byte<T>() / 4)) % 2 == 0) ? reinterpret_cast<float*>(h_input)[i] : 0.f;
+		const double diff = reinterpret_cast<float*>(h_output)[i] - expected;
 		max_error = std::max(std::abs(diff), max_error);
 	}
 
-	std::printf("%s[%2u Byte] error = %e\n", __func__, get_size_in_byte<T>(), max_error);
+	std::printf("%s[%2u Byte, %5s] error = %e\n", __func__, get_size_in_byte<T>(),
+			std::is_same<CacheOp, void>::value ? "-" : (std::is_same<CacheOp, mtk::wmma::utils::cp_async::cache_all>::value ? "zfill" : "cg"),
+			max_error);
 
 	cudaFree(d_input);
 	cudaFree(d_output);
@@ -61,5 +85,9 @@ int main() {
 	cp_async_test<float , 128>();
 	cp_async_test<float2, 128>();
 	cp_async_test<float4, 128>();
+	cp_async_test<float , 128, mtk::wmma::utils::cp_async::cache_all   >();
+	cp_async_test<float2, 128, mtk::wmma::utils::cp_async::cache_all   >();
+	cp_async_test<float4, 128, mtk::wmma::utils::cp_async::cache_all   >();
+	cp_async_test<float4, 128, mtk::wmma::utils::cp_async::cache_global>();
 }
 
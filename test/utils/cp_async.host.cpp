@@ -0,0 +1,78 @@
+// Host test of mtk::wmma::utils::cp_async (no GPU is required)
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <initializer_list>
+#include <wmma_extension/detail/cp_async.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+template <unsigned Size, class CacheOp>
+void cp_async_zfill_test(const char* const name, const bool with_l2_policy) {
+	alignas(16) std::uint8_t src[Size];
+	for (unsigned i = 0; i < Size; i++) {
+		src[i] = i + 1;
+	}
+
+	unsigned num_errors = 0;
+	const auto l2_policy = mtk::wmma::utils::cp_async::create_l2_policy<mtk::wmma::utils::cp_async::evict_first>(0.5f);
+	for (unsigned src_size = 0; src_size <= Size; src_size++) {
+		alignas(16) std::uint8_t dst[Size];
+		for (auto& v : dst) v = 0xff;
+
+		// `src` must not be read when src_size == 0
+		const void* const src_ptr = src_size == 0 ? nullptr : src;
+		if (with_l2_policy) {
+			mtk::wmma::utils::cp_async::cp_async_zfill<Size, CacheOp>(dst, src_ptr, src_size, l2_policy);
+		} else {
+			mtk::wmma::utils::cp_async::cp_async_zfill<Size, CacheOp>(dst, src_ptr, src_size);
+		}
+		mtk::wmma::utils::cp_async::commit();
+		mtk::wmma::utils::cp_async::wait_all();
+
+		for (unsigned i = 0; i < Size; i++) {
+			if (dst[i] != (i < src_size ? src[i] : 0)) {
+				num_errors++;
+			}
+		}
+	}
+
+	// Full copy
+	{
+		alignas(16) std::uint8_t dst[Size];
+		if (with_l2_policy) {
+			mtk::wmma::utils::cp_async::cp_async<Size, CacheOp>(dst, src, l2_policy);
+		} else {
+			mtk::wmma::utils::cp_async::cp_async<Size, CacheOp>(dst, src);
+		}
+		mtk::wmma::utils::cp_async::commit();
+		mtk::wmma::utils::cp_async::wait_group<0>();
+		for (unsigned i = 0; i < Size; i++) {
+			if (dst[i] != src[i]) {
+				num_errors++;
+			}
+		}
+	}
+
+	std::printf("%s<%2u Byte, %s>[L2 policy:%3s] errors = %u (%s)\n",
+			__func__,
+			Size,
+			name,
+			(with_l2_policy ? "Yes" : "No"),
+			num_errors,
+			result_string(num_errors == 0)
+			);
+}
+} // noname namespace
+
+int main() {
+	for (const auto with_l2_policy : {false, true}) {
+		cp_async_zfill_test<4 , mtk::wmma::utils::cp_async::cache_all   >("ca", with_l2_policy);
+		cp_async_zfill_test<8 , mtk::wmma::utils::cp_async::cache_all   >("ca", with_l2_policy);
+		cp_async_zfill_test<16, mtk::wmma::utils::cp_async::cache_all   >("ca", with_l2_policy);
+		cp_async_zfill_test<16, mtk::wmma::utils::cp_async::cache_global>("cg", with_l2_policy);
+	}
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,86 @@
+// Host test of the occupancy calculator (no GPU is required)
+#include <cstdio>
+#include <wmma_extension/detail/occupancy.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+namespace utils = mtk::wmma::utils;
+
+// The calculator is usable at compile time
+static_assert(utils::compute_occupancy(utils::get_sm_resource(80), 256, 64, 0).blocks_per_sm == 4, "occupancy");
+static_assert(utils::get_register_budget(utils::get_sm_resource(80), 256, 2) == 128, "register budget");
+
+const char* get_limiter_name(const utils::occupancy_limiter l) {
+	switch (l) {
+	case utils::occupancy_limiter::warps        : return "warps";
+	case utils::occupancy_limiter::blocks       : return "blocks";
+	case utils::occupancy_limiter::registers    : return "registers";
+	case utils::occupancy_limiter::shared_memory: return "shared_memory";
+	default: return "invalid";
+	}
+}
+
+void test_occupancy(
+		const unsigned arch,
+		const unsigned threads_per_block,
+		const unsigned registers_per_thread,
+		const unsigned smem_per_block,
+		const unsigned expected_blocks,
+		const utils::occupancy_limiter expected_limiter
+		) {
+	const auto occ = utils::compute_occupancy(utils::get_sm_resource(arch), threads_per_block, registers_per_thread, smem_per_block);
+	const bool passed = occ.blocks_per_sm == expected_blocks && occ.limiter == expected_limiter &&
+		occ.active_warps_per_sm == expected_blocks * ((threads_per_block + 31) / 32);
+	std::printf("[occupancy] sm_%u, threads:%4u, registers:%3u, smem:%6u, blocks:%2u, ratio:%4.2f, limiter:%13s (%6s)\n",
+			arch, threads_per_block, registers_per_thread, smem_per_block,
+			occ.blocks_per_sm, occ.ratio(), get_limiter_name(occ.limiter),
+			result_string(passed)
+			);
+}
+
+void test_register_budget(
+		const unsigned arch,
+		const unsigned threads_per_block,
+		const unsigned min_blocks_per_sm,
+		const unsigned smem_per_block,
+		const unsigned expected
+		) {
+	const auto res = utils::get_sm_resource(arch);
+	const auto budget = utils::get_register_budget(res, threads_per_block, min_blocks_per_sm, smem_per_block);
+	bool passed = budget == expected;
+	// The budget is the largest one
+	if (budget != 0 && budget + 8 <= res.max_registers_per_thread) {
+		passed = passed && utils::compute_occupancy(res, threads_per_block, budget + 8, smem_per_block).blocks_per_sm < min_blocks_per_sm;
+	}
+	std::printf("[register_budget] sm_%u, threads:%4u, min_blocks:%2u, smem:%6u, budget:%3u (%6s)\n",
+			arch, threads_per_block, min_blocks_per_sm, smem_per_block, budget,
+			result_string(passed)
+			);
+}
+} // namespace
+
+int main() {
+	using limiter = utils::occupancy_limiter;
+	test_occupancy(80, 256 , 32 , 0     , 8 , limiter::warps);
+	test_occupancy(80, 256 , 64 , 0     , 4 , limiter::registers);
+	test_occupancy(80, 32  , 16 , 0     , 32, limiter::blocks);
+	test_occupancy(80, 128 , 32 , 48000 , 3 , limiter::shared_memory);
+	test_occupancy(86, 256 , 32 , 0     , 6 , limiter::warps);
+	test_occupancy(75, 1024, 32 , 0     , 1 , limiter::warps);
+	test_occupancy(70, 96  , 255, 0     , 2 , limiter::registers);
+	test_occupancy(80, 1056, 32 , 0     , 0 , limiter::invalid);
+	test_occupancy(80, 256 , 256, 0     , 0 , limiter::invalid);
+	test_occupancy(80, 256 , 32 , 200000, 0 , limiter::invalid);
+	test_occupancy(60, 256 , 32 , 0     , 0 , limiter::invalid);
+
+	test_register_budget(80, 256 , 1, 0    , 255 / 8 * 8);
+	test_register_budget(80, 256 , 2, 0    , 128);
+	test_register_budget(80, 128 , 4, 0    , 128);
+	test_register_budget(86, 256 , 3, 0    , 80);
+	test_register_budget(80, 128 , 4, 65536, 0);
+	test_register_budget(80, 1024, 2, 0    , 32);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <random>
+#include <wmma_extension/utils.hpp>
+
+template <unsigned Stages, unsigned TileBytes, unsigned block_size>
+__global__ void pipeline_test_kernel(
+		float* const dst_ptr,
+		const float* const src_ptr,
+		const unsigned num_bytes
+		) {
+	using pipeline_t = mtk::wmma::utils::pipeline<Stages, TileBytes>;
+	__shared__ float4 smem[pipeline_t::smem_bytes / sizeof(float4)];
+	pipeline_t pipe(smem);
+
+	const unsigned num_tiles = (num_bytes + TileBytes - 1) / TileBytes;
+	const auto src = reinterpret_cast<const std::uint8_t*>(src_ptr);
+	const auto produce = [&](const unsigned t) {
+		const auto offset = t * TileBytes;
+		const auto valid_bytes = min(TileBytes, num_bytes - offset);
+		pipe.producer_copy_tile(src + offset, valid_bytes, threadIdx.x, block_size);
+		pipe.producer_commit();
+	};
+
+	unsigned t = 0;
+	for (; pipe.num_in_flight() < Stages - 1 && t < num_tiles; t++) {
+		produce(t);
+	}
+	for (unsigned i = 0; i < num_tiles; i++) {
+		if (t < num_tiles) {
+			produce(t++);
+		}
+		const auto tile = reinterpret_cast<const float*>(pipe.consumer_wait());
+		__syncthreads();
+		for (unsigned j = threadIdx.x; j < TileBytes / sizeof(float); j += block_size) {
+			dst_ptr[i * TileBytes / sizeof(float) + j] = tile[j];
+		}
+		__syncthreads();
+		pipe.consumer_release();
+	}
+}
+
+template <unsigned Stages, unsigned TileBytes, unsigned block_size>
+void pipeline_test(const unsigned num_elements) {
+	const unsigned num_bytes = num_elements * sizeof(float);
+	const unsigned num_tiles = (num_bytes + TileBytes - 1) / TileBytes;
+	const unsigned dst_num_elements = num_tiles * TileBytes / sizeof(float);
+	float* src_ptr;
+	float* dst_ptr;
+	cudaMallocManaged(&src_ptr, sizeof(float) * dst_num_elements);
+	cudaMallocManaged(&dst_ptr, sizeof(float) * dst_num_elements);
+
+	std::mt19937 mt(std::random_device{}());
+	std::uniform_real_distribution<float> dist(1.f, 2.f);
+	for (unsigned i = 0; i < dst_num_elements; i++) {
+		src_ptr[i] = dist(mt);
+		dst_ptr[i] = -1.f;
+	}
+
+	pipeline_test_kernel<Stages, TileBytes, block_size><<<1, block_size>>>(dst_ptr, src_ptr, num_bytes);
+	cudaDeviceSynchronize();
+
+	double max_error = 0;
+	for (unsigned i = 0; i < dst_num_elements; i++) {
+		const double expected = i < num_elements ? src_ptr[i] : 0.;
+		max_error = std::max(std::abs(expected - dst_ptr[i]), max_error);
+	}
+
+	std::printf("%s<Stages=%u, TileBytes=%4u>[elements=%5u] error = %e\n", __func__, Stages, TileBytes, num_elements, max_error);
+
+	cudaFree(src_ptr);
+	cudaFree(dst_ptr);
+}
+
+int main() {
+	pipeline_test<2, 1024, 128>(4096);
+	pipeline_test<3, 1024, 128>(4097);
+	pipeline_test<4, 2048, 256>(10001);
+}
@@ -0,0 +1,98 @@
+// Host test of mtk::wmma::utils::pipeline (no GPU is required)
+#include <cstdio>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <wmma_extension/detail/pipeline.hpp>
+#include "../host_test.hpp"
+
+namespace {
+using mtk::test_utils::host_test::result_string;
+
+// Streams `num_tiles` tiles of `src` through the pipeline.
+// The last tile is partial when `num_bytes` is not a multiple of TileBytes.
+template <unsigned Stages, unsigned TileBytes, unsigned Size>
+void pipeline_test(const unsigned num_bytes, const unsigned num_threads) {
+	using pipeline_t = mtk::wmma::utils::pipeline<Stages, TileBytes>;
+	const unsigned num_tiles = (num_bytes + TileBytes - 1) / TileBytes;
+
+	std::vector<std::uint32_t> src(num_tiles * TileBytes / 4);
+	std::mt19937 mt(num_bytes);
+	for (auto& v : src) v = mt() | 1u;
+	alignas(16) std::uint8_t smem[pipeline_t::smem_bytes];
+	for (auto& v : smem) v = 0xff;
+
+	pipeline_t pipe(smem);
+	const auto src_ptr = reinterpret_cast<const std::uint8_t*>(src.data());
+
+	unsigned num_errors = 0;
+	unsigned max_in_flight = 0;
+	unsigned num_ring_errors = 0;
+	unsigned t = 0;
+	const auto produce = [&]() {
+		if (!pipe.can_acquire()) {
+			num_ring_errors++;
+		}
+		if (pipe.producer_acquire() != pipe.stage_ptr(t)) {
+			num_ring_errors++;
+		}
+		const auto offset = t * TileBytes;
+		const auto valid_bytes = (num_bytes - offset < TileBytes) ? num_bytes - offset : TileBytes;
+		// Emulate the threads of a block
+		for (unsigned tid = 0; tid < num_threads; tid++) {
+			pipe.template producer_copy_tile<Size>(src_ptr + offset, valid_bytes, tid, num_threads);
+		}
+		pipe.producer_commit();
+		t++;
+		max_in_flight = std::max(max_in_flight, pipe.num_in_flight());
+	};
+
+	// Prologue
+	for (; pipe.num_in_flight() < Stages - 1 && t < num_tiles;) {
+		produce();
+	}
+	for (unsigned i = 0; i < num_tiles; i++) {
+		if (t < num_tiles) {
+			produce();
+		}
+		const auto tile = reinterpret_cast<const std::uint8_t*>(pipe.consumer_wait());
+		if (tile != smem + (i % Stages) * TileBytes) {
+			num_ring_errors++;
+		}
+		for (unsigned b = 0; b < TileBytes; b++) {
+			const auto offset = i * TileBytes + b;
+			const std::uint8_t expected = offset < num_bytes ? src_ptr[offset] : 0;
+			if (tile[b] != expected) {
+				num_errors++;
+			}
+		}
+		pipe.consumer_release();
+	}
+
+	const bool passed = num_errors == 0 && num_ring_errors == 0 && pipe.num_in_flight() == 0 && max_in_flight <= Stages;
+	std::printf("%s<Stages=%u, TileBytes=%4u, Size=%2u>[bytes=%5u, threads=%3u] tiles=%3u, max_in_flight=%u, errors=%u, ring_errors=%u (%s)\n",
+			__func__,
+			Stages, TileBytes, Size,
+			num_bytes, num_threads,
+			num_tiles,
+			max_in_flight,
+			num_errors,
+			num_ring_errors,
+			result_string(passed)
+			);
+}
+} // noname namespace
+
+int main() {
+	pipeline_test<2, 512 , 16>(4096, 32);
+	pipeline_test<3, 512 , 16>(4100, 32);
+	pipeline_test<3, 512 , 8 >(4100, 7);
+	pipeline_test<4, 1024, 16>(10000, 128);
+	pipeline_test<4, 1024, 4 >(10000, 1);
+	pipeline_test<1, 256 , 16>(1000, 16);
+	pipeline_test<5, 256 , 16>(200, 16);
+	pipeline_test<3, 512 , 16>(4099, 32);
+
+	return mtk::test_utils::host_test::exit_code();
+}
@@ -0,0 +1,165 @@
+// Writer / validator of the pre-split operand files (tcec/split_file.hpp)
+//   ./split_file write --type=half|tf32 --rows=M --cols=N [--ld=LD] [--tile-rows=32] [--tile-cols=32] [--alignment=4096] INPUT OUTPUT
+//   ./split_file validate [--source=INPUT --ld=LD] FILE
+//   ./split_file info FILE
+// INPUT is a raw little endian FP32 matrix in the col major view (a row major matrix is given as its transpose).
+#include <cstdio>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <wmma_extension/tcec/split_file.hpp>
+
+namespace {
+namespace split_file = mtk::wmma::tcec::split_file;
+namespace host = mtk::wmma::tcec::host;
+
+struct arguments {
+	std::string command;
+	std::map<std::string, std::string> options;
+	std::vector<std::string> files;
+};
+
+arguments parse_arguments(const int argc, const char* const* const argv) {
+	if (argc < 2) {
+		throw std::runtime_error("split_file : no command");
+	}
+	arguments args;
+	args.command = argv[1];
+	for (int i = 2; i < argc; i++) {
+		const std::string arg = argv[i];
+		if (arg.compare(0, 2, "--") != 0) {
+			args.files.push_back(arg);
+			continue;
+		}
+		const auto eq = arg.find('=');
+		if (eq == std::string::npos) {
+			throw std::runtime_error("split_file : invalid argument \"" + arg + "\"");
+		}
+		args.options[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+	}
+	return args;
+}
+
+std::uint64_t get_uint(const arguments& args, const std::string& key, const std::uint64_t default_value, const bool required = false) {
+	const auto it = args.options.find(key);
+	if (it == args.options.end()) {
+		if (required) {
+			throw std::runtime_error("split_file : --" + key + " is required");
+		}
+		return default_value;
+	}
+	return std::stoull(it->second);
+}
+
+std::vector<float> read_matrix(const std::string& path, const std::uint64_t ld, const std::uint64_t cols) {
+	std::ifstream ifs(path, std::ios::binary);
+	if (!ifs) {
+		throw std::runtime_error("split_file : cannot open " + path);
+	}
+	if (cols != 0 && ld > SIZE_MAX / sizeof(float) / cols) {
+		throw std::runtime_error("split_file : too large matrix");
+	}
+	std::vector<float> matrix(ld * cols);
+	ifs.read(reinterpret_cast<char*>(matrix.data()), static_cast<std::streamsize>(matrix.size() * sizeof(float)));
+	if (static_cast<std::uint64_t>(ifs.gcount()) != matrix.size() * sizeof(float)) {
+		throw std::runtime_error("split_file : " + path + " is smaller than ld x cols");
+	}
+	return matrix;
+}
+
+const char* get_type_name(const split_file::element_type type) {
+	return type == split_file::element_type::fp16 ? "half" : "tf32";
+}
+
+int write(const arguments& args) {
+	if (args.files.size() != 2) {
+		throw std::runtime_error("split_file : write INPUT OUTPUT");
+	}
+	const auto rows = get_uint(args, "rows", 0, true);
+	const auto cols = get_uint(args, "cols", 0, true);
+	const auto ld = get_uint(args, "ld", rows);
+	const auto tile_rows = static_cast<std::uint32_t>(get_uint(args, "tile-rows", 32));
+	const auto tile_cols = static_cast<std::uint32_t>(get_uint(args, "tile-cols", 32));
+	const auto alignment = get_uint(args, "alignment", 4096);
+	const auto type = args.options.count("type") ? args.options.at("type") : "";
+
+	const auto matrix = read_matrix(args.files[0], ld, cols);
+	split_file::header h;
+	if (type == "half") {
+		h = split_file::write<host::fp16>(args.files[1], matrix.data(), ld, rows, cols, tile_rows, tile_cols, alignment);
+	} else if (type == "tf32") {
+		h = split_file::write<host::tf32>(args.files[1], matrix.data(), ld, rows, cols, tile_rows, tile_cols, alignment);
+	} else {
+		throw std::runtime_error("split_file : --type=half|tf32 is required");
+	}
+	std::printf("%s : %s, %llu x %llu, %llu tiles\n",
+			args.files[1].c_str(),
+			get_type_name(h.type),
+			static_cast<unsigned long long>(h.rows),
+			static_cast<unsigned long long>(h.cols),
+			static_cast<unsigned long long>(h.num_tiles_m * h.num_tiles_n)
+			);
+	return 0;
+}
+
+int info(const arguments& args) {
+	if (args.files.size() != 1) {
+		throw std::runtime_error("split_file : info FILE");
+	}
+	const split_file::mapped_file file(args.files[0]);
+	const auto& h = file.get_header();
+	std::printf("version     : %u\n", h.version);
+	std::printf("type        : %s\n", get_type_name(h.type));
+	std::printf("size        : %llu x %llu\n", static_cast<unsigned long long>(h.rows), static_cast<unsigned long long>(h.cols));
+	std::printf("tile        : %u x %u (%llu x %llu tiles)\n", h.tile_rows, h.tile_cols, static_cast<unsigned long long>(h.num_tiles_m), static_cast<unsigned long long>(h.num_tiles_n));
+	std::printf("alignment   : %llu\n", static_cast<unsigned long long>(h.alignment));
+	std::printf("hi plane    : %llu B at %llu\n", static_cast<unsigned long long>(h.plane_bytes), static_cast<unsigned long long>(h.hi_offset));
+	std::printf("lo plane    : %llu B at %llu\n", static_cast<unsigned long long>(h.plane_bytes), static_cast<unsigned long long>(h.lo_offset));
+	std::printf("checksum    : %016llx %016llx\n", static_cast<unsigned long long>(h.hi_checksum), static_cast<unsigned long long>(h.lo_checksum));
+	return 0;
+}
+
+int validate(const arguments& args) {
+	if (args.files.size() != 1) {
+		throw std::runtime_error("split_file : validate FILE");
+	}
+	const split_file::mapped_file file(args.files[0]);
+	const auto& h = file.get_header();
+	bool passed = file.verify_checksum();
+	std::printf("checksum    : %s\n", passed ? "OK" : "NG");
+
+	if (args.options.count("source")) {
+		const auto ld = get_uint(args, "ld", h.rows);
+		if (ld < h.rows) {
+			throw std::runtime_error("split_file : --ld must be >= the number of rows");
+		}
+		const auto matrix = read_matrix(args.options.at("source"), ld, h.cols);
+		const auto num_mismatches = h.type == split_file::element_type::fp16 ?
+			split_file::count_mismatched_tiles<host::fp16>(file, matrix.data(), ld) :
+			split_file::count_mismatched_tiles<host::tf32>(file, matrix.data(), ld);
+		std::printf("source      : %llu mismatched tile(s)\n", static_cast<unsigned long long>(num_mismatches));
+		passed = passed && num_mismatches == 0;
+	}
+	return passed ? 0 : 1;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+	try {
+		const auto args = parse_arguments(argc, argv);
+		if (args.command == "write") {
+			return write(args);
+		} else if (args.command == "validate") {
+			return validate(args);
+		} else if (args.command == "info") {
+			return info(args);
+		}
+		throw std::runtime_error("split_file : unknown command \"" + args.command + "\"");
+	} catch (const std::exception& e) {
+		std::fprintf(stderr, "%s\n", e.what());
+		return 1;
+	}
+}